@@ -0,0 +1,83 @@
+/**
+ * spscBench.cpp - throughput of the resizeable heap ring buffer
+ * vs. the single producer/consumer heap ring buffer, one producer
+ * thread pushing and one consumer thread popping.
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 10:21:37 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <raft>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+using type_t = std::int64_t;
+
+/**
+ * run - push n_items through the given FIFO, returns
+ * millions of items per second.  Exits on an out of
+ * order item so the numbers can be trusted.
+ */
+static double run( FIFO &fifo, const type_t n_items )
+{
+    const auto s( std::chrono::high_resolution_clock::now() );
+    std::thread producer( [&]()
+    {
+        for( type_t i( 0 ); i < n_items; i++ )
+        {
+            fifo.push( i );
+        }
+    } );
+    for( type_t i( 0 ); i < n_items; i++ )
+    {
+        type_t val( 0 );
+        fifo.pop( val );
+        if( val != i )
+        {
+            std::cerr << "received " << val << ", expected " << i << "\n";
+            exit( EXIT_FAILURE );
+        }
+    }
+    producer.join();
+    const auto e( std::chrono::high_resolution_clock::now() );
+    const std::chrono::duration< double > secs( e - s );
+    return( ( static_cast< double >( n_items ) / secs.count() ) / 1e6 );
+}
+
+int
+main( int argc, char **argv )
+{
+    type_t      n_items( 10000000 );
+    std::size_t cap( 1024 );
+    if( argc >= 2 )
+    {
+        n_items = atoll( argv[ 1 ] );
+    }
+    if( argc >= 3 )
+    {
+        cap = atoll( argv[ 2 ] );
+    }
+    RingBuffer< type_t, Type::Heap, false >     heap( cap, 16 );
+    RingBuffer< type_t, Type::HeapSPSC, false > spsc( cap, 16 );
+
+    std::cout << "items: " << n_items << ", capacity: " << cap << "\n";
+    std::cout << "heap: " << run( heap, n_items ) << " Mitems/s\n";
+    std::cout << "spsc: " << run( spsc, n_items ) << " Mitems/s\n";
+    return( EXIT_SUCCESS );
+}
@@ -15,58 +15,6 @@
  * http://www.bzip.org/1.0.3/html/hl-interface.html
  */
 
-template < class chunktype > class filewrite : public raft::parallel_k
-{
-public:
-    filewrite( const std::string filename,
-               const std::size_t n_output_ports = 1 ) : raft::parallel_k()
-    {
-        out_fp = std::fopen( filename.c_str(), "wb" );
-        if( out_fp == nullptr )
-        {
-            std::cerr << "failed to open output file, " << filename << "\n";
-            exit( EXIT_FAILURE );
-        }
-
-        using index_type = std::remove_const_t<decltype(n_output_ports)>;
-        for( index_type i( 0 ); i < n_output_ports; i++ )
-        {
-            addPortTo< chunktype >( input );
-        }
-    }
-
-    virtual ~filewrite()
-    {
-        std::fflush( out_fp );
-        std::fclose( out_fp );
-    }
-
-    virtual raft::kstatus run()
-    {
-        for( auto &port : input )
-        {
-            if( port.size() > 0 )
-            {
-                auto &ele( port.template peek< chunktype >() );
-                if( ele.index == curr_position )
-                {
-                    std::fwrite( ele.buffer,
-                                 1,
-                                 ele.length,
-                                 out_fp );
-                    curr_position++;
-                    port.recycle( 1 );
-                }
-            }
-        }
-        return( raft::proceed );
-    }
-
-private:
-    FILE *out_fp              = nullptr;
-    std::size_t curr_position = 0;
-};
-
 template < class chunktype > class compress : public raft::kernel
 {
 public:
@@ -167,7 +115,7 @@ main( int argc, char **argv )
     const static auto chunksize( 65536 );
     using chunk_t = raft::filechunk< chunksize >;
     using fr_t    = raft::filereader< chunk_t, false >;
-    using fw_t    = filewrite< chunk_t >;
+    using fw_t    = raft::filewriter< chunk_t >;
     using comp    = compress< chunk_t >;
 
     /** variables to set below **/
@@ -220,8 +168,10 @@ main( int argc, char **argv )
     fr_t reader( inputfile,
                  0, /** no offset needed **/
                  num_threads /** manually set threads for b-marking **/ );
+    /** puts the compressed chunks back in file order as it writes **/
     fw_t writer( outputfile,
-                 num_threads /** manually set threads for b-marking **/ );
+                 num_threads /** one input per compress kernel **/,
+                 true /** ordered **/ );
     comp c( blocksize,
             verbosity,
             workfactor );
@@ -233,7 +183,7 @@ main( int argc, char **argv )
      * detect # output ports from reader,
      * duplicate c that #, assign each
      * output port to the input ports in
-     * writer
+     * writer, which writes them in order
      */
     m += reader <= c >= writer;
 
@@ -48,6 +48,12 @@
 
 #define INITIAL_ALLOC_SIZE 64
 
+/**
+ * INITIAL_SHM_ALLOC_SIZE - shared memory edges are never resized
+ * so start them bigger, a process hop costs more than a thread one.
+ */
+#define INITIAL_SHM_ALLOC_SIZE 4096
+
 namespace raft
 {
     class map;
@@ -107,6 +113,45 @@ protected:
    
    virtual void allocate( PortInfo &a, PortInfo &b, void *data );
 
+   /**
+    * allocate_shm - builds the FIFO for every port linked to a
+    * shared memory edge with raft::map::link_shm.  The other end
+    * is in another process so the graph walk never sees these,
+    * call from run() along with the walk.
+    */
+   void allocate_shm();
+
+   /**
+    * fixed_fifo - returns the FIFO builder to use for an edge
+    * whose size has been fixed by the user.  These are never
+    * resized so the single producer/consumer heap is returned
+    * when the port type supports it, the plain heap otherwise.
+    * @param   a - PortInfo&, source port of the edge
+    * @return  builder function, see port_info_types.hpp
+    */
+   static instr_map_t::mapped_type fixed_fifo( PortInfo &a );
+
+   /**
+    * initialize_shm - initialize for a FIFO with only one end
+    * in this process.
+    * @param   port - PortInfo&, the end in this process
+    * @param   dir  - Direction, which end port is
+    * @param   fifo - FIFO*
+    */
+   void initialize_shm( PortInfo &port,
+                        const Direction dir,
+                        FIFO * const fifo );
+
+   /**
+    * setResizeSignal - hands a resizeable FIFO the signal its
+    * producer posts to when blocked, for sub-classes with a
+    * resize policy.
+    * @param   fifo   - FIFO*
+    * @param   signal - ResizeSignal
+    */
+   static void setResizeSignal( FIFO * const fifo,
+                                const ResizeSignal &signal );
+
    /**
     * setReady - call within the implemented run function to signal
     * that the initial allocations have been completed.
@@ -129,6 +174,12 @@ protected:
     * is exited.
     */
    volatile bool &exit_alloc;
+
+   /** wait strategy for ports that don't set their own **/
+   const raft::wait::strategy default_wait;
+
+   /** cap on the bytes held by resizeable FIFOs, 0 for none **/
+   const std::size_t          map_max_bytes;
 private:
    volatile bool ready = false;
    friend class basic_parallel;
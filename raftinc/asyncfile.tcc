@@ -0,0 +1,274 @@
+/**
+ * asyncfile.tcc - file source and sink kernels that keep several
+ * reads or writes in flight (see asyncio.hpp) rather than sitting
+ * in one fread or fwrite at a time.
+ *
+ * async_reader lays chunks out just as filereader does.  Each run()
+ * allocates up to depth chunks on its output FIFO, reads straight
+ * into them, all at once, and sends the lot when every read is
+ * back, so nothing is copied on the way out.
+ *
+ * async_writer appends each chunk's buffer to the output file in
+ * the order they arrive.  Chunks are copied into one of depth
+ * buffers of its own so the FIFO slot can go back right away and
+ * the write carries on while the next chunk is taken.  Whenever
+ * nothing is waiting on its input it waits for the writes it has
+ * out, so by the time the map is done the file is complete.
+ *
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 04:14:52 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _ASYNCFILE_TCC_
+#define _ASYNCFILE_TCC_  1
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <raft>
+#include "asyncio.hpp"
+#include "fileio.tcc"
+
+namespace raft
+{
+
+template < class chunktype = filechunk< 65536 > >
+class async_reader : public raft::kernel
+{
+public:
+   /**
+    * async_reader - opens inputfile, exits if it can't.
+    * @param   inputfile    - file to read
+    * @param   chunk_offset - as for filereader
+    * @param   depth        - max reads in flight
+    * @param   b            - raft::aio::backend
+    */
+   async_reader( const std::string        inputfile,
+                 const long               chunk_offset = 0,
+                 const std::size_t        depth        = 8,
+                 const raft::aio::backend b            = raft::aio::use_default ) :
+      raft::kernel(),
+      stride( ( chunktype::getChunkSize() - 1 ) -
+              ( chunk_offset > 0 ? chunk_offset - 1 : 0 ) ),
+      io( raft::async_io::make( depth, b ) )
+   {
+      if( chunk_offset < 0 ||
+          static_cast< std::size_t >( chunk_offset ) >= chunktype::getChunkSize() )
+      {
+         std::cerr << "async_reader: chunk_offset (" << chunk_offset <<
+            ") has to be less than the chunk size (" <<
+               chunktype::getChunkSize() << "), exiting\n";
+         exit( EXIT_FAILURE );
+      }
+      output.addPort< chunktype >( "0" );
+      fd = open( inputfile.c_str(), O_RDONLY );
+      if( fd < 0 )
+      {
+         perror( "Failed to open input file, exiting!" );
+         exit( EXIT_FAILURE );
+      }
+      struct stat st;
+      if( fstat( fd, &st ) != 0 )
+      {
+         perror( "Failed to stat input file, exiting!" );
+         exit( EXIT_FAILURE );
+      }
+      length = static_cast< std::size_t >( st.st_size );
+      const auto read_size( chunktype::getChunkSize() - 1 );
+      chunks = ( length == 0 ? 0 :
+         1 + ( length > read_size ?
+               ( length - read_size + stride - 1 ) / stride : 0 ) );
+#ifdef POSIX_FADV_SEQUENTIAL
+      posix_fadvise( fd, 0, 0, POSIX_FADV_SEQUENTIAL );
+#endif
+   }
+
+   virtual ~async_reader()
+   {
+      /** nothing can be in flight once run() returns, but be sure **/
+      io.reset();
+      close( fd );
+   }
+
+   /** backend - what the reads actually went through **/
+   raft::aio::backend backend() const noexcept
+   {
+      return( io->get() );
+   }
+
+   virtual raft::kstatus run()
+   {
+      if( next >= chunks )
+      {
+         return( raft::stop );
+      }
+      auto &port( output[ "0" ] );
+      /** allocate_range waits for n free slots, so never ask for more than there are **/
+      const std::size_t n( std::min( { io->depth(),
+                                       static_cast< std::size_t >( chunks - next ),
+                                       std::max( port.capacity(),
+                                                 static_cast< std::size_t >( 1 ) ) } ) );
+      auto range( port.template allocate_range< chunktype >( n ) );
+      for( std::size_t i( 0 ); i < n; i++ )
+      {
+         chunktype &chunk( range[ i ] );
+         const std::size_t position( ( next + i ) * stride );
+         chunk.start_position = position;
+         chunk.index          = next + i;
+         io->read( fd,
+                   chunk.buffer,
+                   std::min( chunktype::getChunkSize() - 1, length - position ),
+                   static_cast< off_t >( position ),
+                   i );
+      }
+      done.clear();
+      io->wait( done, n );
+      for( const auto &c : done )
+      {
+         if( c.result < 0 )
+         {
+            errno = static_cast< int >( -c.result );
+            perror( "Failed to read input file, exiting!" );
+            exit( EXIT_FAILURE );
+         }
+         chunktype &chunk( range[ c.tag ] );
+         chunk.length = static_cast< std::size_t >( c.result );
+         chunk.buffer[ chunk.length ] = '\0';
+      }
+      next += n;
+      port.send_range( next == chunks ? raft::eof : raft::none );
+      return( next == chunks ? raft::stop : raft::proceed );
+   }
+
+private:
+   int                                 fd       = -1;
+   std::size_t                         length   = 0;
+   /** distance between the starts of two chunks **/
+   const std::size_t                   stride;
+   std::uint64_t                       chunks   = 0;
+   std::uint64_t                       next     = 0;
+   std::unique_ptr< raft::async_io >   io;
+   std::vector< raft::async_io::completion > done;
+};
+
+template < class chunktype = filechunk< 65536 > >
+class async_writer : public raft::kernel
+{
+public:
+   /**
+    * async_writer - creates or truncates outputfile, exits if it
+    * can't.
+    * @param   outputfile - file to write
+    * @param   depth      - max writes in flight
+    * @param   b          - raft::aio::backend
+    */
+   async_writer( const std::string        outputfile,
+                 const std::size_t        depth = 8,
+                 const raft::aio::backend b     = raft::aio::use_default ) :
+      raft::kernel(),
+      io( raft::async_io::make( depth, b ) )
+   {
+      input.addPort< chunktype >( "0" );
+      fd = open( outputfile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+      if( fd < 0 )
+      {
+         perror( "Failed to open output file, exiting!" );
+         exit( EXIT_FAILURE );
+      }
+      for( std::size_t i( 0 ); i < io->depth(); i++ )
+      {
+         buffers.emplace_back( chunktype::getChunkSize() );
+         free_buffers.push_back( i );
+      }
+      lengths.resize( io->depth() );
+   }
+
+   virtual ~async_writer()
+   {
+      io.reset();
+      close( fd );
+   }
+
+   raft::aio::backend backend() const noexcept
+   {
+      return( io->get() );
+   }
+
+   virtual raft::kstatus run()
+   {
+      auto &port( input[ "0" ] );
+      if( free_buffers.empty() )
+      {
+         (this)->reap( 1 );
+      }
+      const auto b( free_buffers.back() );
+      free_buffers.pop_back();
+      auto &chunk( port.template peek< chunktype >() );
+      const std::size_t n( chunk.length );
+      std::memcpy( buffers[ b ].data(), chunk.buffer, n );
+      port.recycle();
+      lengths[ b ] = n;
+      io->write( fd, buffers[ b ].data(), n, offset, b );
+      io->submit();
+      offset += n;
+      if( port.size() == 0 )
+      {
+         /** nothing else to do, and this may be the last call **/
+         (this)->reap( io->in_flight() );
+      }
+      return( raft::proceed );
+   }
+
+private:
+   void reap( const std::size_t min )
+   {
+      done.clear();
+      io->wait( done, min );
+      for( const auto &c : done )
+      {
+         if( c.result < 0 ||
+             static_cast< std::size_t >( c.result ) < lengths[ c.tag ] )
+         {
+            errno = ( c.result < 0 ? static_cast< int >( -c.result ) : EIO );
+            perror( "Failed to write output file, exiting!" );
+            exit( EXIT_FAILURE );
+         }
+         free_buffers.push_back( static_cast< std::size_t >( c.tag ) );
+      }
+   }
+
+   int                                        fd       = -1;
+   off_t                                      offset   = 0;
+   std::unique_ptr< raft::async_io >          io;
+   std::vector< std::vector< char > >         buffers;
+   std::vector< std::size_t >                 free_buffers;
+   /** bytes asked of the write out of each buffer **/
+   std::vector< std::size_t >                 lengths;
+   std::vector< raft::async_io::completion >  done;
+};
+
+} /* end namespace raft */
+#endif /* END _ASYNCFILE_TCC_ */
@@ -0,0 +1,181 @@
+/**
+ * asyncio.hpp - keeps several reads and writes in flight for one
+ * kernel, so a kernel doing file I/O waits on a batch at a time
+ * rather than on each call.  On Linux requests go to an io_uring
+ * set up with the raw system calls (no liburing needed), if the
+ * kernel or its seccomp policy won't give us a ring, or on other
+ * platforms, a small pool of threads calls pread/pwrite instead.
+ * Either way requests are finished in full before they're handed
+ * back, short reads and writes are continued where they left off
+ * and a read only comes back short at end of file.
+ *
+ * Only the thread that owns the async_io may call into it.
+ *
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 04:14:52 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _ASYNCIO_HPP_
+#define _ASYNCIO_HPP_  1
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <sys/types.h>
+
+namespace raft
+{
+namespace aio
+{
+/**
+ * backend - what carries the requests, use_default takes an
+ * io_uring if one can be had and the thread pool otherwise.
+ */
+enum backend : std::uint8_t { use_default = 0,
+                              uring,
+                              pool };
+} /** end namespace aio **/
+
+class async_io
+{
+public:
+   struct completion
+   {
+      /** as given to read() or write() **/
+      std::uint64_t tag;
+      /** bytes moved, or -errno if the request failed **/
+      std::int64_t  result;
+   };
+
+   /**
+    * make - an async_io with room for depth requests in flight,
+    * asking for aio::uring falls back to the pool if no ring can
+    * be had, check get() for what was used.
+    * @param   depth - max requests in flight, at least one
+    * @param   b     - raft::aio::backend
+    * @return  std::unique_ptr< async_io >
+    */
+   static std::unique_ptr< async_io > make( const std::size_t depth,
+                                            const aio::backend b = aio::use_default );
+
+   /** waits for anything still in flight **/
+   virtual ~async_io();
+
+   virtual aio::backend get() const noexcept = 0;
+
+   /**
+    * read - queue a read of length bytes at offset into buffer,
+    * nothing starts till submit().  The buffer has to stay put
+    * till the request comes back from wait().
+    * @return  bool - false if depth requests are already out
+    */
+   bool read( const int           fd,
+              void * const        buffer,
+              const std::size_t   length,
+              const off_t         offset,
+              const std::uint64_t tag );
+
+   /** write - as read, from buffer to the file **/
+   bool write( const int           fd,
+               const void * const  buffer,
+               const std::size_t   length,
+               const off_t         offset,
+               const std::uint64_t tag );
+
+   /** submit - start everything queued since the last submit **/
+   void submit();
+
+   /**
+    * wait - blocks till at least min requests have finished,
+    * appends every finished one to out, submits anything still
+    * queued first.  min is capped at in_flight().
+    * @param   out - finished requests go here
+    * @param   min - number to wait for
+    * @return  std::size_t - number appended
+    */
+   std::size_t wait( std::vector< completion > &out,
+                     const std::size_t min );
+
+   /** in_flight - queued or submitted and not yet back from wait() **/
+   std::size_t in_flight() const noexcept
+   {
+      return( slots - free_slots.size() );
+   }
+
+   std::size_t depth() const noexcept
+   {
+      return( slots );
+   }
+
+protected:
+   enum op_t : std::uint8_t { op_read, op_write };
+
+   struct request
+   {
+      op_t           op       = op_read;
+      int            fd       = -1;
+      char          *buffer   = nullptr;
+      std::size_t    length   = 0;
+      off_t          offset   = 0;
+      /** bytes already moved, short transfers restart from here **/
+      std::size_t    done     = 0;
+      std::uint64_t  tag      = 0;
+   };
+
+   explicit async_io( const std::size_t depth );
+
+   /** start - hand request slot to the backend, may be batched **/
+   virtual void start( const std::size_t slot ) = 0;
+   /** flush - make sure everything start()ed is on its way **/
+   virtual void flush() = 0;
+   /**
+    * reap - call finish() for each answer the backend has, if
+    * block then wait for at least one first.
+    */
+   virtual void reap( const bool block ) = 0;
+
+   /**
+    * finish - called by reap() with the outcome of one transfer
+    * for slot, negative is -errno.  Continues short transfers,
+    * otherwise the request is done and goes to the done list.
+    */
+   void finish( const std::size_t slot, const std::int64_t result );
+
+   /** drain - wait for everything, for the backends' destructors **/
+   void drain();
+
+   std::vector< request >      requests;
+   const std::size_t           slots;
+
+private:
+   bool queue( const op_t          op,
+               const int           fd,
+               char * const        buffer,
+               const std::size_t   length,
+               const off_t         offset,
+               const std::uint64_t tag );
+
+   std::vector< std::size_t >  free_slots;
+   /** queued, not yet passed to start() **/
+   std::vector< std::size_t >  queued;
+   /** back from the backend, not yet handed out by wait() **/
+   std::vector< completion >   done;
+   /** slots of done, freed once wait() hands them out **/
+   std::vector< std::size_t >  done_slots;
+};
+
+} /** end namespace raft **/
+#endif /* END _ASYNCIO_HPP_ */
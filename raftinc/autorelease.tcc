@@ -111,15 +111,16 @@ template < class T > class autorelease< T, peekrange > : public autoreleasebase
 public:
    autorelease( FIFO             &fifo, 
                    T * const      queue,
-                Buffer::Signal   * const sig,
+                Buffer::SignalMap * const sig,
                 const std::size_t curr_read_ptr,
-                const std::size_t n_items ) : autoreleasebase(),
-                                              fifo( fifo ),
-                                              queue( queue ),
-                                              signal( sig ),
-                                              crp  ( curr_read_ptr ),
-                                              n_items( n_items ),
-                                              queue_size( fifo.capacity() )
+                const std::size_t n_items,
+                const std::size_t queue_size ) : autoreleasebase(),
+                                                 fifo( fifo ),
+                                                 queue( queue ),
+                                                 signal( sig ),
+                                                 crp  ( curr_read_ptr ),
+                                                 n_items( n_items ),
+                                                 queue_size( queue_size )
    {
       
    }
@@ -156,7 +157,7 @@ public:
       else
       {
          std::size_t ptr_val( (index + crp) % queue_size );
-         return( std::move( autopair< T >( queue[ ptr_val ], signal[ ptr_val ] ) ) );
+         return( std::move( autopair< T >( queue[ ptr_val ], signal->get( ptr_val ) ) ) );
       }
    }
 
@@ -167,7 +168,7 @@ public:
     */
    std::size_t getindex() noexcept
    {
-      return( signal[ 0 ] .getindex() );
+      return( signal->start_index );
    }
 
    std::size_t size() noexcept
@@ -179,7 +180,7 @@ public:
 private:
    FIFO             &fifo;
    T  *  const            queue;
-   Buffer::Signal * const signal;
+   Buffer::SignalMap * const signal;
    /** current read pointer **/
    const std::size_t crp;
    const std::size_t n_items;
@@ -19,6 +19,7 @@
  */
 #ifndef _AUTORELEASEBASE_HPP_
 #define _AUTORELEASEBASE_HPP_  1
+#include "signalvars.hpp"
 
 /**
  * this is used by the autorelease objects so that index operator []
@@ -26,12 +27,13 @@
  */
 template < class T > struct autopair
 {
-   autopair( T &ele, Buffer::Signal &sig ) : ele( ele ),
-                                             sig( sig )
+   autopair( T &ele, const raft::signal sig ) : ele( ele ),
+                                                sig( sig )
    {}
 
-   T              &ele;
-   Buffer::Signal &sig;
+   T                  &ele;
+   /** copy, signals aren't stored next to their item anymore **/
+   const raft::signal  sig;
 };
 
 class autoreleasebase 
@@ -1,10 +1,26 @@
 /**
- * basicparallel.hpp - 
+ * basicparallel.hpp - grows and shrinks the number of copies of
+ * each duplicable kernel while the map runs.  A kernel is
+ * duplicable when every one of its ports is linked out of order
+ * (raft::order::out), map::exe() then puts a split on each of its
+ * inputs and a join on each of its outputs, see
+ * map::setMaxReplicas.
+ *
+ * Every sample the occupancy of each copy's input and output
+ * FIFOs is read, the means over a window are the estimate of how
+ * busy the group is.  A group whose inputs stay full while its
+ * outputs have room gets another copy, made with kernel::clone()
+ * and hooked up with a new port on each split and join.  A group
+ * whose inputs stay close to empty loses its newest copy, its
+ * split ports are closed so it drains what it has and exits.  The
+ * decision has to hold for a few windows in a row and a group
+ * that just changed is left alone for a while.
+ *
  * @author: Jonathan Beard
- * @version: Mon Aug 10 20:00:25 2015
- * 
- * Copyright 2015 Jonathan Beard
- * 
+ * @version: Mon Oct 19 01:38:27 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at:
@@ -20,38 +36,27 @@
 #ifndef _BASICPARALLEL_HPP_
 #define _BASICPARALLEL_HPP_  1
 
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
 
 #include "kernel.hpp"
 #include "port_info.hpp"
 #include "fifo.hpp"
 #include "allocate.hpp"
 #include "schedule.hpp"
-#include <set>
-#include <iostream>
+#include "streamingstat.tcc"
 
 namespace raft
 {
     class map;
 }
 
-/** right now we're only considering single input, single output kernels **/
-struct stats
-{
-   std::uint16_t occ_in  = 0;
-   float        service_rate = static_cast< float >( 0 );
-   friend   std::ostream& operator << ( std::ostream &stream, stats &s )
-   {
-      stream << "occupancy count: " << s.occ_in << "\n";
-      stream << "service rate: " << s.service_rate << "\n";
-      return( stream );
-   }
-};
-
-
 class basic_parallel
 {
 public:
-   basic_parallel( raft::map &map, 
+   basic_parallel( raft::map &map,
                    Allocate &alloc,
                    Schedule &sched,
                    volatile bool &exit_para );
@@ -59,14 +64,90 @@ public:
    virtual ~basic_parallel() = default;
    virtual void start();
 
-   
+   /** mean input occupancy above which a group needs another copy **/
+   static constexpr float       high_water    = .5;
+   /** mean input occupancy below which a group has one too many **/
+   static constexpr float       low_water     = .05;
+   /** length of a window in ms, sampled about every ms **/
+   static constexpr std::size_t window_ms     = 100;
+   /** windows in a row before adding a copy **/
+   static constexpr std::size_t up_confirm    = 2;
+   /** windows in a row before retiring one **/
+   static constexpr std::size_t down_confirm  = 5;
+   /** windows a group is left alone after a change **/
+   static constexpr std::size_t cooldown      = 3;
+
 protected:
+   /** endpoint - the port name on a split or join **/
+   struct endpoint
+   {
+      raft::kernel *k;
+      std::string   name;
+   };
+
+   /** replica - one copy of the kernel and where it's hooked up **/
+   struct replica
+   {
+      raft::kernel            *k;
+      /** split port feeding each input, in the kernel's port order **/
+      std::vector< endpoint >  feeds;
+      std::vector< FIFO* >     in;
+      std::vector< FIFO* >     out;
+   };
+
+   /** group - a duplicable kernel and its copies, original first **/
+   struct group
+   {
+      std::vector< replica >         replicas;
+      /** the split on each input, the join on each output **/
+      std::vector< raft::kernel* >   splits;
+      std::vector< raft::kernel* >   joins;
+      raft::streamingstat< float >   in_occ;
+      raft::streamingstat< float >   out_occ;
+      std::size_t                    up_strikes   = 0;
+      std::size_t                    down_strikes = 0;
+      std::size_t                    frozen       = 0;
+      bool                           clonable     = true;
+   };
+
+   /**
+    * add_group - sets up the group for a kernel the map marked
+    * dup_enabled, false if it isn't hooked to splits and joins.
+    */
+   bool add_group( raft::kernel * const k );
+
+   /** sample - one reading of the group's FIFOs **/
+   static void sample( group &g );
+
+   /**
+    * decide - at the end of a window, adds or retires a copy
+    * if the window's means call for it.
+    */
+   virtual void decide( group &g );
+
+   /**
+    * replicate - clones the original, hooks the clone to a new
+    * port on each split and join and schedules it.
+    * @return  bool - false if it couldn't be done
+    */
+   virtual bool replicate( group &g );
+
+   /**
+    * retire - closes the newest copy's split ports, the copy
+    * finishes what is queued for it then exits.
+    * @return  bool - false if only the original is left
+    */
+   virtual bool retire( group &g );
+
    /** both convenience structs, hold exactly what the names say **/
-   kernelkeeper   &source_kernels;
-   kernelkeeper   &all_kernels;
-   Allocate       &alloc;
-   Schedule       &sched;
-   volatile bool  &exit_para;
+   kernelkeeper        &source_kernels;
+   kernelkeeper        &all_kernels;
+   Allocate            &alloc;
+   Schedule            &sched;
+   volatile bool       &exit_para;
+   /** copies of a kernel allowed, counting the original **/
+   const std::size_t    max_replicas;
+   std::vector< group > groups;
 };
 
 #endif /* END _BASICPARALLEL_HPP_ */
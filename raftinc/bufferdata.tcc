@@ -35,13 +35,10 @@
 #include "ringbuffertypes.hpp"
 #include "signal.hpp"
 #include "database.tcc"
+#include "pagealloc.hpp"
 
 #include "alloc_traits.tcc"
 
-#if BUILDSHM
-#include "shm.hpp"
-#endif
-
 namespace Buffer
 {
 
@@ -62,15 +59,15 @@ template < class T > struct Data< T,
    {
       assert( ptr != nullptr );
       (this)->store  = ptr;
-      (this)->signal = (Signal*)       calloc( 1,
-                                               sizeof( Signal ) );
-      if( (this)->signal == nullptr )
+      auto * const sig_mem( calloc( 1, (this)->length_signal ) );
+      if( sig_mem == nullptr )
       {
          perror( "Failed to allocate signal queue!" );
          exit( EXIT_FAILURE );
       }
+      (this)->signal = SignalMap::make( sig_mem, max_cap );
       /** set index to be start_position **/
-      (this)->signal[ 0 ].index  = start_position; 
+      (this)->signal->start_index = start_position; 
       /** allocate read and write pointers **/
       (this)->read_pt   = new Pointer( max_cap );
       (this)->write_pt  = new Pointer( max_cap, 1 ); 
@@ -79,45 +76,66 @@ template < class T > struct Data< T,
    }
 
 
+   /**
+    * Data - allocates room for max_cap items.  The store and the
+    * signals come from the heap unless mem asks for huge pages or
+    * NUMA placement, then both come from page_alloc.
+    * @param   max_cap - std::size_t, items
+    * @param   align   - std::size_t, heap alignment, mapped pages
+    *                    are always page aligned
+    * @param   mem     - const raft::mem::options&
+    */
    Data( const std::size_t max_cap , 
-         const std::size_t align = 16 ) : DataBase< T >( max_cap )
+         const std::size_t align = 16,
+         const raft::mem::options &mem = raft::mem::options() ) : 
+      DataBase< T >( max_cap ),
+      mem( mem )
    {
-
-#if (defined __linux ) || (defined __APPLE__ )
-      int ret_val( 0 );
-      ret_val = posix_memalign( (void**)&((this)->store), 
-                                 align, 
-                                (this)->length_store );
-      if( ret_val != 0 )
+      if( mem.custom() )
       {
-         std::cerr << "posix_memalign returned error code (" << ret_val << ")";
-         std::cerr << " with message: \n" << strerror( ret_val ) << "\n";
-         exit( EXIT_FAILURE );
+         (this)->store  = reinterpret_cast< T* >(
+            page_alloc::allocate( (this)->length_store, mem ) );
+         (this)->signal = SignalMap::make(
+            page_alloc::allocate( (this)->length_signal, mem ), max_cap );
       }
+      else
+      {
+#if (defined __linux ) || (defined __APPLE__ )
+         int ret_val( 0 );
+         ret_val = posix_memalign( (void**)&((this)->store), 
+                                    align, 
+                                   (this)->length_store );
+         if( ret_val != 0 )
+         {
+            std::cerr << "posix_memalign returned error code (" << ret_val << ")";
+            std::cerr << " with message: \n" << strerror( ret_val ) << "\n";
+            exit( EXIT_FAILURE );
+         }
 #elif (defined _WIN64 ) || (defined _WIN32) 
 //FIXME, we need to test this on Win sys before making live    
-      (this)->store = reinterpret_cast< T* >(  _aligned_malloc( align, 
-                                                                (this)->length_store ) );
+         (this)->store = reinterpret_cast< T* >(  _aligned_malloc( align, 
+                                                                   (this)->length_store ) );
 #else
-      /** 
-       * would use the array allocate, but well...we'd have to 
-       * figure out how to free it
-       */
-      (this)->store = reinterpret_cast< T* >( malloc( (this)->length_store ) );
+         /** 
+          * would use the array allocate, but well...we'd have to 
+          * figure out how to free it
+          */
+         (this)->store = reinterpret_cast< T* >( malloc( (this)->length_store ) );
 #endif
-      assert( (this)->store != nullptr );
-      
+         assert( (this)->store != nullptr );
+
 #if (defined __linux ) || (defined __APPLE__ )
-      posix_madvise( (this)->store, 
-                     (this)->length_store,  
-                     POSIX_MADV_SEQUENTIAL );
+         posix_madvise( (this)->store, 
+                        (this)->length_store,  
+                        POSIX_MADV_SEQUENTIAL );
 #endif
-      (this)->signal = (Signal*)       calloc( (this)->max_cap,
-                                               sizeof( Signal ) );
-      if( (this)->signal == nullptr )
-      {
-         perror( "Failed to allocate signal queue!" );
-         exit( EXIT_FAILURE );
+         auto * const sig_mem( calloc( 1, (this)->length_signal ) );
+         if( sig_mem == nullptr )
+         {
+            perror( "Failed to allocate signal queue!" );
+            exit( EXIT_FAILURE );
+         }
+         (this)->signal = SignalMap::make( sig_mem, max_cap );
       }
       /** allocate read and write pointers **/
       /** TODO, see if there are optimizations to be made with sizing and alignment **/
@@ -169,6 +187,12 @@ template < class T > struct Data< T,
       delete( (this)->write_pt );
       
       //FREE USED HERE
+      if( mem.custom() )
+      {
+         page_alloc::release( (this)->store, (this)->length_store, mem );
+         page_alloc::release( (this)->signal, (this)->length_signal, mem );
+         return;
+      }
       if( ! (this)->external_alloc )
       {
          free( (this)->store );
@@ -176,6 +200,9 @@ template < class T > struct Data< T,
       free( (this)->signal );
    }
 
+   /** how the store was allocated, default for the heap **/
+   raft::mem::options mem;
+
 }; /** end heap < Line Size **/
 
 /** buffer structure for "heap" storage class > line size **/
@@ -194,15 +221,15 @@ template < class T >
    {
       assert( ptr != nullptr );
       (this)->store  = reinterpret_cast< type_t* >( ptr );
-      (this)->signal = (Signal*)       calloc( 1,
-                                               sizeof( Signal ) );
-      if( (this)->signal == nullptr )
+      auto * const sig_mem( calloc( 1, (this)->length_signal ) );
+      if( sig_mem == nullptr )
       {
          perror( "Failed to allocate signal queue!" );
          exit( EXIT_FAILURE );
       }
+      (this)->signal = SignalMap::make( sig_mem, max_cap );
       /** set index to be start_position **/
-      (this)->signal[ 0 ].index  = start_position; 
+      (this)->signal->start_index = start_position; 
       /** allocate read and write pointers **/
       (this)->read_pt   = new Pointer( max_cap );
       (this)->write_pt  = new Pointer( max_cap, 1 ); 
@@ -211,45 +238,66 @@ template < class T >
    }
 
 
+   /**
+    * Data - allocates room for max_cap items.  The store and the
+    * signals come from the heap unless mem asks for huge pages or
+    * NUMA placement, then both come from page_alloc.
+    * @param   max_cap - std::size_t, items
+    * @param   align   - std::size_t, heap alignment, mapped pages
+    *                    are always page aligned
+    * @param   mem     - const raft::mem::options&
+    */
    Data( const std::size_t max_cap , 
-         const std::size_t align = 16 ) : ourtype_t( max_cap )
+         const std::size_t align = 16,
+         const raft::mem::options &mem = raft::mem::options() ) : 
+      ourtype_t( max_cap ),
+      mem( mem )
    {
-
-#if (defined __linux ) || (defined __APPLE__ )
-      const auto ret_val = posix_memalign( (void**)&((this)->store), 
-                                           align, 
-                                           (this)->length_store );
-      if( ret_val != 0 )
+      if( mem.custom() )
       {
-         std::cerr << "posix_memalign returned error code (" << ret_val << ")";
-         std::cerr << " with message: \n" << strerror( ret_val ) << "\n";
-         exit( EXIT_FAILURE );
+         (this)->store  = reinterpret_cast< type_t* >(
+            page_alloc::allocate( (this)->length_store, mem ) );
+         (this)->signal = SignalMap::make(
+            page_alloc::allocate( (this)->length_signal, mem ), max_cap );
       }
+      else
+      {
+#if (defined __linux ) || (defined __APPLE__ )
+         const auto ret_val = posix_memalign( (void**)&((this)->store), 
+                                              align, 
+                                              (this)->length_store );
+         if( ret_val != 0 )
+         {
+            std::cerr << "posix_memalign returned error code (" << ret_val << ")";
+            std::cerr << " with message: \n" << strerror( ret_val ) << "\n";
+            exit( EXIT_FAILURE );
+         }
 #elif (defined _WIN64 ) || (defined _WIN32) 
 //FIXME, we need to test this on Win sys before making live    
-      (this)->store = reinterpret_cast< type_t* >(  _aligned_malloc( align, 
-                                                                    (this)->length_store ) );
+         (this)->store = reinterpret_cast< type_t* >(  _aligned_malloc( align, 
+                                                                       (this)->length_store ) );
 #else
-      /** 
-       * would use the array allocate, but well...we'd have to 
-       * figure out how to free it
-       */
-      (this)->store = reinterpret_cast< type_t* >( malloc( (this)->length_store ) );
+         /** 
+          * would use the array allocate, but well...we'd have to 
+          * figure out how to free it
+          */
+         (this)->store = reinterpret_cast< type_t* >( malloc( (this)->length_store ) );
 #endif
-      assert( (this)->store != nullptr );
-      
+         assert( (this)->store != nullptr );
+
 #if (defined __linux ) || (defined __APPLE__ )
-      posix_madvise( (this)->store, 
-                     (this)->length_store,  
-                     POSIX_MADV_SEQUENTIAL );
+         posix_madvise( (this)->store, 
+                        (this)->length_store,  
+                        POSIX_MADV_SEQUENTIAL );
 #endif
-      errno = 0;
-      (this)->signal = (Signal*)       calloc( (this)->max_cap,
-                                               sizeof( Signal ) );
-      if( (this)->signal == nullptr )
-      {
-         perror( "Failed to allocate signal queue!" );
-         exit( EXIT_FAILURE );
+         errno = 0;
+         auto * const sig_mem( calloc( 1, (this)->length_signal ) );
+         if( sig_mem == nullptr )
+         {
+            perror( "Failed to allocate signal queue!" );
+            exit( EXIT_FAILURE );
+         }
+         (this)->signal = SignalMap::make( sig_mem, max_cap );
       }
       /** allocate read and write pointers **/
       /** TODO, see if there are optimizations to be made with sizing and alignment **/
@@ -293,6 +341,12 @@ template < class T >
       delete( (this)->write_pt );
       
       //FREE USED HERE
+      if( mem.custom() )
+      {
+         page_alloc::release( (this)->store, (this)->length_store, mem );
+         page_alloc::release( (this)->signal, (this)->length_signal, mem );
+         return;
+      }
       if( ! (this)->external_alloc )
       {
          free( (this)->store );
@@ -300,179 +354,10 @@ template < class T >
       free( (this)->signal );
    }
 
-}; /** end heap > Line Size **/
-
-#if BUILDSHM
-template < class T > struct Data< T, Type::SharedMemory > : 
-   public DataBase< T > 
-{
-   /**
-    * Data - Constructor for SHM based ringbuffer.  Allocates store, signal and 
-    * ptr structures in separate SHM segments.  Could have been a single one but
-    * makes reading the ptr arithmatic a bit more difficult.  TODO, reevaluate
-    * if performance wise that might be a good idea, also decide how best to 
-    * align data elements.
-    * @param   max_cap, size_t with number of items to allocate queue for
-    * @param   shm_key, const std::string key for opening the SHM, 
-                        must be same for both ends of the queue
-    * @param   dir,     Direction enum for letting this queue know 
-                        which side we're allocating
-    * @param   alignment, size_t with alignment NOTE: haven't implemented yet
-    */
-   Data( size_t max_cap, 
-         const std::string shm_key,
-         Direction dir,
-         const size_t alignment ) : DataBase< T >( max_cap ),
-                                    store_key( shm_key + "_store" ),
-                                    signal_key( shm_key + "_key" ),
-                                    ptr_key( shm_key + "_ptr" )
-   {
-      /** now work through opening SHM **/
-      switch( dir )
-      {
-         case( Direction::Producer ):
-         {
-            auto alloc_with_error = 
-            [&]( void **ptr, const size_t length, const char *key )
-            {
-               try
-               {
-                  *ptr = SHM::Init( key, length );
-               }catch( bad_shm_alloc &ex )
-               {
-                  std::cerr << 
-                  "Bad SHM allocate for key (" << 
-                     key << ") with length (" << length << ")\n";
-                  std::cerr << "Message: " << ex.what() << ", exiting.\n";
-                  exit( EXIT_FAILURE );
-               }
-               assert( *ptr != nullptr );
-            };
-            alloc_with_error( (void**)&(this)->store, 
-                              (this)->length_store, 
-                              store_key.c_str() );
-            alloc_with_error( (void**)&(this)->signal, 
-                              (this)->length_signal, 
-                              signal_key.c_str() );
-            alloc_with_error( (void**)&(this)->read_pt, 
-                              (sizeof( Pointer ) * 2 ) + sizeof( Cookie ), 
-                              ptr_key.c_str() );
-
-            (this)->write_pt = &(this)->read_pt[ 1 ];
-            
-            Pointer temp( max_cap );
-            std::memcpy( (this)->read_pt,  &temp, sizeof( Pointer ) );
-            std::memcpy( (this)->write_pt, &temp, sizeof( Pointer ) );
-            
-            (this)->cookie   = (Cookie*) &(this)->read_pt[ 2 ];
-            (this)->cookie->producer = 0x1337;
-            while( (this)->cookie->consumer != 0x1337 )
-            {
-               std::this_thread::yield();
-            }
-         }
-         break;
-         case( Direction::Consumer ):
-         {
-            auto retry_func = [&]( void **ptr, const char *str )
-            {
-               std::string error_copy;
-               std::int32_t timeout( 1000 );
-               while( timeout-- )
-               {
-                  try
-                  {
-                     *ptr = SHM::Open( str );
-                  }
-                  catch( bad_shm_alloc &ex )
-                  {
-                     //do nothing
-                     timeout--;
-                     error_copy = ex.what();
-                     std::this_thread::yield();
-                     continue;
-                  }
-                  goto SUCCESS;
-               }
-               /** timeout reached **/
-               std::cerr << "Failed to open shared memory for \"" << 
-                  str << "\", exiting!!\n";
-               std::cerr << "Error message: " << error_copy << "\n";
-               exit( EXIT_FAILURE );
-               SUCCESS:;
-            };
-            retry_func( (void**) &(this)->store,  store_key.c_str() );
-            retry_func( (void**) &(this)->signal, signal_key.c_str() );
-            retry_func( (void**) &(this)->read_pt, ptr_key.c_str() );
-            
-            assert( (this)->store != nullptr );
-            assert( (this)->signal != nullptr );
-            assert( (this)->read_pt   != nullptr );
-            
-            /** fix write_pt **/
-            (this)->write_pt  = &(this)->read_pt[ 1 ];
-            assert( (this)->write_pt  != nullptr );
-            (this)->cookie    = (Cookie*)&(this)->read_pt[ 2 ]; 
-            
-            Pointer temp( max_cap );
-            std::memcpy( (this)->read_pt,  &temp, sizeof( Pointer ) );
-            std::memcpy( (this)->write_pt, &temp, sizeof( Pointer ) );
-            
-            (this)->cookie->consumer = 0x1337;
-            while( (this)->cookie->producer != 0x1337 )
-            {
-               std::this_thread::yield();
-            }
-         }
-         break;
-         default:
-         {
-            //TODO, add signal handler to cleanup
-            std::cerr << "Invalid direction, exiting\n";
-            exit( EXIT_FAILURE );
-         }
-      }
-      /** should be all set now **/
-   }
-
-   virtual void copyFrom( DataBase< T > *other )
-   {
-      assert( false );
-      /** TODO, implement me **/
-   }
-
-   ~Data()
-   {
-      /** three segments of SHM to close **/
-      SHM::Close( store_key.c_str(), 
-                  (void*) (this)->store, 
-                  (this)->length_store,
-                  false,
-                  true );
-      SHM::Close( signal_key.c_str(),
-                  (void*) (this)->signal,
-                  (this)->length_signal,
-                  false,
-                  true );
-      SHM::Close( ptr_key.c_str(),   
-                  (void*) (this)->read_pt, 
-                  (sizeof( Pointer ) * 2) + sizeof( Cookie ),
-                  false,
-                  true );
-   }
-   struct Cookie
-   {
-      std::int32_t producer;
-      std::int32_t consumer;;
-   };
+   /** how the store was allocated, default for the heap **/
+   raft::mem::options mem;
 
-   volatile Cookie         *cookie;
+}; /** end heap > Line Size **/
 
-   /** process local key copies **/
-   const std::string store_key; 
-   const std::string signal_key;  
-   const std::string ptr_key; 
-};
-#endif //END BUILDSHM
 } //end namespace Buffer
 #endif /* END _BUFFERDATA_TCC_ */
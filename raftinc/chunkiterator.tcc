@@ -30,32 +30,36 @@ namespace raft
 /** declare this guy **/
 template < std::size_t size > struct filechunk;
 
-template < std::size_t size > class chunk_iterator : public std::iterator< std::forward_iterator_tag, char >
+/**
+ * basic_chunk_iterator - iterates over the bytes of anything with
+ * a buffer member and operator[], filechunk and fileview.
+ */
+template < class chunk_t > class basic_chunk_iterator : public std::iterator< std::forward_iterator_tag, char >
 {
 public:
-   chunk_iterator( filechunk< size > * const chunk ) : chunk( chunk )
+   basic_chunk_iterator( chunk_t * const chunk ) : chunk( chunk )
    {
       /** nothing to do here **/
    }
    
-   chunk_iterator( filechunk< size > * const chunk, 
-                   const std::size_t index ) : chunk( chunk ),
-                                               index( index ),
-                                               is_end( true )
+   basic_chunk_iterator( chunk_t * const chunk, 
+                         const std::size_t index ) : chunk( chunk ),
+                                                     index( index ),
+                                                     is_end( true )
    {
       /** nothing to do here **/
    }
 
-   chunk_iterator( const chunk_iterator &it ) : chunk( it.chunk ),
-                                                index( it.index ),
-                                                is_end( it.is_end )
+   basic_chunk_iterator( const basic_chunk_iterator &it ) : chunk( it.chunk ),
+                                                            index( it.index ),
+                                                            is_end( it.is_end )
    {
       /** nothing to do here **/
    }
 
-   virtual ~chunk_iterator() = default;
+   virtual ~basic_chunk_iterator() = default;
 
-   chunk_iterator& operator++() noexcept
+   basic_chunk_iterator& operator++() noexcept
    {
       index++;
       return( (*this) );
@@ -64,7 +68,7 @@ public:
    template < typename T, 
               typename 
                std::enable_if< std::is_integral< T >::value >::type* = nullptr >
-   chunk_iterator& operator += ( const T val )
+   basic_chunk_iterator& operator += ( const T val )
    {
       index += val;
       return( *this );
@@ -74,14 +78,14 @@ public:
               typename 
                std::enable_if< std::is_integral< T >::value >::type* = nullptr >
    inline
-   chunk_iterator& operator - ( const T val )
+   basic_chunk_iterator& operator - ( const T val )
    {
       index -= val;
       assert( index >= 0 );
       return( *this );
    }
 
-   inline chunk_iterator& operator = ( const chunk_iterator &other )
+   inline basic_chunk_iterator& operator = ( const basic_chunk_iterator &other )
    {
       index = other.index;
       (this)->chunk = other.chunk;
@@ -89,22 +93,22 @@ public:
       return( *this );
    }
 
-   inline bool operator <= ( const chunk_iterator &c )
+   inline bool operator <= ( const basic_chunk_iterator &c )
    {
       return( index <= c.index );
    }
    
-   inline bool operator < ( const chunk_iterator &c )
+   inline bool operator < ( const basic_chunk_iterator &c )
    {
       return( index < c.index );
    }
    
-   inline bool operator == ( const chunk_iterator& rhs ) noexcept
+   inline bool operator == ( const basic_chunk_iterator& rhs ) noexcept
    {
       return( index == rhs.index );
    }
 
-   inline bool operator!=(const chunk_iterator& rhs) noexcept
+   inline bool operator!=(const basic_chunk_iterator& rhs) noexcept
    {
       return( ( index != rhs.index ) );
    }
@@ -126,11 +130,13 @@ public:
    }
 
 private:
-   filechunk< size > *             chunk;
+   chunk_t *                       chunk;
    /** current index iterated with respect to the buffer **/
    std::size_t                     index = 0;
    bool                            is_end    = false;
 };
 
+template < std::size_t size > using chunk_iterator = basic_chunk_iterator< filechunk< size > >;
+
 }
 #endif /* END _CHUNKITERATOR_HPP_ */
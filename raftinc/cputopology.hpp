@@ -0,0 +1,83 @@
+/**
+ * cputopology.hpp - which cores this process may run on and how they
+ * share caches and memory, read from /sys/devices/system/cpu so no
+ * outside library is needed.  For every CPU in the allowed set
+ * (sched_getaffinity) we keep the last level cache it shares, its
+ * NUMA node and its physical core, anything sysfs doesn't say is
+ * treated as not shared.
+ *
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 00:21:09 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _CPUTOPOLOGY_HPP_
+#define _CPUTOPOLOGY_HPP_  1
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "defs.hpp"
+
+class cpu_topology
+{
+public:
+   struct cpu
+   {
+      core_id_t   id   = 0;
+      /** index of the last level cache, dense from zero **/
+      std::size_t llc  = 0;
+      /** NUMA node, zero if unknown **/
+      std::size_t node = 0;
+      /** index of the physical core, SMT siblings share one **/
+      std::size_t core = 0;
+   };
+
+   /**
+    * cpu_topology - reads the topology of the allowed CPUs.
+    * @param   root    - sysfs cpu directory
+    * @param   allowed - CPUs to use, empty for the affinity
+    *                    mask of the calling thread
+    */
+   cpu_topology( const std::string &root = "/sys/devices/system/cpu",
+                 const std::vector< core_id_t > &allowed = {} );
+
+   /**
+    * cpus - allowed CPUs, grouped by node, then last level
+    * cache, with one thread of every physical core in an LLC
+    * coming before any SMT siblings.
+    */
+   const std::vector< cpu >& cpus() const noexcept
+   {
+      return( cpu_list );
+   }
+
+   std::size_t llc_count() const noexcept
+   {
+      return( n_llc );
+   }
+
+   /**
+    * allowed_cpus - CPUs the calling thread may be scheduled on,
+    * every online CPU if the mask can't be read.
+    */
+   static std::vector< core_id_t > allowed_cpus();
+
+private:
+   std::vector< cpu > cpu_list;
+   std::size_t        n_llc = 0;
+};
+
+#endif /* END _CPUTOPOLOGY_HPP_ */
@@ -42,7 +42,7 @@ template < class T > struct DataBase
 {
    DataBase( const std::size_t max_cap ) : max_cap ( max_cap ),
                                            length_store( sizeof( T ) * max_cap ),
-                                           length_signal( sizeof( T ) * max_cap ){}
+                                           length_signal( SignalMap::bytes( max_cap ) ){}
 
    /** 
     * copyFrom - implement in all sub-structs to 
@@ -104,7 +104,7 @@ template < class T > struct DataBase
    
    
    T                       *store         = nullptr;
-   Signal                  *signal        = nullptr;
+   SignalMap               *signal        = nullptr;
    bool                    external_alloc = false;
    /** variable set by scheduler, used for shutdown **/
    bool                    is_valid       = true;
@@ -1,10 +1,10 @@
 /**
- * datamanager.tcc - 
+ * datamanager.tcc -
  * @author: Jonathan Beard
  * @version: Tue Oct 14 14:15:00 2014
- * 
+ *
  * Copyright 2014 Jonathan Beard
- * 
+ *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at:
@@ -28,269 +28,521 @@
 
 #include "ringbuffertypes.hpp"
 #include "bufferdata.tcc"
+#include "defs.hpp"
+
+#ifdef USEQTHREADS
+#include <qthread/qthread.hpp>
+#endif
 
 namespace dm
 {
 using key_t = std::uint8_t;
 /**
- * access_key - each one of these is to be used as a 
- * key for  buffer access functions.  Everything <= 
+ * access_key - each one of these is to be used as a
+ * key for  buffer access functions.  Everything <=
  * push is expected to be a write type function, everything
  * else is expected to be a read type operation.
  */
-enum access_key : key_t { allocate       = 0, 
-                          allocate_range = 1, 
-                          push           = 3, 
-                          recycle        = 4, 
-                          pop            = 5, 
-                          peek           = 6, 
-                          size           = 7,
+enum access_key : key_t { allocate       = 0,
+                          allocate_range = 1,
+                          push           = 3,
+                          recycle        = 4,
+                          pop            = 5,
+                          peek           = 6,
                           N };
 }
 
-template < class T, 
+/**
+ * DataManager - holds the store(s) behind a heap FIFO.  Most of
+ * the time there is exactly one.  Resizing doesn't copy, the
+ * new store is handed to the producer which switches to it the
+ * next time it enters the buffer, leaving the old store linked
+ * in front of the new one.  The consumer drains the old store
+ * and then follows.  Neither end ever waits on the other or on
+ * the allocator.  Stores the consumer has left are freed by the
+ * allocator thread (reclaim()) once no thread outside of the two
+ * ends that might still be looking at them is, see enterEpoch().
+ */
+template < class T,
            Type::RingBufferType B,
            size_t SIZE = 0 > class DataManager
 {
 public:
+   using buffer_t = Buffer::Data< T, B >;
+
    DataManager( )         = default;
-   virtual ~DataManager() = default;
-   
+
+   /**
+    * destructor - the producer's current store belongs to the
+    * FIFO (see ~RingBuffer), the rest are freed here.
+    */
+   virtual ~DataManager()
+   {
+      auto *s( head );
+      while( s != nullptr )
+      {
+         auto * const next( s->next.load( std::memory_order_relaxed ) );
+         if( s != producer.node )
+         {
+            delete( s->data );
+         }
+         delete( s );
+         s = next;
+      }
+      auto * const p( pending.load( std::memory_order_relaxed ) );
+      if( p != nullptr )
+      {
+         delete( p->data );
+         delete( p );
+      }
+   }
+
    /**
     * set - set the buffer from the parameter
     * as the buffer to be managed by this
-    * object.
+    * object, call once from the FIFO constructor.
     * @param   buffer - Buffer::Data< T, B >
     */
-   void set( Buffer::Data< T, B > * const buffer ) noexcept 
+   void set( buffer_t * const buffer ) noexcept
    {
       assert( buffer != nullptr );
-      (this)->buffer = buffer;
+      assert( head == nullptr );
+      head = new store( buffer );
+      producer.node = head;
+      producer.data = buffer;
+      producer.shared.store( head, std::memory_order_release );
+      consumer.node = head;
+      consumer.data = buffer;
+      consumer.shared.store( head, std::memory_order_release );
+      max_cap.store( buffer->max_cap, std::memory_order_release );
       /** check to see if buffer is given is resizeable **/
-      resizeable     = (  buffer->external_alloc ? false : true ); 
+      resizeable     = (  buffer->external_alloc ? false : true );
    }
 
-   inline bool is_resizeable() noexcept 
+   /**
+    * replace - swaps the first store for buffer, which must have
+    * the same capacity, and frees the old one.  Only for the
+    * allocator before either end of the FIFO has run, e.g., to
+    * re-allocate it on the consumer's NUMA node.
+    * @param   buffer - Buffer::Data< T, B >
+    */
+   void replace( buffer_t * const buffer ) noexcept
+   {
+      assert( buffer != nullptr );
+      assert( head != nullptr );
+      assert( producer.node == head && consumer.node == head );
+      assert( pending.load( std::memory_order_relaxed ) == nullptr );
+      assert( buffer->max_cap == head->data->max_cap );
+      delete( head->data );
+      head->data    = buffer;
+      producer.data = buffer;
+      consumer.data = buffer;
+   }
+
+   /**
+    * capacity - capacity of the newest store, which is the
+    * one the producer is (or is about to be) writing to.
+    * Safe to call from any thread.
+    * @return std::size_t
+    */
+   inline std::size_t capacity() const noexcept
+   {
+      return( max_cap.load( std::memory_order_acquire ) );
+   }
+
+   inline bool is_resizeable() noexcept
    {
       return( resizeable );
    }
 
    /**
-    * resize - resize the buffer currently held by this
-    * object.  It is expected that the buffer passed in
-    * by the parameter is larger than the current buffer.
-    * a second param exit_buffer is also required and
-    * should be available from the allocator object calling
-    * this function.  When exit_buffer is set to exit, the
-    * function returns without actually resizing the buffer
-    * since the application has finished.
-    * @param buffer, - Buffer::Data< T, B>
-    * @param exit_alloc, - set to false initially, true
+    * resize - hands new_buffer to the producer, which starts
+    * writing to it at its next enterBuffer() call.  The buffer
+    * passed in may be larger or smaller than the current one,
+    * items already queued stay where they are until the consumer
+    * reads them so a shrink never has to wait for the queue to
+    * drain.  Call only from the allocator thread.  When
+    * exit_buffer is set the application has finished and the
+    * buffer is dropped.
+    * @param new_buffer - Buffer::Data< T, B >*
+    * @param exit_buffer - set to false initially, true
     * when the application is complete
+    * @return bool - true if the producer will switch stores
     */
-   void resize( Buffer::Data< T, B > *new_buffer, volatile bool &exit_buffer )
+   bool resize( buffer_t * const new_buffer, volatile bool &exit_buffer )
    {
-      /**
-       * allclear - call this function to see
-       * if all fifo functions have completed
-       * their operations.
-       */
-      auto allclear = [&]() noexcept -> bool
+      if( exit_buffer /** comes from allocator **/ ||
+          ! valid.load( std::memory_order_acquire ) )
       {
-         for( const auto &flag_array : thread_access )
-         {
-            if( flag_array.whole != 0 )
-            {
-               return( false );
-            }
-         }
-         if( checking_size.load( std::memory_order_relaxed ) != 0 )
-         {
-            return( false );
-         }
-         return( true );
-      };
+         delete( new_buffer );
+         return( false );
+      }
+      auto * const stale(
+         pending.exchange( new store( new_buffer ), std::memory_order_acq_rel ) );
+      if( stale != nullptr )
+      {
+         /** producer never picked this one up, nobody else can see it **/
+         delete( stale->data );
+         delete( stale );
+      }
+      max_cap.store( new_buffer->max_cap, std::memory_order_release );
+      reclaim();
+      return( true );
+   }
 
+   /**
+    * reclaim - frees the stores the consumer has moved past.
+    * Waits only on threads inside enterEpoch()/exitEpoch()
+    * sections, never on the producer or the consumer.  Call
+    * only from the allocator thread.
+    */
+   void reclaim() noexcept
+   {
+      auto * const upto( consumer.shared.load( std::memory_order_seq_cst ) );
+      if( head == upto )
+      {
+         return;
+      }
       /**
-       * buffercondition - call to see if the 
-       * current buffer state is amenable to
-       * expanding.
+       * everybody who enters from here on sees upto or something
+       * after it, wait for those who entered before to leave.
        */
-      auto buffercondition = [&]() noexcept -> bool
-      {
-         /** 
-          * there's only a few conditions that you can copy
-          * the ringbuffer in one contiguous section without
-          * having to re-order the elements which is far 
-          * more expensive in most cases than simply waiting.
-          * The only real case is when rpt < wpt.  This should
-          * happen quite a bit but we do have to make sure.  For
-          * other bad things that could happen, see the conditions
-          * in the size() function from the ringbufferheap.tcc 
-          * file.
-          */
-         auto * const buff_ptr( get() );
-         const auto rpt( Pointer::val( buff_ptr->read_pt  ) );
-         const auto wpt( Pointer::val( buff_ptr->write_pt ) );
-         return( rpt < wpt );
-      };
-      
-      auto *old_buffer( get() );
-      for(;;)
+      const auto e( epoch.fetch_add( 1, std::memory_order_seq_cst ) );
+      while( readers[ e & 1 ].load( std::memory_order_acquire ) != 0 )
       {
-         /** check to see if program is done **/
-         if( exit_buffer /** comes from allocator **/ |
-             ! old_buffer->is_valid  /** comes indirectly from scheduler **/ )
-         {
-            /** get rid of newly allocated buff, don't need **/
-            delete( new_buffer );
-            resizing = false;
-            std::this_thread::yield();
-            return;
-         }
-         /** set resizing global flag **/
-         resizing = true;
-         /** see if everybody is done with the current buffer **/
-         if( allclear() )
-         {
-            /** check to see if the state of the buffer is good **/
-            if( buffercondition() )
-            {
-               break;
-            }
-
-#ifdef   PEEKTEST
-            std::cerr << "Peek Loop\n";
-#endif
-         }
-         resizing = false;
          std::this_thread::yield();
       }
-      /** nobody should have outstanding references to the old buff **/
-      new_buffer->copyFrom( old_buffer );
-      set( new_buffer );
-      delete( old_buffer );
-      resizing = false;
+      while( head != upto )
+      {
+         auto * const next( head->next.load( std::memory_order_acquire ) );
+         delete( head->data );
+         delete( head );
+         head = next;
+      }
    }
-   
+
    /**
-    * get - returns the current buffer object 
+    * get - returns the store the producer is writing to, only
+    * the producer end should dereference it.
     * @return - Buffer< T, B >*
     */
-   auto get() noexcept -> Buffer::Data< T, B >*
+   inline auto get() noexcept -> buffer_t*
    {
-      return( buffer );
+      return( producer.data );
    }
 
    /**
-    * enterBuffer - call from the function with the
-    * appropriate access key to signal that the buffer
-    * will soon be in use.
-    * @param - key, dm::access_key
+    * get_read - returns the store the consumer is reading
+    * from, only the consumer end should dereference it.
+    * @return - Buffer< T, B >*
     */
-   void enterBuffer( const dm::access_key key ) noexcept
+   inline auto get_read() noexcept -> buffer_t*
    {
-      /** see lambda below **/
-      set_helper( key, static_cast< dm::key_t >( 1 ) );
+      return( consumer.data );
    }
 
    /**
-    * exitBuffer - call from fifo function with the appropriate
-    * access key to signal that the buffer is no longer
-    * in use.
+    * enterBuffer - call with the appropriate access key at the
+    * start of each fifo function, it is the only point at which
+    * either end changes stores.  The producer picks up a store
+    * handed over by resize(), the consumer moves on from a store
+    * the producer has left once it is empty.  Don't call it on
+    * the producer side between allocate and send, the consumer
+    * side may call it while a peek is outstanding since a store
+    * with a peeked item in it isn't empty.
     * @param - key, dm::access_key
     */
-   void exitBuffer( const dm::access_key key ) noexcept
+   inline void enterBuffer( const dm::access_key key ) noexcept
    {
-      /** see lambda below **/
-      set_helper( key, static_cast< dm::key_t >( 0 ) );
+      if( key <= dm::push )
+      {
+         if( R_UNLIKELY(
+            pending.load( std::memory_order_relaxed ) != nullptr ) )
+         {
+            adopt();
+         }
+      }
+      else if( R_UNLIKELY(
+         consumer.node->next.load( std::memory_order_relaxed ) != nullptr ) )
+      {
+         follow();
+      }
    }
 
    /**
-    * notResizing - called by various fifo functions
-    * to check first entry flag before signalling enterBuffer()
-    * @return bool - currently not resizing 
+    * sealed - consumer side, true if the producer has moved on
+    * from the store the consumer is reading, i.e., nothing more
+    * will be added to it.
+    * @return bool
     */
-   bool notResizing() noexcept
+   inline bool sealed() noexcept
    {
-      return( ! resizing ); 
+      return( consumer.node->next.load( std::memory_order_acquire ) != nullptr );
    }
-   
 
-private:
-   Buffer::Data< T, B > *buffer              = nullptr; 
-   volatile bool         resizing            =  false;
+   /**
+    * gather - consumer side, for callers that need n items in
+    * one store when the read store is sealed with fewer than n
+    * in it.  Moves items, oldest first, from the read store and
+    * the ones after it to the back of fresh (which must be empty
+    * and hold at least n), then fresh takes the place of the
+    * stores it emptied.  move( src, index, dst, dst_index, count )
+    * must move count contiguous items.
+    * @param   fresh - buffer_t*, consumer allocated
+    * @param   n     - items wanted
+    * @param   move  - MOVE
+    */
+   template < class MOVE > void gather( buffer_t * const fresh,
+                                        const std::size_t n,
+                                        MOVE &&move )
+   {
+      assert( fresh->max_cap >= n );
+      store *s( consumer.node );
+      store *prev( nullptr );
+      std::size_t have( 0 );
+      while( have < n )
+      {
+         auto * const next( s->next.load( std::memory_order_acquire ) );
+         const auto avail( count( s->data ) );
+         if( avail > 0 )
+         {
+            const auto index( Pointer::val( s->data->read_pt ) );
+            const auto to_end( s->data->max_cap - index );
+            auto k( n - have );
+            k = ( avail < k ? avail : k );
+            k = ( to_end < k ? to_end : k );
+            move( s->data, index, fresh, have, k );
+            Pointer::incBy( s->data->read_pt, k );
+            have += k;
+            continue;
+         }
+         if( next == nullptr )
+         {
+            /** caught up with the producer **/
+            break;
+         }
+         prev = s;
+         s    = next;
+      }
+      /** only called with a sealed read store that has fewer than n **/
+      assert( prev != nullptr );
+      Pointer::incBy( fresh->write_pt, have );
+      auto * const node( new store( fresh ) );
+      node->next.store( s, std::memory_order_relaxed );
+      /** the emptied stores stay in front so reclaim() finds them **/
+      prev->next.store( node, std::memory_order_release );
+      consumer.node = node;
+      consumer.data = fresh;
+      consumer.shared.store( node, std::memory_order_release );
+   }
 
-   bool                  resizeable          = true;
-   
-   struct ThreadAccess
+   /**
+    * size - items queued over all of the stores, safe to call
+    * from any thread.
+    * @return std::size_t
+    */
+   std::size_t size() noexcept
    {
-      union
+      const auto e( enterEpoch() );
+      std::size_t n( 0 );
+      for( auto *s( consumer.shared.load( std::memory_order_acquire ) );
+           s != nullptr;
+           s = s->next.load( std::memory_order_acquire ) )
       {
-         std::uint64_t whole = 0; /** just in case, default zero **/
-         dm::key_t     flag[ 8 ];
-      };
-      std::uint8_t padding[ L1D_CACHE_LINE_SIZE - 8 /** 64 padding **/ ];
-   } 
-#if defined __APPLE__ || defined __linux   
-    __attribute__((aligned( L1D_CACHE_LINE_SIZE ))) 
-#endif    
-    volatile thread_access[ 2 ];
-  
-   std::atomic< std::uint64_t >  checking_size = { 0 };
-
-   inline void set_helper( const dm::access_key key, 
-                           const dm::key_t      val ) noexcept
+         n += count( s->data );
+      }
+      exitEpoch( e );
+      return( n );
+   }
+
+   /**
+    * space_avail - free slots in the producer's store, or in
+    * the one it is about to switch to, safe to call from any
+    * thread.
+    * @return std::size_t
+    */
+   std::size_t space_avail() noexcept
    {
-      switch( key )
+      if( pending.load( std::memory_order_acquire ) != nullptr )
       {
-         case( dm::allocate ):
-         {
-            thread_access[ 0 ].flag[ dm::allocate ] = val;
-         }
-         break;
-         case( dm::allocate_range ):
+         /** fresh store, nothing in it yet **/
+         return( capacity() );
+      }
+      const auto e( enterEpoch() );
+      auto * const buff_ptr(
+         producer.shared.load( std::memory_order_acquire )->data );
+      const auto avail( buff_ptr->max_cap - count( buff_ptr ) );
+      exitEpoch( e );
+      return( avail );
+   }
+
+   /**
+    * count - items queued in a single store.
+    * @param   buff_ptr - buffer_t*
+    * @return  std::size_t
+    */
+   static std::size_t count( buffer_t * const buff_ptr ) noexcept
+   {
+      for( ;; )
+      {
+         const auto   wrap_write( Pointer::wrapIndicator( buff_ptr->write_pt  ) ),
+                      wrap_read(  Pointer::wrapIndicator( buff_ptr->read_pt   ) );
+
+         const auto   wpt( Pointer::val( buff_ptr->write_pt ) ),
+                      rpt( Pointer::val( buff_ptr->read_pt  ) );
+         if( R_LIKELY( rpt < wpt ) )
          {
-            thread_access[ 0 ].flag[ dm::allocate_range ] = val;
+            return( wpt - rpt );
          }
-         break;
-         case( dm::push ):
+         else if( rpt > wpt )
          {
-            thread_access[ 0 ].flag[ dm::push ] = val;
+            return( buff_ptr->max_cap - rpt + wpt );
          }
-         break;
-         case( dm::recycle ):
+         /** wpt == rpt, expect most of the time to be full **/
+         if( R_LIKELY( wrap_read < wrap_write ) )
          {
-            thread_access[ 1 ].flag[ dm::recycle ] = val;
+            return( buff_ptr->max_cap );
          }
-         break;
-         case( dm::pop ):
+         else if( wrap_read == wrap_write )
          {
-            thread_access[ 1 ].flag[ dm::pop ] = val;
+            return( 0 );
          }
-         break;
-         case( dm::peek ):
+         /**
+          * TODO, this condition is momentary, however there
+          * is a better way to fix this with atomic operations...
+          * or on second thought benchmarking shows the atomic
+          * operations slows the queue down drastically so, perhaps
+          * this is in fact the best of all possible returns (see
+          * Leibniz or Candide for further info).
+          */
+#ifndef USEQTHREADS
+         std::this_thread::yield();
+#else
+         qthread_yield();
+#endif
+      }
+      return( 0 ); /** keep some compilers happy **/
+   }
+
+   /**
+    * enterEpoch - threads at neither end of the FIFO call this
+    * before following a pointer to any store and hand the
+    * return value to exitEpoch() once done.
+    * @return std::uint64_t - epoch entered
+    */
+   std::uint64_t enterEpoch() noexcept
+   {
+      for( ;; )
+      {
+         const auto e( epoch.load( std::memory_order_seq_cst ) );
+         readers[ e & 1 ].fetch_add( 1, std::memory_order_seq_cst );
+         if( epoch.load( std::memory_order_seq_cst ) == e )
          {
-            thread_access[ 1 ].flag[ dm::peek ] = val;
+            return( e );
          }
-         break;
-         case( dm::size ):
+         /** reclaim() moved on, go with it **/
+         readers[ e & 1 ].fetch_sub( 1, std::memory_order_release );
+      }
+   }
+
+   void exitEpoch( const std::uint64_t e ) noexcept
+   {
+      readers[ e & 1 ].fetch_sub( 1, std::memory_order_release );
+   }
+
+   /**
+    * invalidate - producer side, no more items will be added.
+    */
+   inline void invalidate() noexcept
+   {
+      valid.store( false, std::memory_order_release );
+   }
+
+   inline bool is_valid() noexcept
+   {
+      return( valid.load( std::memory_order_acquire ) );
+   }
+
+private:
+   struct store
+   {
+      explicit store( buffer_t * const data ) : data( data ){}
+
+      buffer_t               *data;
+      /** set by the producer when it leaves this store **/
+      std::atomic< store* >   next = { nullptr };
+   };
+
+   struct end
+   {
+      /** node and data only change on this end's thread **/
+      store                  *node = nullptr;
+      buffer_t               *data = nullptr;
+      /** node, for everybody else **/
+      std::atomic< store* >   shared = { nullptr };
+   };
+
+   /**
+    * adopt - producer side, switch to the store handed over
+    * by resize().  The release on next is what tells the
+    * consumer every item in the old store has been written.
+    */
+   void adopt() noexcept
+   {
+      auto * const s( pending.exchange( nullptr, std::memory_order_acquire ) );
+      if( s == nullptr )
+      {
+         return;
+      }
+      s->data->src_kernel = producer.data->src_kernel;
+      s->data->dst_kernel = producer.data->dst_kernel;
+      producer.node->next.store( s, std::memory_order_release );
+      producer.node = s;
+      producer.data = s->data;
+      producer.shared.store( s, std::memory_order_release );
+   }
+
+   /**
+    * follow - consumer side, move past every store that the
+    * producer has left and that is empty.  Emptiness has to be
+    * checked after seeing next set, not before.
+    */
+   void follow() noexcept
+   {
+      for( ;; )
+      {
+         auto * const next(
+            consumer.node->next.load( std::memory_order_acquire ) );
+         if( next == nullptr || count( consumer.data ) != 0 )
          {
-            /** this one has to be atomic, multiple updaters **/
-            if( val == 0 )
-            {
-                checking_size.fetch_sub( 1, std::memory_order_relaxed );
-            }
-            else
-            {
-                checking_size.fetch_add( 1, std::memory_order_relaxed );
-            }
+            break;
          }
-         break;
-         default:
-            assert( false );
+         consumer.node = next;
+         consumer.data = next->data;
       }
-      return;
+      consumer.shared.store( consumer.node, std::memory_order_release );
    }
+
+   /** producer owned line **/
+   end                           producer;
+   /** written by resize(), taken by the producer **/
+   std::atomic< store* >         pending = { nullptr };
+   char                          pad_producer[ L1D_CACHE_LINE_SIZE -
+                                               ( sizeof( end ) +
+                                                 sizeof( store* ) ) %
+                                                  L1D_CACHE_LINE_SIZE ];
+   /** consumer owned line **/
+   end                           consumer;
+   char                          pad_consumer[ L1D_CACHE_LINE_SIZE -
+                                               sizeof( end ) %
+                                                  L1D_CACHE_LINE_SIZE ];
+
+   /** oldest store not yet freed, allocator thread only **/
+   store                        *head      = nullptr;
+   std::atomic< std::uint64_t >  epoch     = { 0 };
+   std::atomic< std::uint64_t >  readers[ 2 ] = { { 0 }, { 0 } };
+   std::atomic< std::size_t >    max_cap   = { 0 };
+   std::atomic< bool >           valid     = { true };
+   bool                          resizeable = true;
 };
 #endif /* END _DATAMANAGER_TCC_ */
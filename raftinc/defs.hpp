@@ -27,6 +27,8 @@
 #include <vector>
 #include <utility>
 
+#include "ptrset.hpp"
+
 
 /** predeclare raft::kernel for kernel_list_t below **/
 namespace raft
@@ -37,9 +39,12 @@ namespace raft
 template < typename T > 
     using set_t = std::set< T >;
 
-using ptr_set_t = set_t< std::uintptr_t >;
-using recyclefunc_t = std::function< void( void * ) >;
-using ptr_map_t = std::map< std::uintptr_t, recyclefunc_t >;
+/** see ptrset.hpp **/
+using ptr_set_t = ptr_set;
+/** destroys a recycled item and gives back its memory **/
+using recyclefunc_t = void (*)( void * );
+/** recycled items in the order recycled, see Schedule::fifo_gc **/
+using ptr_map_t = std::vector< std::pair< std::uintptr_t, recyclefunc_t > >;
 using ptr_t = std::uintptr_t;
 
 using core_id_t = std::int64_t;
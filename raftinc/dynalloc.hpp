@@ -20,6 +20,7 @@
 #ifndef _DYNALLOC_HPP_
 #define _DYNALLOC_HPP_  1
 #include "allocate.hpp"
+#include "resizepolicy.hpp"
 
 namespace raft
 {
@@ -41,22 +42,19 @@ public:
      */
     virtual void run();
 
-private:
+protected:
     /**
-     * hash - simple hash function to quickly
-     * look-up stats on individual FIFO objects
-     * within the streaming app, based on 
-     * addresses of each queue, one consequence
-     * obviously is that the info is trash once
-     * the FIFO is re-allocated, but this is a 
-     * good thing since we don't typically want
-     * stats to hang around.
+     * allocate - same as the base version, edges whose size
+     * the user hasn't fixed are also registered with the
+     * resize policy.
      * @param a, PortInfo& - src portinfo
      * @param b, PortInfo& - dst portinfo
-     * @return std::size_t
+     * @param data, void*
      */
-    static std::size_t hash( PortInfo &a, 
-                             PortInfo &b );
+    virtual void allocate( PortInfo &a, PortInfo &b, void *data );
+
+    /** grows/shrinks the resizeable edges, see resizepolicy.hpp **/
+    ResizePolicy policy;
 };
 
 #endif /* END _DYNALLOC_HPP_ */
@@ -20,6 +20,7 @@
 #ifndef _FIFO_HPP_
 #define _FIFO_HPP_  1
 #include <cstddef>
+#include <cstdint>
 #include <typeinfo>
 #include <iterator>
 #include <list>
@@ -33,6 +34,8 @@
 #include <stdexcept>
 #include "bufferdata.tcc"
 #include "blocked.hpp"
+#include "waitstrategy.hpp"
+#include "resizesignal.hpp"
 #include "signalvars.hpp"
 #include "alloc_traits.tcc"
 
@@ -46,6 +49,7 @@ class Allocate;
 namespace raft
 {
    class kernel;
+   class parallel_k;
 }
 
 class FIFO
@@ -129,9 +133,10 @@ public:
    allocate( Args&&... params )
    {
       T **ptr( nullptr );
-      /** call blocks till an element is available **/
+      /** call blocks till an element is available, *ptr is its slot **/
       local_allocate( (void**) &ptr );
-      *ptr = new T( std::forward< Args >( params )... );
+      T * temp( new ( *ptr ) T( std::forward< Args >( params )... ) );
+      UNUSED( temp );
       return( **ptr );
    }
 
@@ -380,13 +385,15 @@ public:
       void *ptr = nullptr;
       void *sig = nullptr;
       std::size_t curr_pointer_loc( 0 );
-      local_peek_range( &ptr, &sig, n, curr_pointer_loc );
+      std::size_t queue_size( 0 );
+      local_peek_range( &ptr, &sig, n, curr_pointer_loc, queue_size );
       return( autorelease< T, peekrange >( 
          (*this),
          reinterpret_cast< T * const >( ptr ),
-         reinterpret_cast< Buffer::Signal* >( sig ),
+         reinterpret_cast< Buffer::SignalMap* >( sig ),
          curr_pointer_loc,
-         n ) );
+         n,
+         queue_size ) );
    }
    
    template< class T,
@@ -399,13 +406,15 @@ public:
       void *ptr = nullptr;
       void *sig = nullptr;
       std::size_t curr_pointer_loc( 0 );
-      local_peek_range( &ptr, &sig, n, curr_pointer_loc );
+      std::size_t queue_size( 0 );
+      local_peek_range( &ptr, &sig, n, curr_pointer_loc, queue_size );
       return( autorelease< T, peekrange >( 
          (*this),
          reinterpret_cast< T * const >( ptr ),
-         reinterpret_cast< Buffer::Signal* >( sig ),
+         reinterpret_cast< Buffer::SignalMap* >( sig ),
          curr_pointer_loc,
-         n ) );
+         n,
+         queue_size ) );
    }
 
 
@@ -460,18 +469,26 @@ public:
     */
    virtual void get_zero_write_stats( Blocked &copy );
 
+   /**
+    * get_items_written - total items pushed into this FIFO
+    * since it was made, never reset.  Read by the profiler
+    * once the map is done, so it needn't be exact while the
+    * producer is running.  Default version returns zero.
+    * @return  std::uint64_t
+    */
+   virtual std::uint64_t get_items_written();
+
    /**
     * resize - called from the dynamic allocator  to 
     * resize the queue.  The function itself is 
     * implemented in the various template specializations
     * found in ringuffer.tcc.  A new queue is allocated
-    * with the size specified and alignment and the old 
-    * queue is copied over.  The third parameter, exit_alloc
-    * must be passed from the dynamic allocator to signal
-    * with the application is finished so that the resize
-    * function doesn't wait indefinitely for queue conditions
-    * that will never arise (for exact conditions, see 
-    * datamanager.tcc.
+    * with the size specified and alignment and handed to
+    * the producer, the consumer drains the old one before
+    * following (see datamanager.tcc).  The third parameter,
+    * exit_alloc must be passed from the dynamic allocator to
+    * signal when the application is finished so that a queue
+    * that is about to go away isn't resized.
     * @param   n_items - number of items to resize q to
     * @param   align   - alignment of queue to allocate
     * @param   exit_alloc - bool to signal when app is finished
@@ -480,6 +497,14 @@ public:
                         const std::size_t align, 
                         volatile bool &exit_alloc ) = 0;
 
+   /**
+    * reclaim - frees whatever storage earlier resizes left
+    * behind that the consumer is done with, call from the
+    * same thread that calls resize.  Default version does
+    * nothing.
+    */
+   virtual void reclaim();
+
    /**
     * get_frac_write_blocked - returns the fraction
     * of time that this queue was blocked.  This might
@@ -525,6 +550,58 @@ protected:
     * setOutPeekSet -
     */
    virtual void setOutPeekSet( ptr_set_t * const peekset );
+   /**
+    * set_wait_strategy - sets what the producer and consumer
+    * do when this fifo is full or empty, default version does
+    * nothing for FIFOs that don't wait.
+    * @param   strategy - raft::wait::strategy
+    */
+   virtual void set_wait_strategy( const raft::wait::strategy strategy );
+   /**
+    * idle_wait - called by the scheduler on the consumer thread
+    * when the kernel reading this fifo has nothing to do, waits
+    * per the wait strategy until data arrives or the fifo is
+    * invalidated.  Default version just yields.
+    * @param   spins - times the consumer has been idle in a row
+    */
+   virtual void idle_wait( const std::size_t spins );
+   /**
+    * set_ready_bits - hooks this fifo up to the readiness
+    * bitmaps of the kernels on either end, see readiness.hpp.
+    * Default version does nothing, the scheduler then only
+    * sees this fifo when it polls.
+    * @param   data   - ReadyBit, consumer has data
+    * @param   space  - ReadyBit, producer has room
+    * @param   closed - ReadyBit, fifo invalidated
+    */
+   virtual void set_ready_bits( const ReadyBit &data,
+                                const ReadyBit &space,
+                                const ReadyBit &closed );
+   /**
+    * set_resize_signal - gives a resizeable fifo the handle it
+    * posts to when its producer blocks, see resizepolicy.hpp.
+    * Default version does nothing, fifos that can't be resized
+    * never post.
+    * @param   signal - ResizeSignal
+    */
+   virtual void set_resize_signal( const ResizeSignal &signal );
+   /**
+    * set_memory_options - huge pages and NUMA placement for this
+    * fifo's stores, see pagealloc.hpp.  Set by the allocator
+    * before either end runs, the current store is re-allocated
+    * and every store after a resize uses them too.  Default
+    * version does nothing.
+    * @param   mem - const raft::mem::options&
+    */
+   virtual void set_memory_options( const raft::mem::options &mem );
+   /**
+    * set_fused - both ends of this fifo are run by the same
+    * thread, see raft::map::fuseChains, so waiting on the other
+    * end would never end.  Set by the allocator before either
+    * end runs.  Default version does nothing, only fifos that
+    * can be fused override it.
+    */
+   virtual void set_fused();
    /**
     * set_src_kernel - sets teh protected source
     * kernel for this fifo, necessary for preemption,
@@ -639,11 +716,14 @@ protected:
     * @param   sig - void**, same as above but for signal queue
     * @param   n_items - const std::size_t, number of items requested
     * @param   curr_pointer_loc - number of items able to be returned
+    * @param   queue_size - capacity of the store the items are in,
+    *                       which isn't always capacity() after a resize
     */
    virtual void local_peek_range( void **ptr, 
                                   void **sig,
                                   const std::size_t n_items,
-                                  std::size_t &curr_pointer_loc ) = 0;
+                                  std::size_t &curr_pointer_loc,
+                                  std::size_t &queue_size ) = 0;
    
    /**
     * local_recycle - called by template recycle function
@@ -658,6 +738,8 @@ protected:
     */
    friend class Schedule;
    friend class Allocate;
+   /** a join waits on an input when it can't go on, see reorderjoin.tcc **/
+   friend class raft::parallel_k;
 };
 
 
@@ -0,0 +1,409 @@
+/**
+ * filewriter.tcc - file sink.  Whatever comes in is gathered into
+ * one large page aligned buffer and written out with writev once
+ * the buffer fills, so the file sees a few big writes instead of
+ * one per item.  An item that won't fit in what's left of the
+ * buffer goes out in the same writev as the buffer, straight from
+ * the FIFO.  Whenever every input is empty the buffer is written
+ * too: if the writer can't keep up its inputs never run dry and
+ * writes stay large, if it can the short write costs nothing, and
+ * either way the file is complete by the time the map is done.
+ *
+ * Chunk types (anything with buffer and length members, e.g.
+ * filechunk) have their first length bytes written, other types
+ * are written as they are in memory, so have to be trivially
+ * copyable.
+ *
+ * With ordered set chunks are written in order of chunk.index,
+ * starting at zero, whatever input they come in on, for use behind
+ * a section of parallel replicas ("( reader >> work ) >= writer").
+ * A chunk that comes early is only copied aside when the one that's
+ * next isn't at the head of any input, at most held_per_port per
+ * input.  If every open input is held up by a chunk too far ahead
+ * a ReorderWindowException is thrown; once every input is closed a
+ * missing index is skipped.
+ *
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 04:43:36 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _FILEWRITER_TCC_
+#define _FILEWRITER_TCC_  1
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <raft>
+#include "kernelexception.hpp"
+
+namespace raft
+{
+
+/** is_chunk - T carries its bytes in buffer and length, as filechunk does **/
+template < class T, class = void > struct is_chunk : std::false_type{};
+
+template < class T > struct is_chunk< T,
+   decltype( (void) std::declval< T& >().buffer,
+             (void) std::declval< T& >().length,
+             void() ) > : std::true_type{};
+
+template < class T > class filewriter : public raft::kernel
+{
+public:
+   /** chunks copied aside per input, waiting on the one before them **/
+   static constexpr std::size_t held_per_port = 4;
+
+   /**
+    * filewriter - creates or truncates outputfile, exits if it
+    * can't.
+    * @param   outputfile    - file to write
+    * @param   n_input_ports - ports named "0" on up
+    * @param   ordered       - write chunks in chunk.index order
+    * @param   buffer_size   - bytes gathered before a write
+    */
+   filewriter( const std::string  outputfile,
+               const std::size_t  n_input_ports = 1,
+               const bool         ordered       = false,
+               const std::size_t  buffer_size   = 1 << 20 ) : raft::kernel(),
+                                                              ordered( ordered ),
+                                                              capacity( buffer_size )
+   {
+      static_assert( is_chunk< T >::value || std::is_trivially_copyable< T >::value,
+                     "filewriter writes chunks or trivially copyable types" );
+      if( ordered && ! is_chunk< T >::value )
+      {
+         std::cerr << "filewriter: only chunks carry an index to order by, exiting\n";
+         exit( EXIT_FAILURE );
+      }
+      if( capacity == 0 )
+      {
+         std::cerr << "filewriter: buffer_size has to be more than zero, exiting\n";
+         exit( EXIT_FAILURE );
+      }
+      for( std::size_t index( 0 ); index < n_input_ports; index++ )
+      {
+         input.addPort< T >( std::to_string( index ) );
+      }
+      void *ptr( nullptr );
+      if( posix_memalign( &ptr,
+                          static_cast< std::size_t >( sysconf( _SC_PAGESIZE ) ),
+                          capacity ) != 0 )
+      {
+         std::cerr << "filewriter: failed to allocate a " << capacity <<
+            " byte buffer, exiting\n";
+         exit( EXIT_FAILURE );
+      }
+      buffer = reinterpret_cast< char* >( ptr );
+      fd = open( outputfile.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+      if( fd < 0 )
+      {
+         perror( "Failed to open output file, exiting!" );
+         exit( EXIT_FAILURE );
+      }
+   }
+
+   virtual ~filewriter()
+   {
+      (this)->release_held();
+      (this)->flush();
+      close( fd );
+      free( buffer );
+   }
+
+   virtual raft::kstatus run()
+   {
+      if( ordered )
+      {
+         (this)->take_ordered();
+      }
+      else
+      {
+         for( auto &port : input )
+         {
+            const auto n( port.size() );
+            if( n > 0 )
+            {
+               (this)->take( port, n );
+            }
+         }
+      }
+      bool idle( true ), closed( true );
+      for( auto &port : input )
+      {
+         idle   = idle   && port.size() == 0;
+         closed = closed && port.is_invalid();
+      }
+      if( idle )
+      {
+         if( closed )
+         {
+            /** nothing more is coming, whatever is missing is gone **/
+            (this)->release_held();
+         }
+         (this)->flush();
+      }
+      return( raft::proceed );
+   }
+
+private:
+   /** take - n chunks **/
+   template < class U = T,
+              typename std::enable_if< is_chunk< U >::value >::type* = nullptr >
+   void take( FIFO &port, std::size_t n )
+   {
+      while( n-- > 0 )
+      {
+         auto &chunk( port.template peek< T >() );
+         (this)->append( chunk.buffer, chunk.length );
+         port.recycle();
+      }
+   }
+
+   /** take - n small items, all at once **/
+   template < class U = T,
+              typename std::enable_if< ! is_chunk< U >::value &&
+                                       inline_alloc< U >::value >::type* = nullptr >
+   void take( FIFO &port, const std::size_t n )
+   {
+      {
+         auto range( port.template peek_range< T >( n ) );
+         for( std::size_t i( 0 ); i < n; i++ )
+         {
+            (this)->append( reinterpret_cast< const char* >( &range[ i ].ele ),
+                            sizeof( T ) );
+         }
+      }
+      port.recycle( n );
+   }
+
+   /** take - n large items, no peek_range for these **/
+   template < class U = T,
+              typename std::enable_if< ! is_chunk< U >::value &&
+                                       ext_alloc< U >::value >::type* = nullptr >
+   void take( FIFO &port, std::size_t n )
+   {
+      while( n-- > 0 )
+      {
+         auto &item( port.template peek< T >() );
+         (this)->append( reinterpret_cast< const char* >( &item ), sizeof( T ) );
+         port.recycle();
+      }
+   }
+
+   template < class U = T,
+              typename std::enable_if< ! is_chunk< U >::value >::type* = nullptr >
+   void take_ordered()
+   {
+      /** the constructor won't have it **/
+   }
+
+   /**
+    * take_ordered - writes chunk next wherever it is, copies the
+    * lowest chunk at the head of an input aside if next isn't at
+    * any head, till nothing more can be done.
+    */
+   template < class U = T,
+              typename std::enable_if< is_chunk< U >::value >::type* = nullptr >
+   void take_ordered()
+   {
+      for( ;; )
+      {
+         const auto found( held.find( next ) );
+         if( found != held.end() )
+         {
+            (this)->append( found->second.data(), found->second.size() );
+            held.erase( found );
+            next++;
+            continue;
+         }
+         bool           moved( false );
+         /** every open input has a chunk at its head **/
+         bool           blocked( true );
+         bool           closed( true );
+         FIFO          *lowest( nullptr );
+         std::uint64_t  lowest_index( 0 );
+         for( auto &port : input )
+         {
+            closed = closed && port.is_invalid();
+            if( port.size() == 0 )
+            {
+               blocked = blocked && port.is_invalid();
+               continue;
+            }
+            auto &chunk( port.template peek< T >() );
+            const std::uint64_t index( chunk.index );
+            if( index == next )
+            {
+               (this)->append( chunk.buffer, chunk.length );
+               port.recycle();
+               next++;
+               moved = true;
+               break;
+            }
+            port.unpeek();
+            if( index < next )
+            {
+               throw ReorderWindowException( "chunk index " +
+                  std::to_string( index ) + " seen twice or after it was skipped" );
+            }
+            if( lowest == nullptr || index < lowest_index )
+            {
+               lowest       = &port;
+               lowest_index = index;
+            }
+         }
+         if( moved )
+         {
+            continue;
+         }
+         if( lowest == nullptr )
+         {
+            /** nothing at any head, wait for more **/
+            return;
+         }
+         if( held.size() < held_per_port * input.count() )
+         {
+            auto &chunk( lowest->template peek< T >() );
+            held.emplace( lowest_index,
+                          std::vector< char >( chunk.buffer, chunk.buffer + chunk.length ) );
+            lowest->recycle();
+            continue;
+         }
+         if( closed )
+         {
+            /** next will never come **/
+            next = std::min( lowest_index, held.begin()->first );
+            continue;
+         }
+         if( blocked )
+         {
+            throw ReorderWindowException( "holding " +
+               std::to_string( held.size() ) + " chunks while waiting on " +
+               std::to_string( next ) + ", every input is held up" );
+         }
+         /** next may still come in on an empty input **/
+         return;
+      }
+   }
+
+   /** release_held - writes out chunks held aside, in order, gaps or not **/
+   void release_held()
+   {
+      for( const auto &h : held )
+      {
+         (this)->append( h.second.data(), h.second.size() );
+         next = h.first + 1;
+      }
+      held.clear();
+   }
+
+   void append( const char * const data, const std::size_t n )
+   {
+      if( used + n <= capacity )
+      {
+         std::memcpy( buffer + used, data, n );
+         used += n;
+         if( used == capacity )
+         {
+            (this)->flush();
+         }
+         return;
+      }
+      /** doesn't fit, goes out behind the buffer without a copy **/
+      struct iovec iov[ 2 ];
+      iov[ 0 ].iov_base = buffer;
+      iov[ 0 ].iov_len  = used;
+      iov[ 1 ].iov_base = const_cast< char* >( data );
+      iov[ 1 ].iov_len  = n;
+      (this)->write_all( iov, 2 );
+      used = 0;
+   }
+
+   void flush()
+   {
+      struct iovec iov;
+      iov.iov_base = buffer;
+      iov.iov_len  = used;
+      (this)->write_all( &iov, 1 );
+      used = 0;
+   }
+
+   void write_all( struct iovec *iov, int count )
+   {
+      for( ;; )
+      {
+         while( count > 0 && iov->iov_len == 0 )
+         {
+            iov++;
+            count--;
+         }
+         if( count == 0 )
+         {
+            return;
+         }
+         const auto ret( writev( fd, iov, count ) );
+         if( ret < 0 )
+         {
+            if( errno == EINTR )
+            {
+               continue;
+            }
+            perror( "Failed to write output file, exiting!" );
+            exit( EXIT_FAILURE );
+         }
+         /** short, move past what did get written **/
+         auto left( static_cast< std::size_t >( ret ) );
+         while( left > 0 )
+         {
+            const auto take( std::min( left, iov->iov_len ) );
+            iov->iov_base = reinterpret_cast< char* >( iov->iov_base ) + take;
+            iov->iov_len -= take;
+            left         -= take;
+            if( iov->iov_len == 0 )
+            {
+               iov++;
+               count--;
+            }
+         }
+      }
+   }
+
+   const bool                                      ordered;
+   const std::size_t                               capacity;
+   char                                           *buffer = nullptr;
+   std::size_t                                     used    = 0;
+   int                                             fd      = -1;
+   /** next chunk index to write when ordered **/
+   std::uint64_t                                   next    = 0;
+   std::map< std::uint64_t, std::vector< char > >  held;
+};
+
+template < class T > constexpr std::size_t filewriter< T >::held_per_port;
+
+} /* end namespace raft */
+#endif /* END _FILEWRITER_TCC_ */
@@ -38,6 +38,7 @@ template< typename EDGEID_T, typename WEIGHT_T > struct ScotchTables
    constexpr ScotchTables( const ScotchTables &other ) : vtable( other.vtable ),
                                                          etable( other.etable ),
                                                          eweight( other.eweight ),
+                                                         vweight( other.vweight ),
                                                          partition( other.partition ),
                                                          num_vertices( other.num_vertices ),
                                                          num_edges( other.num_edges ){};
@@ -47,12 +48,15 @@ template< typename EDGEID_T, typename WEIGHT_T > struct ScotchTables
       delete[]( vtable );
       delete[]( etable );
       delete[]( eweight );
+      delete[]( vweight );
       delete[]( partition );
    }
    
    EDGEID_T      *vtable     = nullptr;
    EDGEID_T      *etable     = nullptr;
    WEIGHT_T      *eweight    = nullptr;
+   /** vertex loads, null if none were set **/
+   WEIGHT_T      *vweight    = nullptr;
    EDGEID_T      *partition  = nullptr;
    std::size_t    num_vertices;
    std::size_t    num_edges;
@@ -166,6 +170,8 @@ private:
     * it could get really really large
     */
    std::set< edge_id_t >                     vertex_hash;
+   /** loads for vertices that were given one, the rest get 1 **/
+   std::map< edge_id_t, weight_t >           vertex_weight;
 public:
 
 
@@ -203,6 +209,19 @@ public:
    }
 
 
+   /**
+    * setVertexWeight - load for vertex, e.g. how busy the
+    * kernel is.  Unless set every vertex weighs the same.
+    * @param   vertex - const edge_id_t
+    * @param   weight - const weight_t, at least one
+    */
+   void setVertexWeight( const edge_id_t vertex,
+                         const weight_t  weight )
+   {
+      vertex_weight[ vertex ] = weight;
+      return;
+   }
+
    /**
     * getScotchTables() - call once you are completely done
     * adding edges to the graph, formats the returned arrays
@@ -248,6 +267,17 @@ public:
       table->eweight           = edge_weight;
       table->num_vertices      = size;
       table->num_edges         = edge_list_temp_size;
+      if( ! vertex_weight.empty() )
+      {
+         table->vweight = new weight_t[ size ];
+         auto index( 0 );
+         for( const auto vertex_id : vertex_hash )
+         {
+            const auto found( vertex_weight.find( vertex_id ) );
+            table->vweight[ index++ ] =
+               ( found == vertex_weight.end() ? 1 : (*found).second );
+         }
+      }
       table->partition         = new edge_id_t[ size ];
       return( table );
    }
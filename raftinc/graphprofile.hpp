@@ -0,0 +1,158 @@
+/**
+ * graphprofile.hpp - measured costs of a graph, kept between runs
+ * so the partitioner has something better than a weight of one for
+ * every edge.  While the map executes each kernel's time in run()
+ * is summed and, once the kernels are done, the items that went
+ * over each edge are read off the FIFOs.  The numbers are written
+ * to a file named for the shape of the graph (kernel types, ports
+ * and links), the next exe() of the same graph reads them back:
+ *
+ *    kernel load - fraction of the run spent inside run()
+ *    edge rate   - bytes per second pushed over the edge
+ *
+ * Kernels are numbered by when they were constructed, so the same
+ * program building the same graph gets the same numbering.  Runs
+ * are blended into what was on file, recent ones counting most.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 23:58:36 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _GRAPHPROFILE_HPP_
+#define _GRAPHPROFILE_HPP_  1
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "kernelkeeper.tcc"
+
+struct PortInfo;
+
+namespace raft
+{
+
+class kernel;
+
+/**
+ * run_sample - time a kernel spent in run(), only written by
+ * whichever thread is running the kernel.
+ */
+struct run_sample
+{
+   std::uint64_t busy_ns = 0;
+   std::uint64_t runs    = 0;
+};
+
+class graph_profile
+{
+public:
+   /**
+    * graph_profile - numbers the kernels in all, works out the
+    * key for the graph's shape and loads what is on file for it
+    * in dir, if anything.  Call once every kernel is linked.
+    * @param   all - kernelkeeper&, every kernel in the map
+    * @param   dir - const std::string&, where profiles are kept
+    */
+   graph_profile( kernelkeeper &all, const std::string &dir );
+
+   ~graph_profile();
+
+   /** true if an earlier run of this graph was on file **/
+   bool loaded() const noexcept
+   {
+      return( runs != 0 );
+   }
+
+   /** hash of the graph's shape, names the file **/
+   std::uint64_t key() const noexcept
+   {
+      return( graph_key );
+   }
+
+   /** file the profile is read from and written to **/
+   std::string path() const;
+
+   /**
+    * kernel_load - fraction of earlier runs the kernel spent
+    * in run(), between zero and one.
+    * @param   k - kernel in the graph
+    * @return  double, negative if nothing is known
+    */
+   double kernel_load( const raft::kernel * const k ) const;
+
+   /**
+    * edge_rate - bytes per second earlier runs pushed over the
+    * edge leaving port src.
+    * @param   src - const PortInfo&, output side of the edge
+    * @return  double, negative if nothing is known
+    */
+   double edge_rate( const PortInfo &src ) const;
+
+   /** highest edge_rate on file, zero if none **/
+   double max_edge_rate() const noexcept;
+
+   /**
+    * start - begins timing run() of every kernel, call just
+    * before the scheduler starts.
+    */
+   void start();
+
+   /**
+    * stop - call once the scheduler is done but before the
+    * FIFOs are freed.  Reads the edges, blends the run into the
+    * profile and writes it out.
+    */
+   void stop();
+
+private:
+   struct edge
+   {
+      edge( PortInfo * const info ) : info( info ){}
+
+      PortInfo    *info;
+      double       rate = -1.0;
+   };
+
+   struct vertex
+   {
+      vertex( raft::kernel * const k ) : k( k ){}
+
+      raft::kernel *k;
+      run_sample    sample;
+      double        load = -1.0;
+   };
+
+   bool read();
+   void write() const;
+
+   std::string                                  dir;
+   std::uint64_t                                graph_key = 0;
+   /** runs blended into the numbers below, zero if none on file **/
+   std::uint64_t                                runs      = 0;
+   /** in order of construction **/
+   std::vector< vertex >                        vertices;
+   /** outputs of each kernel in turn, by port name **/
+   std::vector< edge >                          edges;
+   std::map< const raft::kernel*, std::size_t > vertex_index;
+   std::map< const PortInfo*, std::size_t >     edge_index;
+   std::chrono::steady_clock::time_point        started;
+};
+
+} /** end namespace raft **/
+#endif /* END _GRAPHPROFILE_HPP_ */
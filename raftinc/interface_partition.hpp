@@ -23,6 +23,7 @@
 
 #include "kernelkeeper.tcc"
 #include "kernel.hpp"
+#include "graphprofile.hpp"
 
 class interface_partition
 {
@@ -41,7 +42,20 @@ public:
      */
     virtual void partition( kernelkeeper &keeper ) = 0;
 
+    /**
+     * setProfile - costs measured on earlier runs of the
+     * graph, called before partition.  Partitioners that
+     * can weigh kernels and edges should check loaded().
+     * @param profile - const raft::graph_profile*, may be null
+     */
+    void setProfile( const raft::graph_profile * const profile ) noexcept
+    {
+        (this)->profile = profile;
+    }
+
 protected:
+    const raft::graph_profile *profile = nullptr;
+
     /** TODO: add std::enable_if **/
     template < class T, class CORE > 
     static inline void setCore( T &kernel, const CORE core )
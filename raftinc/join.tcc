@@ -30,6 +30,7 @@ public:
    join( const std::size_t num_ports = 1 ) : parallel_k()
    {
       output.addPort< T >( "0" );
+      out = output.handle< T >( "0" );
 
       using index_type = std::remove_const_t<decltype(num_ports)>;
       for( index_type it( 0 ); it < num_ports; it++ )
@@ -48,17 +49,20 @@ public:
        * able to dynamically re-allocate or move the memory backing
        * the stream, so call deallocate below if unused
        */
-      auto &output_port( output[ "0" ] );
-      T &mem( output_port.template allocate< T >() );
+      T &mem( out.allocate() );
       raft::signal temp_signal;
-      if( split_func.get( mem, temp_signal, input ) )
+      /** ports are added while running, see basicparallel.hpp **/
+      lock_helper( input );
+      const bool got( split_func.get( mem, temp_signal, input ) );
+      unlock_helper( input );
+      if( got )
       {
          /** call push to release above allocated memory **/
-         output_port.send( temp_signal );
+         out.send( temp_signal );
       }
       else /** didn't use allocated mem, deallocate **/
       {
-         output_port.deallocate();
+         out.deallocate();
       }
       return( raft::proceed );
    }
@@ -81,6 +85,7 @@ protected:
    }
 
    method split_func;
+   port_handle< T > out;
 };
 }
 #endif /* END _JOIN_TCC_ */
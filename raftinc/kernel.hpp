@@ -27,6 +27,7 @@
 #include <string>
 #include "kernelexception.hpp"
 #include "port.hpp"
+#include "readiness.hpp"
 #include "signalvars.hpp"
 #include "rafttypes.hpp"
 #include "kernel_wrapper.hpp"
@@ -40,6 +41,8 @@ class basic_parallel;
 class kpair;
 class interface_partition;
 class pool_schedule;
+class Allocate;
+class repin_monitor;
 
 
 #ifndef CLONE
@@ -61,6 +64,9 @@ virtual raft::kernel* clone()\
 #endif
 
 namespace raft {
+struct run_sample;
+class graph_profile;
+
 class kernel
 {
 public:
@@ -139,12 +145,19 @@ protected:
     */
    Port               input  = { this };
    Port               output = { this };
+
+   /**
+    * readiness - which input ports have data and which output
+    * ports have room, kept up to date by the FIFOs themselves.
+    */
+   Readiness          readiness;
   
    
    std::string getEnabledPort();
    
    /** in namespace raft **/
    friend class map;
+   friend class graph_profile;
    /** in global namespace **/
    friend class ::MapBase;
    friend class ::Schedule;
@@ -154,6 +167,8 @@ protected:
    friend class ::kpair;
    friend class ::interface_partition;
    friend class ::pool_schedule;
+   friend class ::Allocate;
+   friend class ::repin_monitor;
 
    /**
     * NOTE: doesn't need to be atomic since only one thread
@@ -191,6 +206,19 @@ private:
 
    bool             execution_done    = false;
 
+   /** set while the map is being profiled, see graphprofile.hpp **/
+   raft::run_sample *sample           = nullptr;
+
+   /**
+    * fused chains, see map::setFusion.  The first stage is run
+    * by the scheduler and runs the stages after it itself.
+    */
+   raft::kernel     *fused_next       = nullptr;
+   /** true for every stage of a chain but the first **/
+   bool             fused_stage       = false;
+   /** this stage has finished, the first stage's thread keeps going till all have **/
+   bool             fused_done        = false;
+
    /** for operator syntax **/
    std::queue< std::string > enabled_port;
 };
@@ -38,5 +38,12 @@ public:
         KernelException( message ){};
 };
 
+class ReorderWindowException : public KernelException
+{
+public:
+    ReorderWindowException( const std::string message ) :
+        KernelException( message ){};
+};
+
 
 #endif /* END _KERNELEXCEPTION_HPP_ */
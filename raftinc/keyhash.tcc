@@ -0,0 +1,178 @@
+/**
+ * keyhash.tcc - key partitioning, for copies of a kernel that keep
+ * state per key.  Every item with the same key goes to the same
+ * port, picked by jump consistent hashing (Lamping and Veach) of
+ * Key( item ) over the port ids.  When map::setMaxReplicas adds a
+ * port the only keys that move are those that move to the new
+ * port, about one in n.  If the key's port has been closed (its
+ * copy retired) the key is hashed again till it lands on an open
+ * port, keys on open ports stay where they are.  A copy keeping
+ * state per key only sees keys moving in from the new or retired
+ * ports.  An item whose port is full waits rather than go
+ * elsewhere, so one hot key can hold up the split.
+ *
+ * Use as raft::split< T, keyhash< T, Key > >, Key is a functor
+ * taking const T& and returning std::size_t, std::hash< T > by
+ * default.  Reading (in a join) takes any port with data.
+ *
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 02:06:44 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _KEYHASH_TCC_
+#define _KEYHASH_TCC_  1
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "fifo.hpp"
+#include "port.hpp"
+#include "splitmethod.hpp"
+
+template < class T, class Key = std::hash< T > > class keyhash : public splitmethod
+{
+public:
+   keyhash() : splitmethod()
+   {
+   }
+
+   virtual ~keyhash() = default;
+
+   /**
+    * send - hides splitmethod::send, items go out in order, a
+    * batch is a run of consecutive items for the same port.
+    * @param   range - peek range from the split's input
+    * @param   outputs - output port list
+    * @return  std::size_t - items sent, from the front of range
+    */
+   template < class R >
+      std::size_t send( R &range, Port &outputs )
+   {
+      auto &list( fifos( outputs ) );
+      std::size_t sent( 0 );
+      while( sent < range.size() )
+      {
+         auto * const fifo( target( range[ sent ].ele, list ) );
+         if( fifo == nullptr || fifo->space_avail() == 0 )
+         {
+            break;
+         }
+         const auto room( std::min( fifo->space_avail(), batch ) );
+         std::size_t n( 0 );
+         do
+         {
+            fifo->push( range[ sent ].ele, range[ sent ].sig );
+            sent++;
+            n++;
+         }while( n < room && sent < range.size() &&
+                 target( range[ sent ].ele, list ) == fifo );
+      }
+      return( sent );
+   }
+
+   bool send( T &item, const raft::signal signal, Port &outputs )
+   {
+      auto * const fifo( target( item, fifos( outputs ) ) );
+      if( fifo == nullptr || fifo->space_avail() == 0 )
+      {
+         return( false );
+      }
+      fifo->push( item, signal );
+      return( true );
+   }
+
+   /**
+    * jump - jump consistent hash, the bucket in [0,n) for k.
+    * Going from n to n + 1 buckets only moves keys to bucket n.
+    * @param   k - std::uint64_t key
+    * @param   n - const std::size_t buckets, more than zero
+    * @return  std::size_t
+    */
+   static std::size_t jump( std::uint64_t k, const std::size_t n )
+   {
+      std::int64_t b( -1 ), j( 0 );
+      while( j < static_cast< std::int64_t >( n ) )
+      {
+         b = j;
+         k = k * 2862933555777941757ULL + 1;
+         j = static_cast< std::int64_t >(
+            static_cast< double >( b + 1 ) *
+            ( static_cast< double >( std::int64_t( 1 ) << 31 ) /
+              static_cast< double >( ( k >> 33 ) + 1 ) ) );
+      }
+      return( static_cast< std::size_t >( b ) );
+   }
+
+protected:
+   /** rehashes of a key whose port is closed before walking the list **/
+   static constexpr std::size_t max_probes = 8;
+
+   /** target - port for item's key, nullptr if all are closed **/
+   FIFO* target( const T &item, std::vector< FIFO* > &list )
+   {
+      const auto n( list.size() );
+      if( n == 0 )
+      {
+         return( nullptr );
+      }
+      std::uint64_t k( key( item ) );
+      auto index( jump( k, n ) );
+      for( std::size_t probe( 0 ); probe < max_probes; probe++ )
+      {
+         if( ! list[ index ]->is_invalid() )
+         {
+            return( list[ index ] );
+         }
+         /** same sequence for the same key, so it still sticks to one port **/
+         k = ( k ^ ( k >> 29 ) ) * 0xbf58476d1ce4e5b9ULL + probe + 1;
+         index = jump( k, n );
+      }
+      for( std::size_t i( 1 ); i < n; i++ )
+      {
+         auto * const fifo( list[ ( index + i ) % n ] );
+         if( ! fifo->is_invalid() )
+         {
+            return( fifo );
+         }
+      }
+      return( nullptr );
+   }
+
+   /** for joins, any port with data in turn **/
+   virtual FIFO* select_fifo( Port &port_list, const functype type )
+   {
+      auto &list( fifos( port_list ) );
+      const auto n( list.size() );
+      for( std::size_t i( 0 ); i < n; i++ )
+      {
+         const auto index( ( next + i ) % n );
+         if( ready( *list[ index ], type ) )
+         {
+            next = index + 1;
+            return( list[ index ] );
+         }
+      }
+      return( nullptr );
+   }
+
+   Key         key;
+   std::size_t next = 0;
+};
+
+template < class T, class Key > constexpr std::size_t keyhash< T, Key >::max_probes;
+#endif /* END _KEYHASH_TCC_ */
@@ -20,4 +20,26 @@
 #ifndef _LEASTUSEDFIRST_HPP_
 #define _LEASTUSEDFIRST_HPP_  1
 
+#include "fifo.hpp"
+#include "port.hpp"
+#include "splitmethod.hpp"
+
+/**
+ * leastusedfirst - join the shortest queue.  A split sends to the
+ * open port that is least full, a join reads from the one that is
+ * most full.  Looks at every port on every selection, ties go to
+ * the port after the last one chosen.
+ */
+class leastusedfirst : public splitmethod
+{
+public:
+   leastusedfirst();
+   virtual ~leastusedfirst();
+
+protected:
+   virtual FIFO*  select_fifo( Port &port_list, const functype type );
+
+   std::size_t next = 0;
+};
+
 #endif /* END _LEASTUSEDFIRST_HPP_ */
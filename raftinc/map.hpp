@@ -23,6 +23,9 @@
 #include <cassert>
 #include <thread>
 #include <sstream>
+#include <memory>
+#include <chrono>
+#include <string>
 
 #include "kernelkeeper.tcc"
 #include "portexception.hpp"
@@ -35,10 +38,12 @@
 #include "stdalloc.hpp"
 #include "mapbase.hpp"
 #include "poolschedule.hpp"
+#include "workstealschedule.hpp"
 #include "basicparallel.hpp"
 #include "noparallel.hpp"
 /** includes all partitioners **/
 #include "partitioners.hpp"
+#include "graphprofile.hpp"
 
 namespace raft
 {
@@ -73,8 +78,8 @@ public:
 #if USE_PARTITION
              partition_scotch
 #else
-             //partition_basic /** no scotch, simple affinity assign **/
-             partition_dummy
+             /** no scotch, cache topology from sysfs **/
+             partition_affinity
 #endif
 #else /** OS X, WIN64 **/
              partition_dummy
@@ -104,11 +109,23 @@ public:
       }
       /** check types, ensure all are linked **/
       checkEdges( source_kernels );
+      /** adds in split/join kernels **/
+      if( max_replicas > 1 )
+      {
+         enableDuplication( source_kernels, all_kernels );
+      }
+      /** after the splits and joins are in, they aren't fused **/
+      if( fusion )
+      {
+         fuseChains( all_kernels );
+      }
+      std::unique_ptr< graph_profile > profile(
+         profile_dir.empty() ? nullptr :
+                               new graph_profile( all_kernels, profile_dir ) );
       partition pt;
+      pt.setProfile( profile.get() );
       pt.partition( all_kernels );
       
-      /** adds in split/join kernels **/
-      //enableDuplication( source_kernels, all_kernels );
       volatile bool exit_alloc( false );
       allocator alloc( (*this), exit_alloc );
       /** launch allocator in a thread **/
@@ -121,6 +138,10 @@ public:
       scheduler sched( (*this) );
       sched.init();
       
+      if( profile )
+      {
+         profile->start();
+      }
       /** launch scheduler in thread **/
       std::thread sched_thread( [&](){
          sched.start();
@@ -137,6 +158,11 @@ public:
       });
       /** join scheduler first **/
       sched_thread.join();
+      if( profile )
+      {
+         /** before alloc goes, the edges are read off the FIFOs **/
+         profile->stop();
+      }
 
       /** scheduler done, cleanup alloc **/
       exit_alloc = true;
@@ -155,6 +181,70 @@ public:
     */
    kernel_pair_t operator +=( kpair &p );
 
+   /**
+    * setWaitStrategy - sets what every FIFO in this map does
+    * when it is full or empty, ports with their own strategy
+    * set via Port::setWaitStrategy keep theirs.  Call before
+    * exe(), default is raft::wait::adaptive.
+    * @param   strategy - raft::wait::strategy
+    */
+   void setWaitStrategy( const raft::wait::strategy strategy );
+
+   /**
+    * setMemoryCap - limits the total bytes the allocator may
+    * hold in this map's resizeable FIFOs, buffers aren't grown
+    * past it and idle ones are shrunk over time.  Per edge caps
+    * are set with Port::setMemoryCap.  Call before exe().
+    * @param   bytes - const std::size_t, zero for no cap
+    */
+   void setMemoryCap( const std::size_t bytes );
+
+   /**
+    * setProfileDir - measure the cost of each kernel and edge
+    * while the map runs and keep it in dir, in a file named for
+    * the shape of the graph.  Later runs of the same graph hand
+    * it to the partitioner, see graphprofile.hpp.  Call before
+    * exe(), empty (the default) to turn profiling off.
+    * @param   dir - const std::string&
+    */
+   void setProfileDir( const std::string &dir );
+
+   /**
+    * setRepinWindow - how often the scheduler looks at where
+    * pinned kernels run and moves ones that are fighting over
+    * a core, see repinmonitor.hpp.  Zero turns it off, default
+    * is a second.  Call before exe().
+    * @param   period - const std::chrono::milliseconds
+    */
+   void setRepinWindow( const std::chrono::milliseconds period );
+
+   /**
+    * setMaxReplicas - lets the run-time make up to n copies of
+    * each kernel whose ports are all linked out of order, e.g.,
+    * a >> raft::order::out >> b >> raft::order::out >> c, as the
+    * load calls for, see basicparallel.hpp.  The kernel has to
+    * implement clone(), see the CLONE() macro.  Default is one,
+    * no copies.  Call before exe().
+    * @param   n - const std::size_t, copies counting the original
+    */
+   void setMaxReplicas( const std::size_t n );
+
+   /**
+    * setFusion - runs each chain of kernels linked one output
+    * port to one input port on a single thread, see fuseChains.
+    * Each stage runs till the stage before has nothing left for
+    * it.  The FIFO between two stages grows rather than block
+    * when a run pushes more than it holds, but a fused kernel
+    * that waits for more input than is there (peek_range, pop of
+    * more than size()) would wait forever, so that throws a
+    * FusedStageBlockedException instead.  Off by default.  Call
+    * before exe().
+    * @param   enable - const bool
+    */
+   void setFusion( const bool enable );
+
+   /** items the FIFO between two fused stages starts out with **/
+   static constexpr std::size_t fused_capacity = 64;
    
 
 protected:
@@ -174,15 +264,38 @@ protected:
    void checkEdges( kernelkeeper &source_k );
 
    /**
-    * enableDuplication - add split / join kernels where needed, 
-    * for the moment we're going with a simple split/join topology,
-    * however that doesn't mean that more complex topologies might
-    * not be implemented in the future.
+    * enableDuplication - puts a split on every input and a join
+    * on every output of each kernel whose ports are all linked
+    * out of order and marks it dup_enabled for the parallelism
+    * monitor.  Sources are left alone, a copy of one would be a
+    * second stream rather than more capacity.
     * @param    source_k - std::set< raft::kernel* > with sources
     */
    void enableDuplication( kernelkeeper &source, 
                            kernelkeeper &all );
 
+   /**
+    * fuseChains - finds each run of kernels a -> b -> c where
+    * every link is a's only output to b's only input and makes
+    * it one scheduling unit, the scheduler runs a and a runs the
+    * rest, see Schedule::fusedRun.  Links out of order, to a
+    * split or join, through shared memory or external buffers,
+    * or of types the single producer/consumer ring can't hold
+    * are left alone.  Links without a fixed size start out with
+    * fused_capacity.
+    * @param   all - kernelkeeper with every kernel
+    */
+   void fuseChains( kernelkeeper &all );
+
+   /**
+    * fused_link - the port info for k's output if k has exactly
+    * one output going to a kernel with exactly one input and the
+    * link can be fused, nullptr otherwise.
+    * @param   k - raft::kernel * const
+    * @return  PortInfo*
+    */
+   static PortInfo* fused_link( raft::kernel * const k );
+
 
    /** 
     * TODO, refactor basic_parallel base class to match the
@@ -198,6 +311,19 @@ private:
     using up_group_t = std::unique_ptr< group_t >;
     using kernels_t = std::vector< up_group_t >;
 
+    /** applied by the allocator to ports without their own strategy **/
+    raft::wait::strategy wait_strategy = raft::wait::adaptive;
+    /** applied by the allocator to all resizeable FIFOs **/
+    std::size_t          max_bytes     = 0;
+    /** where graph profiles are kept, empty if not profiling **/
+    std::string          profile_dir   = "";
+    /** window of the scheduler's re-pinning monitor, zero for off **/
+    std::chrono::milliseconds repin_window = std::chrono::milliseconds( 1000 );
+    /** most copies of a duplicable kernel, one turns it off **/
+    std::size_t          max_replicas  = 1;
+    /** run single port chains on one thread, see fuseChains **/
+    bool                 fusion        = false;
+
     /**
      * inline_cont - takes care of >> syntax, even
      * multiple ones.
@@ -226,6 +226,40 @@ public:
       set_order< t >( port_info_a, port_info_b ); 
       return( kernel_pair_t( a, b ) );
    }
+
+   /**
+    * link_shm - links output port a_port of kernel a to the
+    * shared memory edge named edge.  Another process links an
+    * input port to the same name with the overload below, the
+    * two ends may be set up and executed in either order.  The
+    * buffer is never resized, buffer sets its size in items,
+    * whichever process attaches first decides.  Only trivially
+    * copyable types that fit in a cache line may cross.
+    * @param   a      - raft::kernel*, producer in this process
+    * @param   a_port - const std::string, output port name
+    * @param   edge   - const std::string, name shared by both maps
+    * @param   buffer - const std::size_t, items, 0 for the default
+    * @throws  PortNotFoundException - a has no output a_port
+    * @throws  PortTypeException - type can't cross processes
+    * @throws  PortDoubleInitializeException - port already linked
+    */
+   void link_shm( raft::kernel *a,
+                  const std::string a_port,
+                  const std::string edge,
+                  const std::size_t buffer = 0 );
+
+   /**
+    * link_shm - links input port b_port of kernel b to the
+    * shared memory edge named edge, see above.
+    * @param   edge   - const std::string, name shared by both maps
+    * @param   b      - raft::kernel*, consumer in this process
+    * @param   b_port - const std::string, input port name
+    * @param   buffer - const std::size_t, items, 0 for the default
+    */
+   void link_shm( const std::string edge,
+                  raft::kernel *b,
+                  const std::string b_port,
+                  const std::size_t buffer = 0 );
    
 
 
@@ -252,6 +286,19 @@ protected:
                        raft::kernel *b,  PortInfo &b_in,
                        raft::kernel *i );
 
+   /**
+    * join_shm - marks the port as one end of a shared memory
+    * edge, the allocator builds its FIFO.
+    * @param k      - raft::kernel&
+    * @param info   - PortInfo for the port on kernel k
+    * @param edge   - edge name
+    * @param buffer - items, 0 for the default
+    * @throws PortTypeException, PortDoubleInitializeException
+    */
+   static void join_shm( raft::kernel &k, PortInfo &info,
+                         const std::string &edge,
+                         const std::size_t buffer );
+
    /** 
     * set_order - keep redundant code, well, less redundant. 
     * This version handles the in-order settings.
@@ -0,0 +1,192 @@
+/**
+ * mmapreader.tcc - reads a file by mapping it rather than copying
+ * it into chunks.  Each item sent is a fileview, a pointer to
+ * chunk_size bytes of the mapping with its offset in the file, so
+ * nothing is copied on the way to the kernels that read it.  Like
+ * filereader each view after the first starts overlap bytes before
+ * the end of the one before, for a search use the term length
+ * minus one.  Views are dealt over the output ports in turn.
+ *
+ * The mapping stays till the reader is destroyed, views must not
+ * be kept past that.
+ *
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 03:22:47 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _MMAPREADER_TCC_
+#define _MMAPREADER_TCC_  1
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <ostream>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <raft>
+#include "chunkiterator.tcc"
+#include "defs.hpp"
+
+namespace raft
+{
+
+/** fileview - length bytes of a mapped file, starting start_position in **/
+struct fileview
+{
+   const char    *buffer           = nullptr;
+   std::size_t    length           = 0;
+   std::size_t    start_position   = 0;
+   std::uint64_t  index            = 0;
+
+   basic_chunk_iterator< fileview > begin() noexcept
+   {
+      return( basic_chunk_iterator< fileview >( this ) );
+   }
+
+   basic_chunk_iterator< fileview > end() noexcept
+   {
+      return( basic_chunk_iterator< fileview >( this, length ) );
+   }
+
+   inline char operator []( const std::size_t n ) const
+   {
+      assert( n < length );
+      return( buffer[ n ] );
+   }
+
+   friend std::ostream& operator <<( std::ostream &output, const fileview &v )
+   {
+      output.write( v.buffer, v.length );
+      return( output );
+   }
+};
+
+class mmap_reader : public raft::kernel
+{
+public:
+   /**
+    * mmap_reader - maps inputfile, exits if it can't.
+    * @param   inputfile      - file to read
+    * @param   chunk_size     - bytes per view
+    * @param   overlap        - bytes each view shares with the one before
+    * @param   n_output_ports - ports named "0" on up
+    * @param   sequential     - tell the OS the file is read front to back
+    */
+   mmap_reader( const std::string  inputfile,
+                const std::size_t  chunk_size     = 1 << 20,
+                const std::size_t  overlap        = 0,
+                const std::size_t  n_output_ports = 1,
+                const bool         sequential     = true ) : raft::kernel(),
+                                                             chunk_size( chunk_size ),
+                                                             stride( chunk_size - overlap )
+   {
+      if( chunk_size == 0 || overlap >= chunk_size )
+      {
+         std::cerr << "mmap_reader: overlap (" << overlap <<
+            ") has to be less than the chunk size (" << chunk_size << "), exiting\n";
+         exit( EXIT_FAILURE );
+      }
+      for( std::size_t index( 0 ); index < n_output_ports; index++ )
+      {
+         output.addPort< fileview >( std::to_string( index ) );
+      }
+      const auto fd( open( inputfile.c_str(), O_RDONLY ) );
+      if( fd < 0 )
+      {
+         perror( "Failed to open input file, exiting!" );
+         exit( EXIT_FAILURE );
+      }
+      struct stat st;
+      if( fstat( fd, &st ) != 0 )
+      {
+         perror( "Failed to stat input file, exiting!" );
+         exit( EXIT_FAILURE );
+      }
+      length = static_cast< std::size_t >( st.st_size );
+      /** nothing to map, run() stops straight away **/
+      if( length > 0 )
+      {
+         auto * const ptr( mmap( nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0 ) );
+         if( ptr == MAP_FAILED )
+         {
+            perror( "Failed to map input file, exiting!" );
+            exit( EXIT_FAILURE );
+         }
+         base = reinterpret_cast< const char* >( ptr );
+#ifdef MADV_SEQUENTIAL
+         if( sequential )
+         {
+            /** only advice, fine if it's ignored **/
+            madvise( ptr, length, MADV_SEQUENTIAL );
+         }
+#else
+         UNUSED( sequential );
+#endif
+      }
+      /** the mapping keeps its own reference to the file **/
+      close( fd );
+   }
+
+   virtual ~mmap_reader()
+   {
+      if( base != nullptr )
+      {
+         munmap( const_cast< char* >( base ), length );
+      }
+   }
+
+   virtual raft::kstatus run()
+   {
+      for( auto &port : output )
+      {
+         if( position >= length )
+         {
+            return( raft::stop );
+         }
+         if( ! port.space_avail() )
+         {
+            continue;
+         }
+         auto &view( port.template allocate< fileview >() );
+         view.buffer         = base + position;
+         view.length         = std::min( chunk_size, length - position );
+         view.start_position = position;
+         view.index          = view_index++;
+         const bool last( position + view.length >= length );
+         position = ( last ? length : position + stride );
+         port.send( last ? raft::eof : raft::none );
+      }
+      return( position >= length ? raft::stop : raft::proceed );
+   }
+
+private:
+   const char        *base       = nullptr;
+   std::size_t        length     = 0;
+   const std::size_t  chunk_size;
+   /** distance between the starts of two views **/
+   const std::size_t  stride;
+   std::size_t        position   = 0;
+   std::uint64_t      view_index = 0;
+};
+
+} /* end namespace raft */
+#endif /* END _MMAPREADER_TCC_ */
@@ -0,0 +1,115 @@
+/**
+ * pagealloc.hpp - page level allocation for FIFO stores that ask
+ * for huge pages or for a particular NUMA node.  The options are
+ * set per port and handed to Buffer::Data by the FIFO, which uses
+ * page_alloc instead of the heap whenever any are set.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 19:02:17 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _PAGEALLOC_HPP_
+#define _PAGEALLOC_HPP_  1
+#include <cstddef>
+#include <cstdint>
+
+#include "defs.hpp"
+
+namespace raft
+{
+namespace mem
+{
+/**
+ * pages - normal - whatever the allocator hands back
+ *         huge   - huge pages, reserved ones (MAP_HUGETLB) if the
+ *                  system has any, otherwise transparent huge pages
+ *                  through madvise, otherwise normal pages.  Stores
+ *                  smaller than one huge page always use normal
+ *                  pages.
+ */
+enum pages : std::uint8_t { normal = 0,
+                            huge };
+
+/**
+ * placement - anywhere    - wherever the OS puts it, usually the node
+ *                           of the producer since it writes first
+ *             first_touch - the pages are faulted in by a thread
+ *                           pinned to the consumer's core
+ *             bind        - mbind to the node of the consumer's core,
+ *                           falls back to first_touch if the kernel
+ *                           won't let us
+ * Both need the consumer's core from the partitioner, if it
+ * hasn't assigned one the store is placed anywhere.
+ */
+enum placement : std::uint8_t { anywhere = 0,
+                                first_touch,
+                                bind };
+
+struct options
+{
+   options() = default;
+
+   options( const pages page,
+            const placement place ) : page( page ),
+                                      place( place ){}
+
+   /** true if anything other than a plain heap allocation is wanted **/
+   bool custom() const noexcept
+   {
+      return( page != normal || place != anywhere );
+   }
+
+   pages      page  = normal;
+   placement  place = anywhere;
+   /** consumer's core, filled in by the allocator, -1 if unknown **/
+   core_id_t  core  = -1;
+};
+
+} /** end namespace mem **/
+} /** end namespace raft **/
+
+struct page_alloc
+{
+   /**
+    * allocate - maps zeroed, page aligned memory for at least
+    * length bytes, placed as asked for in opts.  Exits if the
+    * memory can't be had at all, same as the heap path.
+    * @param   length - bytes wanted
+    * @param   opts   - const raft::mem::options&
+    * @return  void*, free with release using the same arguments
+    */
+   static void* allocate( const std::size_t length,
+                          const raft::mem::options &opts );
+
+   /**
+    * release - unmaps memory from allocate.
+    * @param   ptr    - from allocate
+    * @param   length - same length passed to allocate
+    * @param   opts   - same options passed to allocate
+    */
+   static void  release( void * const ptr,
+                         const std::size_t length,
+                         const raft::mem::options &opts );
+
+   /**
+    * node_of - NUMA node the core belongs to.
+    * @param   core - core_id_t
+    * @return  node, -1 if unknown or the system isn't NUMA
+    */
+   static int   node_of( const core_id_t core );
+};
+
+#endif /* END _PAGEALLOC_HPP_ */
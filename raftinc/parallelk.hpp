@@ -27,6 +27,7 @@
 #include <cstddef>
 
 class Schedule;
+class FIFO;
 
 namespace raft
 {
@@ -58,6 +59,13 @@ protected:
 
    void unlock_helper( Port &port );
 
+   /**
+    * idle_wait - waits on fifo per its wait strategy, for a
+    * kernel that can't go on until more data comes in there.
+    * @param   spins - times in a row it couldn't go on
+    */
+   static void idle_wait( FIFO &fifo, const std::size_t spins );
+
    std::size_t  port_name_index = 0; 
    friend class ::Schedule;
    friend class map;
@@ -0,0 +1,52 @@
+/**
+ * partition_affinity.hpp - pins kernels to cores without Scotch.
+ * Kernels are taken in breadth first order from the sources, each
+ * one goes to the last level cache already holding most of the
+ * kernels it talks to (by measured traffic if there's a profile),
+ * then to the least used core within it, physical cores before
+ * SMT siblings.  Only cores in the process's affinity mask are
+ * used, see cputopology.hpp.
+ *
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 00:21:09 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _PARTITION_AFFINITY_HPP_
+#define _PARTITION_AFFINITY_HPP_  1
+#include "interface_partition.hpp"
+#include "cputopology.hpp"
+
+class partition_affinity : public interface_partition
+{
+public:
+    partition_affinity() = default;
+    virtual ~partition_affinity() = default;
+
+    /**
+     * partition - places the kernels on the cores of this
+     * machine that the process may use.
+     * @param kernels - kernelkeeper&
+     */
+    virtual void partition( kernelkeeper &kernels );
+
+    /**
+     * place - partition, but onto the given topology.
+     * @param kernels  - kernelkeeper&
+     * @param topology - const cpu_topology&
+     */
+    void place( kernelkeeper &kernels, const cpu_topology &topology );
+};
+#endif /* END _PARTITION_AFFINITY_HPP_ */
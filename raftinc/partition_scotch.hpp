@@ -29,6 +29,7 @@
 #include "graph.tcc"
 #include "port_info.hpp"
 #include "interface_partition.hpp"
+#include "graphprofile.hpp"
 
 class partition_scotch : public interface_partition
 {
@@ -50,6 +51,21 @@ private:
                         weight_function_t   weight_func,
                         void                *weight_data );
    
+   /** measured weights are scaled to 1..1+weight_scale **/
+   static constexpr double weight_scale = 1000.0;
+
+   /**
+    * loaded_profile - the profile as weight data for
+    * run_scotch, null unless an earlier run is on file.
+    */
+   void* loaded_profile() const noexcept;
+
+   /**
+    * edge_weight - weight for the edge leaving src, from the
+    * graph_profile in weight_data, 1 if there is none.
+    */
+   static weight_t edge_weight( PortInfo &src, void *weight_data );
+
    void  
    simple( container_type    &c, 
            const core_id_t   cores );
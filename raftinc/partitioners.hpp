@@ -25,6 +25,7 @@
  * some of the necessary bits to conditionally compile
  */
 #include "partition_basic.hpp"
+#include "partition_affinity.hpp"
 #if USE_PARTITION
 #include "partition_scotch.hpp"
 #endif
@@ -39,10 +39,13 @@
 #include "portmap_t.hpp"
 #include "portiterator.hpp"
 #include "portexception.hpp"
+#include "porthandle.tcc"
+#include "typedfifo.tcc"
 #include "defs.hpp"
 
 /** needed for friending below **/
 class MapBase;
+class Allocate;
 class roundrobin;
 class basic_parallel;
 /** need to pre-declare this **/
@@ -51,6 +54,7 @@ namespace raft
    class map;
    class kernel;
    class parallel_k;
+   class graph_profile;
    template < class T, class method > class join;
    template < class T, class method > class split;
 }
@@ -205,6 +209,87 @@ public:
     */
    virtual FIFO& operator[]( const std::string &&port_name );
 
+   /**
+    * handle - looks up the named port once so that run() doesn't
+    * have to, see porthandle.tcc.  Call from the kernel's
+    * constructor, after the port has been added.
+    * @param   port_name - const std::string
+    * @return  raft::port_handle< T >
+    * @throws  PortNotFoundException
+    * @throws  PortTypeMismatchException - port doesn't carry T
+    */
+   template < class T >
+   raft::port_handle< T > handle( const std::string &&port_name )
+   {
+      auto &pi( getPortInfoFor( port_name ) );
+      if( pi.type != std::type_index( typeid( T ) ) )
+      {
+         throw PortTypeMismatchException( "Port \"" + port_name +
+            "\" doesn't carry the type asked for by handle" );
+      }
+      return( raft::port_handle< T >( &pi ) );
+   }
+
+   /**
+    * typed - like handle, but push, pop and peek call the ring
+    * directly when the edge's FIFO is the kind given by type,
+    * see typedfifo.tcc.
+    * @param   port_name - const std::string
+    * @return  TypedFIFO< T, type >
+    * @throws  PortNotFoundException
+    * @throws  PortTypeMismatchException - port doesn't carry T
+    */
+   template < class T, Type::RingBufferType type = Type::Heap >
+   TypedFIFO< T, type > typed( const std::string &&port_name )
+   {
+      auto &pi( getPortInfoFor( port_name ) );
+      if( pi.type != std::type_index( typeid( T ) ) )
+      {
+         throw PortTypeMismatchException( "Port \"" + port_name +
+            "\" doesn't carry the type asked for by typed" );
+      }
+      return( TypedFIFO< T, type >( &pi ) );
+   }
+
+   /**
+    * setWaitStrategy - sets what the FIFO attached to the named
+    * port does when it is full (output port) or empty (input port).
+    * Call before the map is executed, overrides the strategy set
+    * on the map for this edge.
+    * @param   port_name - const std::string
+    * @param   strategy  - raft::wait::strategy
+    * @throws  PortNotFoundException
+    */
+   void setWaitStrategy( const std::string &&port_name,
+                         const raft::wait::strategy strategy );
+
+   /**
+    * setMemoryCap - limits how large the allocator may grow the
+    * FIFO attached to the named port, in bytes.  Call before the
+    * map is executed, if both ends of an edge set a cap the
+    * smaller one wins.
+    * @param   port_name - const std::string
+    * @param   bytes     - const std::size_t, zero for no cap
+    * @throws  PortNotFoundException
+    */
+   void setMemoryCap( const std::string &&port_name,
+                      const std::size_t bytes );
+
+   /**
+    * setMemoryOptions - asks for huge pages and/or NUMA placement
+    * for the FIFO attached to the named port, see pagealloc.hpp.
+    * Placement is relative to the core the partitioner gives the
+    * consuming kernel.  Call before the map is executed, if both
+    * ends of an edge set options the output port's win.
+    * @param   port_name - const std::string
+    * @param   page      - raft::mem::pages
+    * @param   place     - raft::mem::placement
+    * @throws  PortNotFoundException
+    */
+   void setMemoryOptions( const std::string &&port_name,
+                          const raft::mem::pages page,
+                          const raft::mem::placement place = raft::mem::anywhere );
+
 
    /**
     * hasPorts - returns true if any ports exists, false
@@ -252,6 +337,7 @@ public:
       PortInfo pi( typeid( T ) );
       pi.my_kernel = kernel;
       pi.my_name   = port_name;
+      pi.item_size = sizeof( T );
       (this)->initializeConstMap<T>( pi );
       (this)->initializeSplit< T >( pi );
       (this)->initializeJoin< T >( pi );
@@ -288,10 +374,9 @@ protected:
          std::make_pair( true /** yes instrumentation **/,
                          RingBuffer< T, Type::Heap, true >::make_new_fifo ) );
 
-      //pi.const_map.insert( std::make_pair( Type::SharedMemory, new instr_map_t() ) );
-      //pi.const_map[ Type::SharedMemory ]->insert(
-      //   std::make_pair( false /** no instrumentation **/,
-      //                   RingBuffer< T, Type::SharedMemory >::make_new_fifo ) );
+      (this)->initializeSPSC< T >( pi );
+      (this)->initializeSHM< T >( pi );
+
       /**
        * NOTE: If you define more port resource types, they have
        * to be defined here...otherwise the allocator won't be
@@ -301,6 +386,60 @@ protected:
       return;
    }
 
+   /**
+    * initializeSPSC - the non-resizeable single producer/consumer
+    * heap only handles inline allocated types (see spsc_alloc), so
+    * only add a builder for those.  Allocate::allocate picks it up for edges
+    * with a fixed buffer size.
+    * @param   pi - PortInfo&
+    */
+   template < class T,
+              typename std::enable_if< spsc_alloc< T >::value >::type* = nullptr >
+   void initializeSPSC( PortInfo &pi )
+   {
+      pi.const_map.insert(
+         std::make_pair( Type::HeapSPSC, new instr_map_t() ) );
+      pi.const_map[ Type::HeapSPSC ]->insert(
+         std::make_pair( false /** no instrumentation **/,
+                         RingBuffer< T, Type::HeapSPSC, false >::make_new_fifo ) );
+      return;
+   }
+
+   template < class T,
+              typename std::enable_if< ! spsc_alloc< T >::value >::type* = nullptr >
+   void initializeSPSC( PortInfo &pi )
+   {
+      UNUSED( pi );
+      return;
+   }
+
+   /**
+    * initializeSHM - only types that mean the same thing in
+    * another process can cross a shared memory edge, the
+    * builder is left out for the rest so raft::map::link_shm
+    * can refuse them.
+    * @param   pi - PortInfo&
+    */
+   template < class T,
+              typename std::enable_if< shm_alloc< T >::value >::type* = nullptr >
+   void initializeSHM( PortInfo &pi )
+   {
+      pi.const_map.insert(
+         std::make_pair( Type::SharedMemory, new instr_map_t() ) );
+      pi.const_map[ Type::SharedMemory ]->insert(
+         std::make_pair( false /** no instrumentation **/,
+                         RingBuffer< T, Type::SharedMemory, false >::make_new_fifo ) );
+      return;
+   }
+
+   template < class T,
+              typename std::enable_if< ! shm_alloc< T >::value >::type* = nullptr >
+   void initializeSHM( PortInfo &pi )
+   {
+      UNUSED( pi );
+      return;
+   }
+
    /**
     * initializeSplit - pre-allocate split kernels...saves
     * allocation time later, then all that is needed is to
@@ -381,6 +520,8 @@ protected:
    friend class GraphTools;
    friend class basic_parallel;
    friend class raft::parallel_k;
+   friend class raft::graph_profile;
+   friend class Allocate;
 };
 
 
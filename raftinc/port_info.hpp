@@ -61,7 +61,20 @@ struct PortInfo
     * until the FIFO is fully emptied.
     * @return FIFO*
     */
-   FIFO* getFIFO();
+   inline FIFO* getFIFO()
+   {
+      struct{
+         FIFO *a;
+         FIFO *b;
+      }copy = { fifo_a, fifo_b };
+      /** for most architectures that don't need this, it'll be optimized out after the first iteration **/
+      while( copy.a != copy.b )
+      {
+         copy.a = fifo_a;
+         copy.b = fifo_b;
+      }
+      return( copy.a );
+   }
 
    /**
     * setFIFO - call this funciton to set a FIFO, updates both
@@ -111,5 +124,16 @@ struct PortInfo
    std::size_t       nitems          = 0;
    std::size_t       start_index     = 0;
    std::size_t       fixed_buffer_size = 0;   
+   raft::wait::strategy wait_strategy = raft::wait::use_default;
+   /** sizeof the port type, used to account for buffer memory **/
+   std::size_t       item_size         = 0;
+   /** cap on the bytes the allocator may give this edge, 0 for none **/
+   std::size_t       max_bytes         = 0;
+   /** huge pages and NUMA placement for this edge's stores **/
+   raft::mem::options mem_options;
+   /** edge name if mem is SHM, see raft::map::link_shm **/
+   std::string       shm_name          = "";
+   /** both ends run on one thread, see raft::map::fuseChains **/
+   bool              fused             = false;
 };
 #endif /* END _PORT_INFO_HPP_ */
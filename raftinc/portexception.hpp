@@ -76,4 +76,11 @@ class PortAlreadyExists : public PortException
 public:
    PortAlreadyExists( const std::string message );
 };
+
+/** a fused stage would wait on the stage at the other end, which runs on its thread **/
+class FusedStageBlockedException : public PortException
+{
+public:
+   FusedStageBlockedException( const std::string message );
+};
 #endif /* END _PORTEXCEPTION_HPP_ */
@@ -0,0 +1,154 @@
+/**
+ * porthandle.tcc - a port looked up once, by name, when the kernel
+ * is built, instead of on every call to run().  input[ "0" ] makes
+ * a std::string and searches the port map each time, a handle
+ * keeps where the port lives and goes straight to its FIFO:
+ *
+ *    in = input.handle< T >( "0" );   //constructor, after addPort
+ *    ...
+ *    auto &val( in.peek() );          //run()
+ *    in.recycle();
+ *
+ * The handle knows the item type, so no template arguments on the
+ * calls either.  The FIFO is fetched on each use since the map
+ * doesn't hand one out until it executes.  Handles belong to the
+ * kernel that made them, a copied kernel has to make its own.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 23:02:47 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _PORTHANDLE_TCC_
+#define _PORTHANDLE_TCC_  1
+#include <cassert>
+#include <cstddef>
+#include <utility>
+
+#include "fifo.hpp"
+#include "port_info.hpp"
+#include "signal.hpp"
+
+class Port;
+
+namespace raft
+{
+
+template < class T > class port_handle
+{
+public:
+   /** not bound to a port, get one from Port::handle **/
+   port_handle() = default;
+
+   /**
+    * fifo - the FIFO for the port, for anything not wrapped
+    * below.  Only valid once the map is executing.
+    * @return  FIFO&
+    */
+   FIFO& fifo() const
+   {
+      assert( info != nullptr );
+      auto * const f( info->getFIFO() );
+      assert( f != nullptr );
+      return( *f );
+   }
+
+   FIFO& operator *() const
+   {
+      return( fifo() );
+   }
+
+   FIFO* operator ->() const
+   {
+      return( &fifo() );
+   }
+
+   /** true if bound to a port **/
+   explicit operator bool() const noexcept
+   {
+      return( info != nullptr );
+   }
+
+   std::size_t size() const
+   {
+      return( fifo().size() );
+   }
+
+   template < class... Args >
+   T& allocate( Args&&... params ) const
+   {
+      return( fifo().template allocate< T >( std::forward< Args >( params )... ) );
+   }
+
+   void send( const raft::signal signal = raft::none ) const
+   {
+      fifo().send( signal );
+   }
+
+   void deallocate() const
+   {
+      fifo().deallocate();
+   }
+
+   void push( const T &item, const raft::signal signal = raft::none ) const
+   {
+      fifo().push( item, signal );
+   }
+
+   template < class iterator_type >
+   void insert( iterator_type begin,
+                iterator_type end,
+                const raft::signal signal = raft::none ) const
+   {
+      fifo().insert( begin, end, signal );
+   }
+
+   void pop( T &item, raft::signal *signal = nullptr ) const
+   {
+      fifo().pop( item, signal );
+   }
+
+   T& peek( raft::signal *signal = nullptr ) const
+   {
+      return( fifo().template peek< T >( signal ) );
+   }
+
+   /** autorelease< T, peekrange >, see FIFO::peek_range **/
+   auto peek_range( const std::size_t n ) const
+   {
+      return( fifo().template peek_range< T >( n ) );
+   }
+
+   void unpeek() const
+   {
+      fifo().unpeek();
+   }
+
+   void recycle( const std::size_t range = 1 ) const
+   {
+      fifo().recycle( range );
+   }
+
+private:
+   explicit port_handle( PortInfo * const info ) : info( info ){}
+
+   PortInfo *info = nullptr;
+
+   friend class ::Port;
+};
+
+} /** end namespace raft **/
+
+#endif /* END _PORTHANDLE_TCC_ */
@@ -0,0 +1,54 @@
+/**
+ * poweroftwo.hpp - power of two choices.  Each selection looks at
+ * two ports picked at random and takes the less full one to send
+ * to (the more full one to read from), nearly as balanced as
+ * looking at all of them for a wide split at a fraction of the
+ * cost.  Falls back to a scan when neither port is ready.
+ *
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 02:06:44 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _POWEROFTWO_HPP_
+#define _POWEROFTWO_HPP_  1
+#include <cstdint>
+
+#include "fifo.hpp"
+#include "port.hpp"
+#include "splitmethod.hpp"
+
+class poweroftwo : public splitmethod
+{
+public:
+   poweroftwo();
+   virtual ~poweroftwo();
+
+protected:
+   virtual FIFO*  select_fifo( Port &port_list, const functype type );
+
+   /** xorshift, quality doesn't matter much here, speed does **/
+   inline std::uint64_t random() noexcept
+   {
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      return( state );
+   }
+
+   std::uint64_t state;
+   std::size_t   next = 0;
+};
+#endif /* END _POWEROFTWO_HPP_ */
@@ -0,0 +1,203 @@
+/**
+ * preadreader.tcc - reads a file from as many threads as there are
+ * copies of the reader.  filereader deals chunks from one FILE*
+ * over its ports, so more ports only means more fan-out; here each
+ * copy of the kernel (one per join port with "reader >= join", or
+ * one per chain with "( reader >> work ) >= join") owns its own
+ * contiguous run of chunks and reads it with pread on its own
+ * descriptor, no seek position is shared.
+ *
+ * Chunks are laid out just as filereader lays them out, chunk_offset
+ * works the same way and chunk.index is the chunk's place in the
+ * whole file, so the chunks the copies send can be put back in
+ * order (see reorder_join).  Which copy gets which run is decided
+ * on each copy's first run(), once the map has made all of them.
+ *
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 03:47:19 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _PREADREADER_TCC_
+#define _PREADREADER_TCC_  1
+#include <atomic>
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <raft>
+#include "fileio.tcc"
+
+namespace raft
+{
+
+template < class chunktype = filechunk< 65536 > >
+class pread_reader : public raft::kernel
+{
+public:
+   /**
+    * pread_reader - opens inputfile, exits if it can't.
+    * @param   inputfile    - file to read
+    * @param   chunk_offset - as for filereader, chunks after the
+    *                         first start chunk_offset - 1 bytes
+    *                         before the end of the one before
+    */
+   pread_reader( const std::string inputfile,
+                 const long        chunk_offset = 0 ) :
+      raft::kernel(),
+      inputfile( inputfile ),
+      stride( ( chunktype::getChunkSize() - 1 ) -
+              ( chunk_offset > 0 ? chunk_offset - 1 : 0 ) ),
+      shared( std::make_shared< parts_t >() )
+   {
+      if( chunk_offset < 0 ||
+          static_cast< std::size_t >( chunk_offset ) >= chunktype::getChunkSize() )
+      {
+         std::cerr << "pread_reader: chunk_offset (" << chunk_offset <<
+            ") has to be less than the chunk size (" <<
+               chunktype::getChunkSize() << "), exiting\n";
+         exit( EXIT_FAILURE );
+      }
+      output.addPort< chunktype >( "0" );
+      (this)->open_file();
+      const auto bytes( (this)->length );
+      const auto read_size( chunktype::getChunkSize() - 1 );
+      shared->chunks = ( bytes == 0 ? 0 :
+         1 + ( bytes > read_size ?
+               ( bytes - read_size + stride - 1 ) / stride : 0 ) );
+   }
+
+   /**
+    * copies share the parts with the kernel they're copied from,
+    * every copy made is one more part for the file to be cut in.
+    */
+   pread_reader( const pread_reader &other ) : raft::kernel(),
+                                               inputfile( other.inputfile ),
+                                               stride( other.stride ),
+                                               shared( other.shared )
+   {
+      output.addPort< chunktype >( "0" );
+      (this)->open_file();
+      shared->instances++;
+   }
+
+   virtual ~pread_reader()
+   {
+      if( fd >= 0 )
+      {
+         close( fd );
+      }
+   }
+
+   CLONE();
+
+   virtual raft::kstatus run()
+   {
+      if( ! claimed )
+      {
+         /** every copy exists by now, the map made them before exe() ran us **/
+         const std::uint64_t part( shared->next_part++ );
+         const std::uint64_t parts( shared->instances.load() );
+         next = shared->chunks * part / parts;
+         last = shared->chunks * ( part + 1 ) / parts;
+         claimed = true;
+      }
+      if( next >= last )
+      {
+         return( raft::stop );
+      }
+      auto &chunk( output[ "0" ].template allocate< chunktype >() );
+      const std::size_t position( next * stride );
+      const std::size_t want(
+         std::min( chunktype::getChunkSize() - 1, length - position ) );
+      std::size_t num_read( 0 );
+      while( num_read < want )
+      {
+         const auto ret( pread( fd,
+                                chunk.buffer + num_read,
+                                want - num_read,
+                                static_cast< off_t >( position + num_read ) ) );
+         if( ret < 0 && errno == EINTR )
+         {
+            continue;
+         }
+         if( ret <= 0 )
+         {
+            perror( "Failed to read input file, exiting!" );
+            exit( EXIT_FAILURE );
+         }
+         num_read += static_cast< std::size_t >( ret );
+      }
+      chunk.buffer[ num_read ] = '\0';
+      chunk.length = num_read;
+      chunk.start_position = position;
+      chunk.index = next;
+      next++;
+      output[ "0" ].send( next == last ? raft::eof : raft::none );
+      return( next == last ? raft::stop : raft::proceed );
+   }
+
+private:
+   /** shared by a reader and all of its copies **/
+   struct parts_t
+   {
+      std::uint64_t                chunks      = 0;
+      std::atomic< std::uint64_t > instances   = { 1 };
+      std::atomic< std::uint64_t > next_part   = { 0 };
+   };
+
+   void open_file()
+   {
+      fd = open( inputfile.c_str(), O_RDONLY );
+      if( fd < 0 )
+      {
+         perror( "Failed to open input file, exiting!" );
+         exit( EXIT_FAILURE );
+      }
+      struct stat st;
+      if( fstat( fd, &st ) != 0 )
+      {
+         perror( "Failed to stat input file, exiting!" );
+         exit( EXIT_FAILURE );
+      }
+      length = static_cast< std::size_t >( st.st_size );
+#ifdef POSIX_FADV_SEQUENTIAL
+      /** only advice, each copy reads its own run front to back **/
+      posix_fadvise( fd, 0, 0, POSIX_FADV_SEQUENTIAL );
+#endif
+   }
+
+   const std::string           inputfile;
+   /** distance between the starts of two chunks **/
+   const std::size_t           stride;
+   std::shared_ptr< parts_t >  shared;
+   int                         fd       = -1;
+   std::size_t                 length   = 0;
+   bool                        claimed  = false;
+   /** this copy's chunks, [ next, last ) **/
+   std::uint64_t               next     = 0;
+   std::uint64_t               last     = 0;
+};
+
+} /* end namespace raft */
+#endif /* END _PREADREADER_TCC_ */
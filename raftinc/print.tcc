@@ -20,32 +20,66 @@
 #ifndef _PRINT_TCC_
 #define _PRINT_TCC_  1
 
+#include <clocale>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <functional>
-#include <ostream>
 #include <iostream>
-#include <raft>
-#include <cstdlib>
+#include <limits>
+#include <locale>
 #include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <raft>
+#include "defs.hpp"
 
 namespace raft{
 
+/**
+ * print_as_integer - integer types ostream prints as numbers,
+ * i.e., not bool and not the character types.
+ */
+template < class T > struct print_as_integer : std::integral_constant< bool,
+   std::is_integral< T >::value &&
+   ! std::is_same< T, bool >::value &&
+   ! std::is_same< T, char >::value &&
+   ! std::is_same< T, signed char >::value &&
+   ! std::is_same< T, unsigned char >::value &&
+   ! std::is_same< T, wchar_t >::value &&
+   ! std::is_same< T, char16_t >::value &&
+   ! std::is_same< T, char32_t >::value >{};
+
 class printbase
 {
 protected:
    std::ostream *ofs = nullptr;
-   static std::mutex   print_lock;
+   /**
+    * print_lock - held for each write to the stream, so that
+    * print kernels sharing one only interleave whole flushes.
+    */
+   static std::mutex& print_lock()
+   {
+      static std::mutex lock;
+      return( lock );
+   }
 };
 
-std::mutex printbase::print_lock;
-
 template< typename T > class printabstract : public raft::kernel, 
                                              public raft::printbase
 {
 public:
+   /** bytes formatted before they're written out **/
+   static constexpr std::size_t flush_bytes = 1 << 16;
+
    printabstract( ) : raft::kernel(),
                       raft::printbase()
    {
       input.addPort< T >( "in" );
+      in  = input.handle< T >( "in" );
       ofs = &(std::cout);
    }
    
@@ -53,53 +87,222 @@ public:
                                            raft::printbase()
    {
       input.addPort< T >( "in" );
+      in  = input.handle< T >( "in" );
       ofs = &stream;
    }
-};
 
-template< typename T, char delim = '\0' > class print : public printabstract< T >
-{
-public:
-   print( ) : printabstract< T >()
+   virtual ~printabstract()
    {
+      (this)->flush();
    }
-   
-   print( std::ostream &stream ) : printabstract< T >( stream )
+
+protected:
+   /**
+    * print_all - formats what is waiting on the input when called
+    * into buffer with delim after each item (none if delim is
+    * '\0'), writing the buffer out each time it passes flush_bytes
+    * and once more at the end, since the input may not get any
+    * more.  Only the one batch, whatever comes in meanwhile is for
+    * the next run() so a producer that keeps up can't keep this
+    * one from returning.
+    */
+   void print_all( const char delim )
    {
+      /** the stream's format can change between runs, not within one **/
+      const auto flags( ofs->flags() );
+      const auto precision( ofs->precision() );
+      const auto n( in.size() );
+      if( n > 0 )
+      {
+         /**
+          * digits by hand and snprintf know nothing of the stream's
+          * locale or width, anything but the classic locale with no
+          * width goes through operator << on fmt set up like ofs.
+          */
+         const auto loc( ofs->getloc() );
+         plain = ( loc == std::locale::classic() && ofs->width() == 0 );
+         /** snprintf goes by the C locale (setlocale), not the stream's **/
+         c_point = ( std::strcmp( std::localeconv()->decimal_point, "." ) == 0 );
+         if( fmt.getloc() != loc )
+         {
+            fmt.imbue( loc );
+         }
+         fmt.fill( ofs->fill() );
+         /** like ofs << item, only the first item is padded **/
+         fmt.width( ofs->width() );
+         ofs->width( 0 );
+         fmt.flags( flags );
+         fmt.precision( precision );
+         (this)->take( n, delim, flags, precision );
+      }
+      (this)->flush();
    }
-   
-   print( const print &other ) : print( *other.ofs )
+
+   void flush()
    {
+      if( buffer.empty() )
+      {
+         return;
+      }
+      {
+         std::lock_guard< std::mutex > lg( print_lock() );
+         ofs->write( buffer.data(), buffer.size() );
+      }
+      buffer.clear();
    }
 
-   //FIXME - might need to synchronize streams for users
-   //design point
+   raft::port_handle< T > in;
 
-   /** enable cloning **/
-   CLONE();
+private:
+   /** take - n small items, all at once **/
+   template < class U = T,
+              typename std::enable_if< inline_alloc< U >::value >::type* = nullptr >
+   void take( const std::size_t             n,
+              const char                    delim,
+              const std::ios_base::fmtflags flags,
+              const std::streamsize         precision )
+   {
+      {
+         auto range( in.peek_range( n ) );
+         for( std::size_t i( 0 ); i < n; i++ )
+         {
+            (this)->format( range[ i ].ele, flags, precision );
+            (this)->end_item( delim );
+         }
+      }
+      in.recycle( n );
+   }
 
-   /** 
-    * run - implemented to take a single 
-    * input port, pop the itam and print it.
-    * the output isn't yet synchronized so if
-    * multiple things are printing to std::cout
-    * then there might be issues, otherwise
-    * this works well for debugging and basic 
-    * output.
-    * @return raft::kstatus
-    */
-   virtual raft::kstatus run()
+   /** take - n large items, no peek_range for these **/
+   template < class U = T,
+              typename std::enable_if< ext_alloc< U >::value >::type* = nullptr >
+   void take( std::size_t                   n,
+              const char                    delim,
+              const std::ios_base::fmtflags flags,
+              const std::streamsize         precision )
    {
-      std::lock_guard< std::mutex > lg( print< T, delim >::print_lock );
-      auto &input_port( (this)->input[ "in" ] );
-      auto &data( input_port.template peek< T >() );
-      *((this)->ofs) << data << delim;
-      input_port.unpeek();
-      input_port.recycle( 1 );
-      return( raft::proceed );
+      while( n-- > 0 )
+      {
+         (this)->format( in.peek(), flags, precision );
+         in.unpeek();
+         in.recycle( 1 );
+         (this)->end_item( delim );
+      }
+   }
+
+   void end_item( const char delim )
+   {
+      if( delim != '\0' )
+      {
+         buffer.push_back( delim );
+      }
+      if( buffer.size() >= flush_bytes )
+      {
+         (this)->flush();
+      }
+   }
+
+   /** format - integers, by hand unless the stream wants more than decimal digits **/
+   template < class U,
+              typename std::enable_if< print_as_integer< U >::value >::type* = nullptr >
+   void format( U                             &item,
+                const std::ios_base::fmtflags flags,
+                const std::streamsize         precision )
+   {
+      if( ! plain ||
+          ( flags & ( std::ios_base::basefield & ~std::ios_base::dec ) ) != 0 ||
+          ( flags & std::ios_base::showpos ) != 0 )
+      {
+         (this)->format_stream( item );
+         return;
+      }
+      UNUSED( precision );
+      using unsigned_t = typename std::make_unsigned< U >::type;
+      /** magnitude, without overflow for the most negative value **/
+      unsigned_t value( static_cast< unsigned_t >( item ) );
+      const bool negative( item < U( 0 ) );
+      if( negative )
+      {
+         value = static_cast< unsigned_t >( unsigned_t( 0 ) - value );
+      }
+      char digits[ std::numeric_limits< unsigned_t >::digits10 + 2 ];
+      char *end( digits + sizeof( digits ) ), *p( end );
+      do
+      {
+         *--p = static_cast< char >( '0' + ( value % 10 ) );
+         value /= 10;
+      }while( value != 0 );
+      if( negative )
+      {
+         *--p = '-';
+      }
+      buffer.append( p, end );
    }
+
+   /** format - floating point, as ostream would with no floatfield set **/
+   template < class U,
+              typename std::enable_if< std::is_floating_point< U >::value >::type* = nullptr >
+   void format( U                             &item,
+                const std::ios_base::fmtflags flags,
+                const std::streamsize         precision )
+   {
+      if( ! plain || ! c_point ||
+          ( flags & ( std::ios_base::floatfield |
+                      std::ios_base::showpoint  |
+                      std::ios_base::showpos    |
+                      std::ios_base::uppercase ) ) != 0 )
+      {
+         (this)->format_stream( item );
+         return;
+      }
+      char digits[ 64 ];
+      const int p( static_cast< int >( precision ) );
+      const int length( std::is_same< U, long double >::value ?
+         std::snprintf( digits, sizeof( digits ), "%.*Lg", p,
+                        static_cast< long double >( item ) ) :
+         std::snprintf( digits, sizeof( digits ), "%.*g", p,
+                        static_cast< double >( item ) ) );
+      if( length < 0 || static_cast< std::size_t >( length ) >= sizeof( digits ) )
+      {
+         (this)->format_stream( item );
+         return;
+      }
+      buffer.append( digits, static_cast< std::size_t >( length ) );
+   }
+
+   /** format - anything else goes through operator << **/
+   template < class U,
+              typename std::enable_if< ! print_as_integer< U >::value &&
+                                       ! std::is_floating_point< U >::value >::type* = nullptr >
+   void format( U                             &item,
+                const std::ios_base::fmtflags flags,
+                const std::streamsize         precision )
+   {
+      UNUSED( flags );
+      UNUSED( precision );
+      (this)->format_stream( item );
+   }
+
+   template < class U > void format_stream( U &item )
+   {
+      fmt << item;
+      buffer.append( fmt.str() );
+      fmt.str( "" );
+   }
+
+   /** formatted, not yet written **/
+   std::string          buffer;
+   /** for items that go through operator <<, set up like the stream **/
+   std::ostringstream   fmt;
+   /** the stream has the classic locale and no width, see print_all **/
+   bool                 plain   = true;
+   /** the C locale's decimal point is '.', see print_all **/
+   bool                 c_point = true;
 };
-template< typename T > class print< T, '\0' > : public printabstract< T >
+
+template < typename T > constexpr std::size_t printabstract< T >::flush_bytes;
+
+template< typename T, char delim = '\0' > class print : public printabstract< T >
 {
 public:
    print( ) : printabstract< T >()
@@ -110,33 +313,25 @@ public:
    {
    }
    
-   //FIXME - might need to synchronize streams for users
-   //design point
    print( const print &other ) : print( *other.ofs )
    {
    }
 
+   /** enable cloning **/
    CLONE();
-                                 
 
    /** 
-    * run - implemented to take a single 
-    * input port, pop the itam and print it.
-    * the output isn't yet synchronized so if
-    * multiple things are printing to std::cout
-    * then there might be issues, otherwise
-    * this works well for debugging and basic 
-    * output.
+    * run - implemented to take a single input port, formats
+    * what is on it into a buffer of this kernel's own and
+    * writes that to the stream, holding the stream's lock only
+    * for the write.  Kernels printing to the same stream never
+    * split each other's items, or each other's lines if delim
+    * is '\n'.
     * @return raft::kstatus
     */
    virtual raft::kstatus run()
    {
-      std::lock_guard< std::mutex > lg( print< T, '\0' >::print_lock );
-      auto &input_port( (this)->input[ "in" ] );
-      auto &data( input_port.template peek< T >() );
-      *((this)->ofs) << data;
-      input_port.unpeek();
-      input_port.recycle( 1 );
+      (this)->print_all( delim );
       return( raft::proceed );
    }
 };
@@ -0,0 +1,88 @@
+/**
+ * ptrset.hpp - small open addressed set of pointers, what each
+ * kernel thread uses to remember which externally allocated items
+ * it peeked at and which of those it forwarded, see
+ * Schedule::fifo_gc.  It is filled and emptied on every run of the
+ * kernel so clearing only touches what was put in, and lookups are
+ * a hash and usually a single compare.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 22:31:05 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _PTRSET_HPP_
+#define _PTRSET_HPP_  1
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class ptr_set
+{
+public:
+   ptr_set();
+
+   /**
+    * insert - adds ptr, nothing if already there.  Zero is not
+    * a valid member.
+    * @param   ptr - std::uintptr_t
+    */
+   void insert( const std::uintptr_t ptr );
+
+   bool contains( const std::uintptr_t ptr ) const noexcept
+   {
+      for( auto i( slot( ptr ) ); table[ i ] != 0; i = ( i + 1 ) & mask )
+      {
+         if( table[ i ] == ptr )
+         {
+            return( true );
+         }
+      }
+      return( false );
+   }
+
+   bool empty() const noexcept
+   {
+      return( members.empty() );
+   }
+
+   std::size_t size() const noexcept
+   {
+      return( members.size() );
+   }
+
+   /**
+    * clear - removes everything, keeps the memory for the
+    * next run.
+    */
+   void clear() noexcept;
+
+private:
+   std::size_t slot( const std::uintptr_t ptr ) const noexcept
+   {
+      /** low bits are alignment, multiplicative hash takes the high ones **/
+      return( ( ( ptr >> 4 ) * 0x9e3779b97f4a7c15ULL >> 32 ) & mask );
+   }
+
+   /** doubles the table once half full **/
+   void grow();
+
+   std::vector< std::uintptr_t > table;
+   std::size_t                   mask;
+   /** what's in the table, in the order added **/
+   std::vector< std::uintptr_t > members;
+};
+
+#endif /* END _PTRSET_HPP_ */
@@ -24,6 +24,8 @@
 #include <raft>
 #include <cstddef>
 #include <chrono>
+#include <string>
+#include <vector>
 
 namespace raft
 {
@@ -46,7 +48,7 @@ public:
         for( auto i( 0 ); i < STATICPORT; i++ )
         {
 #endif
-        addPortTo< TYPE >( output );
+        add_output();
 #ifdef STATICPORT
         }
 #endif
@@ -62,7 +64,7 @@ public:
         for( auto i( 0 ); i < STATICPORT; i++ )
         {
 #endif
-        addPortTo< TYPE >( output );
+        add_output();
 #ifdef STATICPORT
         }
 #endif
@@ -75,7 +77,7 @@ public:
 
     virtual raft::kstatus run()
     {
-        for( auto &p : output )
+        for( auto &p : out )
         {
             p.push( dist( gen ) );
             if( ++count_of_sent >= N )
@@ -87,10 +89,18 @@ public:
     }
 
 private:
+    /** add a port and keep a typed view of it for run() **/
+    void add_output()
+    {
+        const auto id( addPortTo< TYPE >( output ) );
+        out.emplace_back( output.typed< TYPE >( std::to_string( id ) ) );
+    }
+
     GENERATOR       gen;
     DIST< TYPE >    dist;
     std::size_t     count_of_sent = 0;
     const std::size_t N;
+    std::vector< TypedFIFO< TYPE > > out;
 };
 
 
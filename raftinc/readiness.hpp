@@ -0,0 +1,214 @@
+/**
+ * readiness.hpp - per kernel bitmap of which input FIFOs hold
+ * data, which are closed and which output FIFOs have room.  The
+ * other end of each FIFO sets our bit on an empty to non-empty
+ * (or full to not-full) transition so that the scheduler can tell
+ * whether a kernel has work without touching every port.
+ *
+ * Bits are only ever cleared by the owning kernel's side, which
+ * re-checks the FIFO afterwards.  The setting side doesn't fence,
+ * so a bit can (rarely) read clear while the FIFO has data, the
+ * scheduler calls the poll functions when a kernel looks idle to
+ * pick those up, the same way a missed futex wake is bounded.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 15:31:08 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _READINESS_HPP_
+#define _READINESS_HPP_  1
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+class FIFO;
+
+/**
+ * ReadyBit - handle on one bit of some kernel's Readiness, held
+ * by the FIFO.  A default constructed ReadyBit is unbound and
+ * every call is a no-op, e.g., for FIFOs built outside a map.
+ */
+class ReadyBit
+{
+public:
+   using word_t = std::uint64_t;
+
+   ReadyBit() = default;
+
+   ReadyBit( std::atomic< word_t > * const word,
+             const word_t mask ) : word( word ),
+                                   mask( mask ){}
+
+   /**
+    * set - only writes the shared word if the bit isn't
+    * already set, which is the common case for a busy edge.
+    */
+   inline void set() noexcept
+   {
+      if( word != nullptr &&
+          ( word->load( std::memory_order_relaxed ) & mask ) == 0 )
+      {
+         word->fetch_or( mask, std::memory_order_release );
+      }
+   }
+
+   /**
+    * clear - owner side only, the caller must re-check the FIFO
+    * after this returns and call set() if it is ready after all.
+    */
+   inline void clear() noexcept
+   {
+      if( word != nullptr &&
+          ( word->load( std::memory_order_relaxed ) & mask ) != 0 )
+      {
+         word->fetch_and( ~mask, std::memory_order_seq_cst );
+      }
+   }
+
+   inline bool is_set() const noexcept
+   {
+      return( word != nullptr &&
+              ( word->load( std::memory_order_acquire ) & mask ) != 0 );
+   }
+
+private:
+   std::atomic< word_t > *word = nullptr;
+   word_t                 mask = 0;
+};
+
+class Readiness
+{
+public:
+   using word_t = ReadyBit::word_t;
+
+   Readiness() = default;
+
+   /**
+    * copy - bits belong to the FIFOs attached to a kernel's
+    * ports, a clone gets new FIFOs so it starts out empty.
+    */
+   Readiness( const Readiness &other );
+
+   virtual ~Readiness();
+
+   /**
+    * add_input - register an input FIFO, data is set whenever
+    * the FIFO goes non-empty and closed once it is invalidated.
+    * Safe to call while the kernel is running.
+    * @param   fifo   - FIFO* attached to the input port
+    * @param   data   - ReadyBit&, set on return
+    * @param   closed - ReadyBit&, set on return
+    */
+   void add_input( FIFO * const fifo,
+                   ReadyBit &data,
+                   ReadyBit &closed );
+
+   /**
+    * add_output - register an output FIFO, the returned bit
+    * is set whenever the FIFO goes from full to not full.
+    * @param   fifo - FIFO* attached to the output port
+    * @return  ReadyBit
+    */
+   ReadyBit add_output( FIFO * const fifo );
+
+   /**
+    * has_input - true if any input FIFO has data, O(1) for
+    * up to 64 input ports.
+    * @return  bool
+    */
+   bool has_input() const noexcept;
+
+   /**
+    * has_output_space - true if no output FIFO has been seen
+    * full since the last pop from it.
+    * @return  bool
+    */
+   bool has_output_space() const noexcept;
+
+   /**
+    * inputs_closed - true if every registered input FIFO has
+    * been invalidated, they may still hold data.
+    * @return  bool
+    */
+   bool inputs_closed() const noexcept;
+
+   /**
+    * refresh_input - call after the kernel has run, clears the
+    * data bit of each input the kernel emptied.  Only looks at
+    * FIFOs whose bit is set.
+    */
+   void refresh_input();
+
+   /**
+    * poll_input - checks every input FIFO and brings the data
+    * bits up to date, for idle paths only.
+    * @return  bool - true if any input FIFO has data
+    */
+   bool poll_input();
+
+   /**
+    * poll_output_space - same as poll_input for the space bits.
+    * @return  bool - true if every output FIFO has room
+    */
+   bool poll_output_space();
+
+private:
+   static constexpr std::size_t word_bits = sizeof( word_t ) * 8;
+
+   /**
+    * block - bits and FIFOs for 64 input and 64 output ports,
+    * blocks are only appended so readers never need the lock.
+    */
+   struct block
+   {
+      std::atomic< word_t >  data     = { 0 };
+      std::atomic< word_t >  closed   = { 0 };
+      std::atomic< word_t >  space    = { 0 };
+      FIFO                  *in[ word_bits ]  = { nullptr };
+      FIFO                  *out[ word_bits ] = { nullptr };
+      std::atomic< block* >  next     = { nullptr };
+   };
+
+   /**
+    * get_block - returns the block holding index, appending
+    * blocks as needed, call with add_mutex held.
+    */
+   block* get_block( const std::size_t index );
+
+   /**
+    * valid - mask of bits in use in block number b given
+    * count ports total.
+    */
+   static inline word_t valid( const std::size_t b,
+                               const std::size_t count ) noexcept
+   {
+      const auto base( b * word_bits );
+      if( count <= base )
+      {
+         return( 0 );
+      }
+      const auto n( count - base );
+      return( n >= word_bits ? ~word_t( 0 ) : ( word_t( 1 ) << n ) - 1 );
+   }
+
+   block                       first;
+   std::atomic< std::size_t >  n_in  = { 0 };
+   std::atomic< std::size_t >  n_out = { 0 };
+   std::mutex                  add_mutex;
+};
+
+#endif /* END _READINESS_HPP_ */
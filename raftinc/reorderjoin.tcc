@@ -0,0 +1,380 @@
+/**
+ * reorderjoin.tcc - a join that puts an out of order parallel
+ * section back in order.  Every item carries a sequence number,
+ * Seq( item ) gives it, the first is first_seq and each one after
+ * is one more.  Items are pulled off the input ports into a
+ * window of ports * depth slots starting at the next number to go
+ * out, the run of numbers from the start of the window goes out as
+ * soon as it is complete.
+ *
+ * An item too far ahead for the window is left on its port.  With
+ * nothing to pull and nothing to send the join waits on one of its
+ * empty inputs, the next number has to come in on one of those.
+ * If every open input is held up by an item too far ahead the
+ * window is too small for the section and a ReorderWindowException
+ * is thrown, raise depth.  Once every input is closed a missing
+ * number is skipped so nothing is held back forever.
+ *
+ * Use with a split (or map::setMaxReplicas) in front:
+ *    m += s <= worker >= raft::reorder_join< chunk_t >( n ) >> out;
+ * Seq is a functor taking const T& and returning std::uint64_t,
+ * by default it reads T's index member (raft::filechunk has one).
+ * T has to be default constructible and movable.
+ *
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 02:31:15 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _REORDERJOIN_TCC_
+#define _REORDERJOIN_TCC_  1
+#include <raft>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "kernelexception.hpp"
+
+namespace raft
+{
+
+/** by_index - the default sequence number, item.index **/
+struct by_index
+{
+   template < class T >
+      std::uint64_t operator()( const T &item ) const
+   {
+      return( static_cast< std::uint64_t >( item.index ) );
+   }
+};
+
+template < class T, class Seq = by_index > class reorder_join : public raft::parallel_k
+{
+public:
+   /**
+    * reorder_join - num_ports is the width of the section feeding
+    * it, the window holds depth items per port.
+    */
+   reorder_join( const std::size_t   num_ports = 1,
+                 const std::size_t   depth     = 4,
+                 const std::uint64_t first_seq = 0 ) : parallel_k(),
+                                                       depth( depth == 0 ? 1 : depth ),
+                                                       next( first_seq )
+   {
+      output.addPort< T >( "0" );
+      out = output.handle< T >( "0" );
+
+      using index_type = std::remove_const_t<decltype(num_ports)>;
+      for( index_type it( 0 ); it < num_ports; it++ )
+      {
+         addPort();
+      }
+   }
+
+   virtual ~reorder_join() = default;
+
+   virtual raft::kstatus run()
+   {
+      FIFO *wait_on( nullptr );
+      /** ports are added while running, see basicparallel.hpp **/
+      lock_helper( input );
+      try
+      {
+         const bool pulled( pull() );
+         collect();
+         if( ! pulled && ready.empty() )
+         {
+            wait_on = stalled();
+         }
+      }
+      catch( ... )
+      {
+         unlock_helper( input );
+         throw;
+      }
+      unlock_helper( input );
+      send_ready();
+      if( wait_on != nullptr )
+      {
+         /** the next number can only come in here or on another empty port **/
+         (this)->idle_wait( *wait_on, idle++ );
+      }
+      else
+      {
+         idle = 0;
+      }
+      /**
+       * the run-time only calls again once something comes in, and
+       * not at all once the inputs are closed and empty.  So while
+       * items are held and every input is empty keep waiting here
+       * till something comes in or every input is closed, then send
+       * what's held.
+       */
+      for( ;; )
+      {
+         lock_helper( input );
+         flush_drained();
+         const bool holding( count > 0 && all_empty() );
+         /** with nothing on any port stalled() can't throw **/
+         wait_on = ( holding ? stalled() : nullptr );
+         unlock_helper( input );
+         send_ready();
+         if( ! holding )
+         {
+            break;
+         }
+         if( wait_on != nullptr )
+         {
+            (this)->idle_wait( *wait_on, idle++ );
+         }
+      }
+      return( raft::proceed );
+   }
+
+   virtual std::size_t  addPort()
+   {
+      const auto id( (this)->addPortTo< T >( input ) );
+      resize( input.count() * depth );
+      return( id );
+   }
+
+protected:
+   virtual void lock()
+   {
+      lock_helper( input );
+   }
+
+   virtual void unlock()
+   {
+      unlock_helper( input );
+   }
+
+   /**
+    * pull - moves every head that fits the window into it
+    * @return  bool - true if anything was moved
+    */
+   bool pull()
+   {
+      bool moved( false );
+      for( auto &port : input )
+      {
+         while( port.size() > 0 )
+         {
+            auto &head( port.template peek< T >() );
+            const auto seq( seq_func( head ) );
+            if( seq < next )
+            {
+               port.unpeek();
+               throw ReorderWindowException( "sequence number " +
+                  std::to_string( seq ) + " seen twice or after it was skipped" );
+            }
+            if( seq - next >= slots.size() )
+            {
+               port.unpeek();
+               break;
+            }
+            const auto i( seq % slots.size() );
+            slots[ i ] = std::move( head );
+            held[ i ]  = true;
+            count++;
+            port.recycle( 1 );
+            moved = true;
+         }
+      }
+      return( moved );
+   }
+
+   /** collect - moves the complete run at the front of the window to ready **/
+   void collect()
+   {
+      for( auto i( next % slots.size() ); held[ i ]; i = next % slots.size() )
+      {
+         ready.emplace_back( std::move( slots[ i ] ) );
+         held[ i ] = false;
+         count--;
+         next++;
+      }
+   }
+
+   /**
+    * stalled - nothing moved and nothing to send, finds an empty
+    * open port to wait on.  Skips a missing number once every port
+    * is closed, throws if every open port is held up instead.
+    * @return  FIFO* - port to wait on, nullptr to run again now
+    */
+   FIFO* stalled()
+   {
+      FIFO *empty( nullptr );
+      bool  open( false );
+      std::size_t n( 0 );
+      const auto pick( idle % input.count() );
+      for( auto &port : input )
+      {
+         const bool closed( port.is_invalid() );
+         open |= ! closed;
+         if( port.size() > 0 )
+         {
+            const auto seq( seq_func( port.template peek< T >() ) );
+            port.unpeek();
+            if( seq - next < slots.size() )
+            {
+               /** came in since pull() looked **/
+               return( nullptr );
+            }
+         }
+         else if( ! closed && ( empty == nullptr || n <= pick ) )
+         {
+            empty = &port;
+         }
+         n++;
+      }
+      if( empty != nullptr )
+      {
+         return( empty );
+      }
+      if( open )
+      {
+         throw ReorderWindowException( "reorder window of " +
+            std::to_string( slots.size() ) + " items full while waiting on " +
+            std::to_string( next ) + ", raise depth" );
+      }
+      skip();
+      return( nullptr );
+   }
+
+   /**
+    * flush_drained - once every port is closed and empty the
+    * run-time won't call again, so everything held goes to ready,
+    * gaps or not.
+    */
+   void flush_drained()
+   {
+      while( count > 0 && drained() )
+      {
+         skip();
+         collect();
+      }
+   }
+
+   /** send_ready - sends whatever collect() has lined up **/
+   void send_ready()
+   {
+      for( auto &item : ready )
+      {
+         out.allocate() = std::move( item );
+         out.send();
+      }
+      ready.clear();
+   }
+
+   /** all_empty - nothing on any port, closed or not **/
+   bool all_empty()
+   {
+      for( auto &port : input )
+      {
+         if( port.size() > 0 )
+         {
+            return( false );
+         }
+      }
+      return( true );
+   }
+
+   /** drained - every port closed with nothing left on it **/
+   bool drained()
+   {
+      for( auto &port : input )
+      {
+         if( ! port.is_invalid() || port.size() > 0 )
+         {
+            return( false );
+         }
+      }
+      return( true );
+   }
+
+   /** skip - the stream is done and next never came, go to the lowest we have **/
+   void skip()
+   {
+      bool found( false );
+      std::uint64_t lowest( 0 );
+      auto consider( [&]( const std::uint64_t seq )
+      {
+         if( ! found || seq < lowest )
+         {
+            lowest = seq;
+            found  = true;
+         }
+      } );
+      for( std::size_t i( 0 ); i < slots.size(); i++ )
+      {
+         if( held[ i ] )
+         {
+            consider( seq_func( slots[ i ] ) );
+         }
+      }
+      for( auto &port : input )
+      {
+         if( port.size() > 0 )
+         {
+            consider( seq_func( port.template peek< T >() ) );
+            port.unpeek();
+         }
+      }
+      if( found )
+      {
+         next = lowest;
+      }
+   }
+
+   /** resize - rehomes what is held for a window of n slots **/
+   void resize( const std::size_t n )
+   {
+      if( n <= slots.size() )
+      {
+         return;
+      }
+      std::vector< T >    new_slots( n );
+      std::vector< bool > new_held( n, false );
+      for( std::size_t i( 0 ); i < slots.size(); i++ )
+      {
+         if( held[ i ] )
+         {
+            const auto j( seq_func( slots[ i ] ) % n );
+            new_slots[ j ] = std::move( slots[ i ] );
+            new_held[ j ]  = true;
+         }
+      }
+      slots.swap( new_slots );
+      held.swap( new_held );
+   }
+
+   const std::size_t    depth;
+   /** next sequence number to go out, the start of the window **/
+   std::uint64_t        next;
+   std::vector< T >     slots;
+   std::vector< bool >  held;
+   /** items in the window **/
+   std::size_t          count = 0;
+   std::vector< T >     ready;
+   std::size_t          idle  = 0;
+   Seq                  seq_func;
+   port_handle< T >     out;
+};
+
+} /** end namespace raft **/
+#endif /* END _REORDERJOIN_TCC_ */
@@ -0,0 +1,147 @@
+/**
+ * repinmonitor.hpp - moves pinned kernels between cores while the
+ * map runs.  The placement chosen at exe() is only a guess about
+ * load, this watches what each kernel thread actually does and
+ * moves one when it is plainly in the wrong spot.  Every window
+ * each kernel's demand is taken from the scheduler's own counts
+ * (/proc/self/task/<tid>/schedstat):
+ *
+ *    cpu     - fraction of the window it ran
+ *    wait    - fraction it was runnable but waiting for its core
+ *
+ * along with how often its FIFOs left it nothing to do (inputs
+ * empty or an output full).  A kernel that waits on its core a lot
+ * but isn't held up by its FIFOs is moved to the least loaded
+ * allowed core, one in the same last level cache if that is about
+ * as good, as long as that takes a fair bit of load off its core.
+ * The case has to hold for a few windows in a row, only one kernel
+ * moves per window, and a kernel that moved stays put for a while,
+ * so short bursts don't bounce kernels around.
+ *
+ * The move itself is done by the kernel's thread, it checks its
+ * slot between calls to run() and re-pins itself.
+ *
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 01:12:40 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _REPINMONITOR_HPP_
+#define _REPINMONITOR_HPP_  1
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "cputopology.hpp"
+#include "defs.hpp"
+
+namespace raft
+{
+   class kernel;
+}
+
+class repin_monitor
+{
+public:
+   /**
+    * slot - shared with the kernel's thread, which fills in tid
+    * when it starts and re-pins itself whenever core changes.
+    */
+   struct slot
+   {
+      std::atomic< core_id_t >    core = { -1 };
+      std::atomic< std::int64_t > tid  = { 0 };
+   };
+
+   /** usage - one kernel over one window **/
+   struct usage
+   {
+      double cpu     = 0.0;
+      double wait    = 0.0;
+      double blocked = 0.0;
+   };
+
+   /** wait fraction above which a kernel is short of CPU **/
+   static constexpr double      wait_threshold = 0.25;
+   /** FIFO blocked fraction above which moving won't help **/
+   static constexpr double      blocked_limit  = 0.5;
+   /** load a move has to take off the kernel's core **/
+   static constexpr double      min_gain       = 0.3;
+   /** windows in a row the move has to look right **/
+   static constexpr std::size_t confirm        = 3;
+   /** windows a kernel that moved stays put **/
+   static constexpr std::size_t cooldown       = 10;
+
+   /**
+    * repin_monitor - nothing moves outside of topology's cores.
+    * @param   topology - allowed cores
+    * @param   period   - length of a window
+    */
+   repin_monitor( const cpu_topology &topology,
+                  const std::chrono::milliseconds period );
+
+   /**
+    * add - watch kernel k, which runs on its own thread and
+    * re-pins itself from s.
+    */
+   void add( raft::kernel * const k, slot * const s );
+
+   /**
+    * tick - call often, from the scheduler's loop.  Samples the
+    * FIFOs and, at the end of each window, the threads, and
+    * decides whether to move a kernel.
+    */
+   void tick();
+
+   /**
+    * window - the decision for one window.
+    * @param   use - one per kernel, in the order added
+    * @return  index of the kernel moved, -1 if none
+    */
+   std::int64_t window( const std::vector< usage > &use );
+
+private:
+   struct entry
+   {
+      entry( raft::kernel * const k, slot * const s ) : k( k ), s( s ){}
+
+      raft::kernel  *k;
+      slot          *s;
+      std::uint64_t  cpu_ns   = 0;
+      std::uint64_t  wait_ns  = 0;
+      bool           primed   = false;
+      std::size_t    samples  = 0;
+      std::size_t    blocked  = 0;
+      std::size_t    strikes  = 0;
+      std::size_t    frozen   = 0;
+   };
+
+   /** true if the kernel had nothing to do right now **/
+   static bool fifo_blocked( raft::kernel * const k );
+   static bool fifo_blocked_locked( raft::kernel * const k );
+
+   using clock = std::chrono::steady_clock;
+
+   const cpu_topology              topology;
+   const clock::duration           period;
+   clock::time_point               window_start;
+   std::vector< entry >            entries;
+   /** schedstat couldn't be read, so there is nothing to go on **/
+   bool                            disabled = false;
+};
+
+#endif /* END _REPINMONITOR_HPP_ */
@@ -0,0 +1,148 @@
+/**
+ * resizepolicy.hpp - decides when the allocator grows and shrinks
+ * the resizeable FIFOs of a map.  Producers post to the policy
+ * when they block (see resizesignal.hpp) and the edge is grown at
+ * once, up to the edge's and the map's memory caps.  Occupancy is
+ * sampled every tick and an edge that hasn't blocked and stayed
+ * under a quarter full for a whole window is halved, down to the
+ * allocator's initial size.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 16:40:12 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _RESIZEPOLICY_HPP_
+#define _RESIZEPOLICY_HPP_  1
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "resizesignal.hpp"
+
+class FIFO;
+
+class ResizePolicy
+{
+public:
+   /**
+    * ResizePolicy - constructor
+    * @param   map_max_bytes - cap on the bytes held by all of the
+    *          edges registered with this policy, zero for no cap
+    * @param   min_items     - never shrink an edge below this
+    */
+   ResizePolicy( const std::size_t map_max_bytes,
+                 const std::size_t min_items );
+
+   virtual ~ResizePolicy() = default;
+
+   /**
+    * add_edge - register a resizeable FIFO, safe to call while
+    * the policy is running.  Ids are handed out in order so
+    * they never collide.
+    * @param   fifo      - FIFO*
+    * @param   item_size - bytes per item
+    * @param   max_bytes - cap for this edge, zero for no cap
+    * @return  ResizeSignal for the FIFO's producer to post to
+    */
+   ResizeSignal add_edge( FIFO * const fifo,
+                          const std::size_t item_size,
+                          const std::size_t max_bytes );
+
+   /**
+    * post - called through ResizeSignal when the producer on
+    * edge_id blocks, wakes the allocator.
+    * @param   edge_id - std::size_t
+    */
+   void post( const std::size_t edge_id );
+
+   /**
+    * run - the allocator's monitor loop, returns once
+    * exit_alloc is set.
+    * @param   exit_alloc - volatile bool&
+    */
+   void run( volatile bool &exit_alloc );
+
+   /**
+    * total_bytes - bytes held by all registered edges
+    * @return  std::size_t
+    */
+   std::size_t total_bytes();
+
+   /** time between occupancy samples **/
+   static constexpr std::chrono::microseconds tick = std::chrono::microseconds( 3000 );
+   /** ticks an edge must be idle and under a quarter full to shrink **/
+   static constexpr std::size_t shrink_window = 64;
+
+protected:
+   struct edge
+   {
+      edge( FIFO * const fifo,
+            const std::size_t item_size,
+            const std::size_t max_bytes ) : fifo( fifo ),
+                                            item_size( item_size ),
+                                            max_bytes( max_bytes ){}
+
+      FIFO               *fifo;
+      const std::size_t   item_size;
+      const std::size_t   max_bytes;
+      /** set by the producer, cleared once the post is handled **/
+      std::atomic< bool > pending      = { false };
+      /** most items seen queued this window **/
+      std::size_t         high_water   = 0;
+      /** ticks since the producer last blocked **/
+      std::size_t         quiet_ticks  = 0;
+      /** consumer has found the edge empty since we last grew it **/
+      bool                starved      = true;
+   };
+
+   /**
+    * grow - doubles the edge, limited by the caps, returns
+    * false if the caps leave no room.
+    */
+   bool grow( edge &e, volatile bool &exit_alloc );
+
+   /**
+    * sample - per tick bookkeeping for one edge, shrinks it if
+    * it has been quiet for a whole window.
+    */
+   void sample( edge &e, volatile bool &exit_alloc );
+
+   /**
+    * resize - resizes the edge and updates the byte count
+    * with whatever capacity the FIFO ended up with.
+    */
+   void resize( edge &e,
+                const std::size_t items,
+                volatile bool &exit_alloc );
+
+   const std::size_t                       map_max_bytes;
+   const std::size_t                       min_items;
+   /** bytes held by every registered edge **/
+   std::atomic< std::size_t >              bytes      = { 0 };
+
+   std::mutex                              edge_mutex;
+   std::vector< std::unique_ptr< edge > >  edges;
+
+   std::mutex                              post_mutex;
+   std::condition_variable                 post_cv;
+   std::vector< std::size_t >              posted;
+};
+
+#endif /* END _RESIZEPOLICY_HPP_ */
@@ -0,0 +1,65 @@
+/**
+ * resizesignal.hpp - handle a resizeable FIFO uses to tell the
+ * allocator's resize policy that its producer is blocked, so
+ * the allocator doesn't have to walk the graph to find out.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 16:40:12 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _RESIZESIGNAL_HPP_
+#define _RESIZESIGNAL_HPP_  1
+#include <atomic>
+#include <cstddef>
+
+class ResizePolicy;
+
+class ResizeSignal
+{
+public:
+   /** unbound, post() does nothing **/
+   ResizeSignal() = default;
+
+   ResizeSignal( ResizePolicy * const policy,
+                 std::atomic< bool > * const pending,
+                 const std::size_t edge_id ) : policy( policy ),
+                                               pending( pending ),
+                                               edge_id( edge_id ){}
+
+   /**
+    * post - producer side, called once the producer has been
+    * blocked for a while.  Only the first post until the policy
+    * has handled the edge reaches the allocator.
+    */
+   inline void post() noexcept
+   {
+      if( pending != nullptr &&
+          ! pending->exchange( true, std::memory_order_acq_rel ) )
+      {
+         forward();
+      }
+   }
+
+private:
+   /** hands edge_id to the policy, out of line **/
+   void forward() noexcept;
+
+   ResizePolicy         *policy  = nullptr;
+   std::atomic< bool >  *pending = nullptr;
+   std::size_t           edge_id = 0;
+};
+
+#endif /* END _RESIZESIGNAL_HPP_ */
@@ -115,8 +115,13 @@ public:
     {
         if((this)->datamanager.is_resizeable())
         {
-            (this)->datamanager.resize(
-                new Buffer::Data<T, type>(size, align), exit_alloc);
+            if( (this)->datamanager.resize(
+                new Buffer::Data<T, type>(size, align, (this)->mem_options),
+                exit_alloc) )
+            {
+                /** a producer parked on the old buffer may have room now **/
+                (this)->waiter.wake_producer();
+            }
         }
         /** else, not resizeable..just return **/
         return;
@@ -188,8 +193,13 @@ public:
     {
         if((this)->datamanager.is_resizeable())
         {
-            (this)->datamanager.resize(
-                new Buffer::Data<T, type>(size, align), exit_alloc);
+            if( (this)->datamanager.resize(
+                new Buffer::Data<T, type>(size, align, (this)->mem_options),
+                exit_alloc) )
+            {
+                /** a producer parked on the old buffer may have room now **/
+                (this)->waiter.wake_producer();
+            }
         }
         /** else, not resizeable..just return **/
         return;
@@ -239,6 +249,56 @@ public:
     }
 };
 
+/**
+ * specialization for the single producer/consumer heap, this
+ * one is never resized so it is only handed out for edges whose
+ * size is fixed by the user (see Allocate::allocate).
+ */
+template <class T>
+class RingBuffer< T, Type::HeapSPSC, false >
+    : public RingBufferBase< T, Type::HeapSPSC >
+{
+public:
+    RingBuffer( const std::size_t n, const std::size_t align = 16 )
+        : RingBufferBase< T, Type::HeapSPSC >()
+    {
+        (this)->init( n, align );
+    }
+
+    virtual ~RingBuffer() = default;
+
+    static FIFO* make_new_fifo( const std::size_t n_items,
+                                const std::size_t align,
+                                void * const data )
+    {
+        UNUSED( data );
+        assert( data == nullptr );
+        return( new RingBuffer< T, Type::HeapSPSC, false >( n_items, align ) );
+    }
+
+    virtual void resize( const std::size_t size,
+                         const std::size_t align,
+                         volatile bool& exit_alloc )
+    {
+        UNUSED( size );
+        UNUSED( align );
+        UNUSED( exit_alloc );
+        /** not resizeable..just return **/
+        return;
+    }
+
+    virtual float get_frac_write_blocked()
+    {
+        const auto copy( (this)->write_stats );
+        (this)->write_stats.all = 0;
+        if( copy.bec.blocked == 0 || copy.bec.count == 0 )
+        {
+            return( 0.0 );
+        }
+        return( (float)copy.bec.blocked / (float)copy.bec.count );
+    }
+};
+
 /** specialization for dummy one **/
 template <class T>
 class RingBuffer<T, Type::Infinite, true /* monitor */>
@@ -332,9 +392,9 @@ public:
     }
 };
 
-#if BUILDSHM
 /**
- * SharedMemory
+ * SharedMemory, one end of an edge between two processes, see
+ * ringbuffershm.tcc.  Never resized.
  */
 template <class T>
 class RingBuffer< T, Type::SharedMemory, false >
@@ -346,35 +406,21 @@ public:
                 Direction dir,
                 const std::size_t alignment = 16 ) 
                     : RingBufferBase< T, 
-                                      Type::SharedMemory >() ,
-                      shm_key( key )
-    {
-        (this)->datamanager.set( 
-            new Buffer::Data< T, Type::SharedMemory >( nitems, 
-                                                       key, 
-                                                       dir, 
-                                                       alignment )
-        );
-    }
-
-    virtual ~RingBuffer()
+                                      Type::SharedMemory >()
     {
-        delete((this)->datamanager.get());
+        (this)->init( nitems, key, dir, alignment );
     }
 
-    struct Data
-    {
-        const std::string key;
-        Direction dir;
-    };
+    virtual ~RingBuffer() = default;
+
+    using Data = shm_edge;
 
     /**
      * make_new_fifo - builder function to dynamically
      * allocate FIFO's at the time of execution.  The
      * first two parameters are self explanatory.  The
-     * data ptr is a data struct that is dependent on the
-     * type of FIFO being built.  In there really is no
-     * data necessary so it is expacted to be set to nullptr
+     * data ptr is a shm_edge naming the edge and which
+     * end of it this process is, must not be nullptr.
      * @param   n_items - std::size_t
      * @param   align   - memory alignment
      * @return  FIFO*
@@ -383,11 +429,12 @@ public:
                                 const std::size_t align, 
                                 void * const data )
     {
+        assert( data != nullptr );
         auto * const data_ptr(reinterpret_cast<Data*>(data) );
         return( new RingBuffer< T, 
                                 Type::SharedMemory, 
                                 false>( n_items, 
-                                        data_ptr->key, 
+                                        data_ptr->name, 
                                         data_ptr->dir, 
                                         align )
         );
@@ -400,22 +447,23 @@ public:
         UNUSED( size );
         UNUSED( align );
         UNUSED( exit_alloc );
-        assert(false);
-        /** TODO, implement me **/
+        /** not resizeable..just return **/
         return;
     }
 
     virtual float get_frac_write_blocked()
     {
-        assert(false);
-        return( static_cast< float >( 0.0 ) );
+        const auto copy( (this)->write_stats );
+        (this)->write_stats.all = 0;
+        if( copy.bec.blocked == 0 || copy.bec.count == 0 )
+        {
+            return( 0.0 );
+        }
+        return( (float)copy.bec.blocked / (float)copy.bec.count );
     }
-
-protected:
-    const std::string shm_key;
 };
 
-
+#if BUILDTCP
 /**
  * TCP w/ multiplexing
  */
@@ -477,5 +525,5 @@ public:
 
 protected:
 };
-#endif // end BUILDSHM
+#endif // end BUILDTCP
 #endif /* END _RINGBUFFER_TCC_ */
@@ -44,12 +44,10 @@ namespace raft
 }
 
 /**
- * Note: there is a NICE define that can be uncommented
- * below if you want sched_yield called when waiting for
- * writes or blocking for space, otherwise blocking will
- * actively spin while waiting.
+ * Note: what a FIFO does while waiting for writes or blocking
+ * for space is set per port or per map with a wait strategy,
+ * see waitstrategy.hpp.
  */
-#define NICE 1
 
 template < class T,
            Type::RingBufferType type,
@@ -68,4 +66,10 @@ public:
 /** infinite dummy implementation, can use shared memory or SHM **/
 #include "ringbufferinfinite.tcc"
 
+/** non-resizeable single producer/consumer heap implementation **/
+#include "ringbufferspsc.tcc"
+
+/** single producer/consumer ring in SHM, one end per process **/
+#include "ringbuffershm.tcc"
+
 #endif /* END _RINGBUFFERBASE_TCC_ */
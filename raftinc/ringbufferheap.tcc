@@ -28,6 +28,7 @@
 #include "alloc_traits.tcc"
 #include "prefetch.hpp"
 #include "defs.hpp"
+#include "slabpool.hpp"
 
 #ifdef USEQTHREADS
 #include <qthread/qthread.hpp>
@@ -51,7 +52,6 @@ public:
    virtual void deallocate()
    {
       (this)->allocate_called = false;
-      (this)->datamanager.exitBuffer( dm::allocate );
    }
 
    /**
@@ -69,7 +69,7 @@ public:
       /** should be the end of the write, regardless of which allocate called **/
       auto * const buff_ptr( (this)->datamanager.get() );
       const size_t write_index( Pointer::val( buff_ptr->write_pt ) );
-      buff_ptr->signal[ write_index ] = signal;
+      buff_ptr->signal->set( write_index, signal );
       (this)->write_stats.bec.count++;
       if( signal == raft::eof )
       {
@@ -81,7 +81,7 @@ public:
       }
       (this)->allocate_called = false;
       Pointer::inc( buff_ptr->write_pt );
-      (this)->datamanager.exitBuffer( dm::allocate );
+      (this)->waiter.wake_consumer();
    }
 
    /**
@@ -94,10 +94,13 @@ public:
    {
       if( ! (this)->allocate_called ) return;
       /** should be the end of the write, regardless of which allocate called **/
-      const size_t write_index( Pointer::val( (this)->datamanager.get()->write_pt ) );
-      (this)->datamanager.get()->signal[ write_index ] = signal;
+      auto * const buff_ptr( (this)->datamanager.get() );
+      const size_t write_index( Pointer::val( buff_ptr->write_pt ) );
+      /** signal travels with the last item of the range **/
+      buff_ptr->signal->set( ( write_index + (this)->n_allocated - 1 ) %
+                                buff_ptr->max_cap, signal );
       /* only need to inc one more **/
-      Pointer::incBy( (this)->datamanager.get()->write_pt,
+      Pointer::incBy( buff_ptr->write_pt,
                       (this)->n_allocated );
       (this)->write_stats.bec.count += (this)->n_allocated;
       if( signal == raft::eof )
@@ -110,14 +113,14 @@ public:
       }
       (this)->allocate_called = false;
       (this)->n_allocated     = 0;
-      (this)->datamanager.exitBuffer( dm::allocate_range );
+      (this)->waiter.wake_consumer();
    }
 
 
 
    virtual void unpeek()
    {
-      (this)->datamanager.exitBuffer( dm::peek );
+      /** nothing held, the peeked item keeps its store from being left **/
    }
 
 protected:
@@ -128,43 +131,21 @@ protected:
     */
    virtual void local_recycle( std::size_t range )
    {
-      if( range == 0 )
+      while( range > 0 )
       {
-         /** do nothing **/
-         return;
-      }
-      do{ /** at least one to remove **/
-         for( ;; )
+         const auto avail( (this)->wait_for_data( dm::recycle ) );
+         if( avail == 0 )
          {
-            (this)->datamanager.enterBuffer( dm::recycle );
-            if( (this)->datamanager.notResizing() )
-            {
-               if( (this)->size() > 0 )
-               {
-                  break;
-               }
-               else if( (this)->is_invalid() && (this)->size() == 0 )
-               {
-                  (this)->datamanager.exitBuffer( dm::recycle );
-                  return;
-               }
-            }
-            (this)->datamanager.exitBuffer( dm::recycle );
-#if (defined NICE) && (! defined USEQTHREADS)
-         std::this_thread::yield();
-#endif
-#ifdef USEQTHREADS
-         qthread_yield();
-#endif
+            /** invalid and empty, nothing left to recycle **/
+            return;
          }
-         auto * const buff_ptr( (this)->datamanager.get() );
-         /**
-          * TODO, this whole func can be optimized a bit more
-          * using the incBy func of Pointer
-          */
-         Pointer::inc( buff_ptr->read_pt );
-         (this)->datamanager.exitBuffer( dm::recycle );
-      }while( --range > 0 );
+         const auto n( avail < range ? avail : range );
+         auto * const buff_ptr( (this)->datamanager.get_read() );
+         (this)->drop_signals( buff_ptr, n );
+         Pointer::incBy( buff_ptr->read_pt, n );
+         (this)->waiter.wake_producer();
+         range -= n;
+      }
       return;
    }
 
@@ -179,67 +160,32 @@ protected:
     */
    virtual void local_allocate( void **ptr )
    {
-      for(;;)
+      for( std::size_t spins( 0 );; spins++ )
       {
          (this)->datamanager.enterBuffer( dm::allocate );
-         if( (this)->datamanager.notResizing() && (this)->space_avail() > 0  )
+         if( (this)->writable() > 0  )
          {
             break;
          }
-         (this)->datamanager.exitBuffer( dm::allocate );
-         /** else, spin **/
-         if( (this)->write_stats.bec.blocked == 0 )
-         {
-            (this)->write_stats.bec.blocked = 1;
-         }
-#if (defined NICE) && (! defined USEQTHREADS)
-         std::this_thread::yield();
-#if __x86_64
-         __asm__ volatile("\
-           pause"
-           :
-           :
-           : );
-#endif
-#endif
-#ifdef USEQTHREADS
-         qthread_yield();
-#endif
+         (this)->producer_wait( spins, 1 );
       }
       auto * const buff_ptr( (this)->datamanager.get() );
       const size_t write_index( Pointer::val( buff_ptr->write_pt ) );
       *ptr = (void*)&( buff_ptr->store[ write_index ] );
       (this)->allocate_called = true;
-      /** call exitBuffer during push call **/
+      /** send() releases it **/
    }
 
    virtual void local_allocate_n( void *ptr, const std::size_t n )
    {
-      for( ;; )
+      for( std::size_t spins( 0 );; spins++ )
       {
          (this)->datamanager.enterBuffer( dm::allocate_range );
-         if( (this)->datamanager.notResizing() && (this)->space_avail() >= n )
+         if( (this)->writable() >= n )
          {
             break;
          }
-         (this)->datamanager.exitBuffer( dm::allocate_range );
-         if( (this)->write_stats.bec.blocked == 0 )
-         {
-            (this)->write_stats.bec.blocked = 1;
-         }
-#if (defined NICE) && (! defined USEQTHREADS)
-         std::this_thread::yield();
-#if __x86_64
-       __asm__ volatile("\
-         pause"
-         :
-         :
-         : );
-#endif
-#endif
-#ifdef USEQTHREADS
-         qthread_yield();
-#endif
+         (this)->producer_wait( spins, n );
       }
       auto *container(
          reinterpret_cast< std::vector< std::reference_wrapper< T > >* >( ptr ) );
@@ -257,12 +203,14 @@ protected:
           * not here
           */
          container->emplace_back( buff_ptr->store[ write_index ] );
-         buff_ptr->signal[ write_index ] = raft::none;
-         write_index = ( write_index + 1 ) % buff_ptr->max_cap;
+         if( ++write_index == buff_ptr->max_cap )
+         {
+            write_index = 0;
+         }
       }
       (this)->n_allocated = static_cast< decltype( (this)->n_allocated ) >( n );
       (this)->allocate_called = true;
-      /** exitBuffer() called by push_range **/
+      /** send_range() releases them **/
    }
 
 
@@ -279,50 +227,7 @@ protected:
     */
    virtual void  local_push( void *ptr, const raft::signal &signal )
    {
-      for(;;)
-      {
-         (this)->datamanager.enterBuffer( dm::push );
-         if( (this)->datamanager.notResizing() )
-         {
-            if( (this)->space_avail() > 0 )
-            {
-               break;
-            }
-         }
-         (this)->datamanager.exitBuffer( dm::push );
-         if( (this)->write_stats.bec.blocked == 0 )
-         {
-            (this)->write_stats.bec.blocked = 1;
-         }
-#if (defined NICE) && (! defined USEQTHREADS)
-         std::this_thread::yield();
-#if __x86_64
-         __asm__ volatile("\
-           pause"
-           :
-           :
-           : );
-#endif
-#endif
-#ifdef USEQTHREADS
-         qthread_yield();
-#endif
-      }
-      auto * const buff_ptr( (this)->datamanager.get() );
-       const size_t write_index( Pointer::val( buff_ptr->write_pt ) );
-      if( ptr != nullptr )
-      {
-         T *item( reinterpret_cast< T* >( ptr ) );
-          buff_ptr->store[ write_index ]          = *item;
-          (this)->write_stats.bec.count++;
-       }
-      buff_ptr->signal[ write_index ]         = signal;
-       Pointer::inc( buff_ptr->write_pt );
-      if( signal == raft::quit )
-      {
-         (this)->write_finished = true;
-      }
-      (this)->datamanager.exitBuffer( dm::push );
+      (this)->push_item( reinterpret_cast< const T* >( ptr ), signal );
    }
 
    /**
@@ -335,50 +240,7 @@ protected:
    virtual void
    local_pop( void *ptr, raft::signal *signal )
    {
-      for(;;)
-      {
-         (this)->datamanager.enterBuffer( dm::pop );
-         if( (this)->datamanager.notResizing() )
-         {
-            if( (this)->size() > 0 )
-            {
-               break;
-            }
-            else if( (this)->is_invalid() && (this)->size() == 0 )
-            {
-               throw ClosedPortAccessException(
-                  "Accessing closed port with pop call, exiting!!" );
-            }
-         }
-         else
-         {
-            (this)->datamanager.exitBuffer( dm::pop );
-            if( (this)->read_stats.bec.blocked == 0 )
-            {
-               (this)->read_stats.bec.blocked  = 1;
-            }
-#if (defined NICE) && (! defined USEQTHREADS)
-         std::this_thread::yield();
-#endif
-#ifdef USEQTHREADS
-         qthread_yield();
-#endif
-         }
-      }
-      auto * const buff_ptr( (this)->datamanager.get() );
-      const std::size_t read_index( Pointer::val( buff_ptr->read_pt ) );
-      if( signal != nullptr )
-      {
-         *signal = buff_ptr->signal[ read_index ];
-      }
-      assert( ptr != nullptr );
-      /** gotta dereference pointer and copy **/
-      T *item( reinterpret_cast< T* >( ptr ) );
-      *item = buff_ptr->store[ read_index ];
-      /** only increment here b/c we're actually reading an item **/
-      (this)->read_stats.bec.count++;
-      Pointer::inc( buff_ptr->read_pt );
-      (this)->datamanager.exitBuffer( dm::pop );
+      (this)->pop_item( reinterpret_cast< T* >( ptr ), signal );
    }
 
 
@@ -391,102 +253,22 @@ protected:
     */
    virtual void local_peek(  void **ptr, raft::signal *signal )
    {
-      for(;;)
-      {
-
-         (this)->datamanager.enterBuffer( dm::peek );
-         if( (this)->datamanager.notResizing() )
-         {
-            if( (this)->size() > 0  )
-            {
-               break;
-            }
-            else if( (this)->is_invalid() && (this)->size() == 0 )
-            {
-               throw ClosedPortAccessException(
-                  "Accessing closed port with local_peek call, exiting!!" );
-            }
-         }
-         (this)->datamanager.exitBuffer( dm::peek );
-#if (defined NICE) && (! defined USEQTHREADS)
-         std::this_thread::yield();
-#if  __x86_64
-         __asm__ volatile("\
-           pause"
-           :
-           :
-           : );
-#endif
-#endif
-#ifdef USEQTHREADS
-         qthread_yield();
-#endif
-      }
-      auto * const buff_ptr( (this)->datamanager.get() );
-      const auto read_index( Pointer::val( buff_ptr->read_pt ) );
-      if( signal != nullptr )
-      {
-         *signal = buff_ptr->signal[ read_index ];
-      }
-      *ptr = reinterpret_cast< void* >( &( buff_ptr->store[ read_index ] ) );
-      return;
-      /**
-       * exitBuffer() called when recycle is called, can't be sure the
-       * reference isn't being used until all outside accesses to it are
-       * invalidated from the buffer.
-       */
+      *ptr = reinterpret_cast< void* >( (this)->peek_item( signal ) );
    }
 
    virtual void local_peek_range( void **ptr,
                                   void **sig,
                                   const std::size_t n,
-                                  std::size_t &curr_pointer_loc )
+                                  std::size_t &curr_pointer_loc,
+                                  std::size_t &queue_size )
    {
-      for(;;)
-      {
-
-         (this)->datamanager.enterBuffer( dm::peek );
-         if( (this)->datamanager.notResizing() )
-         {
-            if( (this)->size() >= n  )
-            {
-               break;
-            }
-            else if( (this)->is_invalid() && (this)->size() == 0 )
-            {
-               throw ClosedPortAccessException(
-                  "Accessing closed port with local_peek_range call, exiting!!" );
-            }
-            else if( (this)->is_invalid() && (this)->size() < n )
-            {
-               throw NoMoreDataException( "Too few items left on closed port, kernel exiting" );
-            }
-         }
-         (this)->datamanager.exitBuffer( dm::peek );
-#if (defined NICE) && (! defined USEQTHREADS)
-         std::this_thread::yield();
-#if  __x86_64
-         __asm__ volatile("\
-           pause"
-           :
-           :
-           : );
-#endif
-#endif
-#ifdef USEQTHREADS
-         qthread_yield();
-#endif
-      }
-
-      /**
-       * TODO, fix this condition where the user can ask for more,
-       * double buffer.
-       */
-      /** iterate over range, pause if not enough items **/
-      auto * const buff_ptr( (this)->datamanager.get() );
+      (this)->wait_for_range( n );
+      auto * const buff_ptr( (this)->datamanager.get_read() );
       const std::size_t cpl( Pointer::val( buff_ptr->read_pt ) );
       curr_pointer_loc = cpl;
-      *sig =  reinterpret_cast< void* >(  &buff_ptr->signal[ cpl ] );
+      queue_size       = buff_ptr->max_cap;
+      /** autorelease indexes both arrays from their base **/
+      *sig =  reinterpret_cast< void* >( buff_ptr->signal );
       *ptr =  buff_ptr->store;
       return;
    }
@@ -519,7 +301,6 @@ public:
       /** destruct **/
       ptr->~T();
       (this)->allocate_called = false;
-      (this)->datamanager.exitBuffer( dm::allocate );
    }
 
    /**
@@ -537,7 +318,7 @@ public:
       /** should be the end of the write, regardless of which allocate called **/
       auto * const buff_ptr( (this)->datamanager.get() );
       const size_t write_index( Pointer::val( buff_ptr->write_pt ) );
-      buff_ptr->signal[ write_index ] = signal;
+      buff_ptr->signal->set( write_index, signal );
       (this)->write_stats.bec.count++;
       if( signal == raft::eof )
       {
@@ -549,7 +330,7 @@ public:
       }
       (this)->allocate_called = false;
       Pointer::inc( buff_ptr->write_pt );
-      (this)->datamanager.exitBuffer( dm::allocate );
+      (this)->waiter.wake_consumer();
    }
 
    /**
@@ -562,10 +343,13 @@ public:
    {
       if( ! (this)->allocate_called ) return;
       /** should be the end of the write, regardless of which allocate called **/
-      const size_t write_index( Pointer::val( (this)->datamanager.get()->write_pt ) );
-      (this)->datamanager.get()->signal[ write_index ] = signal;
+      auto * const buff_ptr( (this)->datamanager.get() );
+      const size_t write_index( Pointer::val( buff_ptr->write_pt ) );
+      /** signal travels with the last item of the range **/
+      buff_ptr->signal->set( ( write_index + (this)->n_allocated - 1 ) %
+                                buff_ptr->max_cap, signal );
       /* only need to inc one more, the rest have already**/
-      Pointer::incBy( (this)->datamanager.get()->write_pt,
+      Pointer::incBy( buff_ptr->write_pt,
                       (this)->n_allocated );
       (this)->write_stats.bec.count += (this)->n_allocated;
       /** cleanup **/
@@ -579,13 +363,13 @@ public:
       }
       (this)->allocate_called = false;
       (this)->n_allocated     = 0;
-      (this)->datamanager.exitBuffer( dm::allocate_range );
+      (this)->waiter.wake_consumer();
    }
 
 
    virtual void unpeek()
    {
-      (this)->datamanager.exitBuffer( dm::peek );
+      /** nothing held, the peeked item keeps its store from being left **/
    }
 
 protected:
@@ -596,44 +380,33 @@ protected:
     */
    virtual void local_recycle( std::size_t range )
    {
-      if( range == 0 )
+      while( range > 0 )
       {
-         /** do nothing **/
-         return;
-      }
-      do{ /** at least one to remove **/
-         for( ;; )
+         const auto avail( (this)->wait_for_data( dm::recycle ) );
+         if( avail == 0 )
          {
-            (this)->datamanager.enterBuffer( dm::recycle );
-            if( (this)->datamanager.notResizing() )
-            {
-               if( (this)->size() > 0 )
-               {
-                  break;
-               }
-               else if( (this)->is_invalid() && (this)->size() == 0 )
-               {
-                  (this)->datamanager.exitBuffer( dm::recycle );
-                  return;
-               }
-            }
-            (this)->datamanager.exitBuffer( dm::recycle );
-#if (defined NICE) && (! defined USEQTHREADS)
-         std::this_thread::yield();
-#endif
-#ifdef USEQTHREADS
-         qthread_yield();
-#endif
+            /** invalid and empty, nothing left to recycle **/
+            return;
          }
-         auto * const buff_ptr( (this)->datamanager.get() );
-         const size_t read_index( Pointer::val( buff_ptr->read_pt ) );
-         auto *ptr =
-            reinterpret_cast< T* >( &( buff_ptr->store[ read_index ] ) );
+         const auto n( avail < range ? avail : range );
+         auto * const buff_ptr( (this)->datamanager.get_read() );
+         const std::size_t read_index( Pointer::val( buff_ptr->read_pt ) );
+         const auto to_end( buff_ptr->max_cap - read_index );
+         const auto first( n < to_end ? n : to_end );
          /** call destructor direct, faster than recyle func **/
-         ptr->~T();
-         Pointer::inc( buff_ptr->read_pt );
-         (this)->datamanager.exitBuffer( dm::recycle );
-      }while( --range > 0 );
+         for( std::size_t i( 0 ); i < first; i++ )
+         {
+            buff_ptr->store[ read_index + i ].~T();
+         }
+         for( std::size_t i( 0 ); i < n - first; i++ )
+         {
+            buff_ptr->store[ i ].~T();
+         }
+         (this)->drop_signals( buff_ptr, n );
+         Pointer::incBy( buff_ptr->read_pt, n );
+         (this)->waiter.wake_producer();
+         range -= n;
+      }
       return;
    }
 
@@ -648,66 +421,32 @@ protected:
     */
    virtual void local_allocate( void **ptr )
    {
-      for(;;)
+      for( std::size_t spins( 0 );; spins++ )
       {
          (this)->datamanager.enterBuffer( dm::allocate );
-         if( (this)->datamanager.notResizing() && (this)->space_avail() > 0  )
+         if( (this)->writable() > 0  )
          {
             break;
          }
-         (this)->datamanager.exitBuffer( dm::allocate );
-         if( (this)->write_stats.bec.blocked == 0 )
-         {
-            (this)->write_stats.bec.blocked = 1;
-         }
-#if (defined NICE) && (! defined USEQTHREADS)
-         std::this_thread::yield();
-#if __x86_64
-         __asm__ volatile("\
-           pause"
-           :
-           :
-           : );
-#endif
-#endif
-#ifdef USEQTHREADS
-         qthread_yield();
-#endif
+         (this)->producer_wait( spins, 1 );
       }
       auto * const buff_ptr( (this)->datamanager.get() );
       const size_t write_index( Pointer::val( buff_ptr->write_pt ) );
       *ptr = (void*)&( buff_ptr->store[ write_index ] );
       (this)->allocate_called = true;
-      /** call exitBuffer during push call **/
+      /** send() releases it **/
    }
 
    virtual void local_allocate_n( void *ptr, const std::size_t n )
    {
-      for( ;; )
+      for( std::size_t spins( 0 );; spins++ )
       {
          (this)->datamanager.enterBuffer( dm::allocate_range );
-         if( (this)->datamanager.notResizing() && (this)->space_avail() >= n )
+         if( (this)->writable() >= n )
          {
             break;
          }
-         (this)->datamanager.exitBuffer( dm::allocate_range );
-         if( (this)->write_stats.bec.blocked == 0 )
-         {
-            (this)->write_stats.bec.blocked = 1;
-         }
-#if (defined NICE) && (! defined USEQTHREADS)
-         std::this_thread::yield();
-#if __x86_64
-       __asm__ volatile("\
-         pause"
-         :
-         :
-         : );
-#endif
-#endif
-#ifdef USEQTHREADS
-         qthread_yield();
-#endif
+         (this)->producer_wait( spins, n );
       }
       auto *container(
          reinterpret_cast< std::vector< std::reference_wrapper< T > >* >( ptr ) );
@@ -725,12 +464,14 @@ protected:
           * not here
           */
          container->emplace_back( buff_ptr->store[ write_index ] );
-         buff_ptr->signal[ write_index ] = raft::none;
-         write_index = ( write_index + 1 ) % buff_ptr->max_cap;
+         if( ++write_index == buff_ptr->max_cap )
+         {
+            write_index = 0;
+         }
       }
       (this)->n_allocated = static_cast< decltype( (this)->n_allocated ) >( n );
       (this)->allocate_called = true;
-      /** exitBuffer() called by push_range **/
+      /** send_range() releases them **/
    }
 
 
@@ -747,53 +488,7 @@ protected:
     */
    virtual void  local_push( void *ptr, const raft::signal &signal )
    {
-      for(;;)
-      {
-         (this)->datamanager.enterBuffer( dm::push );
-         if( (this)->datamanager.notResizing() )
-         {
-            if( (this)->space_avail() > 0 )
-            {
-               break;
-            }
-         }
-         (this)->datamanager.exitBuffer( dm::push );
-         if( (this)->write_stats.bec.blocked == 0 )
-         {
-            (this)->write_stats.bec.blocked = 1;
-         }
-#if (defined NICE) && (! defined USEQTHREADS)
-         std::this_thread::yield();
-#if __x86_64
-         __asm__ volatile("\
-           pause"
-           :
-           :
-           : );
-#endif
-#endif
-#ifdef USEQTHREADS
-         qthread_yield();
-#endif
-      }
-      auto * const buff_ptr( (this)->datamanager.get() );
-       const size_t write_index( Pointer::val( buff_ptr->write_pt ) );
-      if( ptr != nullptr )
-      {
-          T *item( reinterpret_cast< T* >( ptr ) );
-          T * temp( new (
-            &buff_ptr->store[ write_index ]
-          ) T( *item  ) );
-          UNUSED( temp );
-          (this)->write_stats.bec.count++;
-       }
-      buff_ptr->signal[ write_index ]         = signal;
-       Pointer::inc( buff_ptr->write_pt );
-      if( signal == raft::quit )
-      {
-         (this)->write_finished = true;
-      }
-      (this)->datamanager.exitBuffer( dm::push );
+      (this)->push_item( reinterpret_cast< const T* >( ptr ), signal );
    }
 
    /**
@@ -806,50 +501,7 @@ protected:
    virtual void
    local_pop( void *ptr, raft::signal *signal )
    {
-      for(;;)
-      {
-         (this)->datamanager.enterBuffer( dm::pop );
-         if( (this)->datamanager.notResizing() )
-         {
-            if( (this)->size() > 0 )
-            {
-               break;
-            }
-            else if( (this)->is_invalid() && (this)->size() == 0 )
-            {
-               throw ClosedPortAccessException(
-                  "Accessing closed port with pop call, exiting!!" );
-            }
-         }
-         else
-         {
-            (this)->datamanager.exitBuffer( dm::pop );
-            if( (this)->read_stats.bec.blocked == 0 )
-            {
-               (this)->read_stats.bec.blocked  = 1;
-            }
-#if (defined NICE) && (! defined USEQTHREADS)
-         std::this_thread::yield();
-#endif
-#ifdef USEQTHREADS
-         qthread_yield();
-#endif
-         }
-      }
-      auto * const buff_ptr( (this)->datamanager.get() );
-      const std::size_t read_index( Pointer::val( buff_ptr->read_pt ) );
-      if( signal != nullptr )
-      {
-         *signal = buff_ptr->signal[ read_index ];
-      }
-      assert( ptr != nullptr );
-      /** gotta dereference pointer and copy **/
-      T *item( reinterpret_cast< T* >( ptr ) );
-      *item = buff_ptr->store[ read_index ];
-      /** only increment here b/c we're actually reading an item **/
-      (this)->read_stats.bec.count++;
-      Pointer::inc( buff_ptr->read_pt );
-      (this)->datamanager.exitBuffer( dm::pop );
+      (this)->pop_item( reinterpret_cast< T* >( ptr ), signal );
    }
 
 
@@ -862,102 +514,22 @@ protected:
     */
    virtual void local_peek(  void **ptr, raft::signal *signal )
    {
-      for(;;)
-      {
-
-         (this)->datamanager.enterBuffer( dm::peek );
-         if( (this)->datamanager.notResizing() )
-         {
-            if( (this)->size() > 0  )
-            {
-               break;
-            }
-            else if( (this)->is_invalid() && (this)->size() == 0 )
-            {
-               throw ClosedPortAccessException(
-                  "Accessing closed port with local_peek call, exiting!!" );
-            }
-         }
-         (this)->datamanager.exitBuffer( dm::peek );
-#if (defined NICE) && (! defined USEQTHREADS)
-         std::this_thread::yield();
-#if  __x86_64
-         __asm__ volatile("\
-           pause"
-           :
-           :
-           : );
-#endif
-#endif
-#ifdef USEQTHREADS
-         qthread_yield();
-#endif
-      }
-      auto * const buff_ptr( (this)->datamanager.get() );
-      const size_t read_index( Pointer::val( buff_ptr->read_pt ) );
-      if( signal != nullptr )
-      {
-         *signal = buff_ptr->signal[ read_index ];
-      }
-      *ptr = (void*) &( buff_ptr->store[ read_index ] );
-      return;
-      /**
-       * exitBuffer() called when recycle is called, can't be sure the
-       * reference isn't being used until all outside accesses to it are
-       * invalidated from the buffer.
-       */
+      *ptr = reinterpret_cast< void* >( (this)->peek_item( signal ) );
    }
 
    virtual void local_peek_range( void **ptr,
                                   void **sig,
                                   const std::size_t n,
-                                  std::size_t &curr_pointer_loc )
+                                  std::size_t &curr_pointer_loc,
+                                  std::size_t &queue_size )
    {
-      for(;;)
-      {
-
-         (this)->datamanager.enterBuffer( dm::peek );
-         if( (this)->datamanager.notResizing() )
-         {
-            if( (this)->size() >= n  )
-            {
-               break;
-            }
-            else if( (this)->is_invalid() && (this)->size() == 0 )
-            {
-               throw ClosedPortAccessException(
-                  "Accessing closed port with local_peek_range call, exiting!!" );
-            }
-            else if( (this)->is_invalid() && (this)->size() < n )
-            {
-               throw NoMoreDataException( "Too few items left on closed port, kernel exiting" );
-            }
-         }
-         (this)->datamanager.exitBuffer( dm::peek );
-#if (defined NICE) && (! defined USEQTHREADS)
-         std::this_thread::yield();
-#if  __x86_64
-         __asm__ volatile("\
-           pause"
-           :
-           :
-           : );
-#endif
-#endif
-#ifdef USEQTHREADS
-         qthread_yield();
-#endif
-      }
-
-      /**
-       * TODO, fix this condition where the user can ask for more,
-       * double buffer.
-       */
-      /** iterate over range, pause if not enough items **/
-      auto * const buff_ptr( (this)->datamanager.get() );
+      (this)->wait_for_range( n );
+      auto * const buff_ptr( (this)->datamanager.get_read() );
       const auto cpl( Pointer::val( buff_ptr->read_pt ) );
       curr_pointer_loc = cpl;
-      *sig =  reinterpret_cast< void* >(  &buff_ptr->signal[ cpl ] );
+      queue_size       = buff_ptr->max_cap;
+      /** autorelease indexes both arrays from their base **/
+      *sig =  reinterpret_cast< void* >( buff_ptr->signal );
       *ptr =  buff_ptr->store;
       return;
    }
@@ -976,23 +548,27 @@ class RingBufferBase<
 : public RingBufferBaseHeap< T, Type::Heap >
 {
 public:
-   RingBufferBase() : RingBufferBaseHeap< T, Type::Heap >()
+   RingBufferBase() : RingBufferBaseHeap< T, Type::Heap >(),
+                      pool( Buffer::slab_pool::make( sizeof( T ),
+                                                     alignof( T ) ) )
    {
    }
 
-   virtual ~RingBufferBase() = default;
+   /**
+    * destructor - items forwarded downstream keep the pool
+    * around until they're released.
+    */
+   virtual ~RingBufferBase()
+   {
+      pool->detach();
+   }
 
    virtual void deallocate()
    {
       auto * const buff_ptr( (this)->datamanager.get() );
       const size_t write_index( Pointer::val( buff_ptr->write_pt ) );
-      auto *ptr(
-        reinterpret_cast< T* >( buff_ptr->store[ write_index ] )
-      );
-      /** call local delete on obj **/
-      ptr->~T();
+      destroy( buff_ptr->store[ write_index ] );
       (this)->allocate_called = false;
-      (this)->datamanager.exitBuffer( dm::allocate );
    }
 
    /**
@@ -1010,7 +586,7 @@ public:
       /** should be the end of the write, regardless of which allocate called **/
       auto * const buff_ptr( (this)->datamanager.get() );
       const size_t write_index( Pointer::val( buff_ptr->write_pt ) );
-      buff_ptr->signal[ write_index ] = signal;
+      buff_ptr->signal->set( write_index, signal );
       (this)->write_stats.bec.count++;
       if( signal == raft::eof )
       {
@@ -1022,7 +598,7 @@ public:
       }
       (this)->allocate_called = false;
       Pointer::inc( buff_ptr->write_pt );
-      (this)->datamanager.exitBuffer( dm::allocate );
+      (this)->waiter.wake_consumer();
    }
 
    /**
@@ -1035,9 +611,12 @@ public:
    {
       if( ! (this)->allocate_called ) return;
       /** should be the end of the write, regardless of which allocate called **/
-      const size_t write_index( Pointer::val( (this)->datamanager.get()->write_pt ) );
-      (this)->datamanager.get()->signal[ write_index ] = signal;
-      Pointer::incBy( (this)->datamanager.get()->write_pt,
+      auto * const buff_ptr( (this)->datamanager.get() );
+      const size_t write_index( Pointer::val( buff_ptr->write_pt ) );
+      /** signal travels with the last item of the range **/
+      buff_ptr->signal->set( ( write_index + (this)->n_allocated - 1 ) %
+                                buff_ptr->max_cap, signal );
+      Pointer::incBy( buff_ptr->write_pt,
                       (this)->n_allocated );
       /** cleanup **/
       (this)->write_stats.bec.count += (this)->n_allocated;
@@ -1051,17 +630,24 @@ public:
       }
       (this)->allocate_called = false;
       (this)->n_allocated     = 0;
-      (this)->datamanager.exitBuffer( dm::allocate_range );
+      (this)->waiter.wake_consumer();
    }
 
 
    virtual void unpeek()
    {
-      (this)->datamanager.exitBuffer( dm::peek );
+      /** nothing held, the peeked item keeps its store from being left **/
    }
 
 protected:
 
+   /** slabs come from where the stores do **/
+   virtual void set_memory_options( const raft::mem::options &mem )
+   {
+      RingBufferBaseHeap< T, Type::Heap >::set_memory_options( mem );
+      pool->set_options( mem );
+   }
+
    /**
     * removes range items from the buffer, ignores
     * them without the copy overhead.
@@ -1074,46 +660,36 @@ protected:
          return;
       }
       do{ /** at least one to remove **/
-         for( ;; )
+         for( std::size_t spins( 0 );; spins++ )
          {
             (this)->datamanager.enterBuffer( dm::recycle );
-            if( (this)->datamanager.notResizing() )
+            if( (this)->readable() > 0 )
             {
-               if( (this)->size() > 0 )
-               {
-                  break;
-               }
-               else if( (this)->is_invalid() && (this)->size() == 0 )
-               {
-                  (this)->datamanager.exitBuffer( dm::recycle );
-                  return;
-               }
+               break;
             }
-            (this)->datamanager.exitBuffer( dm::recycle );
-#if (defined NICE) && (! defined USEQTHREADS)
-            std::this_thread::yield();
-#endif
-#ifdef USEQTHREADS
-         qthread_yield();
-#endif
+            else if( (this)->is_invalid() && (this)->size() == 0 )
+            {
+               return;
+            }
+            (this)->consumer_wait( spins, 1 );
          }
-         auto * const buff_ptr( (this)->datamanager.get() );
+         auto * const buff_ptr( (this)->datamanager.get_read() );
          const size_t read_index( Pointer::val( buff_ptr->read_pt ) );
 
-         auto **ptr( reinterpret_cast< void** >( &( buff_ptr->store[ read_index ] ) )
-         );
-
-         (this)->in->insert(
-            std::make_pair( reinterpret_cast< std::uintptr_t >( *ptr ),
-                            []( void * ptr )
-                            {
-                                auto *actual_ptr(
-                                    reinterpret_cast< T* >( ptr )
-                                );
-                                actual_ptr->~T();
-                            } ) );
+         auto * const item( buff_ptr->store[ read_index ] );
+         if( (this)->in != nullptr )
+         {
+            /** may have been peeked and forwarded, fifo_gc decides **/
+            (this)->in->emplace_back(
+               reinterpret_cast< std::uintptr_t >( item ), destroy );
+         }
+         else
+         {
+            destroy( item );
+         }
+         buff_ptr->signal->take( read_index );
          Pointer::inc( buff_ptr->read_pt );
-         (this)->datamanager.exitBuffer( dm::recycle );
+         (this)->waiter.wake_producer();
       }while( --range > 0 );
       return;
    }
@@ -1129,70 +705,34 @@ protected:
     */
    virtual void local_allocate( void **ptr )
    {
-      for(;;)
+      for( std::size_t spins( 0 );; spins++ )
       {
          (this)->datamanager.enterBuffer( dm::allocate );
-         if( (this)->datamanager.notResizing() && (this)->space_avail() > 0  )
+         if( (this)->writable() > 0  )
          {
             break;
          }
-         (this)->datamanager.exitBuffer( dm::allocate );
-         /** else, spin **/
-         if( (this)->write_stats.bec.blocked == 0 )
-         {
-            (this)->write_stats.bec.blocked = 1;
-         }
-#if (defined NICE) && (! defined USEQTHREADS)
-         std::this_thread::yield();
-#if __x86_64
-         __asm__ volatile("\
-           pause"
-           :
-           :
-           : );
-#endif
-#endif
-#ifdef USEQTHREADS
-         qthread_yield();
-#endif
+         (this)->producer_wait( spins, 1 );
       }
       auto * const buff_ptr( (this)->datamanager.get() );
       const size_t write_index( Pointer::val( buff_ptr->write_pt ) );
+      /** FIFO::allocate constructs the object in the slot **/
+      buff_ptr->store[ write_index ] = reinterpret_cast< T* >( pool->allocate() );
       *ptr = (void*)&( buff_ptr->store[ write_index ] );
       (this)->allocate_called = true;
-      /** call exitBuffer during push call **/
+      /** send() releases it **/
    }
 
    virtual void local_allocate_n( void *ptr, const std::size_t n )
    {
-      for( ;; )
+      for( std::size_t spins( 0 );; spins++ )
       {
          (this)->datamanager.enterBuffer( dm::allocate_range );
-         if( (this)->datamanager.notResizing() && (this)->space_avail() >= n )
+         if( (this)->writable() >= n )
          {
             break;
          }
-         else
-         {
-            (this)->datamanager.exitBuffer( dm::allocate_range );
-         }
-         if( (this)->write_stats.bec.blocked == 0 )
-         {
-            (this)->write_stats.bec.blocked = 1;
-         }
-#if (defined NICE) && (! defined USEQTHREADS)
-         std::this_thread::yield();
-#if __x86_64
-       __asm__ volatile("\
-         pause"
-         :
-         :
-         : );
-#endif
-#endif
-#ifdef USEQTHREADS
-         qthread_yield();
-#endif
+         (this)->producer_wait( spins, n );
       }
       auto *container(
          reinterpret_cast< std::vector< std::reference_wrapper< T > >* >( ptr ) );
@@ -1209,13 +749,16 @@ protected:
           * TODO, fix this logic here, write index must get iterated, but
           * not here
           */
-         container->emplace_back(
-            *reinterpret_cast< T* >( buff_ptr->store[ write_index ] ) );
-         buff_ptr->signal[ write_index ] = raft::none;
-         write_index = ( write_index + 1 ) % buff_ptr->max_cap;
+         buff_ptr->store[ write_index ] = construct( pool->allocate() );
+         container->emplace_back( *buff_ptr->store[ write_index ] );
+         if( ++write_index == buff_ptr->max_cap )
+         {
+            write_index = 0;
+         }
       }
+      (this)->n_allocated = static_cast< decltype( (this)->n_allocated ) >( n );
       (this)->allocate_called = true;
-      /** exitBuffer() called by push_range **/
+      /** send_range() releases them **/
    }
 
 
@@ -1232,63 +775,42 @@ protected:
     */
    virtual void  local_push( void *ptr, const raft::signal &signal )
    {
-      for(;;)
+      for( std::size_t spins( 0 );; spins++ )
       {
          (this)->datamanager.enterBuffer( dm::push );
-         if( (this)->datamanager.notResizing() )
-         {
-            if( (this)->space_avail() > 0 )
-            {
-               break;
-            }
-         }
-         (this)->datamanager.exitBuffer( dm::push );
-         if( (this)->write_stats.bec.blocked == 0 )
+         if( (this)->writable() > 0 )
          {
-            (this)->write_stats.bec.blocked = 1;
+            break;
          }
-#if (defined NICE) && (! defined USEQTHREADS)
-         std::this_thread::yield();
-#if __x86_64
-         __asm__ volatile("\
-           pause"
-           :
-           :
-           : );
-#endif
-#endif
-#ifdef USEQTHREADS
-         qthread_yield();
-#endif
+         (this)->producer_wait( spins, 1 );
       }
       auto * const buff_ptr( (this)->datamanager.get() );
        const size_t write_index( Pointer::val( buff_ptr->write_pt ) );
       if( ptr != nullptr )
       {
-         /** might be faster to simply check stack range for alloc loc **/
          T *item( reinterpret_cast< T* >( ptr ) );
          auto **b_ptr( reinterpret_cast< T** >( &buff_ptr->store[ write_index ] ) );
 
-         if( (this)->out_peek->find(
-            reinterpret_cast< std::uintptr_t >( item ) ) != (this)->out_peek->cend() )
+         if( (this)->out_peek != nullptr &&
+             (this)->out_peek->contains( reinterpret_cast< std::uintptr_t >( item ) ) )
          {
-            //this was from a previous peek call
+            /** from a previous peek, the slot moves on as is **/
             (this)->out->insert( reinterpret_cast< std::uintptr_t >( item ) );
             *b_ptr = item;
          }
-         else /** hope we have a move/copy constructor **/
+         else /** hope we have a copy constructor **/
          {
-            *b_ptr = new T( *item );
+            *b_ptr = new ( pool->allocate() ) T( *item );
          }
          (this)->write_stats.bec.count++;
        }
-      buff_ptr->signal[ write_index ]         = signal;
+      buff_ptr->signal->set( write_index, signal );
        Pointer::inc( buff_ptr->write_pt );
       if( signal == raft::quit )
       {
          (this)->write_finished = true;
       }
-      (this)->datamanager.exitBuffer( dm::push );
+      (this)->waiter.wake_consumer();
    }
 
    /**
@@ -1301,52 +823,38 @@ protected:
    virtual void
    local_pop( void *ptr, raft::signal *signal )
    {
-      for(;;)
+      for( std::size_t spins( 0 );; spins++ )
       {
          (this)->datamanager.enterBuffer( dm::pop );
-         if( (this)->datamanager.notResizing() )
+         if( (this)->readable() > 0 )
          {
-            if( (this)->size() > 0 )
-            {
-               break;
-            }
-            else if( (this)->is_invalid() && (this)->size() == 0 )
-            {
-               throw ClosedPortAccessException(
-                  "Accessing closed port with pop call, exiting!!" );
-            }
+            break;
          }
-         else
+         else if( (this)->is_invalid() && (this)->size() == 0 )
          {
-            (this)->datamanager.exitBuffer( dm::pop );
-            if( (this)->read_stats.bec.blocked == 0 )
-            {
-               (this)->read_stats.bec.blocked  = 1;
-            }
-#if (defined NICE) && (! defined USEQTHREADS)
-            std::this_thread::yield();
-#endif
-#ifdef USEQTHREADS
-         qthread_yield();
-#endif
+            throw ClosedPortAccessException(
+               "Accessing closed port with pop call, exiting!!" );
          }
+         (this)->consumer_wait( spins, 1 );
       }
-      auto * const buff_ptr( (this)->datamanager.get() );
+      auto * const buff_ptr( (this)->datamanager.get_read() );
       const std::size_t read_index( Pointer::val( buff_ptr->read_pt ) );
+      /** take even if nobody wants it, clears the slot **/
+      const auto sig( buff_ptr->signal->take( read_index ) );
       if( signal != nullptr )
       {
-         *signal = buff_ptr->signal[ read_index ];
+         *signal = sig;
       }
       assert( ptr != nullptr );
       /** gotta dereference pointer and copy **/
       T *item( reinterpret_cast< T* >( ptr ) );
       auto *head( reinterpret_cast< T* >( buff_ptr->store[ read_index ] ) );
-      *item = *head;
+      *item = std::move( *head );
       /** only increment here b/c we're actually reading an item **/
       (this)->read_stats.bec.count++;
       Pointer::inc( buff_ptr->read_pt );
-      head->~T();
-      (this)->datamanager.exitBuffer( dm::pop );
+      destroy( head );
+      (this)->waiter.wake_producer();
    }
 
 
@@ -1359,42 +867,26 @@ protected:
     */
    virtual void local_peek(  void **ptr, raft::signal *signal )
    {
-      for(;;)
+      for( std::size_t spins( 0 );; spins++ )
       {
 
          (this)->datamanager.enterBuffer( dm::peek );
-         if( (this)->datamanager.notResizing() )
+         if( (this)->readable() > 0 )
          {
-            if( (this)->size() > 0  )
-            {
-               break;
-            }
-            else if( (this)->is_invalid() && (this)->size() == 0 )
-            {
-               throw ClosedPortAccessException(
-                  "Accessing closed port with local_peek call, exiting!!" );
-            }
+            break;
          }
-         (this)->datamanager.exitBuffer( dm::peek );
-#if (defined NICE) && (! defined USEQTHREADS)
-         std::this_thread::yield();
-#if  __x86_64
-         __asm__ volatile("\
-           pause"
-           :
-           :
-           : );
-#endif
-#endif
-#ifdef USEQTHREADS
-         qthread_yield();
-#endif
+         else if( (this)->is_invalid() && (this)->size() == 0 )
+         {
+            throw ClosedPortAccessException(
+               "Accessing closed port with local_peek call, exiting!!" );
+         }
+         (this)->consumer_wait( spins, 1 );
       }
-      auto * const buff_ptr( (this)->datamanager.get() );
+      auto * const buff_ptr( (this)->datamanager.get_read() );
       const size_t read_index( Pointer::val( buff_ptr->read_pt ) );
       if( signal != nullptr )
       {
-         *signal = buff_ptr->signal[ read_index ];
+         *signal = buff_ptr->signal->get( read_index );
       }
       //actual pointer
       auto ***real_ptr( reinterpret_cast< T*** >( ptr ) );
@@ -1407,56 +899,41 @@ protected:
                       sizeof( T ) < sizeof( std::uintptr_t ) << 7 ?
                       sizeof( T ) : sizeof( std::uintptr_t ) << 7
                       >( **real_ptr );
-      (this)->in_peek->insert( reinterpret_cast< ptr_t >( **real_ptr ) );
+      if( (this)->in_peek != nullptr )
+      {
+         (this)->in_peek->insert( reinterpret_cast< ptr_t >( **real_ptr ) );
+      }
       return;
       /**
-       * exitBuffer() called when recycle is called, can't be sure the
-       * reference isn't being used until all outside accesses to it are
-       * invalidated from the buffer.
+       * the item stays in the store until recycle is called, which
+       * also keeps the consumer from moving to another store.
        */
    }
 
    virtual void local_peek_range( void **ptr,
                                   void **sig,
                                   const std::size_t n,
-                                  std::size_t &curr_pointer_loc )
+                                  std::size_t &curr_pointer_loc,
+                                  std::size_t &queue_size )
    {
-      for(;;)
+      for( std::size_t spins( 0 );; spins++ )
       {
 
          (this)->datamanager.enterBuffer( dm::peek );
-         if( (this)->datamanager.notResizing() )
+         if( (this)->readable() >= n )
          {
-            if( (this)->size() >= n  )
-            {
-               break;
-            }
-            else if( (this)->is_invalid() && (this)->size() == 0 )
-            {
-               (this)->datamanager.exitBuffer( dm::peek );
-               throw ClosedPortAccessException(
-                  "Accessing closed port with local_peek_range call, exiting!!" );
-            }
-            else if( (this)->is_invalid() && (this)->size() < n )
-            {
-               (this)->datamanager.exitBuffer( dm::peek );
-               throw NoMoreDataException( "Too few items left on closed port, kernel exiting" );
-            }
+            break;
          }
-         (this)->datamanager.exitBuffer( dm::peek );
-#if (defined NICE) && (! defined USEQTHREADS)
-         std::this_thread::yield();
-#if  __x86_64
-         __asm__ volatile("\
-           pause"
-           :
-           :
-           : );
-#endif
-#endif
-#ifdef USEQTHREADS
-         qthread_yield();
-#endif
+         else if( (this)->is_invalid() && (this)->size() == 0 )
+         {
+            throw ClosedPortAccessException(
+               "Accessing closed port with local_peek_range call, exiting!!" );
+         }
+         else if( (this)->is_invalid() && (this)->size() < n )
+         {
+            throw NoMoreDataException( "Too few items left on closed port, kernel exiting" );
+         }
+         (this)->consumer_wait( spins, n );
       }
 
       /**
@@ -1464,15 +941,52 @@ protected:
        * double buffer.
        */
       /** iterate over range, pause if not enough items **/
-      auto * const buff_ptr( (this)->datamanager.get() );
+      auto * const buff_ptr( (this)->datamanager.get_read() );
       const auto cpl( Pointer::val( buff_ptr->read_pt ) );
       curr_pointer_loc = cpl;
-      *sig =  reinterpret_cast< void* >(  &buff_ptr->signal[ cpl ] );
+      queue_size       = buff_ptr->max_cap;
+      /** autorelease indexes both arrays from their base **/
+      *sig =  reinterpret_cast< void* >( buff_ptr->signal );
       *ptr =  buff_ptr->store;
       return;
    }
 
+   /**
+    * destroy - done with the item, the slot goes back to the
+    * pool it came from, which may be another FIFO's if the item
+    * was forwarded.  Also the recyclefunc_t for fifo_gc.
+    * @param   ptr - item from a pool
+    */
+   static void destroy( void *ptr )
+   {
+      reinterpret_cast< T* >( ptr )->~T();
+      Buffer::slab_pool::release( ptr );
+   }
+
+   /**
+    * construct - default constructs the objects handed out by
+    * allocate_range, which has no constructor arguments.
+    */
+   template < class U = T,
+              typename std::enable_if<
+                 std::is_default_constructible< U >::value >::type* = nullptr >
+   static T* construct( void *ptr )
+   {
+      return( new ( ptr ) T() );
+   }
+
+   template < class U = T,
+              typename std::enable_if<
+                 ! std::is_default_constructible< U >::value >::type* = nullptr >
+   static T* construct( void *ptr )
+   {
+      /** nothing sensible to build, use allocate instead **/
+      assert( false );
+      return( reinterpret_cast< T* >( ptr ) );
+   }
 
+   /** slots for this FIFO's items, see slabpool.hpp **/
+   Buffer::slab_pool * const pool;
 };
 
 #endif /* END _RINGBUFFERHEAP_TCC_ */
@@ -20,13 +20,14 @@
 #ifndef _RINGBUFFERHEAP_ABSTRACT_TCC_
 #define _RINGBUFFERHEAP_ABSTRACT_TCC_  1
 
+#include <iterator>
+#include <utility>
+#include <vector>
+
 #include "portexception.hpp"
 #include "optdef.hpp"
 #include "scheduleconst.hpp"
 #include "defs.hpp"
-#ifdef USEQTHREADS
-#include <qthread/qthread.hpp>
-#endif
 
 template < class T,  Type::RingBufferType type > 
 class RingBufferBaseHeap : public FIFOAbstract< T, type> 
@@ -48,68 +49,7 @@ public:
     */
    virtual std::size_t   size() noexcept
    {  
-      for( ;; )
-      {
-         datamanager.enterBuffer( dm::size );
-         if( datamanager.notResizing() )
-         {
-            auto * const buff_ptr( datamanager.get() );
-TOP:      
-            const auto   wrap_write( Pointer::wrapIndicator( buff_ptr->write_pt  ) ),
-                         wrap_read(  Pointer::wrapIndicator( buff_ptr->read_pt   ) );
-
-            const auto   wpt( Pointer::val( buff_ptr->write_pt ) ), 
-                         rpt( Pointer::val( buff_ptr->read_pt  ) );
-            if( R_UNLIKELY (wpt == rpt) )
-            {
-               /** expect most of the time to be full **/
-               if( R_LIKELY( wrap_read < wrap_write ) )
-               {
-                  datamanager.exitBuffer( dm::size );
-                  return( buff_ptr->max_cap );
-               }
-               else if( wrap_read > wrap_write )
-               {
-                  /**
-                   * TODO, this condition is momentary, however there
-                   * is a better way to fix this with atomic operations...
-                   * or on second thought benchmarking shows the atomic
-                   * operations slows the queue down drastically so, perhaps
-                   * this is in fact the best of all possible returns (see 
-                   * Leibniz or Candide for further info).
-                   */
-#ifndef USEQTHREADS                   
-                  std::this_thread::yield();
-#else
-                  qthread_yield();
-#endif
-                  goto TOP;
-               }
-               else
-               {
-                  datamanager.exitBuffer( dm::size );
-                  return( 0 );
-               }
-            }
-            else if( rpt < wpt )
-            {
-               datamanager.exitBuffer( dm::size );
-               return( wpt - rpt );
-            }
-            else if( rpt > wpt )
-            {
-               datamanager.exitBuffer( dm::size );
-               return( buff_ptr->max_cap - rpt + wpt ); 
-            }
-            datamanager.exitBuffer( dm::size );
-            return( 0 );
-         }
-         datamanager.exitBuffer( dm::size );
-#ifdef USEQTHREADS                   
-                  qthread_yield();
-#endif
-      } /** end for **/
-      return( 0 ); /** keep some compilers happy **/
+      return( datamanager.size() );
    }
 
 
@@ -123,8 +63,9 @@ TOP:
     */
    virtual void invalidate()
    {
-      auto * const ptr( datamanager.get() );
-      ptr->is_valid = false;
+      datamanager.invalidate();
+      /** a parked consumer has to see end of stream **/
+      waiter.close();
       return;
    }
    
@@ -137,8 +78,7 @@ TOP:
     */
    virtual bool is_invalid()
    {
-      auto * const ptr( datamanager.get() );
-      return( ! ptr->is_valid );
+      return( ! datamanager.is_valid() );
    }
 
 
@@ -150,7 +90,7 @@ TOP:
     */
    virtual std::size_t   space_avail()
    {
-      return( datamanager.get()->max_cap - size() );
+      return( datamanager.space_avail() );
    }
   
    /**
@@ -160,7 +100,12 @@ TOP:
     */
    virtual std::size_t   capacity() 
    {
-      return( datamanager.get()->max_cap );
+      return( datamanager.capacity() );
+   }
+
+   virtual void reclaim()
+   {
+      datamanager.reclaim();
    }
 
    
@@ -186,9 +131,20 @@ TOP:
    virtual void get_zero_write_stats( Blocked &copy )
    {
       copy.all       = write_stats.all;
+      written       += write_stats.bec.count;
       write_stats.all = 0;
    }
 
+   /**
+    * get_items_written - items pushed since the FIFO was
+    * made, see FIFO::get_items_written.
+    * @return  std::uint64_t
+    */
+   virtual std::uint64_t get_items_written()
+   {
+      return( written + write_stats.bec.count );
+   }
+
    /**
     * get_write_finished - does exactly what it says, 
     * sets the param variable to true when all writes
@@ -202,6 +158,94 @@ TOP:
       write_finished = (this)->write_finished;
    }
    
+   /**
+    * push_item - local_push for types stored inline, not virtual
+    * so that TypedFIFO can inline it into the kernel.  A null
+    * item sends the signal alone.
+    * @param   item   - const T*, copied in
+    * @param   signal - const raft::signal
+    */
+   template < class U = T,
+              typename std::enable_if< inline_alloc< U >::value >::type* = nullptr >
+   inline void push_item( const T * const item, const raft::signal signal )
+   {
+      wait_for_space( dm::push );
+      auto * const buff_ptr( datamanager.get() );
+      const auto write_index( Pointer::val( buff_ptr->write_pt ) );
+      if( item != nullptr )
+      {
+         copy_in( item, &buff_ptr->store[ write_index ], 1 );
+         write_stats.bec.count++;
+      }
+      buff_ptr->signal->set( write_index, signal );
+      Pointer::inc( buff_ptr->write_pt );
+      if( signal == raft::quit )
+      {
+         write_finished = true;
+      }
+      waiter.wake_consumer();
+   }
+
+   /**
+    * pop_item - local_pop for types stored inline, a null item
+    * throws the head away.
+    * @param   item   - T*, copied out to
+    * @param   signal - raft::signal*, may be null
+    * @throws  ClosedPortAccessException
+    */
+   template < class U = T,
+              typename std::enable_if< inline_alloc< U >::value >::type* = nullptr >
+   inline void pop_item( T * const item, raft::signal * const signal )
+   {
+      if( R_UNLIKELY( wait_for_data( dm::pop ) == 0 ) )
+      {
+         throw ClosedPortAccessException(
+            "Accessing closed port with pop call, exiting!!" );
+      }
+      auto * const buff_ptr( datamanager.get_read() );
+      const auto read_index( Pointer::val( buff_ptr->read_pt ) );
+      /** take even if nobody wants it, clears the slot **/
+      const auto sig( buff_ptr->signal->take( read_index ) );
+      if( signal != nullptr )
+      {
+         *signal = sig;
+      }
+      if( item != nullptr )
+      {
+         *item = buff_ptr->store[ read_index ];
+         /** only increment here b/c we're actually reading an item **/
+         read_stats.bec.count++;
+      }
+      Pointer::inc( buff_ptr->read_pt );
+      waiter.wake_producer();
+   }
+
+   /**
+    * peek_item - local_peek for types stored inline, the item
+    * stays in the store until recycle is called, which also
+    * keeps the consumer from moving to another store.
+    * @param   signal - raft::signal*, may be null
+    * @return  T*, the head
+    * @throws  ClosedPortAccessException
+    */
+   template < class U = T,
+              typename std::enable_if< inline_alloc< U >::value >::type* = nullptr >
+   inline T* peek_item( raft::signal * const signal )
+   {
+      if( R_UNLIKELY( wait_for_data( dm::peek ) == 0 ) )
+      {
+         throw ClosedPortAccessException(
+            "Accessing closed port with local_peek call, exiting!!" );
+      }
+      auto * const buff_ptr( datamanager.get_read() );
+      const auto read_index( Pointer::val( buff_ptr->read_pt ) );
+      if( signal != nullptr )
+      {
+         *signal = buff_ptr->signal->get( read_index );
+      }
+      return( &buff_ptr->store[ read_index ] );
+   }
+
 
 protected:
    /**
@@ -235,6 +279,42 @@ protected:
        (this)->out_peek = peekset;
    }
 
+   virtual void set_wait_strategy( const raft::wait::strategy strategy )
+   {
+      waiter.set( strategy );
+   }
+
+   virtual void set_ready_bits( const ReadyBit &data,
+                                const ReadyBit &space,
+                                const ReadyBit &closed )
+   {
+      waiter.set_ready_bits( data, space, closed );
+   }
+
+   virtual void set_resize_signal( const ResizeSignal &signal )
+   {
+      resize_signal = signal;
+   }
+
+   virtual void set_memory_options( const raft::mem::options &mem )
+   {
+      mem_options = mem;
+      /** user supplied buffers stay where they are **/
+      if( mem.custom() && datamanager.is_resizeable() )
+      {
+         datamanager.replace( 
+            new Buffer::Data< T, type >( datamanager.capacity(), 16, mem ) );
+      }
+   }
+
+   virtual void idle_wait( const std::size_t spins )
+   {
+      waiter.consumer_wait( spins,
+                            write_stats,
+                            [&](){ return( (this)->is_invalid() ||
+                                           (this)->size() > 0 ); } );
+   }
+
    /**
     * set_src_kernel - sets teh protected source
     * kernel for this fifo, necessary for preemption,
@@ -244,12 +324,7 @@ protected:
    virtual void set_src_kernel( raft::kernel * const k )
    {
       assert( k != nullptr );
-      while( ! datamanager.notResizing() )
-      { 
-         /* spin */ 
-      }
-      auto * const buffer( datamanager.get() );
-      buffer->setSourceKernel( k );
+      datamanager.get()->setSourceKernel( k );
    }
 
 
@@ -262,12 +337,7 @@ protected:
    virtual void set_dst_kernel( raft::kernel * const k )
    {
       assert( k != nullptr );
-      while( ! datamanager.notResizing() )
-      {
-         /* spin */
-      }
-      auto * const buffer( datamanager.get() );
-      buffer->setDestKernel( k );
+      datamanager.get()->setDestKernel( k );
    }
 
    /**
@@ -283,13 +353,13 @@ protected:
        * be quick since it'll be used quite often in tight
        * loops I think we'll be okay with getting the current
        * pointer to the head of the queue and returning the
-       * value.  Logically copying the queue shouldn't effect
-       * this value since the elements all remain in their 
-       * location relative to the start of the queue.
+       * value.  A resize leaves queued items where they are
+       * so the head doesn't move.
        */
-      auto * const buff_ptr( datamanager.get() );
+      datamanager.enterBuffer( dm::peek );
+      auto * const buff_ptr( datamanager.get_read() );
       const size_t read_index( Pointer::val( buff_ptr->read_pt ) );
-      return( buff_ptr->signal[ read_index ] /* make copy */ ); 
+      return( buff_ptr->signal->get( read_index ) ); 
    }
    /**
     * signal_pop - special function fo rthe scheduler to 
@@ -312,31 +382,123 @@ protected:
                              iterator_type end,
                              const raft::signal &signal )
    {
-      /**
-       * TODO, not happy with the performance of the current 
-       * solution.  This could easily be much faster with streaming
-       * copies.
-       */
+      (this)->template insert_range< T >( begin, end, signal );
+      return;
+   }
+
+   /**
+    * insert_range - bulk version for inline types, enters the
+    * buffer once per batch of free slots, copies the batch in at
+    * most two contiguous segments (either side of the wrap point)
+    * and advances the write pointer once.  The signal travels
+    * with the last item of the range.
+    */
+   template < class U,
+              class iterator_type,
+              typename std::enable_if< inline_alloc< U >::value >::type* = nullptr >
+   void insert_range( iterator_type begin,
+                      iterator_type end,
+                      const raft::signal &signal )
+   {
+      std::size_t remaining( std::distance( begin, end ) );
+      while( remaining > 0 )
+      {
+         const auto avail( (this)->wait_for_space( dm::push ) );
+         const auto n( avail < remaining ? avail : remaining );
+         auto * const buff_ptr( datamanager.get() );
+         const std::size_t write_index( Pointer::val( buff_ptr->write_pt ) );
+         const auto to_end( buff_ptr->max_cap - write_index );
+         const auto first( n < to_end ? n : to_end );
+         begin = copy_in( begin, &buff_ptr->store[ write_index ], first );
+         begin = copy_in( begin, &buff_ptr->store[ 0 ], n - first );
+         remaining -= n;
+         if( remaining == 0 )
+         {
+            buff_ptr->signal->set( ( write_index + n - 1 ) % buff_ptr->max_cap,
+                                   signal );
+            if( signal == raft::quit )
+            {
+               (this)->write_finished = true;
+            }
+         }
+         write_stats.bec.count += n;
+         Pointer::incBy( buff_ptr->write_pt, n );
+         waiter.wake_consumer();
+      }
+      return;
+   }
+
+   /**
+    * insert_range - externally allocated types need the pointer
+    * hand-off logic in local_push, so these go one at a time.
+    */
+   template < class U,
+              class iterator_type,
+              typename std::enable_if< ext_alloc< U >::value >::type* = nullptr >
+   void insert_range( iterator_type begin,
+                      iterator_type end,
+                      const raft::signal &signal )
+   {
       auto dist( std::distance( begin, end ) );
       const raft::signal dummy( raft::none );
       while( dist-- )
       {
-         /** use global push function **/
-         if( dist == 0 )
-         {
-            /** add signal to last el only **/
-            (this)->local_push( (void*) &(*begin), signal );
-         }
-         else
-         {
-            (this)->local_push( (void*)&(*begin), dummy );
-         }
+         /** add signal to last el only **/
+         (this)->local_push( (void*) &(*begin), dist == 0 ? signal : dummy );
          ++begin;
       }
       return;
    }
-   
 
+   /**
+    * copy_in - copy n items from begin into contiguous slots
+    * starting at store, returns the advanced iterator.
+    */
+   template < class iterator_type,
+              class U,
+              typename std::enable_if< 
+                  inline_nonclass_alloc< U >::value >::type* = nullptr >
+   static iterator_type copy_in( iterator_type begin, 
+                                 U * const store, 
+                                 const std::size_t n )
+   {
+      for( std::size_t i( 0 ); i < n; i++, ++begin )
+      {
+         store[ i ] = *begin;
+      }
+      return( begin );
+   }
+
+   template < class iterator_type,
+              class U,
+              typename std::enable_if< 
+                  inline_class_alloc< U >::value >::type* = nullptr >
+   static iterator_type copy_in( iterator_type begin, 
+                                 U * const store, 
+                                 const std::size_t n )
+   {
+      for( std::size_t i( 0 ); i < n; i++, ++begin )
+      {
+         U * temp( new ( &store[ i ] ) U( *begin ) );
+         UNUSED( temp );
+      }
+      return( begin );
+   }
+
+   /**
+    * drop_signals - clears the signals of the n items at the
+    * read pointer, for items that leave without being read.
+    */
+   static void drop_signals( Buffer::Data< T, type > * const buff_ptr,
+                             const std::size_t n )
+   {
+      const std::size_t read_index( Pointer::val( buff_ptr->read_pt ) );
+      const auto to_end( buff_ptr->max_cap - read_index );
+      const auto first( n < to_end ? n : to_end );
+      buff_ptr->signal->clear_range( read_index, first );
+      buff_ptr->signal->clear_range( 0, n - first );
+   }
+   
    /**
     * insert - inserts the range from begin to end in the queue,
     * blocks until space is available.  If the range is greater than
@@ -412,18 +574,274 @@ protected:
             std::vector< std::pair< T, raft::signal > >* >( ptr_data ) );
       /** just in case **/
       assert( items->size() == n_items );
-      /**
-       * TODO: same as with the other range function
-       * I'm not too  happy with the performance on this
-       * one.  It'd be relatively easy to fix with a little
-       * time.
-       */
-      for( auto &pair : (*items))
+      (this)->template pop_range< T >( *items );
+      return;
+   }
+
+   /**
+    * pop_range - bulk version for inline types, copies out as
+    * many items as are available (up to what is left to fill)
+    * in at most two contiguous segments and advances the read
+    * pointer once per batch.
+    */
+   template < class U,
+              typename std::enable_if< inline_alloc< U >::value >::type* = nullptr >
+   void pop_range( std::vector< std::pair< T, raft::signal > > &items )
+   {
+      const std::size_t n_items( items.size() );
+      std::size_t done( 0 );
+      while( done < n_items )
+      {
+         const auto avail( (this)->wait_for_data( dm::pop ) );
+         if( avail == 0 )
+         {
+            throw ClosedPortAccessException(
+               "Accessing closed port with pop_range call, exiting!!" );
+         }
+         const auto remaining( n_items - done );
+         const auto n( avail < remaining ? avail : remaining );
+         auto * const buff_ptr( datamanager.get_read() );
+         const std::size_t read_index( Pointer::val( buff_ptr->read_pt ) );
+         const auto to_end( buff_ptr->max_cap - read_index );
+         const auto first( n < to_end ? n : to_end );
+         for( std::size_t i( 0 ); i < first; i++ )
+         {
+            items[ done + i ].first  = buff_ptr->store[ read_index + i ];
+            items[ done + i ].second = raft::none;
+         }
+         for( std::size_t i( first ); i < n; i++ )
+         {
+            items[ done + i ].first  = buff_ptr->store[ i - first ];
+            items[ done + i ].second = raft::none;
+         }
+         buff_ptr->signal->take_range( read_index, first,
+            [&]( const std::size_t offset, const raft::signal sig )
+            {
+               items[ done + offset ].second = sig;
+            } );
+         buff_ptr->signal->take_range( 0, n - first,
+            [&]( const std::size_t offset, const raft::signal sig )
+            {
+               items[ done + first + offset ].second = sig;
+            } );
+         read_stats.bec.count += n;
+         Pointer::incBy( buff_ptr->read_pt, n );
+         waiter.wake_producer();
+         done += n;
+      }
+      return;
+   }
+
+   template < class U,
+              typename std::enable_if< ext_alloc< U >::value >::type* = nullptr >
+   void pop_range( std::vector< std::pair< T, raft::signal > > &items )
+   {
+      for( auto &pair : items )
       {
          (this)->pop( pair.first, &(pair.second) );
       }
       return;
    }
+
+   /**
+    * wait_for_space - enters the buffer with key and blocks
+    * until there is at least one free slot in the producer's
+    * store.
+    * @param   key - dm::access_key
+    * @return  std::size_t - number of free slots
+    */
+   std::size_t wait_for_space( const dm::access_key key )
+   {
+      for( std::size_t spins( 0 );; spins++ )
+      {
+         datamanager.enterBuffer( key );
+         const auto avail( (this)->writable() );
+         if( avail > 0 )
+         {
+            return( avail );
+         }
+         producer_wait( spins, 1 );
+      }
+      return( 0 ); /** keep some compilers happy **/
+   }
+
+   /**
+    * wait_for_data - enters the buffer with key and blocks until
+    * there is at least one item to read in the consumer's store.
+    * Returns the number of items readable from that store, if
+    * the queue is invalid and empty then it returns zero.
+    * @param   key - dm::access_key
+    * @return  std::size_t - number of readable items
+    */
+   std::size_t wait_for_data( const dm::access_key key )
+   {
+      for( std::size_t spins( 0 );; spins++ )
+      {
+         datamanager.enterBuffer( key );
+         const auto avail( (this)->readable() );
+         if( avail > 0 )
+         {
+            return( avail );
+         }
+         else if( (this)->is_invalid() && (this)->size() == 0 )
+         {
+            return( 0 );
+         }
+         consumer_wait( spins, 1 );
+      }
+      return( 0 ); /** keep some compilers happy **/
+   }
+
+   /**
+    * writable - producer side, free slots in the store the
+    * producer is writing to.  Call after enterBuffer().
+    * @return  std::size_t
+    */
+   inline std::size_t writable() noexcept
+   {
+      auto * const buff_ptr( datamanager.get() );
+      return( buff_ptr->max_cap - DataManager< T, type >::count( buff_ptr ) );
+   }
+
+   /**
+    * readable - consumer side, items in the store the consumer
+    * is reading from, which after a resize may be fewer than
+    * size() returns.  Call after enterBuffer().
+    * @return  std::size_t
+    */
+   inline std::size_t readable() noexcept
+   {
+      return( DataManager< T, type >::count( datamanager.get_read() ) );
+   }
+
+   /**
+    * wait_for_range - consumer side of peek_range, enters the
+    * buffer and blocks until n items are readable from one
+    * store.  If the producer has moved on to a new store and
+    * left fewer than n behind, the items are gathered into a
+    * store of their own.  Throws if the queue closes first.
+    * @param   n - std::size_t
+    */
+   void wait_for_range( const std::size_t n )
+   {
+      for( std::size_t spins( 0 );; spins++ )
+      {
+         datamanager.enterBuffer( dm::peek );
+         if( (this)->readable() >= n )
+         {
+            return;
+         }
+         const auto queued( (this)->size() );
+         if( queued >= n && datamanager.sealed() )
+         {
+            /** 
+             * short lived and first touched by the consumer, so
+             * the memory options aren't worth it here
+             */
+            datamanager.gather( new Buffer::Data< T, type >( n, 16 ),
+                                n,
+                                []( Buffer::Data< T, type > * const src,
+                                    const std::size_t        src_index,
+                                    Buffer::Data< T, type > * const dst,
+                                    const std::size_t        dst_index,
+                                    const std::size_t        count )
+                                {
+                                   move_items< T >( &src->store [ src_index ],
+                                                    &dst->store [ dst_index ],
+                                                    count );
+                                   src->signal->take_range( src_index, count,
+                                      [&]( const std::size_t offset,
+                                           const raft::signal sig )
+                                      {
+                                         dst->signal->set( dst_index + offset, sig );
+                                      } );
+                                } );
+            continue;
+         }
+         else if( (this)->is_invalid() && queued == 0 )
+         {
+            throw ClosedPortAccessException(
+               "Accessing closed port with local_peek_range call, exiting!!" );
+         }
+         else if( (this)->is_invalid() && queued < n )
+         {
+            throw NoMoreDataException( "Too few items left on closed port, kernel exiting" );
+         }
+         consumer_wait( spins, n );
+      }
+   }
+
+   /**
+    * move_items - move count items between two stores,
+    * the source slots are left unconstructed.
+    */
+   template < class U,
+              typename std::enable_if<
+                  inline_nonclass_alloc< U >::value >::type* = nullptr >
+   static void move_items( U * const src, U * const dst, const std::size_t count )
+   {
+      for( std::size_t i( 0 ); i < count; i++ )
+      {
+         dst[ i ] = src[ i ];
+      }
+   }
+
+   template < class U,
+              typename std::enable_if<
+                  inline_class_alloc< U >::value >::type* = nullptr >
+   static void move_items( U * const src, U * const dst, const std::size_t count )
+   {
+      for( std::size_t i( 0 ); i < count; i++ )
+      {
+         U * temp( new ( &dst[ i ] ) U( std::move( src[ i ] ) ) );
+         UNUSED( temp );
+         src[ i ].~U();
+      }
+   }
+
+   /**
+    * producer_wait - marks the write side blocked then waits per
+    * the wait strategy, call with the buffer exited each time
+    * around a loop that found fewer than n free slots.
+    * @param   spins - times the caller has already waited
+    * @param   n     - number of free slots the caller needs
+    */
+   void producer_wait( const std::size_t spins, const std::size_t n )
+   {
+      if( write_stats.bec.blocked == 0 )
+      {
+         write_stats.bec.blocked = 1;
+      }
+      if( R_UNLIKELY( spins == WaitStrategy::blocked_spins ) )
+      {
+         /** let the allocator know, it may grow the buffer **/
+         resize_signal.post();
+      }
+      waiter.producer_wait( spins,
+                            write_stats,
+                            [&](){ return( (this)->space_avail() >= n ); } );
+   }
+
+   /**
+    * consumer_wait - marks the read side blocked then waits per
+    * the wait strategy, call with the buffer exited each time
+    * around a loop that found fewer than n items.  The adaptive
+    * strategy keys off of the write stats for both ends since
+    * those are the ones the allocator zeroes each interval.
+    * @param   spins - times the caller has already waited
+    * @param   n     - number of items the caller needs
+    */
+   void consumer_wait( const std::size_t spins, const std::size_t n )
+   {
+      if( read_stats.bec.blocked == 0 )
+      {
+         read_stats.bec.blocked = 1;
+      }
+      waiter.consumer_wait( spins,
+                            write_stats,
+                            [&](){ return( (this)->is_invalid() ||
+                                           (this)->size() >= n ); } );
+   }
    
    
    /** 
@@ -441,6 +859,8 @@ protected:
     */
    Blocked                     read_stats;
    Blocked                     write_stats;
+   /** write counts already taken out of write_stats **/
+   std::uint64_t               written = 0;
    /** 
     * This should be okay outside of the buffer, its local 
     * to the writing thread.  Variable gets set "true" in
@@ -449,6 +869,12 @@ protected:
     */
    /** TODO, this needs to get moved into the buffer for SHM **/
    volatile bool                write_finished = false;
+   /** what to do when full or empty, set by the allocator **/
+   WaitStrategy                 waiter;
+   /** tells the allocator's resize policy the producer blocked **/
+   ResizeSignal                 resize_signal;
+   /** huge pages and placement for every store, set by the allocator **/
+   raft::mem::options           mem_options;
    ptr_map_t                   *in = nullptr;
    ptr_set_t                   *out = nullptr;
    /** these are named with reference to the kernel, in == kernel in **/
@@ -97,7 +97,9 @@ public:
    virtual void send( const raft::signal signal = raft::none )
    {
       if( ! (this)->allocate_called ) return;
-      (this)->datamanager.get()->signal[ 0 ].sig = signal;
+      /** one slot, overwritten every time **/
+      (this)->datamanager.get()->signal->take( 0 );
+      (this)->datamanager.get()->signal->set( 0, signal );
       (this)->write_stats.count += (this)->n_allocated;
       (this)->allocate_called = false;
       (this)->n_allocated = 1;
@@ -154,7 +156,9 @@ protected:
       T *item (reinterpret_cast< T* >( ptr ) );
       (this)->datamanager.get()->store [ 0 ]  = *item;
       /** a bit awkward since it gives the same behavior as the actual queue **/
-      (this)->datamanager.get()->signal[ 0 ].sig  = signal;
+      /** one slot, overwritten every time **/
+      (this)->datamanager.get()->signal->take( 0 );
+      (this)->datamanager.get()->signal->set( 0, signal );
       (this)->write_stats.count++;
    }
 
@@ -169,7 +173,9 @@ protected:
          begin++;
          (this)->write_stats.count++;
       }
-      (this)->datamanager.get()->signal[ 0 ].sig = signal;
+      /** one slot, overwritten every time **/
+      (this)->datamanager.get()->signal->take( 0 );
+      (this)->datamanager.get()->signal->set( 0, signal );
       return;
    }
    
@@ -217,7 +223,7 @@ protected:
       *item  = (this)->datamanager.get()->store[ 0 ];
       if( signal != nullptr )
       {
-         *signal = (this)->datamanager.get()->signal[ 0 ].sig;
+         *signal = (this)->datamanager.get()->signal->get( 0 );
       }
       (this)->read_stats.count++;
    }
@@ -252,7 +258,7 @@ protected:
       *ptr = (void*)&( (this)->datamanager.get()->store[ 0 ] );
       if( signal != nullptr )
       {
-         *signal = (this)->datamanager.get()->signal[  0  ].sig;
+         *signal = (this)->datamanager.get()->signal->get( 0 );
       }
    }
 };
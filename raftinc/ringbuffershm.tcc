@@ -0,0 +1,156 @@
+/**
+ * ringbuffershm.tcc - single producer/consumer ring living in a POSIX
+ * shared memory segment, for linking a kernel in this process to one
+ * in another (see raft::map::link_shm).  Same ring as the heap SPSC,
+ * only the memory differs, so allocate and peek hand out pointers
+ * straight into the segment.  Each process holds one end only.  The
+ * items are copied byte for byte between address spaces so only
+ * trivially copyable types are allowed.  Neither end can wake the
+ * other, a parked end wakes on the park timeout instead.
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 21:40:12 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _RINGBUFFERSHM_TCC_
+#define _RINGBUFFERSHM_TCC_  1
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+
+#include "portexception.hpp"
+#include "defs.hpp"
+#include "alloc_traits.tcc"
+#include "ringbufferspsc.tcc"
+#include "shmsegment.hpp"
+
+/**
+ * shm_alloc - types that can go through a shared memory FIFO,
+ * stored inline and meaningful in another address space.
+ */
+template < class T >
+struct shm_alloc : std::integral_constant< bool,
+   inline_alloc< T >::value && std::is_trivially_copyable< T >::value >{};
+
+template < class T >
+class RingBufferBase<
+    T,
+    Type::SharedMemory,
+    typename std::enable_if< shm_alloc< T >::value >::type >
+: public RingBufferSPSC< T, Type::SharedMemory >
+{
+public:
+   RingBufferBase() : RingBufferSPSC< T, Type::SharedMemory >()
+   {
+   }
+
+   virtual ~RingBufferBase() = default;
+
+   /**
+    * invalidate - only the producer closes the edge, a consumer
+    * that stops early simply goes away, the producer notices
+    * once the buffer fills.
+    */
+   virtual void invalidate()
+   {
+      if( dir == Direction::Producer )
+      {
+         RingBufferSPSC< T, Type::SharedMemory >::invalidate();
+      }
+   }
+
+protected:
+   /**
+    * init - called by the RingBuffer constructor, attaches to
+    * (or creates) the segment for the named edge.
+    * @param   n     - requested number of items, if creating
+    * @param   edge  - name shared by both processes
+    * @param   dir   - which end this process is
+    * @param   align - alignment for the store
+    */
+   void init( const std::size_t n,
+              const std::string &edge,
+              const Direction dir,
+              const std::size_t align )
+   {
+      (this)->dir = dir;
+      segment.reset( new shm_segment( edge,
+                                      dir,
+                                      sizeof( T ),
+                                      typeid( T ).hash_code(),
+                                      (this)->round_up( n ),
+                                      align ) );
+      (this)->bind( reinterpret_cast< T* >( segment->store() ),
+                    segment->signals(),
+                    segment->indices(),
+                    segment->capacity() );
+   }
+
+   /**
+    * check_peer - a producer whose consumer has died would block
+    * forever so it throws, a consumer whose producer has died
+    * takes it as the end of the stream.  Only checked every so
+    * often, it's a system call.
+    */
+   virtual void check_peer( const std::size_t spins )
+   {
+      if( spins == 0 || spins % WaitStrategy::blocked_spins != 0 ||
+          segment->peer_alive() )
+      {
+         return;
+      }
+      if( dir == Direction::Producer )
+      {
+         throw ClosedPortAccessException(
+            "Consumer of shared memory edge exited, exiting!!" );
+      }
+      (this)->idx->valid.store( false, std::memory_order_release );
+   }
+
+   /**
+    * idle_wait - nothing in the other process sets the readiness
+    * bits here, so this is also where the consumer finds out the
+    * producer has closed the edge.
+    */
+   virtual void idle_wait( const std::size_t spins )
+   {
+      check_peer( spins );
+      RingBufferSPSC< T, Type::SharedMemory >::idle_wait( spins );
+      if( (this)->is_invalid() )
+      {
+         (this)->waiter.close();
+      }
+   }
+
+   /** the kernel on the other end is in another process **/
+   virtual void set_src_kernel( raft::kernel * const k )
+   {
+      UNUSED( k );
+   }
+
+   virtual void set_dst_kernel( raft::kernel * const k )
+   {
+      UNUSED( k );
+   }
+
+   std::unique_ptr< shm_segment > segment;
+   Direction                      dir = Direction::Producer;
+};
+
+#endif /* END _RINGBUFFERSHM_TCC_ */
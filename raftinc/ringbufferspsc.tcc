@@ -0,0 +1,897 @@
+/**
+ * ringbufferspsc.tcc - non-resizable single-producer/single-consumer
+ * heap ring buffer.  Each FIFO edge in the stream graph has exactly
+ * one producing and one consuming kernel, so if the buffer is never
+ * resized the DataManager enter/exit protocol and the doubled Pointer
+ * reads are pure overhead.  This version keeps free-running head/tail
+ * counters as acquire/release atomics on separate cache lines, caches
+ * the opposite index locally and masks with a power-of-two capacity.
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 09:12:40 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _RINGBUFFERSPSC_TCC_
+#define _RINGBUFFERSPSC_TCC_  1
+
+#include <atomic>
+#include <cstddef>
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <map>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+#include "portexception.hpp"
+#include "defs.hpp"
+#include "alloc_traits.tcc"
+#include "bufferdata.tcc"
+#include "spscindices.hpp"
+
+#ifdef USEQTHREADS
+#include <qthread/qthread.hpp>
+#endif
+
+/**
+ * RingBufferSPSC - the ring itself, the sub-class owns the store,
+ * signal map and indices and hands them over with bind() before
+ * the FIFO is used.  Shared by the heap version below and the
+ * shared memory version in ringbuffershm.tcc.
+ */
+template < class T, Type::RingBufferType type >
+class RingBufferSPSC : public FIFOAbstract< T, type >
+{
+protected:
+   using index_t = std::size_t;
+public:
+   RingBufferSPSC() : FIFOAbstract< T, type >()
+   {
+   }
+
+   virtual ~RingBufferSPSC() = default;
+
+   /**
+    * size - returns the number of items currently in the
+    * queue, safe to call from any thread.  The head is read
+    * first so that the tail can never appear to be behind it.
+    * @return std::size_t
+    */
+   virtual std::size_t size() noexcept
+   {
+      const auto h( idx->head.load( std::memory_order_acquire ) );
+      const auto t( idx->tail.load( std::memory_order_acquire ) );
+      const auto n( t - h );
+      return( n > max_cap ? max_cap : n );
+   }
+
+   virtual std::size_t space_avail()
+   {
+      return( max_cap - size() );
+   }
+
+   virtual std::size_t capacity()
+   {
+      return( max_cap );
+   }
+
+   virtual void deallocate()
+   {
+      if( ! (this)->allocate_called )
+      {
+         return;
+      }
+      destroy( &store[ idx->tail.load( std::memory_order_relaxed ) & mask ] );
+      (this)->allocate_called = false;
+   }
+
+   /**
+    * send - releases the last item allocated by allocate() to
+    * the queue.  Function will simply return if allocate wasn't
+    * called prior to calling this function.
+    * @param signal - const raft::signal signal, default: NONE
+    */
+   virtual void send( const raft::signal signal = raft::none )
+   {
+      if( R_UNLIKELY( ! (this)->allocate_called ) )
+      {
+         return;
+      }
+      const auto t( idx->tail.load( std::memory_order_relaxed ) );
+      signals->set( t & mask, signal );
+      write_stats.bec.count++;
+      note_finished( signal );
+      (this)->allocate_called = false;
+      idx->tail.store( t + 1, std::memory_order_release );
+      waiter.wake_consumer();
+   }
+
+   /**
+    * send_range - releases the items allocated by allocate_range()
+    * to the queue, the signal travels with the last item.
+    * @param signal - const raft::signal signal, default: NONE
+    */
+   virtual void send_range( const raft::signal signal = raft::none )
+   {
+      if( ! (this)->allocate_called )
+      {
+         return;
+      }
+      const auto t( idx->tail.load( std::memory_order_relaxed ) );
+      const index_t n( (this)->n_allocated );
+      signals->set( ( t + n - 1 ) & mask, signal );
+      write_stats.bec.count += (this)->n_allocated;
+      note_finished( signal );
+      (this)->allocate_called = false;
+      (this)->n_allocated     = 0;
+      idx->tail.store( t + n, std::memory_order_release );
+      waiter.wake_consumer();
+   }
+
+   virtual void unpeek()
+   {
+      /** nothing to release, buffer is never moved **/
+      return;
+   }
+
+   virtual void invalidate()
+   {
+      idx->valid.store( false, std::memory_order_release );
+      /** a parked consumer has to see end of stream **/
+      waiter.close();
+   }
+
+   virtual bool is_invalid()
+   {
+      return( ! idx->valid.load( std::memory_order_acquire ) );
+   }
+
+   virtual void get_zero_read_stats( Blocked &copy )
+   {
+      copy.all       = read_stats.all;
+      read_stats.all = 0;
+   }
+
+   virtual void get_zero_write_stats( Blocked &copy )
+   {
+      copy.all        = write_stats.all;
+      written        += write_stats.bec.count;
+      write_stats.all = 0;
+   }
+
+   virtual std::uint64_t get_items_written()
+   {
+      return( written + write_stats.bec.count );
+   }
+
+   virtual void get_write_finished( bool &write_finished )
+   {
+      write_finished = (this)->write_finished;
+   }
+
+   /**
+    * push_item - local_push without the virtual call, see
+    * TypedFIFO.  A null item sends the signal alone, the slot
+    * still gets an empty T since pop_item moves out of and
+    * destroys whatever is at the head.
+    * @param   item   - const T*, copied in
+    * @param   signal - const raft::signal
+    */
+   inline void push_item( const T * const item, const raft::signal signal )
+   {
+      const auto t( wait_for_space( 1 ) );
+      const auto slot( t & mask );
+      if( item != nullptr )
+      {
+         construct( &store[ slot ], *item );
+         write_stats.bec.count++;
+      }
+      else
+      {
+         construct_empty( &store[ slot ] );
+      }
+      signals->set( slot, signal );
+      note_finished( signal );
+      idx->tail.store( t + 1, std::memory_order_release );
+      waiter.wake_consumer();
+   }
+
+   /**
+    * pop_item - local_pop without the virtual call, a null item
+    * throws the head away.
+    * @param   item   - T*, moved out to
+    * @param   signal - raft::signal*, may be null
+    * @throws  ClosedPortAccessException
+    */
+   inline void pop_item( T * const item, raft::signal * const signal )
+   {
+      const auto h( wait_for_data( 1, "pop" ) );
+      const auto slot( h & mask );
+      /** take even if nobody wants it, clears the slot **/
+      const auto sig( signals->take( slot ) );
+      if( signal != nullptr )
+      {
+         *signal = sig;
+      }
+      if( item != nullptr )
+      {
+         *item = std::move( store[ slot ] );
+         read_stats.bec.count++;
+      }
+      destroy( &store[ slot ] );
+      idx->head.store( h + 1, std::memory_order_release );
+      waiter.wake_producer();
+   }
+
+   /**
+    * peek_item - local_peek without the virtual call.
+    * @param   signal - raft::signal*, may be null
+    * @return  T*, the head, valid until recycle
+    * @throws  ClosedPortAccessException
+    */
+   inline T* peek_item( raft::signal * const signal )
+   {
+      const auto slot( wait_for_data( 1, "local_peek" ) & mask );
+      if( signal != nullptr )
+      {
+         *signal = signals->get( slot );
+      }
+      return( &store[ slot ] );
+   }
+
+protected:
+   virtual void set_wait_strategy( const raft::wait::strategy strategy )
+   {
+      waiter.set( strategy );
+   }
+
+   virtual void set_ready_bits( const ReadyBit &data,
+                                const ReadyBit &space,
+                                const ReadyBit &closed )
+   {
+      waiter.set_ready_bits( data, space, closed );
+   }
+
+   virtual void set_fused()
+   {
+      fused = true;
+   }
+
+   virtual void idle_wait( const std::size_t spins )
+   {
+      waiter.consumer_wait( spins,
+                            write_stats,
+                            [&](){ return( is_invalid() || size() > 0 ); } );
+   }
+
+   /**
+    * bind - hands the ring its memory, called by the sub-class
+    * before the FIFO is used and again if it moves the store.
+    * @param   store   - T*, max_cap items
+    * @param   signals - Buffer::SignalMap*, for max_cap items
+    * @param   idx     - SPSCIndices*
+    * @param   max_cap - power of two, see round_up
+    */
+   void bind( T * const store,
+              Buffer::SignalMap * const signals,
+              SPSCIndices * const idx,
+              const index_t max_cap )
+   {
+      assert( max_cap != 0 && ( max_cap & ( max_cap - 1 ) ) == 0 );
+      (this)->store   = store;
+      (this)->signals = signals;
+      (this)->idx     = idx;
+      (this)->max_cap = max_cap;
+      (this)->mask    = max_cap - 1;
+   }
+
+   /**
+    * round_up - rounds the requested size up to the next power
+    * of two so that indices can be masked rather than taken
+    * modulo capacity.
+    * @param   n - requested number of items
+    * @return  index_t
+    */
+   static index_t round_up( const std::size_t n )
+   {
+      assert( n != 0 );
+      index_t cap( 1 );
+      while( cap < n )
+      {
+         cap <<= 1;
+      }
+      return( cap );
+   }
+
+   /**
+    * check_peer - called each time around every wait loop, may
+    * throw or invalidate the FIFO if the other end is known to
+    * be gone.  Both ends of the heap version are in this
+    * process so there's nothing to do.
+    * @param   spins - times the caller has already waited
+    */
+   virtual void check_peer( const std::size_t spins )
+   {
+      UNUSED( spins );
+   }
+
+   /**
+    * grow - called instead of waiting for space once fused, the
+    * consumer is on this thread and can't free any.  The sub-class
+    * moves the ring to a store that holds at least n, see rehome.
+    * Default version can't, wait_for_space throws.
+    * @param   n - items the ring has to hold
+    */
+   virtual void grow( const index_t n )
+   {
+      UNUSED( n );
+   }
+
+   /**
+    * rehome - moves everything between head and tail to store,
+    * signals and all, and binds the ring to it.  Only safe with
+    * both ends on the calling thread, i.e. fused.
+    * @param   store   - T*, raw room for max_cap items
+    * @param   signals - Buffer::SignalMap*, for max_cap items
+    * @param   max_cap - power of two, bigger than the current one
+    */
+   void rehome( T * const store,
+                Buffer::SignalMap * const signals,
+                const index_t max_cap )
+   {
+      const auto new_mask( max_cap - 1 );
+      const auto t( idx->tail.load( std::memory_order_relaxed ) );
+      for( auto h( idx->head.load( std::memory_order_relaxed ) ); h != t; h++ )
+      {
+         auto &from( (this)->store[ h & mask ] );
+         construct( &store[ h & new_mask ], from );
+         destroy( &from );
+         signals->set( h & new_mask, (this)->signals->take( h & mask ) );
+      }
+      bind( store, signals, idx, max_cap );
+   }
+
+   /**
+    * destroy_in_flight - destructs anything pushed but never
+    * popped, for the sub-class destructor.
+    */
+   void destroy_in_flight()
+   {
+      if( idx == nullptr )
+      {
+         return;
+      }
+      const auto t( idx->tail.load( std::memory_order_acquire ) );
+      for( auto h( idx->head.load( std::memory_order_acquire ) ); h != t; h++ )
+      {
+         destroy( &store[ h & mask ] );
+      }
+   }
+
+   virtual raft::signal signal_peek()
+   {
+      return( signals->get( idx->head.load( std::memory_order_relaxed ) & mask ) );
+   }
+
+   virtual void signal_pop()
+   {
+      (this)->local_pop( nullptr, nullptr );
+   }
+
+   virtual void inline_signal_send( const raft::signal sig )
+   {
+      (this)->local_push( nullptr, sig );
+   }
+
+   virtual void local_allocate( void **ptr )
+   {
+      const auto t( wait_for_space( 1 ) );
+      *ptr = reinterpret_cast< void* >( &store[ t & mask ] );
+      (this)->allocate_called = true;
+   }
+
+   virtual void local_allocate_n( void *ptr, const std::size_t n )
+   {
+      assert( fused || n <= max_cap );
+      const auto t( wait_for_space( n ) );
+      auto *container(
+         reinterpret_cast< std::vector< std::reference_wrapper< T > >* >( ptr ) );
+      container->reserve( container->size() + n );
+      for( index_t index( 0 ); index < n; index++ )
+      {
+         const auto slot( ( t + index ) & mask );
+         container->emplace_back( store[ slot ] );
+      }
+      (this)->n_allocated = static_cast< decltype( (this)->n_allocated ) >( n );
+      (this)->allocate_called = true;
+   }
+
+   virtual void local_push( void *ptr, const raft::signal &signal )
+   {
+      push_item( reinterpret_cast< const T* >( ptr ), signal );
+   }
+
+   /**
+    * local_insert_helper - copies the range in as space frees up,
+    * each batch goes in as at most two contiguous segments and
+    * is published with a single tail store.  The signal travels
+    * with the last item.
+    */
+   template < class iterator_type >
+   void local_insert_helper( iterator_type begin,
+                             iterator_type end,
+                             const raft::signal &signal )
+   {
+      index_t remaining( std::distance( begin, end ) );
+      while( remaining > 0 )
+      {
+         const auto t( wait_for_space( 1 ) );
+         const auto avail( max_cap - ( t - head_cache ) );
+         const auto n( avail < remaining ? avail : remaining );
+         const auto slot( t & mask );
+         const auto to_end( max_cap - slot );
+         const auto first( n < to_end ? n : to_end );
+         for( index_t i( 0 ); i < first; i++, ++begin )
+         {
+            construct( &store[ slot + i ], *begin );
+         }
+         for( index_t i( 0 ); i < n - first; i++, ++begin )
+         {
+            construct( &store[ i ], *begin );
+         }
+         remaining -= n;
+         if( remaining == 0 )
+         {
+            signals->set( ( t + n - 1 ) & mask, signal );
+            note_finished( signal );
+         }
+         write_stats.bec.count += n;
+         idx->tail.store( t + n, std::memory_order_release );
+         waiter.wake_consumer();
+      }
+      return;
+   }
+
+   virtual void local_insert( void *begin_ptr,
+                              void *end_ptr,
+                              const raft::signal &signal,
+                              const std::size_t iterator_type )
+   {
+      using it_list = typename std::list< T >::iterator;
+      using it_vec  = typename std::vector< T >::iterator;
+
+      if( iterator_type == typeid( it_list ).hash_code() )
+      {
+         local_insert_helper( *reinterpret_cast< it_list* >( begin_ptr ),
+                              *reinterpret_cast< it_list* >( end_ptr ),
+                              signal );
+      }
+      else if( iterator_type == typeid( it_vec ).hash_code() )
+      {
+         local_insert_helper( *reinterpret_cast< it_vec* >( begin_ptr ),
+                              *reinterpret_cast< it_vec* >( end_ptr ),
+                              signal );
+      }
+      else
+      {
+         /** nothing has gone in, no half inserted range or lost signal **/
+         throw PortTypeException(
+            "insert takes std::list or std::vector iterators of the port's type" );
+      }
+      return;
+   }
+
+   virtual void local_pop( void *ptr, raft::signal *signal )
+   {
+      pop_item( reinterpret_cast< T* >( ptr ), signal );
+   }
+
+   /**
+    * local_pop_range - copies out whatever is available in at
+    * most two contiguous segments per batch, releasing the
+    * batch with a single head store.
+    */
+   virtual void local_pop_range( void *ptr_data, const std::size_t n_items )
+   {
+      assert( ptr_data != nullptr );
+      auto &items(
+         *reinterpret_cast<
+            std::vector< std::pair< T, raft::signal > >* >( ptr_data ) );
+      assert( items.size() == n_items );
+      index_t done( 0 );
+      while( done < n_items )
+      {
+         const auto h( wait_for_data( 1, "pop_range" ) );
+         const auto avail( tail_cache - h );
+         const auto remaining( n_items - done );
+         const auto n( avail < remaining ? avail : remaining );
+         const auto slot( h & mask );
+         const auto to_end( max_cap - slot );
+         const auto first( n < to_end ? n : to_end );
+         for( index_t i( 0 ); i < n; i++ )
+         {
+            const auto s( i < first ? slot + i : i - first );
+            items[ done + i ].first  = std::move( store[ s ] );
+            items[ done + i ].second = signals->take( s );
+            destroy( &store[ s ] );
+         }
+         read_stats.bec.count += n;
+         idx->head.store( h + n, std::memory_order_release );
+         waiter.wake_producer();
+         done += n;
+      }
+      return;
+   }
+
+   virtual void local_peek( void **ptr, raft::signal *signal )
+   {
+      *ptr = reinterpret_cast< void* >( peek_item( signal ) );
+   }
+
+   virtual void local_peek_range( void **ptr,
+                                  void **sig,
+                                  const std::size_t n,
+                                  std::size_t &curr_pointer_loc,
+                                  std::size_t &queue_size )
+   {
+      assert( n <= max_cap );
+      const auto h( wait_for_data( n, "local_peek_range" ) );
+      curr_pointer_loc = h & mask;
+      queue_size       = max_cap;
+      /** autorelease indexes both arrays from their base **/
+      *sig = reinterpret_cast< void* >( signals );
+      *ptr = reinterpret_cast< void* >( store );
+   }
+
+   virtual void local_recycle( std::size_t range )
+   {
+      while( range > 0 )
+      {
+         auto h( idx->head.load( std::memory_order_relaxed ) );
+         if( tail_cache == h )
+         {
+            tail_cache = idx->tail.load( std::memory_order_acquire );
+            std::size_t spins( 0 );
+            while( tail_cache == h )
+            {
+               if( is_invalid() )
+               {
+                  tail_cache = idx->tail.load( std::memory_order_acquire );
+                  if( tail_cache == h )
+                  {
+                     return;
+                  }
+                  break;
+               }
+               consumer_wait( spins++, h, 1 );
+               tail_cache = idx->tail.load( std::memory_order_acquire );
+            }
+         }
+         const auto avail( tail_cache - h );
+         const auto n( avail < range ? avail : range );
+         for( index_t i( 0 ); i < n; i++ )
+         {
+            destroy( &store[ ( h + i ) & mask ] );
+            signals->take( ( h + i ) & mask );
+         }
+         idx->head.store( h + n, std::memory_order_release );
+         waiter.wake_producer();
+         range -= n;
+      }
+      return;
+   }
+
+   /**
+    * wait_for_space - producer side, blocks until n slots are
+    * free.  The consumer's head is only re-read once the cached
+    * copy says the buffer is full.
+    * @param   n - number of slots needed
+    * @return  current tail
+    */
+   index_t wait_for_space( const index_t n )
+   {
+      const auto t( idx->tail.load( std::memory_order_relaxed ) );
+      if( R_UNLIKELY( t + n - head_cache > max_cap ) )
+      {
+         head_cache = idx->head.load( std::memory_order_acquire );
+         if( fused && t + n - head_cache > max_cap )
+         {
+            (this)->grow( t + n - head_cache );
+            if( t + n - head_cache > max_cap )
+            {
+               throw FusedStageBlockedException(
+                  "Fused FIFO is full and can't grow, exiting!!" );
+            }
+         }
+         std::size_t spins( 0 );
+         while( t + n - head_cache > max_cap )
+         {
+            if( write_stats.bec.blocked == 0 )
+            {
+               write_stats.bec.blocked = 1;
+            }
+            check_peer( spins );
+            waiter.producer_wait( spins++,
+                                  write_stats,
+                                  [&](){ return( t + n -
+                                     idx->head.load( std::memory_order_acquire )
+                                        <= max_cap ); } );
+            head_cache = idx->head.load( std::memory_order_acquire );
+         }
+      }
+      return( t );
+   }
+
+   /**
+    * wait_for_data - consumer side, blocks until n items are
+    * readable, throws if the producer has invalidated the queue
+    * and not enough items are left.
+    * @param   n - number of items needed
+    * @param   caller - name used for the exception message
+    * @return  current head
+    */
+   index_t wait_for_data( const index_t n, const char * const caller )
+   {
+      const auto h( idx->head.load( std::memory_order_relaxed ) );
+      if( R_UNLIKELY( tail_cache - h < n ) )
+      {
+         tail_cache = idx->tail.load( std::memory_order_acquire );
+         std::size_t spins( 0 );
+         while( tail_cache - h < n )
+         {
+            if( is_invalid() )
+            {
+               /** producer may have pushed right before invalidating **/
+               tail_cache = idx->tail.load( std::memory_order_acquire );
+               if( tail_cache - h >= n )
+               {
+                  break;
+               }
+               if( tail_cache == h )
+               {
+                  throw ClosedPortAccessException(
+                     std::string( "Accessing closed port with " ) +
+                        caller + " call, exiting!!" );
+               }
+               throw NoMoreDataException(
+                  "Too few items left on closed port, kernel exiting" );
+            }
+            if( fused )
+            {
+               /** only the stage before can send more, and it runs after this returns **/
+               throw FusedStageBlockedException(
+                  std::string( "Fused stage asked for " ) + std::to_string( n ) +
+                     " items with " + std::to_string( tail_cache - h ) +
+                        " sent in a " + caller + " call, don't fuse it, exiting!!" );
+            }
+            consumer_wait( spins++, h, n );
+            tail_cache = idx->tail.load( std::memory_order_acquire );
+         }
+      }
+      return( h );
+   }
+
+   /**
+    * consumer_wait - marks the read side blocked and waits per the
+    * wait strategy until n items past h are readable or the queue
+    * is invalidated.
+    * @param   spins - times the caller has already waited
+    * @param   h     - current head
+    * @param   n     - number of items needed
+    */
+   void consumer_wait( const std::size_t spins,
+                       const index_t h,
+                       const index_t n )
+   {
+      if( read_stats.bec.blocked == 0 )
+      {
+         read_stats.bec.blocked = 1;
+      }
+      check_peer( spins );
+      waiter.consumer_wait( spins,
+                            write_stats,
+                            [&](){ return( is_invalid() ||
+                               idx->tail.load( std::memory_order_acquire ) - h
+                                  >= n ); } );
+   }
+
+   /**
+    * note_finished - an eof or quit signal is the producer's
+    * last write, whichever call it came in on.
+    */
+   inline void note_finished( const raft::signal signal ) noexcept
+   {
+      if( signal == raft::eof || signal == raft::quit )
+      {
+         write_finished = true;
+      }
+   }
+
+   /** class types live in raw storage, so construct/destruct in place **/
+   template < class U,
+              typename std::enable_if< std::is_class< U >::value >::type* = nullptr >
+   static inline void construct( U *slot, const U &item )
+   {
+      U * temp( new ( slot ) U( item ) );
+      UNUSED( temp );
+   }
+
+   template < class U,
+              typename std::enable_if< ! std::is_class< U >::value >::type* = nullptr >
+   static inline void construct( U *slot, const U &item )
+   {
+      std::memcpy( (void*)slot, (const void*)&item, sizeof( U ) );
+   }
+
+   /** construct_empty - a slot that only carries a signal **/
+   template < class U,
+              typename std::enable_if< std::is_class< U >::value &&
+                 std::is_default_constructible< U >::value >::type* = nullptr >
+   static inline void construct_empty( U *slot )
+   {
+      U * temp( new ( slot ) U() );
+      UNUSED( temp );
+   }
+
+   /** spsc_alloc only lets the rest in if trivially copyable, bytes will do **/
+   template < class U,
+              typename std::enable_if< ! std::is_class< U >::value ||
+                 ! std::is_default_constructible< U >::value >::type* = nullptr >
+   static inline void construct_empty( U *slot )
+   {
+      std::memset( (void*)slot, 0, sizeof( U ) );
+   }
+
+   template < class U,
+              typename std::enable_if< std::is_class< U >::value >::type* = nullptr >
+   static inline void destroy( U *slot )
+   {
+      slot->~U();
+   }
+
+   template < class U,
+              typename std::enable_if< ! std::is_class< U >::value >::type* = nullptr >
+   static inline void destroy( U *slot )
+   {
+      UNUSED( slot );
+   }
+
+   /** set by bind, owned by the sub-class **/
+   T                             *store   = nullptr;
+   Buffer::SignalMap             *signals = nullptr;
+   SPSCIndices                   *idx     = nullptr;
+   index_t                        max_cap = 0;
+   index_t                        mask    = 0;
+
+   /** producer owned line **/
+   index_t                        head_cache = 0;
+   char                           pad_producer[ L1D_CACHE_LINE_SIZE -
+                                                sizeof( index_t ) ];
+   /** consumer owned line **/
+   index_t                        tail_cache = 0;
+   char                           pad_consumer[ L1D_CACHE_LINE_SIZE -
+                                                sizeof( index_t ) ];
+
+   Blocked                        read_stats;
+   Blocked                        write_stats;
+   /** write counts already taken out of write_stats **/
+   std::uint64_t                  written = 0;
+   volatile bool                  write_finished = false;
+   /** both ends on one thread, grow instead of waiting, see set_fused **/
+   bool                           fused          = false;
+   /** what to do when full or empty, set by the allocator **/
+   WaitStrategy                   waiter;
+};
+
+/**
+ * spsc_alloc - types the single producer/consumer heap takes,
+ * stored inline and able to fill a signal-only slot, either
+ * default constructed or as zeroed bytes.
+ */
+template < class T >
+struct spsc_alloc : std::integral_constant< bool,
+   inline_alloc< T >::value &&
+   ( std::is_default_constructible< T >::value ||
+     std::is_trivially_copyable< T >::value ) >{};
+
+/**
+ * only inline allocated types are handled here, externally
+ * allocated types need the pointer hand-off maps of the
+ * resizeable heap buffer and stay there.
+ */
+template < class T >
+class RingBufferBase<
+    T,
+    Type::HeapSPSC,
+    typename std::enable_if< spsc_alloc< T >::value >::type >
+: public RingBufferSPSC< T, Type::HeapSPSC >
+{
+public:
+   RingBufferBase() : RingBufferSPSC< T, Type::HeapSPSC >()
+   {
+   }
+
+   virtual ~RingBufferBase()
+   {
+      if( data != nullptr )
+      {
+         (this)->destroy_in_flight();
+         delete( data );
+      }
+   }
+
+protected:
+   virtual void set_memory_options( const raft::mem::options &mem )
+   {
+      if( mem.custom() )
+      {
+         /** never resized, so only the one store to replace **/
+         delete( data );
+         data = new Buffer::Data< T, Type::Heap >( (this)->max_cap, 16, mem );
+         (this)->bind( data->store, data->signal, &indices, (this)->max_cap );
+      }
+   }
+
+   /**
+    * init - called by the RingBuffer constructor.
+    * @param   n     - requested number of items
+    * @param   align - alignment for the store
+    */
+   void init( const std::size_t n, const std::size_t align )
+   {
+      const auto cap( (this)->round_up( n ) );
+      data = new Buffer::Data< T, Type::Heap >( cap, align );
+      (this)->align = align;
+      (this)->bind( data->store, data->signal, &indices, cap );
+   }
+
+   /** grow - doubles the store till n fit **/
+   virtual void grow( const std::size_t n )
+   {
+      auto cap( (this)->max_cap );
+      while( cap < n )
+      {
+         cap <<= 1;
+      }
+      auto * const next( new Buffer::Data< T, Type::Heap >( cap, align, data->mem ) );
+      (this)->rehome( next->store, next->signal, cap );
+      delete( data );
+      data = next;
+   }
+
+   virtual void set_src_kernel( raft::kernel * const k )
+   {
+      assert( k != nullptr );
+      data->setSourceKernel( k );
+   }
+
+   virtual void set_dst_kernel( raft::kernel * const k )
+   {
+      assert( k != nullptr );
+      data->setDestKernel( k );
+   }
+
+   /** storage and signal array, read/write Pointers inside are unused **/
+   Buffer::Data< T, Type::Heap > *data = nullptr;
+   SPSCIndices                    indices;
+   std::size_t                    align = 16;
+};
+
+#endif /* END _RINGBUFFERSPSC_TCC_ */
@@ -1,7 +1,7 @@
 #ifndef __RINGBUFFERTYPES__ 
 #define __RINGBUFFERTYPES__ 1
 namespace Type{
-   enum RingBufferType { Heap, SharedMemory, TCP, Infinite, N};
+   enum RingBufferType { Heap, SharedMemory, TCP, Infinite, HeapSPSC, N};
 }
    
    enum Direction { Producer, Consumer };
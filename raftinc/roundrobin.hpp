@@ -24,6 +24,10 @@
 #include "port.hpp"
 #include "splitmethod.hpp"
 
+/**
+ * roundrobin - each selection starts at the port after the last
+ * one chosen, so every port gets its turn whatever its index.
+ */
 class roundrobin : public splitmethod 
 {
 public:
@@ -32,5 +36,8 @@ public:
 
 protected:
    virtual FIFO*  select_fifo( Port &port_list, const functype type );
+
+   /** index of the port to try first next time **/
+   std::size_t next = 0;
 };
 #endif /* END _ROUNDROBIN_HPP_ */
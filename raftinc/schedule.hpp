@@ -24,6 +24,7 @@
 #include "systemsignalhandler.hpp"
 #include "rafttypes.hpp"
 #include <set>
+#include <chrono>
 #include "kernelkeeper.tcc"
 #include "defs.hpp"
 
@@ -95,6 +96,50 @@ public:
     */
    virtual void scheduleKernel( raft::kernel * const kernel );
 protected:
+   /**
+    * fusedStage - true for a kernel that is run by the first
+    * stage of its fused chain, schedulers don't give it a
+    * thread or a task of its own, see map::setFusion.
+    * @param   kernel - raft::kernel * const
+    * @return  bool
+    */
+   static bool fusedStage( raft::kernel * const kernel );
+
+   /**
+    * stageRun - kernelRun for a single kernel, fused or not.
+    * @param   kernel   - raft::kernel * const
+    * @param   finished - set true when the kernel is done
+    */
+   static void stageRun( raft::kernel * const kernel,
+                         volatile bool       &finished );
+
+   /**
+    * fusedRun - kernelRun for the first stage of a fused chain,
+    * runs it once then each stage after it till the one before
+    * has nothing left for it.  Inner FIFOs are empty again
+    * when it returns, so a stage may push up to an inner FIFO's
+    * capacity per run.
+    * @param   head     - raft::kernel * const, first stage
+    * @param   finished - set true once every stage is done
+    */
+   static void fusedRun( raft::kernel * const head,
+                         volatile bool       &finished );
+
+   /**
+    * fusedDrain - runs kernel till its input is used up, and
+    * the stages after it after each run.
+    * @param   kernel - raft::kernel * const, nullptr past the end
+    */
+   static void fusedDrain( raft::kernel * const kernel );
+
+   /**
+    * timedRun - calls run() for a kernel that is being
+    * profiled, adding the time taken to its sample.
+    * @param   kernel - raft::kernel * const, sample is non-null
+    * @return  raft::kstatus from run()
+    */
+   static raft::kstatus timedRun( raft::kernel * const kernel );
+
    virtual void handleSchedule( raft::kernel * const kernel ) = 0; 
    /**
     * checkSystemSignal - check the incomming streams for
@@ -128,25 +173,66 @@ protected:
    static void invalidateOutputPorts( raft::kernel *kernel );
 
    /** 
-    * kernelHasInputData - check each input port for available
-    * data, returns true if any of the input ports has available
-    * data.
+    * kernelHasInputData - check the kernel's readiness bitmap
+    * for available data, returns true if any of the input ports
+    * has available data.  Doesn't touch the ports themselves, see
+    * kernelPollInputData.
     * @param kernel - raft::kernel
     * @return bool  - true if input data available.
     */
    static bool kernelHasInputData( raft::kernel *kernel );
+
+   /**
+    * kernelPollInputData - same as kernelHasInputData but checks
+    * the size of every input port, updating the bitmap as it
+    * goes.  Use when a kernel looks idle, a readiness bit can be
+    * missed since the FIFOs don't fence when setting them.
+    * @param kernel - raft::kernel
+    * @return bool  - true if input data available.
+    */
+   static bool kernelPollInputData( raft::kernel *kernel );
+
+   /**
+    * kernelHasOutputSpace - check the readiness bitmap for room,
+    * returns true if no output port has been seen full since it
+    * was last popped from (or there are no output ports).
+    * @param kernel - raft::kernel
+    * @return bool  - true if all output ports have space.
+    */
+   static bool kernelHasOutputSpace( raft::kernel *kernel );
+
+   /**
+    * kernelPollOutputSpace - kernelHasOutputSpace, checking the
+    * space available on every output port, see kernelPollInputData.
+    * @param kernel - raft::kernel
+    * @return bool  - true if all output ports have space.
+    */
+   static bool kernelPollOutputSpace( raft::kernel *kernel );
    
    /**
     * kernelHasNoInputPorts - pretty much exactly like the 
     * function name says, if the param kernel has no valid
     * input ports (this function assumes that kernelHasInputData()
     * has been called and returns false before this function 
-    * is called) then it returns true.
+    * is called) then it returns true.  O(1), closed ports are
+    * tracked in the readiness bitmap.
     * @params   kernel - raft::kernel*
     * @return  bool   - true if no valid input ports avail
     */
    static bool kernelHasNoInputPorts( raft::kernel *kernel );
 
+   /**
+    * kernelIdleWait - for schedulers that give each kernel its
+    * own thread, call after kernelRun.  If the kernel has no
+    * input data then the thread waits per the wait strategy
+    * of one of the kernel's input FIFOs instead of re-polling.
+    * @param   kernel - raft::kernel*
+    * @param   spins  - times this kernel has been idle in a row
+    * @return  bool   - true if the kernel was idle
+    */
+   static bool kernelIdleWait( raft::kernel * const kernel,
+                               const std::size_t spins );
+
    
    /**
     * setPtrSets - add the tracking object from the
@@ -169,7 +255,14 @@ protected:
                            ptr_set_t    * const out,
                            ptr_set_t    * const peekset );
 
-   
+   /**
+    * fifo_gc - called after each run of a kernel, destroys the
+    * items it recycled from its inputs unless it pushed them on
+    * to an output, then empties all three for the next run.
+    * @param in      - ptr_map_t*, recycled this run
+    * @param out     - ptr_set_t*, forwarded this run
+    * @param peekset - ptr_set_t*, peeked at this run
+    */
    static void fifo_gc( ptr_map_t * const in,
                         ptr_set_t * const out,
                         ptr_set_t * const peekset );
@@ -182,5 +275,7 @@ protected:
    kernelkeeper &kernel_set;
    kernelkeeper &source_kernels;      
    kernelkeeper &dst_kernels;
+   /** for schedulers that move pinned kernels, zero for off **/
+   const std::chrono::milliseconds repin_window;
 };
 #endif /* END _SCHEDULE_HPP_ */
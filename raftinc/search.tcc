@@ -28,6 +28,7 @@
 #include <cstddef>
 #include <raft>
 #include <algorithm>
+#include <vector>
 
 namespace raft
 {
@@ -48,6 +49,8 @@ public:
    {
       input.addPort< T >( "0" );
       output.addPort< match_t >( "0" );
+      in  = input.handle< T >( "0" );
+      out = output.handle< match_t >( "0" );
    }
    
    search( const std::string &term ) : raft::kernel(),
@@ -56,13 +59,15 @@ public:
    {
       input.addPort<  T >( "0" );
       output.addPort< match_t >( "0" );
+      in  = input.handle< T >( "0" );
+      out = output.handle< match_t >( "0" );
    }
 
    virtual ~search() = default;
 
    virtual raft::kstatus run()
    {
-      auto &chunk( input[ "0" ].template peek< T >() );
+      auto &chunk( in.peek() );
       auto it( chunk.begin() );
       do
       {
@@ -72,7 +77,7 @@ public:
          {
             const std::size_t loc( it.location() + chunk.start_position );
             const std::size_t end( loc + term_length );
-            output[ "0" ].push( std::make_pair( loc, end ) );
+            matches.emplace_back( loc, end );
             it += 1;
          }
          else
@@ -81,13 +86,19 @@ public:
          }
       }
       while( true );
-      input[ "0" ].unpeek();
-      input[ "0" ].recycle( );
+      /** hand the whole chunk's worth of matches over at once **/
+      out.insert( matches.begin(), matches.end() );
+      matches.clear();
+      in.unpeek();
+      in.recycle( );
       return( raft::proceed );
    }
 private:
    const std::size_t term_length;
    const std::string term;
+   std::vector< match_t > matches;
+   raft::port_handle< T >       in;
+   raft::port_handle< match_t > out;
 };
 
 
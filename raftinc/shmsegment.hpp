@@ -0,0 +1,129 @@
+/**
+ * shmsegment.hpp - a named POSIX shared memory segment holding one
+ * single producer/consumer ring, so that kernels in two processes
+ * can be linked.  Everything inside is found by offset from the
+ * header, so each process may map it at any address.  Whichever
+ * end attaches first creates the segment and sizes it, the name
+ * is unlinked once both ends are attached.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 21:40:12 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _SHMSEGMENT_HPP_
+#define _SHMSEGMENT_HPP_  1
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "ringbuffertypes.hpp"
+#include "signal.hpp"
+#include "spscindices.hpp"
+
+/**
+ * shm_edge - what the allocator hands the shared memory FIFO
+ * builder in place of a data struct, see Allocate::allocate_shm.
+ */
+struct shm_edge
+{
+   std::string name;
+   Direction   dir;
+};
+
+class shm_segment
+{
+public:
+   /**
+    * shm_segment - attaches to the segment for edge name as
+    * dir, creating it if the other end hasn't yet.  The first
+    * end in decides the capacity, the other must agree on the
+    * item type.  A segment left behind by a process that died
+    * is removed and made again.
+    * @param   name      - edge name, same in both processes
+    * @param   dir       - which end this is
+    * @param   item_size - sizeof the item type
+    * @param   type_hash - hash of the item type, checked on attach
+    * @param   max_cap   - items, power of two, used if creating
+    * @param   align     - alignment of the store
+    * @throws  PortException - bad name
+    * @throws  PortTypeMismatchException - other end has another type
+    * @throws  PortDoubleInitializeException - a live process is
+    *          already attached as dir
+    */
+   shm_segment( const std::string &name,
+                const Direction dir,
+                const std::size_t item_size,
+                const std::size_t type_hash,
+                const std::size_t max_cap,
+                const std::size_t align );
+
+   /**
+    * destructor - unmaps, the segment itself goes away once the
+    * other end has unmapped it too.
+    */
+   ~shm_segment();
+
+   shm_segment( const shm_segment &other ) = delete;
+   shm_segment& operator = ( const shm_segment &other ) = delete;
+
+   std::size_t        capacity() const noexcept;
+   void*              store() const noexcept;
+   Buffer::SignalMap* signals() const noexcept;
+   SPSCIndices*       indices() const noexcept;
+
+   /**
+    * peer_alive - true unless the other end attached and its
+    * process has since exited.  Costs a system call.
+    * @return  bool
+    */
+   bool peer_alive() const noexcept;
+
+private:
+   struct header;
+
+   /**
+    * create - makes and maps a new segment, false if one with
+    * this name already exists.
+    */
+   bool create( const std::size_t item_size,
+                const std::size_t type_hash,
+                const std::size_t max_cap,
+                const std::size_t align );
+
+   /**
+    * open - maps an existing segment, false if it went away or
+    * was left half made by a process that died, the caller
+    * should try to create it again.
+    */
+   bool open( const std::size_t item_size,
+              const std::size_t type_hash );
+
+   /**
+    * claim - registers this process as dir, false if a dead
+    * process left the segment behind and it was unlinked.
+    */
+   bool claim();
+
+   void unmap() noexcept;
+
+   const std::string path;
+   const Direction   dir;
+   header           *head   = nullptr;
+   std::size_t       length = 0;
+};
+
+#endif /* END _SHMSEGMENT_HPP_ */
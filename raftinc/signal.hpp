@@ -1,5 +1,11 @@
 /**
- * signal.hpp - 
+ * signal.hpp - per store record of which slots carry a signal.
+ * Nearly every item goes through with raft::none, so rather than
+ * a signal next to every slot there is one bit per slot and a
+ * table of signal values that is only written and read for slots
+ * whose bit is set.  Pushing plain data never touches either, and
+ * popping it only reads the bitmap word, which stays in cache.
+ *
  * @author: Jonathan Beard
  * @version: Wed Dec 31 15:14:56 2014
  * 
@@ -19,29 +25,168 @@
  */
 #ifndef _SIGNAL_HPP_
 #define _SIGNAL_HPP_  1
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include "signalvars.hpp"
-/**
- * TODO, add templated signal so that the user
- * can define tuple-like structures based on 
- * their own needs.
- */
+#include "defs.hpp"
+
 namespace Buffer
 {
-struct Signal
+/**
+ * SignalMap - lives in a single block of bytes( max_cap ) bytes,
+ * header, then the bitmap, then the values, so it can be put in
+ * any memory the store can (heap, mapped pages, SHM).  Only the
+ * producer sets bits and only the consumer clears them, a slot's
+ * bit is always clear by the time the producer gets it back.
+ * Ordering against the items comes from the read and write
+ * pointers, same as the store.
+ */
+struct SignalMap
 {
-   Signal();
-   Signal( const Signal &other );
+   /**
+    * bytes - size of the block needed for max_cap slots
+    * @param   max_cap - std::size_t
+    * @return  std::size_t
+    */
+   static std::size_t bytes( const std::size_t max_cap ) noexcept;
+
+   /**
+    * make - builds an empty map in mem, which must be zeroed
+    * and at least bytes( max_cap ) long.
+    * @param   mem     - void*
+    * @param   max_cap - std::size_t
+    * @return  SignalMap*, same address as mem
+    */
+   static SignalMap* make( void * const mem,
+                           const std::size_t max_cap ) noexcept;
+
+   /**
+    * get - signal for slot, raft::none for plain items
+    * @param   slot - std::size_t
+    * @return  raft::signal
+    */
+   inline raft::signal get( const std::size_t slot ) noexcept
+   {
+      if( R_LIKELY( ( word( slot ).load( std::memory_order_relaxed ) &
+                      bit( slot ) ) == 0 ) )
+      {
+         return( raft::none );
+      }
+      return( values()[ slot ] );
+   }
+
+   /**
+    * set - producer, attaches sig to slot.  raft::none needs no
+    * write since the slot's bit is already clear.
+    * @param   slot - std::size_t
+    * @param   sig  - raft::signal
+    */
+   inline void set( const std::size_t slot,
+                    const raft::signal sig ) noexcept
+   {
+      if( R_LIKELY( sig == raft::none ) )
+      {
+         return;
+      }
+      values()[ slot ] = sig;
+      word( slot ).fetch_or( bit( slot ), std::memory_order_relaxed );
+   }
+
+   /**
+    * take - consumer, get( slot ) and clears it for the next
+    * time the producer comes around.
+    * @param   slot - std::size_t
+    * @return  raft::signal
+    */
+   inline raft::signal take( const std::size_t slot ) noexcept
+   {
+      const auto sig( get( slot ) );
+      if( R_UNLIKELY( sig != raft::none ) )
+      {
+         word( slot ).fetch_and( ~bit( slot ), std::memory_order_relaxed );
+      }
+      return( sig );
+   }
+
+   /**
+    * take_range - consumer, calls f( offset, signal ) for each
+    * slot in [ start, start + n ) with a signal, offset relative
+    * to start, and clears them.  The range must not wrap.
+    * @param   start - std::size_t
+    * @param   n     - std::size_t
+    * @param   f     - callable( std::size_t, raft::signal )
+    */
+   template < class F >
+   inline void take_range( const std::size_t start,
+                           const std::size_t n,
+                           F &&f ) noexcept
+   {
+      const auto end( start + n );
+      auto slot( start );
+      while( slot < end )
+      {
+         auto &w( word( slot ) );
+         const auto word_end( ( ( slot >> 6 ) + 1 ) << 6 );
+         const auto stop( end < word_end ? end : word_end );
+         auto bits( w.load( std::memory_order_relaxed ) );
+         if( R_UNLIKELY( bits != 0 ) )
+         {
+            std::uint64_t mask( 0 );
+            for( auto s( slot ); s < stop; s++ )
+            {
+               if( ( bits & bit( s ) ) != 0 )
+               {
+                  f( s - start, values()[ s ] );
+                  mask |= bit( s );
+               }
+            }
+            if( mask != 0 )
+            {
+               w.fetch_and( ~mask, std::memory_order_relaxed );
+            }
+         }
+         slot = stop;
+      }
+   }
+
+   /**
+    * clear_range - consumer, drops any signals in [ start,
+    * start + n ), for items thrown away unread.
+    */
+   inline void clear_range( const std::size_t start,
+                            const std::size_t n ) noexcept
+   {
+      take_range( start, n, []( std::size_t, raft::signal ){} );
+   }
+
+   const std::size_t max_cap;
+   /**
+    * start_index - for buffers the user hands in, index of the
+    * first item in the user's array, see autorelease::getindex
+    */
+   std::size_t       start_index = 0;
+
+private:
+   explicit SignalMap( const std::size_t max_cap ) noexcept : max_cap( max_cap ){}
 
-   Signal& operator = ( raft::signal signal );
-   Signal& operator = ( raft::signal &signal );
+   using word_t = std::atomic< std::uint64_t >;
 
-   operator raft::signal ();
+   static inline std::uint64_t bit( const std::size_t slot ) noexcept
+   {
+      return( static_cast< std::uint64_t >( 1 ) << ( slot & 63 ) );
+   }
 
-   std::size_t getindex() noexcept;
+   inline word_t& word( const std::size_t slot ) noexcept
+   {
+      return( reinterpret_cast< word_t* >( this + 1 )[ slot >> 6 ] );
+   }
 
-   raft::signal sig   = raft::none;
-   std::size_t  index = 0;
+   inline raft::signal* values() noexcept
+   {
+      return( reinterpret_cast< raft::signal* >(
+         reinterpret_cast< word_t* >( this + 1 ) + ( ( max_cap + 63 ) >> 6 ) ) );
+   }
 };
 } /** end namespace buffer **/
 #endif /* END _SIGNAL_HPP_ */
@@ -22,7 +22,9 @@
 #include <vector>
 #include <thread>
 #include <cstdint>
+#include <memory>
 #include "defs.hpp"
+#include "repinmonitor.hpp"
 
 namespace raft{
    class kernel;
@@ -45,13 +47,13 @@ protected:
 
    struct thread_data
    {
-      constexpr thread_data( raft::kernel * const k,
-                             bool *fin ) : k( k ),
-                                           finished( fin ){}
+      thread_data( raft::kernel * const k,
+                   bool *fin );
 
-      raft::kernel *k         = nullptr;
-      bool         *finished  = nullptr;
-      core_id_t     loc       = -1;
+      raft::kernel         *k         = nullptr;
+      bool                 *finished  = nullptr;
+      /** core to run on, can change while running, see repinmonitor **/
+      repin_monitor::slot   pin;
    };
    
    struct thread_info_t
@@ -72,5 +74,7 @@ protected:
    
    std::mutex                    thread_map_mutex;
    std::vector< thread_info_t* > thread_map;
+   /** moves pinned kernels that contend, null if off **/
+   std::unique_ptr< repin_monitor > monitor;
 };
 #endif /* END _SIMPLESSCHEDULE_HPP_ */
@@ -0,0 +1,143 @@
+/**
+ * slabpool.hpp - fixed size slots for the items of one externally
+ * allocated (ext_alloc) FIFO, so that pushing a large object takes
+ * a slot off a free list instead of going through new and delete.
+ * Slots are carved out of slabs, each slot is a small header
+ * followed by the object and starts on its own cache line.  The
+ * producer takes slots from a list only it touches, whoever is
+ * done with an item (the consumer, or a kernel further down that
+ * it was forwarded to) hands the slot back on a lock free list
+ * that the producer takes whole once its own runs dry.  The header
+ * says which pool a slot came from, so giving it back never needs
+ * a lookup.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 22:31:05 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _SLABPOOL_HPP_
+#define _SLABPOOL_HPP_  1
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include "defs.hpp"
+#include "pagealloc.hpp"
+
+namespace Buffer
+{
+
+class slab_pool
+{
+public:
+   /**
+    * make - a new pool, given back with detach.
+    * @param   object_size  - sizeof the item type
+    * @param   object_align - alignof the item type
+    * @return  slab_pool*
+    */
+   static slab_pool* make( const std::size_t object_size,
+                           const std::size_t object_align );
+
+   /**
+    * detach - the FIFO is done with the pool, it goes away as
+    * soon as every slot it handed out has been released.
+    */
+   void detach();
+
+   /**
+    * set_options - huge pages and placement for slabs made
+    * from here on, see raft::mem::options.
+    */
+   void set_options( const raft::mem::options &opts );
+
+   /**
+    * allocate - room for one object, producer side only.
+    * @return  void*, object_align aligned, uninitialized
+    */
+   void* allocate();
+
+   /**
+    * release - gives the slot of an object from allocate back
+    * to whichever pool it came from, the object must already be
+    * destroyed.  Safe from any thread.
+    * @param   obj - from allocate
+    */
+   static void release( void * const obj ) noexcept;
+
+   /**
+    * owner - pool obj was allocated from, no search.
+    * @param   obj - from allocate
+    * @return  slab_pool*
+    */
+   static slab_pool* owner( const void * const obj ) noexcept;
+
+   /** slots carved so far, i.e., the most ever live at once **/
+   std::size_t slots() const noexcept
+   {
+      return( carved );
+   }
+
+private:
+   struct slot;
+
+   slab_pool( const std::size_t object_size,
+              const std::size_t object_align );
+   ~slab_pool();
+
+   slab_pool( const slab_pool &other ) = delete;
+   slab_pool& operator = ( const slab_pool &other ) = delete;
+
+   static slot* slot_of( const void * const obj ) noexcept;
+
+   /** refills local from returned, else from a new slab **/
+   void refill();
+
+   /** counted out, deletes the pool once it hits zero **/
+   void drop( const std::size_t n ) noexcept;
+
+   struct slab
+   {
+      void        *mem;
+      std::size_t  length;
+   };
+
+   /** of each slot, at least a cache line **/
+   const std::size_t           align;
+   /** object starts this far into a slot, the header just before it **/
+   const std::size_t           header_bytes;
+   const std::size_t           stride;
+   raft::mem::options          opts;
+   std::vector< slab >         slabs;
+   std::size_t                 carved       = 0;
+   std::size_t                 next_slab    = 0;
+   /** free slots only the producer touches **/
+   slot                       *local        = nullptr;
+   std::size_t                 local_count  = 0;
+   /** keeps the producer's half off the line everyone else writes **/
+   char                        pad[ L1D_CACHE_LINE_SIZE ];
+   /** slots handed back by everyone else **/
+   std::atomic< slot* >        returned     = { nullptr };
+   /**
+    * one for the FIFO plus one per carved slot that isn't on the
+    * returned list, whoever brings it to zero deletes the pool.
+    */
+   std::atomic< std::size_t >  refs         = { 1 };
+};
+
+} /** end namespace Buffer **/
+
+#endif /* END _SLABPOOL_HPP_ */
@@ -26,9 +26,16 @@ namespace raft {
 template < class T, class method = roundrobin > class split : public raft::parallel_k
 {
 public:
-   split( const std::size_t num_ports = 1 ) : parallel_k()
+   /**
+    * split - batch is the most items sent to one port before
+    * the method chooses again, see splitmethod::set_batch.
+    */
+   split( const std::size_t num_ports = 1,
+          const std::size_t batch     = 1 ) : parallel_k()
    {
+      split_func.set_batch( batch );
       input.addPort< T >( "0" );
+      in = input.handle< T >( "0" );
 
       using index_type = std::remove_const_t<decltype(num_ports)>;
       for( index_type it( 0 ); it < num_ports; it++ )
@@ -41,18 +48,23 @@ public:
 
    virtual raft::kstatus run()
    {
-      auto &output_port( input[ "0" ] );
-      const auto avail( output_port.size() );
-      auto range( output_port.template peek_range< T >( avail ) );
-      /** split funtion selects a fifo using the appropriate split method **/
-      if( split_func.send( range, output ) )
+      const auto avail( in.size() );
+      auto range( in.peek_range( avail ) );
+      /** 
+       * split funtion selects a fifo using the appropriate split method,
+       * ports are added and closed while running, see basicparallel.hpp
+       */
+      lock_helper( output );
+      const auto sent( split_func.send( range, output ) );
+      unlock_helper( output );
+      if( sent > 0 )
       {
-         /* recycle item */
-         output_port.recycle( avail );
+         /* recycle only what went out, the rest goes next time */
+         in.recycle( sent );
       }
       else
       {
-         output_port.unpeek();
+         in.unpeek();
       }
       return( raft::proceed );
    }
@@ -65,14 +77,15 @@ public:
 protected:
    virtual void lock()
    {
-      lock_helper( input );
+      lock_helper( output );
    }
 
    virtual void unlock()
    {
-      unlock_helper( input );
+      unlock_helper( output );
    }
    method split_func;
+   port_handle< T > in;
 };
 } /** end namespace raft **/
 #endif /* END _SPLIT_TCC_ */
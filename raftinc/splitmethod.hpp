@@ -20,8 +20,11 @@
 #ifndef _SPLITMETHOD_HPP_
 #define _SPLITMETHOD_HPP_  1
 
+#include <algorithm>
+#include <cstddef>
 #include <type_traits>
 #include <functional>
+#include <vector>
 
 #include "autoreleasebase.hpp"
 #include "signalvars.hpp"
@@ -31,13 +34,31 @@
 
 class autoreleasebase;
 
-/** FIXME, it's relativly easy to do zero copy....so implement **/
+/** 
+ * splitmethod - picks the FIFO a split sends to or a join reads
+ * from.  Sub-classes implement select_fifo, which looks at each
+ * port at most once and returns nullptr if none is ready rather
+ * than wait, the split or join tries again on its next run.
+ *
+ * FIXME, it's relativly easy to do zero copy....so implement 
+ */
 class splitmethod
 {
 public:
    splitmethod()          = default;
    virtual ~splitmethod() = default;
 
+   /**
+    * set_batch - most items a split sends to one FIFO before
+    * choosing again, default is one.  Larger batches cost
+    * fewer selections but balance more coarsely.
+    * @param   n - const std::size_t, zero is taken as one
+    */
+   void set_batch( const std::size_t n ) noexcept
+   {
+      batch = ( n == 0 ? 1 : n );
+   }
+
    template < class T /* item */,
               typename std::enable_if<
                         std::is_fundamental< T >::value >::type* = nullptr >
@@ -59,33 +80,37 @@ public:
     * send - this version is intended for the peekrange object from
     * autorelease.tcc in the fifo dir.  I'll add some code to enable
     * only on the autorelease object shortly, but for now this will
-    * get it working.
+    * get it working.  Up to batch items go out per selection, as
+    * many selections as it takes to send the range or find no
+    * port with room.
     * @param   range - T&, autorelease object
     * @param   outputs - output port list
+    * @return  std::size_t - items sent, from the front of range
     */
    template < class T   /* peek range obj,  */,
               typename std::enable_if<
                        ! std::is_base_of< autoreleasebase,
                                         T >::value >::type* = nullptr >
-      bool send( T &range, Port &outputs )
+      std::size_t send( T &range, Port &outputs )
    {
-      auto * const fifo( select_fifo( outputs, sendtype ) );
-      if( fifo != nullptr )
+      std::size_t sent( 0 );
+      while( sent < range.size() )
       {
-         const auto space_avail(
-            std::min( fifo->space_avail(), range.size() ) );
-
-         using index_type = std::remove_const_t<decltype(space_avail)>;
-         for( index_type i( 0 ); i < space_avail; i++ )
+         auto * const fifo( select_fifo( outputs, sendtype ) );
+         if( fifo == nullptr )
          {
-            fifo->push( range[ i ].ele, range[ i ].sig );
+            break;
          }
-         return( true );
-      }
-      else
-      {
-         return( false );
+         const auto n( std::min( { fifo->space_avail(),
+                                   range.size() - sent,
+                                   batch } ) );
+         for( std::size_t i( 0 ); i < n; i++ )
+         {
+            fifo->push( range[ sent + i ].ele, range[ sent + i ].sig );
+         }
+         sent += n;
       }
+      return( sent );
    }
 
    template < class T /* item */ >
@@ -107,5 +132,38 @@ public:
 protected:
    enum functype { sendtype, gettype };
    virtual FIFO*  select_fifo( Port &port_list, const functype type ) = 0;
+
+   /**
+    * fifos - the ports as a vector in port id order, rebuilt
+    * only when ports have been added, call with the port lock
+    * held.
+    * @param   port_list - Port&
+    * @return  std::vector< FIFO* >&
+    */
+   std::vector< FIFO* >& fifos( Port &port_list );
+
+   /**
+    * ready - true if a split can send to the fifo (open and
+    * with room) or a join can read from it (has data).
+    */
+   static inline bool ready( FIFO &fifo, const functype type )
+   {
+      /** closed ports belong to retired copies **/
+      return( type == sendtype ?
+              ! fifo.is_invalid() && fifo.space_avail() > 0 :
+              fifo.size() > 0 );
+   }
+
+   /** occupancy - fraction full, FIFOs may be resized to differ **/
+   static inline float occupancy( FIFO &fifo )
+   {
+      return( static_cast< float >( fifo.size() ) /
+              static_cast< float >( fifo.capacity() ) );
+   }
+
+   std::size_t batch = 1;
+
+private:
+   std::vector< FIFO* > fifo_cache;
 };
 #endif /* END _SPLITMETHOD_HPP_ */
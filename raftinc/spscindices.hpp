@@ -0,0 +1,41 @@
+/**
+ * spscindices.hpp - the free-running indices and the valid flag of
+ * a single producer/consumer ring, each index on its own cache line.
+ * The heap ring keeps these in the FIFO object, the shared memory
+ * ring in the segment so the other process sees them, see
+ * ringbufferspsc.tcc and shmsegment.hpp.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 21:40:12 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _SPSCINDICES_HPP_
+#define _SPSCINDICES_HPP_  1
+#include <atomic>
+#include <cstddef>
+
+#include "defs.hpp"
+
+struct SPSCIndices
+{
+   std::atomic< std::size_t > tail = { 0 };
+   char pad_tail[ L1D_CACHE_LINE_SIZE - sizeof( std::atomic< std::size_t > ) ];
+   std::atomic< std::size_t > head = { 0 };
+   char pad_head[ L1D_CACHE_LINE_SIZE - sizeof( std::atomic< std::size_t > ) ];
+   std::atomic< bool >        valid = { true };
+};
+
+#endif /* END _SPSCINDICES_HPP_ */
@@ -0,0 +1,248 @@
+/**
+ * typedfifo.tcc - a view of a port's FIFO for kernels that know the
+ * item type and the kind of ring behind the edge at compile time.
+ * Every FIFO call goes through a virtual local_* function taking
+ * void pointers, so the copy of T can't be inlined into the kernel.
+ * The view finds the concrete ring once and then calls its push,
+ * pop and peek directly:
+ *
+ *    out = output.typed< float >( "0" );             //constructor
+ *    out.push( x );                                  //run()
+ *
+ *    in = input.typed< float, Type::HeapSPSC >( "0" );
+ *
+ * If the allocator built some other kind of FIFO for the edge, or
+ * T isn't stored inline, the view quietly goes through the virtual
+ * interface instead, so it is always safe to use.  Like a port
+ * handle it notices when the port is given a new FIFO.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 23:40:18 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _TYPEDFIFO_TCC_
+#define _TYPEDFIFO_TCC_  1
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+#include "alloc_traits.tcc"
+#include "defs.hpp"
+#include "fifo.hpp"
+#include "port_info.hpp"
+#include "ringbuffer.tcc"
+#include "ringbuffertypes.hpp"
+#include "signal.hpp"
+
+class Port;
+
+/**
+ * typed_ring - the concrete ring for T over type, if it has the
+ * non-virtual push_item/pop_item/peek_item, FIFO otherwise.
+ */
+template < class T, Type::RingBufferType type, class Enable = void >
+struct typed_ring
+{
+   using buffer_t = FIFO;
+   static constexpr bool direct = false;
+};
+
+template < class T >
+struct typed_ring< T,
+                   Type::Heap,
+                   typename std::enable_if< inline_alloc< T >::value >::type >
+{
+   using buffer_t = RingBufferBase< T, Type::Heap >;
+   static constexpr bool direct = true;
+};
+
+template < class T >
+struct typed_ring< T,
+                   Type::HeapSPSC,
+                   typename std::enable_if< spsc_alloc< T >::value >::type >
+{
+   using buffer_t = RingBufferSPSC< T, Type::HeapSPSC >;
+   static constexpr bool direct = true;
+};
+
+template < class T >
+struct typed_ring< T,
+                   Type::SharedMemory,
+                   typename std::enable_if< shm_alloc< T >::value >::type >
+{
+   using buffer_t = RingBufferSPSC< T, Type::SharedMemory >;
+   static constexpr bool direct = true;
+};
+
+template < class T, Type::RingBufferType type = Type::Heap >
+class TypedFIFO
+{
+   using ring     = typed_ring< T, type >;
+   using buffer_t = typename ring::buffer_t;
+   using direct_t = std::integral_constant< bool, ring::direct >;
+public:
+   /** not bound to a port, get one from Port::typed **/
+   TypedFIFO() = default;
+
+   /**
+    * fifo - the virtual interface, for anything not here.
+    * @return  FIFO&
+    */
+   FIFO& fifo()
+   {
+      bind();
+      return( *current );
+   }
+
+   /**
+    * is_direct - true if calls skip the virtual interface, only
+    * meaningful once the map is executing.
+    * @return  bool
+    */
+   bool is_direct()
+   {
+      bind();
+      return( buffer != nullptr );
+   }
+
+   std::size_t size()
+   {
+      return( fifo().size() );
+   }
+
+   void push( const T &item, const raft::signal signal = raft::none )
+   {
+      bind();
+      push( item, signal, direct_t() );
+   }
+
+   void pop( T &item, raft::signal *signal = nullptr )
+   {
+      bind();
+      pop( item, signal, direct_t() );
+   }
+
+   T& peek( raft::signal *signal = nullptr )
+   {
+      bind();
+      return( peek( signal, direct_t() ) );
+   }
+
+   void unpeek()
+   {
+      fifo().unpeek();
+   }
+
+   void recycle( const std::size_t range = 1 )
+   {
+      fifo().recycle( range );
+   }
+
+   template < class... Args >
+   T& allocate( Args&&... params )
+   {
+      return( fifo().template allocate< T >( std::forward< Args >( params )... ) );
+   }
+
+   void send( const raft::signal signal = raft::none )
+   {
+      fifo().send( signal );
+   }
+
+   template < class iterator_type >
+   void insert( iterator_type begin,
+                iterator_type end,
+                const raft::signal signal = raft::none )
+   {
+      fifo().insert( begin, end, signal );
+   }
+
+private:
+   explicit TypedFIFO( PortInfo * const info ) : info( info ){}
+
+   /**
+    * bind - the cast is only redone when the port's FIFO
+    * changes, which is once, when the map executes.
+    */
+   inline void bind()
+   {
+      assert( info != nullptr );
+      auto * const f( info->getFIFO() );
+      if( R_UNLIKELY( f != current ) )
+      {
+         assert( f != nullptr );
+         current = f;
+         buffer  = ring::direct ? dynamic_cast< buffer_t* >( f ) : nullptr;
+      }
+   }
+
+   inline void push( const T &item, const raft::signal signal, std::true_type )
+   {
+      if( R_LIKELY( buffer != nullptr ) )
+      {
+         buffer->push_item( &item, signal );
+      }
+      else
+      {
+         current->push( item, signal );
+      }
+   }
+
+   inline void push( const T &item, const raft::signal signal, std::false_type )
+   {
+      current->push( item, signal );
+   }
+
+   inline void pop( T &item, raft::signal *signal, std::true_type )
+   {
+      if( R_LIKELY( buffer != nullptr ) )
+      {
+         buffer->pop_item( &item, signal );
+      }
+      else
+      {
+         current->pop( item, signal );
+      }
+   }
+
+   inline void pop( T &item, raft::signal *signal, std::false_type )
+   {
+      current->pop( item, signal );
+   }
+
+   inline T& peek( raft::signal *signal, std::true_type )
+   {
+      if( R_LIKELY( buffer != nullptr ) )
+      {
+         return( *buffer->peek_item( signal ) );
+      }
+      return( current->template peek< T >( signal ) );
+   }
+
+   inline T& peek( raft::signal *signal, std::false_type )
+   {
+      return( current->template peek< T >( signal ) );
+   }
+
+   PortInfo  *info    = nullptr;
+   FIFO      *current = nullptr;
+   /** the concrete ring, null if the FIFO is some other kind **/
+   buffer_t  *buffer  = nullptr;
+
+   friend class ::Port;
+};
+
+#endif /* END _TYPEDFIFO_TCC_ */
@@ -0,0 +1,356 @@
+/**
+ * waitstrategy.hpp - what a producer does when its FIFO is full
+ * and what a consumer does when its FIFO is empty.  Each FIFO owns
+ * one of these, the strategy is picked per port or per map and set
+ * by the allocator when the FIFO is attached to its ports.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 13:05:44 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _WAITSTRATEGY_HPP_
+#define _WAITSTRATEGY_HPP_  1
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+#include "blocked.hpp"
+#include "readiness.hpp"
+#include "defs.hpp"
+#ifdef USEQTHREADS
+#include <qthread/qthread.hpp>
+#endif
+
+namespace raft
+{
+namespace wait
+{
+/**
+ * strategy - use_default on a port means take the strategy
+ * set on the map, which itself defaults to adaptive.
+ * spin     - never leave the core, pause between checks
+ * yield    - spin briefly then yield the core each check
+ * park     - spin briefly then sleep on a futex until the
+ *            other end of the FIFO wakes us
+ * adaptive - spin, then yield, then park, how long each phase
+ *            lasts depends on how often the edge has blocked
+ */
+enum strategy : std::uint8_t { use_default = 0,
+                               spin,
+                               yield,
+                               park,
+                               adaptive };
+} /** end namespace wait **/
+} /** end namespace raft **/
+
+class WaitStrategy
+{
+public:
+   using block_hook_t = void (*)( void * const );
+
+   /**
+    * blocked_spins - a wait that has gone around this many
+    * times counts as blocked rather than a passing stall, the
+    * block hook fires and resizeable FIFOs tell the allocator.
+    */
+   static constexpr std::size_t blocked_spins = 64;
+
+   WaitStrategy() = default;
+
+   /**
+    * set_block_hook - per thread, hook is called with data once
+    * per wait that outlasts the initial spin, i.e., when the
+    * calling thread is actually blocked on a FIFO.  Schedulers
+    * that multiplex kernels over a few threads use this to
+    * notice a kernel pinning its thread.  Pass nullptr to clear.
+    * @param   hook - block_hook_t
+    * @param   data - void*, passed to hook
+    */
+   static void set_block_hook( block_hook_t hook,
+                               void * const data ) noexcept;
+
+   /**
+    * set_ready_bits - bind the FIFO to the readiness bitmaps of
+    * the kernels on either end, called by the allocator.
+    * @param   data   - consumer's bit, set when items are published
+    * @param   space  - producer's bit, set when slots are freed
+    * @param   closed - consumer's bit, set by close()
+    */
+   void set_ready_bits( const ReadyBit &data,
+                        const ReadyBit &space,
+                        const ReadyBit &closed ) noexcept;
+
+   /**
+    * set - change the strategy, raft::wait::use_default
+    * selects raft::wait::adaptive.
+    * @param   s - raft::wait::strategy
+    */
+   void set( const raft::wait::strategy s ) noexcept;
+
+   /**
+    * get - returns the current strategy
+    * @return raft::wait::strategy
+    */
+   raft::wait::strategy get() const noexcept;
+
+   /**
+    * producer_wait - call each time around a loop in which
+    * the producer found the FIFO full.  The ready function
+    * is checked once more before parking, it must return
+    * true when the producer can make progress and must be
+    * callable without the buffer entered.
+    * @param   spins - number of times the caller has already
+    *                  waited for this operation
+    * @param   stats - write stats for this FIFO
+    * @param   ready - bool()
+    */
+   template < class F >
+   inline void producer_wait( const std::size_t spins,
+                              const Blocked &stats,
+                              F &&ready )
+   {
+      if( R_UNLIKELY( spins == 0 ) )
+      {
+         /** full, the producer owns its space bit so clears it **/
+         producer.ready.clear();
+         if( ready() )
+         {
+            producer.ready.set();
+         }
+      }
+      wait( producer, spins, stats, std::forward< F >( ready ) );
+   }
+
+   /**
+    * consumer_wait - same as producer_wait, but for a
+    * consumer that found the FIFO empty (or too short).
+    * ready must also return true if the FIFO is invalid
+    * so that a parked consumer sees end of stream.
+    */
+   template < class F >
+   inline void consumer_wait( const std::size_t spins,
+                              const Blocked &stats,
+                              F &&ready )
+   {
+      wait( consumer, spins, stats, std::forward< F >( ready ) );
+   }
+
+   /**
+    * wake_producer - consumer calls after freeing slots,
+    * only costs a load unless the producer is parked.
+    */
+   inline void wake_producer() noexcept
+   {
+      producer.ready.set();
+      wake( producer );
+   }
+
+   /**
+    * wake_consumer - producer calls after publishing items
+    * or invalidating the FIFO.
+    */
+   inline void wake_consumer() noexcept
+   {
+      consumer.ready.set();
+      wake( consumer );
+   }
+
+   /**
+    * close - producer calls after invalidating the FIFO,
+    * wakes the consumer without marking data available.
+    */
+   inline void close() noexcept
+   {
+      closed.set();
+      wake( consumer );
+   }
+
+   /**
+    * relax - one iteration of a polite spin, pause on
+    * x86 or qthread_yield when using qthreads.
+    */
+   static inline void relax() noexcept
+   {
+#ifdef USEQTHREADS
+      qthread_yield();
+#elif __x86_64
+      __asm__ volatile("\
+        pause"
+        :
+        :
+        : );
+#endif
+   }
+
+private:
+   /**
+    * side - futex word, parked count and readiness bit for
+    * one end of the FIFO, padded so that the producer and
+    * consumer ends don't share a cache line.
+    */
+   struct side
+   {
+      std::atomic< std::uint32_t > seq     = { 0 };
+      std::atomic< std::uint32_t > waiters = { 0 };
+      ReadyBit                     ready;
+      char pad[ L1D_CACHE_LINE_SIZE - ( sizeof( std::uint32_t ) * 2 ) -
+                sizeof( ReadyBit ) ];
+   };
+
+   /** checks spent spinning before yield/park for spin/yield/park **/
+   static constexpr std::size_t spin_limit         = 64;
+   /** adaptive limits for an edge that blocks while moving few items **/
+   static constexpr std::size_t idle_spin_limit    = 16;
+   static constexpr std::size_t idle_yield_limit   = 64;
+   /** adaptive limits for a busy edge, a block is likely short lived **/
+   static constexpr std::size_t busy_spin_limit    = 256;
+   static constexpr std::size_t busy_yield_limit   = 4096;
+   /** fewer items than this since the stats were zeroed is idle **/
+   static constexpr Blocked::value_type idle_count = 64;
+
+   template < class F >
+   inline void wait( side &s,
+                     const std::size_t spins,
+                     const Blocked &stats,
+                     F &&ready )
+   {
+      if( R_UNLIKELY( spins == blocked_spins ) )
+      {
+         notify_blocked();
+      }
+      switch( mode )
+      {
+         case( raft::wait::spin ):
+         {
+            relax();
+         }
+         break;
+         case( raft::wait::yield ):
+         {
+            if( spins < spin_limit )
+            {
+               relax();
+            }
+            else
+            {
+               yield();
+            }
+         }
+         break;
+         case( raft::wait::park ):
+         {
+            if( spins < spin_limit )
+            {
+               relax();
+            }
+            else
+            {
+               park( s, std::forward< F >( ready ) );
+            }
+         }
+         break;
+         default:
+         {
+            /**
+             * adaptive, an edge that has blocked in this stats
+             * window while moving few items is mostly idle so
+             * get off the core quickly, a busy edge that blocks
+             * will likely unblock within a few hundred cycles.
+             */
+            const bool idle( stats.bec.blocked != 0 &&
+                             stats.bec.count < idle_count );
+            const auto spin_n(  idle ? idle_spin_limit  : busy_spin_limit );
+            const auto yield_n( idle ? idle_yield_limit : busy_yield_limit );
+            if( spins < spin_n )
+            {
+               relax();
+            }
+            else if( spins < yield_n )
+            {
+               yield();
+            }
+            else
+            {
+               park( s, std::forward< F >( ready ) );
+            }
+         }
+      }
+   }
+
+   template < class F >
+   inline void park( side &s, F &&ready )
+   {
+      s.waiters.fetch_add( 1, std::memory_order_seq_cst );
+      const auto ticket( s.seq.load( std::memory_order_acquire ) );
+      if( ! ready() )
+      {
+         futex_wait( s.seq, ticket );
+      }
+      s.waiters.fetch_sub( 1, std::memory_order_release );
+   }
+
+   inline void wake( side &s ) noexcept
+   {
+      /**
+       * an explicit park needs the fence so that either we see
+       * the waiter or it sees our update, adaptive skips it on
+       * the hot path and relies on the bounded park instead.
+       */
+      if( mode == raft::wait::park )
+      {
+         std::atomic_thread_fence( std::memory_order_seq_cst );
+      }
+      if( R_UNLIKELY( s.waiters.load( std::memory_order_relaxed ) != 0 ) )
+      {
+         s.seq.fetch_add( 1, std::memory_order_release );
+         futex_wake( s.seq );
+      }
+   }
+
+   /** calls this thread's block hook if there is one **/
+   static void notify_blocked() noexcept;
+
+   static inline void yield() noexcept
+   {
+#ifdef USEQTHREADS
+      qthread_yield();
+#else
+      std::this_thread::yield();
+#endif
+   }
+
+   /**
+    * futex_wait - sleep while word == expected, returns early
+    * if woken, if the value changed or after a short timeout
+    * so that a missed wakeup only costs latency.
+    */
+   static void futex_wait( std::atomic< std::uint32_t > &word,
+                           const std::uint32_t expected ) noexcept;
+
+   /**
+    * futex_wake - wake every thread sleeping on word
+    */
+   static void futex_wake( std::atomic< std::uint32_t > &word ) noexcept;
+
+   side                 producer;
+   side                 consumer;
+   ReadyBit             closed;
+   raft::wait::strategy mode = raft::wait::adaptive;
+};
+
+#endif /* END _WAITSTRATEGY_HPP_ */
@@ -0,0 +1,202 @@
+/**
+ * workstealschedule.hpp - M:N scheduler, a fixed number of
+ * worker threads each with its own deque of kernels.  A worker
+ * runs the kernels on its own deque that are ready (input data
+ * and room on every output port) and steals from the other
+ * workers when it has nothing to run.
+ *
+ * A kernel that blocks inside a FIFO anyway (pushes more than one
+ * item or pops more than is there) pins its worker, up to
+ * max_spares more workers are started to cover for those, so
+ * there are never more than n_workers + max_spares threads.  Once
+ * every spare is in use the ports are checked exactly before each
+ * firing, so only kernels that push or pop several items at once
+ * still block.  A map where more of those than that block at once
+ * can stall, the default scheduler suits those better.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 14:10:27 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _WORKSTEALSCHEDULE_HPP_
+#define _WORKSTEALSCHEDULE_HPP_  1
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "schedule.hpp"
+#include "defs.hpp"
+
+namespace raft{
+   class kernel;
+   class map;
+}
+
+class work_steal_schedule : public Schedule
+{
+public:
+   /** workers started on top of n_workers to cover blocked ones **/
+   static constexpr std::size_t max_spares = 4;
+
+   /**
+    * work_steal_schedule - constructor, takes a map object,
+    * workers are launched by start().
+    * @param   map - raft::map&
+    * @param   n_workers - number of worker threads, zero
+    *          means one per hardware thread
+    */
+   work_steal_schedule( raft::map &map,
+                        const std::size_t n_workers = 0 );
+
+   virtual ~work_steal_schedule();
+
+   /**
+    * start - launches the workers and returns once every
+    * kernel has finished.
+    */
+   virtual void start();
+
+protected:
+   /**
+    * handleSchedule - kernels added while running (e.g., by
+    * the parallelism monitor) go onto the deques round robin.
+    * If every worker has already run out of kernels and left,
+    * one is started again for it.  Kernels added once start()
+    * is done joining the workers are never run.
+    * @param   kernel - kernel to schedule
+    */
+   virtual void handleSchedule( raft::kernel * const kernel );
+
+   /**
+    * task - one per kernel, lives in exactly one deque unless
+    * a worker is running it.  The gc sets are per kernel since
+    * a kernel can move between workers.
+    */
+   struct task
+   {
+      task( raft::kernel * const k ) : k( k ){}
+
+      raft::kernel *k        = nullptr;
+      volatile bool finished = false;
+      ptr_map_t     in;
+      ptr_set_t     out;
+      ptr_set_t     peekset;
+   };
+
+   struct worker
+   {
+      worker( work_steal_schedule * const sched,
+              const std::size_t index ) : sched( sched ),
+                                          index( index ){}
+
+      work_steal_schedule  *sched   = nullptr;
+      const std::size_t     index   = 0;
+      std::mutex            lock;
+      std::deque< task* >   q;
+      /** set while the kernel being run is blocked inside a FIFO **/
+      bool                  blocked = false;
+      std::thread           th;
+   };
+
+   /**
+    * worker_run - main loop for each worker thread.
+    * @param   w - worker*
+    */
+   static void worker_run( worker * const w );
+
+   /**
+    * worker_blocked - installed as the FIFO block hook on each
+    * worker thread.  A kernel that blocks inside run() pins its
+    * worker, so its deque is handed off and a spare worker is
+    * started to keep n_workers threads making progress.
+    * @param   data - worker*
+    */
+   static void worker_blocked( void * const data );
+
+   /**
+    * next_task - pops from the front of our own deque, steals
+    * from another worker's deque if ours is empty.
+    * @return  task*, nullptr if nothing was found
+    */
+   task* next_task( worker * const w );
+
+   /**
+    * steal - moves half of the first non-empty deque found
+    * after ours onto the back of ours.
+    * @return  bool - true if anything was stolen
+    */
+   bool steal( worker * const w );
+
+   /**
+    * start_worker - starts the next worker slot if there is
+    * one, call with spawn_mutex held.
+    */
+   void start_worker();
+
+   /**
+    * keep_running - false once every kernel has finished, the
+    * calling worker is then counted out of n_running.  Checked
+    * again under spawn_mutex so a kernel handleSchedule adds
+    * right then isn't left without a worker.
+    * @return  bool
+    */
+   bool keep_running();
+
+   /**
+    * spares_used - true once all max_spares spare workers have
+    * been started, workers then check ports exactly before
+    * firing a kernel.
+    * @return  bool
+    */
+   bool spares_used() const;
+
+   const std::size_t                        n_workers;
+   /** n_workers + max_spares slots **/
+   std::vector< std::unique_ptr< worker > > workers;
+   std::atomic< std::size_t >               n_started  = { 0 };
+   std::atomic< std::size_t >               n_blocked  = { 0 };
+   std::atomic< std::size_t >               remaining  = { 0 };
+   std::atomic< std::size_t >               next_queue = { 0 };
+   std::mutex                               spawn_mutex;
+   /** under spawn_mutex, workers still in worker_run **/
+   std::size_t                              n_running  = 0;
+   /** under spawn_mutex, start() has joined or is joining the workers **/
+   bool                                     stopped    = false;
+   /** signalled when n_running gets to zero **/
+   std::condition_variable                  all_done;
+   std::mutex                               task_mutex;
+   std::vector< std::unique_ptr< task > >   tasks;
+};
+
+/**
+ * work_steal_schedule_n - same as above with a fixed worker
+ * count, for use as the scheduler argument of raft::map::exe,
+ * e.g., map.exe< partition_dummy, work_steal_schedule_n< 4 > >().
+ */
+template < std::size_t N > class work_steal_schedule_n :
+   public work_steal_schedule
+{
+public:
+   work_steal_schedule_n( raft::map &map ) : work_steal_schedule( map, N ){}
+
+   virtual ~work_steal_schedule_n() = default;
+};
+
+#endif /* END _WORKSTEALSCHEDULE_HPP_ */
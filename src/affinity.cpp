@@ -49,7 +49,8 @@ affinity::set( const std::size_t desired_core )
    cpu_set_t   *cpuset( nullptr );
    auto cpu_allocate_size( -1 );
 #if   (__GLIBC_MINOR__ > 9 ) && (__GLIBC__ == 2 )
-   const auto  processors_to_allocate( 1 );
+   /** a set big enough to hold the core, may be past the first 64 **/
+   const auto  processors_to_allocate( desired_core + 1 );
    cpuset = CPU_ALLOC( processors_to_allocate );
    assert( cpuset != nullptr );
    cpu_allocate_size = CPU_ALLOC_SIZE( processors_to_allocate );
@@ -60,8 +61,9 @@ affinity::set( const std::size_t desired_core )
    assert( cpuset != nullptr );
    CPU_ZERO( cpuset );
 #endif
-   CPU_SET( desired_core,
-            cpuset );
+   CPU_SET_S( desired_core,
+              cpu_allocate_size,
+              cpuset );
    errno = 0;
    if( sched_setaffinity( 0 /* calling thread */,
                          cpu_allocate_size,
@@ -79,6 +81,7 @@ affinity::set( const std::size_t desired_core )
       std::cerr << " exited with error ( " << str << " ).\n";
       exit( EXIT_FAILURE );
    }
+   free( cpuset );
    /** wait till we know we're on the right processor **/
    if( sched_yield() != 0 )
    {
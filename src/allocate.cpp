@@ -26,11 +26,14 @@
 #include "port_info.hpp"
 #include "map.hpp"
 #include "portexception.hpp"
+#include "shmsegment.hpp"
 
 Allocate::Allocate( raft::map &map, volatile bool &exit_alloc ) :
    source_kernels( map.source_kernels ),
    all_kernels(    map.all_kernels ),
-   exit_alloc( exit_alloc )
+   exit_alloc( exit_alloc ),
+   default_wait( map.wait_strategy ),
+   map_max_bytes( map.max_bytes )
 {
 }
 
@@ -72,10 +75,39 @@ Allocate::initialize( PortInfo * const src,
       throw PortDoubleInitializeException(
          "Destination port \"" + dst->my_name +  "\" already initialized!" );
    }
+   /** before anything is pointed at the store, it may be re-allocated **/
+   auto mem( src->mem_options.custom() ? src->mem_options : dst->mem_options );
+   if( mem.custom() )
+   {
+      mem.core = dst->my_kernel->getCoreAssignment();
+      fifo->set_memory_options( mem );
+   }
+   if( src->fused )
+   {
+      fifo->set_fused();
+   }
    src->setFIFO( fifo );
    fifo->set_src_kernel( src->my_kernel );
    dst->setFIFO( fifo );
    fifo->set_dst_kernel( dst->my_kernel );
+   /** a port's own strategy wins, source first, then the map's **/
+   if( src->wait_strategy != raft::wait::use_default )
+   {
+      fifo->set_wait_strategy( src->wait_strategy );
+   }
+   else if( dst->wait_strategy != raft::wait::use_default )
+   {
+      fifo->set_wait_strategy( dst->wait_strategy );
+   }
+   else
+   {
+      fifo->set_wait_strategy( default_wait );
+   }
+   /** producer and consumer publish to each other's readiness bits **/
+   ReadyBit data, closed;
+   dst->my_kernel->readiness.add_input( fifo, data, closed );
+   const auto space( src->my_kernel->readiness.add_output( fifo ) );
+   fifo->set_ready_bits( data, space, closed );
    /** NOTE: this list simply speeds up the monitoring if we want it **/
    allocated_fifo.insert( fifo );
 }
@@ -96,6 +128,12 @@ Allocate::allocate( PortInfo &a, PortInfo &b, void *data )
                         a.start_index,
                         a.existing_buffer );
    }
+   else if( a.fixed_buffer_size != 0 )
+   {
+      fifo = fixed_fifo( a )( a.fixed_buffer_size,
+                              ALLOC_ALIGN_WIDTH,
+                              nullptr );
+   }
    else
    {
       fifo = test_func( INITIAL_ALLOC_SIZE    /* items */,
@@ -105,3 +143,81 @@ Allocate::allocate( PortInfo &a, PortInfo &b, void *data )
    initialize( &a, &b, fifo );
    return;
 }
+
+void
+Allocate::allocate_shm()
+{
+   auto &container( all_kernels.acquire() );
+   for( auto * const k : container )
+   {
+      for( auto * const port : { &k->output, &k->input } )
+      {
+         const auto dir( port == &k->output ? Direction::Producer :
+                                              Direction::Consumer );
+         for( auto &pair : port->portmap.map )
+         {
+            auto &info( pair.second );
+            if( info.mem != SHM || info.getFIFO() != nullptr )
+            {
+               continue;
+            }
+            shm_edge edge{ info.shm_name, dir };
+            auto * const fifo( (*info.const_map[ Type::SharedMemory ])[ false ](
+               info.fixed_buffer_size != 0 ? info.fixed_buffer_size :
+                                             INITIAL_SHM_ALLOC_SIZE,
+               ALLOC_ALIGN_WIDTH,
+               &edge ) );
+            initialize_shm( info, dir, fifo );
+         }
+      }
+   }
+   all_kernels.release();
+}
+
+void
+Allocate::initialize_shm( PortInfo &port,
+                          const Direction dir,
+                          FIFO * const fifo )
+{
+   assert( fifo != nullptr );
+   port.setFIFO( fifo );
+   fifo->set_wait_strategy( port.wait_strategy != raft::wait::use_default ?
+                            port.wait_strategy : default_wait );
+   /** only this end's bits, the other kernel is in the other process **/
+   ReadyBit data, space, closed;
+   if( dir == Direction::Producer )
+   {
+      fifo->set_src_kernel( port.my_kernel );
+      space = port.my_kernel->readiness.add_output( fifo );
+   }
+   else
+   {
+      fifo->set_dst_kernel( port.my_kernel );
+      port.my_kernel->readiness.add_input( fifo, data, closed );
+   }
+   fifo->set_ready_bits( data, space, closed );
+   allocated_fifo.insert( fifo );
+}
+
+void
+Allocate::setResizeSignal( FIFO * const fifo,
+                           const ResizeSignal &signal )
+{
+   assert( fifo != nullptr );
+   fifo->set_resize_signal( signal );
+}
+
+instr_map_t::mapped_type
+Allocate::fixed_fifo( PortInfo &a )
+{
+   /**
+    * fixed size edges are never resized, so the cheaper single
+    * producer/consumer ring can be used if it exists for this type.
+    */
+   const auto spsc( a.const_map.find( Type::HeapSPSC ) );
+   if( spsc != a.const_map.end() )
+   {
+      return( (*(*spsc).second)[ false ] );
+   }
+   return( (*a.const_map[ Type::Heap ])[ false ] );
+}
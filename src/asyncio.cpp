@@ -0,0 +1,546 @@
+/**
+ * asyncio.cpp -
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 04:14:52 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <unistd.h>
+
+#ifdef __linux
+#if defined( __has_include )
+#if __has_include( <linux/io_uring.h> )
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#if defined( __NR_io_uring_setup ) && defined( __NR_io_uring_enter )
+#define RAFT_IOURING 1
+#endif
+#endif
+#endif
+#endif
+
+#include "asyncio.hpp"
+
+namespace
+{
+
+/**
+ * pool_io - one thread per slot, each takes a request, makes one
+ * pread or pwrite call and hands the outcome back.
+ */
+class pool_io : public raft::async_io
+{
+public:
+   explicit pool_io( const std::size_t depth ) : raft::async_io( depth )
+   {
+      for( std::size_t i( 0 ); i < depth; i++ )
+      {
+         workers.emplace_back( [this](){ (this)->work(); } );
+      }
+   }
+
+   virtual ~pool_io()
+   {
+      (this)->drain();
+      {
+         std::lock_guard< std::mutex > guard( mutex );
+         stopping = true;
+      }
+      todo_cv.notify_all();
+      for( auto &t : workers )
+      {
+         t.join();
+      }
+   }
+
+   virtual raft::aio::backend get() const noexcept
+   {
+      return( raft::aio::pool );
+   }
+
+protected:
+   virtual void start( const std::size_t slot )
+   {
+      {
+         std::lock_guard< std::mutex > guard( mutex );
+         todo.push_back( slot );
+      }
+      todo_cv.notify_one();
+   }
+
+   virtual void flush()
+   {
+      /** start() already woke a worker **/
+   }
+
+   virtual void reap( const bool block )
+   {
+      std::vector< std::pair< std::size_t, std::int64_t > > got;
+      {
+         std::unique_lock< std::mutex > lock( mutex );
+         if( block )
+         {
+            done_cv.wait( lock, [&](){ return( ! answers.empty() ); } );
+         }
+         got.swap( answers );
+      }
+      for( const auto &a : got )
+      {
+         (this)->finish( a.first, a.second );
+      }
+   }
+
+private:
+   void work()
+   {
+      for( ;; )
+      {
+         std::size_t slot( 0 );
+         {
+            std::unique_lock< std::mutex > lock( mutex );
+            todo_cv.wait( lock, [&](){ return( stopping || ! todo.empty() ); } );
+            if( todo.empty() )
+            {
+               return;
+            }
+            slot = todo.front();
+            todo.pop_front();
+         }
+         /** the owner leaves the slot alone till it comes back **/
+         const auto &r( requests[ slot ] );
+         ssize_t ret( 0 );
+         do
+         {
+            ret = ( r.op == op_read ?
+               pread(  r.fd, r.buffer + r.done, r.length - r.done, r.offset + r.done ) :
+               pwrite( r.fd, r.buffer + r.done, r.length - r.done, r.offset + r.done ) );
+         }while( ret < 0 && errno == EINTR );
+         const std::int64_t result( ret < 0 ? -errno : ret );
+         {
+            std::lock_guard< std::mutex > guard( mutex );
+            answers.emplace_back( slot, result );
+         }
+         done_cv.notify_one();
+      }
+   }
+
+   std::mutex                                              mutex;
+   std::condition_variable                                 todo_cv;
+   std::condition_variable                                 done_cv;
+   std::deque< std::size_t >                               todo;
+   std::vector< std::pair< std::size_t, std::int64_t > >   answers;
+   bool                                                    stopping = false;
+   std::vector< std::thread >                              workers;
+};
+
+#ifdef RAFT_IOURING
+
+int
+uring_setup( const unsigned entries, struct io_uring_params * const p )
+{
+   return( static_cast< int >( syscall( __NR_io_uring_setup, entries, p ) ) );
+}
+
+int
+uring_enter( const int         fd,
+             const unsigned    to_submit,
+             const unsigned    min_complete,
+             const unsigned    flags )
+{
+   return( static_cast< int >(
+      syscall( __NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0 ) ) );
+}
+
+/**
+ * uring_io - requests go on the submission ring as readv/writev
+ * (the oldest opcodes, so any kernel with io_uring has them) and
+ * come back on the completion ring, user_data is the slot.
+ */
+class uring_io : public raft::async_io
+{
+public:
+   /** make - nullptr if we can't have a ring **/
+   static uring_io* make( const std::size_t depth )
+   {
+      struct io_uring_params p;
+      std::memset( &p, 0, sizeof( p ) );
+      const auto fd( uring_setup( static_cast< unsigned >( depth ), &p ) );
+      if( fd < 0 )
+      {
+         return( nullptr );
+      }
+      auto *ring( new uring_io( depth, fd ) );
+      if( ! ring->map( p ) )
+      {
+         delete( ring );
+         return( nullptr );
+      }
+      return( ring );
+   }
+
+   virtual ~uring_io()
+   {
+      if( sqes != nullptr )
+      {
+         (this)->drain();
+      }
+      unmap( sq_ptr, sq_len );
+      if( cq_ptr != sq_ptr )
+      {
+         unmap( cq_ptr, cq_len );
+      }
+      unmap( sqes, sqes_len );
+      close( ring_fd );
+   }
+
+   virtual raft::aio::backend get() const noexcept
+   {
+      return( raft::aio::uring );
+   }
+
+protected:
+   virtual void start( const std::size_t slot )
+   {
+      auto &r( requests[ slot ] );
+      iov[ slot ].iov_base = r.buffer + r.done;
+      iov[ slot ].iov_len  = r.length - r.done;
+      /** only we move the tail, the kernel only reads it **/
+      const unsigned tail( *sq_tail );
+      const unsigned index( tail & *sq_mask );
+      auto * const sqe( &sqes[ index ] );
+      std::memset( sqe, 0, sizeof( *sqe ) );
+      sqe->opcode    = ( r.op == op_read ? IORING_OP_READV : IORING_OP_WRITEV );
+      sqe->fd        = r.fd;
+      sqe->off       = static_cast< decltype( sqe->off ) >( r.offset + r.done );
+      sqe->addr      = reinterpret_cast< std::uintptr_t >( &iov[ slot ] );
+      sqe->len       = 1;
+      sqe->user_data = slot;
+      sq_array[ index ] = index;
+      __atomic_store_n( sq_tail, tail + 1, __ATOMIC_RELEASE );
+      to_submit++;
+   }
+
+   virtual void flush()
+   {
+      while( to_submit > 0 )
+      {
+         const auto ret( uring_enter( ring_fd, to_submit, 0, 0 ) );
+         if( ret < 0 )
+         {
+            if( errno == EINTR || errno == EAGAIN )
+            {
+               continue;
+            }
+            perror( "Failed to submit to io_uring, exiting!" );
+            exit( EXIT_FAILURE );
+         }
+         to_submit -= static_cast< unsigned >( ret );
+      }
+   }
+
+   virtual void reap( const bool block )
+   {
+      (this)->flush();
+      for( ;; )
+      {
+         /** only we move the head, the kernel moves the tail **/
+         unsigned head( *cq_head );
+         const unsigned tail( __atomic_load_n( cq_tail, __ATOMIC_ACQUIRE ) );
+         if( head != tail )
+         {
+            std::vector< std::pair< std::size_t, std::int64_t > > got;
+            for( ; head != tail; head++ )
+            {
+               const auto &cqe( cqes[ head & *cq_mask ] );
+               got.emplace_back( static_cast< std::size_t >( cqe.user_data ), cqe.res );
+            }
+            __atomic_store_n( cq_head, head, __ATOMIC_RELEASE );
+            /** finish() may start() again, so only once the ring is put back **/
+            for( const auto &a : got )
+            {
+               (this)->finish( a.first, a.second );
+            }
+            return;
+         }
+         if( ! block )
+         {
+            return;
+         }
+         if( uring_enter( ring_fd, 0, 1, IORING_ENTER_GETEVENTS ) < 0 &&
+             errno != EINTR && errno != EAGAIN )
+         {
+            perror( "Failed to wait on io_uring, exiting!" );
+            exit( EXIT_FAILURE );
+         }
+      }
+   }
+
+private:
+   uring_io( const std::size_t depth, const int fd ) : raft::async_io( depth ),
+                                                       ring_fd( fd ),
+                                                       iov( depth )
+   {
+   }
+
+   static void unmap( void * const ptr, const std::size_t length )
+   {
+      if( ptr != nullptr && ptr != MAP_FAILED )
+      {
+         munmap( ptr, length );
+      }
+   }
+
+   bool map( const struct io_uring_params &p )
+   {
+      sq_len = p.sq_off.array + p.sq_entries * sizeof( unsigned );
+      cq_len = p.cq_off.cqes  + p.cq_entries * sizeof( struct io_uring_cqe );
+      bool single( false );
+#ifdef IORING_FEAT_SINGLE_MMAP
+      single = ( p.features & IORING_FEAT_SINGLE_MMAP ) != 0;
+#endif
+      if( single )
+      {
+         sq_len = cq_len = std::max( sq_len, cq_len );
+      }
+      sq_ptr = mmap( nullptr, sq_len, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING );
+      if( sq_ptr == MAP_FAILED )
+      {
+         sq_ptr = nullptr;
+         return( false );
+      }
+      cq_ptr = ( single ? sq_ptr : mmap( nullptr, cq_len, PROT_READ | PROT_WRITE,
+                                         MAP_SHARED | MAP_POPULATE, ring_fd,
+                                         IORING_OFF_CQ_RING ) );
+      if( cq_ptr == MAP_FAILED )
+      {
+         cq_ptr = nullptr;
+         return( false );
+      }
+      sqes_len = p.sq_entries * sizeof( struct io_uring_sqe );
+      auto * const s( mmap( nullptr, sqes_len, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES ) );
+      if( s == MAP_FAILED )
+      {
+         return( false );
+      }
+      sqes = reinterpret_cast< struct io_uring_sqe* >( s );
+      auto * const sq( reinterpret_cast< char* >( sq_ptr ) );
+      auto * const cq( reinterpret_cast< char* >( cq_ptr ) );
+      sq_tail  = reinterpret_cast< unsigned* >( sq + p.sq_off.tail );
+      sq_mask  = reinterpret_cast< unsigned* >( sq + p.sq_off.ring_mask );
+      sq_array = reinterpret_cast< unsigned* >( sq + p.sq_off.array );
+      cq_head  = reinterpret_cast< unsigned* >( cq + p.cq_off.head );
+      cq_tail  = reinterpret_cast< unsigned* >( cq + p.cq_off.tail );
+      cq_mask  = reinterpret_cast< unsigned* >( cq + p.cq_off.ring_mask );
+      cqes     = reinterpret_cast< struct io_uring_cqe* >( cq + p.cq_off.cqes );
+      return( true );
+   }
+
+   const int                    ring_fd;
+   /** one per slot, readv/writev point at these **/
+   std::vector< struct iovec >  iov;
+   void                        *sq_ptr   = nullptr;
+   std::size_t                  sq_len   = 0;
+   void                        *cq_ptr   = nullptr;
+   std::size_t                  cq_len   = 0;
+   struct io_uring_sqe         *sqes     = nullptr;
+   std::size_t                  sqes_len = 0;
+   unsigned                    *sq_tail  = nullptr;
+   unsigned                    *sq_mask  = nullptr;
+   unsigned                    *sq_array = nullptr;
+   unsigned                    *cq_head  = nullptr;
+   unsigned                    *cq_tail  = nullptr;
+   unsigned                    *cq_mask  = nullptr;
+   struct io_uring_cqe         *cqes     = nullptr;
+   /** on the ring, not yet passed to the kernel **/
+   unsigned                     to_submit = 0;
+};
+
+#endif /** end RAFT_IOURING **/
+
+} /** end anonymous namespace **/
+
+std::unique_ptr< raft::async_io >
+raft::async_io::make( const std::size_t depth, const raft::aio::backend b )
+{
+   const std::size_t d( std::max( depth, static_cast< std::size_t >( 1 ) ) );
+#ifdef RAFT_IOURING
+   if( b != raft::aio::pool )
+   {
+      auto * const ring( uring_io::make( d ) );
+      if( ring != nullptr )
+      {
+         return( std::unique_ptr< raft::async_io >( ring ) );
+      }
+   }
+#else
+   (void) b;
+#endif
+   return( std::unique_ptr< raft::async_io >( new pool_io( d ) ) );
+}
+
+raft::async_io::async_io( const std::size_t depth ) : requests( depth ),
+                                                      slots( depth )
+{
+   free_slots.reserve( depth );
+   for( std::size_t i( depth ); i > 0; i-- )
+   {
+      free_slots.push_back( i - 1 );
+   }
+}
+
+raft::async_io::~async_io() = default;
+
+bool
+raft::async_io::read( const int           fd,
+                      void * const        buffer,
+                      const std::size_t   length,
+                      const off_t         offset,
+                      const std::uint64_t tag )
+{
+   return( (this)->queue( op_read, fd, reinterpret_cast< char* >( buffer ),
+                          length, offset, tag ) );
+}
+
+bool
+raft::async_io::write( const int           fd,
+                       const void * const  buffer,
+                       const std::size_t   length,
+                       const off_t         offset,
+                       const std::uint64_t tag )
+{
+   /** never written through, see pool_io::work and uring_io::start **/
+   return( (this)->queue( op_write, fd,
+                          const_cast< char* >( reinterpret_cast< const char* >( buffer ) ),
+                          length, offset, tag ) );
+}
+
+bool
+raft::async_io::queue( const op_t          op,
+                       const int           fd,
+                       char * const        buffer,
+                       const std::size_t   length,
+                       const off_t         offset,
+                       const std::uint64_t tag )
+{
+   if( free_slots.empty() )
+   {
+      return( false );
+   }
+   const auto slot( free_slots.back() );
+   free_slots.pop_back();
+   auto &r( requests[ slot ] );
+   r.op     = op;
+   r.fd     = fd;
+   r.buffer = buffer;
+   r.length = length;
+   r.offset = offset;
+   r.done   = 0;
+   r.tag    = tag;
+   queued.push_back( slot );
+   return( true );
+}
+
+void
+raft::async_io::submit()
+{
+   for( const auto slot : queued )
+   {
+      if( requests[ slot ].length == 0 )
+      {
+         /** nothing to move, no need to bother the backend **/
+         (this)->finish( slot, 0 );
+      }
+      else
+      {
+         (this)->start( slot );
+      }
+   }
+   queued.clear();
+   (this)->flush();
+}
+
+std::size_t
+raft::async_io::wait( std::vector< completion > &out,
+                      const std::size_t min )
+{
+   (this)->submit();
+   const auto want( std::min( min, (this)->in_flight() ) );
+   while( done.size() < want )
+   {
+      (this)->reap( true );
+   }
+   /** take whatever else is already back while we're here **/
+   (this)->reap( false );
+   const auto n( done.size() );
+   out.insert( out.end(), done.begin(), done.end() );
+   done.clear();
+   free_slots.insert( free_slots.end(), done_slots.begin(), done_slots.end() );
+   done_slots.clear();
+   return( n );
+}
+
+void
+raft::async_io::finish( const std::size_t slot, const std::int64_t result )
+{
+   auto &r( requests[ slot ] );
+   if( result == -EINTR || result == -EAGAIN )
+   {
+      (this)->start( slot );
+      return;
+   }
+   if( result > 0 )
+   {
+      r.done += static_cast< std::size_t >( result );
+      if( r.done < r.length )
+      {
+         /** short, carry on from where it stopped **/
+         (this)->start( slot );
+         return;
+      }
+   }
+   /** error, end of file or all of it **/
+   done.push_back( completion{ r.tag,
+                               result < 0 ? result :
+                                  static_cast< std::int64_t >( r.done ) } );
+   done_slots.push_back( slot );
+}
+
+void
+raft::async_io::drain()
+{
+   (this)->submit();
+   while( done.size() < (this)->in_flight() )
+   {
+      (this)->reap( true );
+   }
+   done.clear();
+   free_slots.insert( free_slots.end(), done_slots.begin(), done_slots.end() );
+   done_slots.clear();
+}
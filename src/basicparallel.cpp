@@ -1,9 +1,9 @@
 /**
  * basicparallel.cpp -
  * @author: Jonathan Beard
- * @version: Mon Aug 10 20:00:25 2015
+ * @version: Mon Oct 19 01:38:27 2026
  *
- * Copyright 2015 Jonathan Beard
+ * Copyright 2026 Jonathan Beard
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -17,14 +17,46 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <chrono>
+#include <set>
+#include <thread>
+
 #include "basicparallel.hpp"
 #include "map.hpp"
-#include "common.hpp"
-#include "streamingstat.tcc"
-#include <map>
+#include "parallelk.hpp"
+#include "kernelexception.hpp"
 #include "defs.hpp"
 
+constexpr float       basic_parallel::high_water;
+constexpr float       basic_parallel::low_water;
+constexpr std::size_t basic_parallel::window_ms;
+constexpr std::size_t basic_parallel::up_confirm;
+constexpr std::size_t basic_parallel::down_confirm;
+constexpr std::size_t basic_parallel::cooldown;
 
+namespace
+{
+
+/** same as MapBase::join, for ports added while running **/
+void
+connect( raft::kernel * const a, PortInfo &a_info,
+         raft::kernel * const b, PortInfo &b_info )
+{
+   a_info.other_kernel = b;
+   a_info.other_name   = b_info.my_name;
+   b_info.other_kernel = a;
+   b_info.other_name   = a_info.my_name;
+}
+
+bool
+is_parallel( raft::kernel * const k )
+{
+   return( k != nullptr &&
+           dynamic_cast< raft::parallel_k* >( k ) != nullptr );
+}
+
+} /** end anonymous namespace **/
 
 basic_parallel::basic_parallel( raft::map &map,
                                 Allocate &alloc,
@@ -34,7 +66,8 @@ basic_parallel::basic_parallel( raft::map &map,
      all_kernels(    map.all_kernels ),
      alloc( alloc ),
      sched( sched ),
-     exit_para( exit_para )
+     exit_para( exit_para ),
+     max_replicas( map.max_replicas )
 {
    /** nothing to do here, move along **/
 }
@@ -43,130 +76,277 @@ basic_parallel::basic_parallel( raft::map &map,
 void
 basic_parallel::start()
 {
-   using hash_t = std::uintptr_t;
-   //FIXME, need to add the code that'll limit this without a count
+   if( max_replicas < 2 )
+   {
+      return;
+   }
+   std::vector< raft::kernel* > dup_list;
+   auto &kernels( all_kernels.acquire() );
+   for( auto * const k : kernels )
+   {
+      if( k->dup_enabled )
+      {
+         dup_list.emplace_back( k );
+      }
+   }
+   all_kernels.release();
+   std::sort( dup_list.begin(), dup_list.end(),
+              []( raft::kernel * const a, raft::kernel * const b )
+              {
+                 return( a->get_id() < b->get_id() );
+              } );
+   for( auto * const k : dup_list )
+   {
+      add_group( k );
+   }
+   if( groups.empty() )
+   {
+      return;
+   }
+   /** by the clock, sleeps run long on a busy machine **/
+   using clock = std::chrono::steady_clock;
+   const std::chrono::milliseconds window( window_ms );
+   auto window_start( clock::now() );
    while( ! exit_para )
    {
-      kernelkeeper::value_type &kernels( source_kernels.acquire() );
-      /**
-       * since we have to have a lock on the ports
-       * for both BFS and duplication, we'll mark
-       * the kernels inside of BFS and duplicate
-       * outside of it.
-       */
-      std::vector< raft::kernel* > dup_list;
-      GraphTools::BFS(  kernels,
-                        (vertex_func) [&dup_list]( raft::kernel *kernel,
-                                           void *data )
-                        {
-                           static std::map< hash_t, stats > hashmap;
-                           static uint64_t count( 0 );
+      for( auto &g : groups )
+      {
+         sample( g );
+      }
+      const auto now( clock::now() );
+      if( now - window_start >= window )
+      {
+         window_start = now;
+         for( auto &g : groups )
+         {
+            decide( g );
+         }
+      }
+      std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+   }
+   return;
+}
 
-                           UNUSED( data );
+bool
+basic_parallel::add_group( raft::kernel * const k )
+{
+   group   g;
+   replica r;
+   r.k = k;
+   for( auto &pair : k->input.portmap.map )
+   {
+      auto &info( pair.second );
+      if( ! is_parallel( info.other_kernel ) || info.getFIFO() == nullptr )
+      {
+         return( false );
+      }
+      g.splits.emplace_back( info.other_kernel );
+      r.feeds.push_back( { info.other_kernel, info.other_name } );
+      r.in.emplace_back( info.getFIFO() );
+   }
+   for( auto &pair : k->output.portmap.map )
+   {
+      auto &info( pair.second );
+      if( ! is_parallel( info.other_kernel ) || info.getFIFO() == nullptr )
+      {
+         return( false );
+      }
+      g.joins.emplace_back( info.other_kernel );
+      r.out.emplace_back( info.getFIFO() );
+   }
+   /** a copy of a source would be a second stream, not more capacity **/
+   if( r.in.empty() )
+   {
+      return( false );
+   }
+   g.replicas.emplace_back( std::move( r ) );
+   groups.emplace_back( std::move( g ) );
+   return( true );
+}
 
-                           if( kernel->dup_enabled )
-                           {
-                              /** start checking stats **/
-                              auto hash(
-                                 reinterpret_cast< std::uintptr_t >( kernel ) );
-                              /** input  stats **/
-                              raft::streamingstat< float > in;
-                              raft::streamingstat< float > out;
-                              if( kernel->input.hasPorts() )
-                              {
-                                 auto &input( kernel->input.getPortInfo() );
-                                 auto *fifo( input.getFIFO() );
-                                 in.update( static_cast< float >( fifo->size() )/ 
-                                                static_cast< float >( fifo->capacity() ) );
-                              }
-                              if( kernel->output.hasPorts() )
-                              {
-                                 auto &output( kernel->output.getPortInfo() );
-                                 auto *fifo( output.getFIFO() );
-                                 out.update( static_cast< float >( fifo->size() )/ 
-                                                  static_cast< float >( fifo->capacity() ) );
-                              }
-                              /** apply criteria **/
-                              if( ( kernel->input.count() == 0 ||
-                                    in.mean< float >() > .5  ) &&
-                                  ( out.mean< float >() < .5   ||
-                                    kernel->output.count() == 0 ) )
-                              {
-                                 hashmap[ hash ].occ_in++;
-                              }
-                              if( hashmap[ hash ].occ_in > 3 && count < 2 )
-                              {
-                                 count++;
-                                 dup_list.emplace_back( kernel );
-                                 hashmap[ hash ].occ_in = 0;
-                              }
-                           }
-                        },
-                        nullptr );
-      source_kernels.release();
+void
+basic_parallel::sample( group &g )
+{
+   float       in( 0 ), out( 0 );
+   std::size_t n_in( 0 ), n_out( 0 );
+   for( const auto &r : g.replicas )
+   {
+      for( auto * const fifo : r.in )
+      {
+         in += static_cast< float >( fifo->size() ) /
+               static_cast< float >( fifo->capacity() );
+         n_in++;
+      }
+      for( auto * const fifo : r.out )
+      {
+         out += static_cast< float >( fifo->size() ) /
+                static_cast< float >( fifo->capacity() );
+         n_out++;
+      }
+   }
+   g.in_occ.update( in / static_cast< float >( n_in ) );
+   if( n_out > 0 )
+   {
+      g.out_occ.update( out / static_cast< float >( n_out ) );
+   }
+   return;
+}
 
-      for( auto * kernel : dup_list )
+void
+basic_parallel::decide( group &g )
+{
+   const auto in( g.in_occ.mean< float >() );
+   const auto out( g.joins.empty() ? 0.0f : g.out_occ.mean< float >() );
+   g.in_occ.reset();
+   g.out_occ.reset();
+   if( g.frozen > 0 )
+   {
+      g.frozen--;
+      g.up_strikes   = 0;
+      g.down_strikes = 0;
+      return;
+   }
+   /** backed up on the way in, and it isn't the next kernel's fault **/
+   if( in > high_water && out < high_water &&
+       g.clonable && g.replicas.size() < max_replicas )
+   {
+      g.down_strikes = 0;
+      if( ++g.up_strikes >= up_confirm )
       {
-         /**
-          * FIXME, logic below only works for
-          * single input, single output..intended
-          * to get it working
-          */
-         /** clone **/
-         auto *ptr( kernel->clone() );
-         /** attach ports **/
-         if( kernel->input.count() != 0 )
+         g.up_strikes = 0;
+         if( replicate( g ) )
          {
-            auto &old_port_in( kernel->input.getPortInfo() );
-            old_port_in.other_kernel->lock();
-            const auto portid(
-               old_port_in.other_kernel->addPort() );
-            auto &new_other_outport(
-               old_port_in.other_kernel->output.getPortInfoFor(
-                  std::to_string( portid )
-               )
-            );
-            auto &new_port_in( ptr->input.getPortInfo() );
-            /**
-             * connecting a.y -> b.x
-             * new_other_outprt == port y on a
-             * new_port_in      == port x on b
-             */
-            alloc.allocate( new_other_outport,
-                            new_port_in,
-                            nullptr );
-            old_port_in.other_kernel->unlock();
+            g.frozen = cooldown;
          }
-         if( kernel->output.count() != 0 )
+      }
+   }
+   else if( in < low_water && g.replicas.size() > 1 )
+   {
+      g.up_strikes = 0;
+      if( ++g.down_strikes >= down_confirm )
+      {
+         g.down_strikes = 0;
+         if( retire( g ) )
          {
-            auto &old_port_out( kernel->output.getPortInfo() );
-            old_port_out.other_kernel->lock();
-            const auto portid(
-               old_port_out.other_kernel->addPort() );
-            auto &new_other_inport(
-               old_port_out.other_kernel->input.getPortInfoFor(
-                  std::to_string( portid ) ) );
-
-            auto &newoutport( ptr->output.getPortInfo() );
-            /**
-             * connecting b.y -> c.x
-             * newoutport       == port y on b
-             * new_other_inport == port x on c
-             */
-            alloc.allocate( newoutport,
-                            new_other_inport,
-                            nullptr );
-
-            old_port_out.other_kernel->unlock();
+            g.frozen = cooldown;
          }
-         /** schedule new kernel **/
-         sched.scheduleKernel( ptr );
       }
+   }
+   else
+   {
+      g.up_strikes   = 0;
+      g.down_strikes = 0;
+   }
+   return;
+}
 
+bool
+basic_parallel::replicate( group &g )
+{
+   auto &original( g.replicas.front() );
+   raft::kernel *ptr( nullptr );
+   try
+   {
+      ptr = original.k->clone();
+   }
+   catch( CloneNotImplementedException &ex )
+   {
+      UNUSED( ex );
+      g.clonable = false;
+      return( false );
+   }
+   if( ptr->input.count()  != g.splits.size() ||
+       ptr->output.count() != g.joins.size() )
+   {
+      /** copy constructor didn't add the same ports **/
+      delete( ptr );
+      g.clonable = false;
+      return( false );
+   }
+   /**
+    * with every split and join locked nothing gets closed while
+    * we look, if the stream hasn't ended yet the new ports will
+    * be closed along with the rest when it does.
+    */
+   const std::set< raft::kernel* > parallel_kernels( [&]()
+   {
+      std::set< raft::kernel* > s( g.splits.begin(), g.splits.end() );
+      s.insert( g.joins.begin(), g.joins.end() );
+      return( s );
+   }() );
+   for( auto * const k : parallel_kernels )
+   {
+      k->lock();
+   }
+   bool open( true );
+   for( auto * const split : g.splits )
+   {
+      open &= ! split->input.getPortInfoFor( "0" ).getFIFO()->is_invalid();
+   }
+   for( auto * const fifo : original.out )
+   {
+      open &= ! fifo->is_invalid();
+   }
+   replica r;
+   r.k = ptr;
+   if( open )
+   {
+      auto split( g.splits.begin() );
+      for( auto &pair : ptr->input.portmap.map )
+      {
+         auto &info( pair.second );
+         const auto name( std::to_string( (*split)->addPort() ) );
+         auto &split_info( (*split)->output.getPortInfoFor( name ) );
+         connect( *split, split_info, ptr, info );
+         alloc.allocate( split_info, info, nullptr );
+         r.feeds.push_back( { *split, name } );
+         r.in.emplace_back( info.getFIFO() );
+         ++split;
+      }
+      auto join( g.joins.begin() );
+      for( auto &pair : ptr->output.portmap.map )
+      {
+         auto &info( pair.second );
+         const auto name( std::to_string( (*join)->addPort() ) );
+         auto &join_info( (*join)->input.getPortInfoFor( name ) );
+         connect( ptr, info, *join, join_info );
+         alloc.allocate( info, join_info, nullptr );
+         r.out.emplace_back( info.getFIFO() );
+         ++join;
+      }
+   }
+   for( auto * const k : parallel_kernels )
+   {
+      k->unlock();
+   }
+   if( ! open )
+   {
+      delete( ptr );
+      return( false );
+   }
+   g.replicas.emplace_back( std::move( r ) );
+   sched.scheduleKernel( ptr );
+   return( true );
+}
 
-      dup_list.clear();
-      std::chrono::microseconds dura( 100 );
-      std::this_thread::sleep_for( dura );
+bool
+basic_parallel::retire( group &g )
+{
+   if( g.replicas.size() < 2 )
+   {
+      return( false );
    }
-   return;
+   /**
+    * the splits skip closed ports, the copy drains its input,
+    * exits and closes its outputs, which the joins then skip.
+    * The ports themselves stay till the map is done.
+    */
+   for( const auto &feed : g.replicas.back().feeds )
+   {
+      feed.k->lock();
+      feed.k->output.getPortInfoFor( feed.name ).getFIFO()->invalidate();
+      feed.k->unlock();
+   }
+   g.replicas.pop_back();
+   return( true );
 }
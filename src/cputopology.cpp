@@ -0,0 +1,210 @@
+/**
+ * cputopology.cpp -
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 00:21:09 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef __linux
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE 1
+#endif
+#include <sched.h>
+#include <dirent.h>
+#endif
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <thread>
+#include <tuple>
+#include <utility>
+
+#include "cputopology.hpp"
+
+namespace
+{
+
+/** first line of a sysfs file, empty if it can't be read **/
+std::string
+read_line( const std::string &path )
+{
+   std::ifstream in( path );
+   std::string line;
+   if( in.is_open() )
+   {
+      std::getline( in, line );
+   }
+   return( line );
+}
+
+/** sysfs_cpu - what sysfs has to say about one CPU **/
+struct sysfs_cpu
+{
+   core_id_t   id;
+   std::string llc;
+   std::size_t node;
+   std::string core;
+};
+
+sysfs_cpu
+read_cpu( const std::string &root, const core_id_t id )
+{
+   const auto dir( root + "/cpu" + std::to_string( id ) );
+   /** on its own unless sysfs says otherwise **/
+   sysfs_cpu c{ id, "cpu" + std::to_string( id ), 0, "cpu" + std::to_string( id ) };
+   int llc_level( 0 );
+   for( int index( 0 ); ; index++ )
+   {
+      const auto cache( dir + "/cache/index" + std::to_string( index ) );
+      const auto level( read_line( cache + "/level" ) );
+      if( level.empty() )
+      {
+         break;
+      }
+      if( read_line( cache + "/type" ) == "Instruction" )
+      {
+         continue;
+      }
+      const auto shared( read_line( cache + "/shared_cpu_list" ) );
+      const auto l( std::atoi( level.c_str() ) );
+      if( l > llc_level && ! shared.empty() )
+      {
+         llc_level = l;
+         c.llc     = "llc" + std::to_string( l ) + ":" + shared;
+      }
+   }
+   const auto package( read_line( dir + "/topology/physical_package_id" ) );
+   const auto core( read_line( dir + "/topology/core_id" ) );
+   if( ! package.empty() && ! core.empty() )
+   {
+      c.core = package + ":" + core;
+   }
+#ifdef __linux
+   /** the node shows up as a nodeN link in the cpu's directory **/
+   if( auto * const d = opendir( dir.c_str() ) )
+   {
+      while( auto * const entry = readdir( d ) )
+      {
+         const std::string name( entry->d_name );
+         if( name.size() > 4 && name.compare( 0, 4, "node" ) == 0 &&
+             name.find_first_not_of( "0123456789", 4 ) == std::string::npos )
+         {
+            c.node = std::strtoul( name.c_str() + 4, nullptr, 10 );
+            break;
+         }
+      }
+      closedir( d );
+   }
+#endif
+   return( c );
+}
+
+} /** end anonymous namespace **/
+
+cpu_topology::cpu_topology( const std::string &root,
+                            const std::vector< core_id_t > &allowed )
+{
+   auto ids( allowed.empty() ? allowed_cpus() : allowed );
+   std::sort( ids.begin(), ids.end() );
+   ids.erase( std::unique( ids.begin(), ids.end() ), ids.end() );
+   std::vector< sysfs_cpu > raw;
+   for( const auto id : ids )
+   {
+      raw.emplace_back( read_cpu( root, id ) );
+   }
+   /** dense indices, in order of the lowest CPU in each **/
+   std::map< std::string, std::size_t > llc_index, core_index;
+   for( const auto &r : raw )
+   {
+      llc_index.insert( std::make_pair( r.llc, llc_index.size() ) );
+      core_index.insert( std::make_pair( r.core, core_index.size() ) );
+   }
+   /** how many threads of each core come before this one **/
+   std::map< std::size_t, std::size_t > seen;
+   std::vector< std::tuple< std::size_t, std::size_t, std::size_t, cpu > > order;
+   for( const auto &r : raw )
+   {
+      cpu c;
+      c.id   = r.id;
+      c.llc  = llc_index[ r.llc ];
+      c.node = r.node;
+      c.core = core_index[ r.core ];
+      const auto thread( seen[ c.core ]++ );
+      order.emplace_back( std::make_tuple( c.node, c.llc, thread, c ) );
+   }
+   std::stable_sort( order.begin(), order.end(),
+                     []( const decltype( order )::value_type &a,
+                         const decltype( order )::value_type &b )
+                     {
+                        return( std::make_tuple( std::get< 0 >( a ),
+                                                 std::get< 1 >( a ),
+                                                 std::get< 2 >( a ) ) <
+                                std::make_tuple( std::get< 0 >( b ),
+                                                 std::get< 1 >( b ),
+                                                 std::get< 2 >( b ) ) );
+                     } );
+   for( const auto &o : order )
+   {
+      cpu_list.emplace_back( std::get< 3 >( o ) );
+   }
+   n_llc = llc_index.size();
+}
+
+std::vector< core_id_t >
+cpu_topology::allowed_cpus()
+{
+   std::vector< core_id_t > out;
+#ifdef __linux
+   /** the mask may be wider than the default cpu_set_t **/
+   for( int n( 1024 ); n <= ( 1 << 20 ); n <<= 1 )
+   {
+      auto * const set( CPU_ALLOC( n ) );
+      if( set == nullptr )
+      {
+         break;
+      }
+      const auto size( CPU_ALLOC_SIZE( n ) );
+      CPU_ZERO_S( size, set );
+      if( sched_getaffinity( 0, size, set ) == 0 )
+      {
+         for( int i( 0 ); i < n; i++ )
+         {
+            if( CPU_ISSET_S( i, size, set ) )
+            {
+               out.emplace_back( i );
+            }
+         }
+         CPU_FREE( set );
+         break;
+      }
+      CPU_FREE( set );
+      if( errno != EINVAL )
+      {
+         break;
+      }
+   }
+#endif
+   if( out.empty() )
+   {
+      const auto n( std::thread::hardware_concurrency() );
+      for( unsigned i( 0 ); i < ( n == 0 ? 1 : n ); i++ )
+      {
+         out.emplace_back( i );
+      }
+   }
+   return( out );
+}
@@ -17,11 +17,6 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
-#include <chrono>
-#include <thread>
-#include <iostream>
-#include <iomanip>
-#include <map>
 #include <cassert>
 
 #include "graphtools.hpp"
@@ -34,7 +29,8 @@
 
 dynalloc::dynalloc( raft::map &map,
                     volatile bool &exit_alloc ) :
-                        Allocate( map, exit_alloc )
+                        Allocate( map, exit_alloc ),
+                        policy( map_max_bytes, INITIAL_ALLOC_SIZE )
 {
 }
 
@@ -43,21 +39,27 @@ dynalloc::~dynalloc()
 {
 }
 
-std::size_t
-dynalloc::hash( PortInfo &a, PortInfo &b )
+void
+dynalloc::allocate( PortInfo &a, PortInfo &b, void *data )
 {
-   union{
-      std::size_t      all;
-      struct a_and_b{
-         std::uint32_t a;
-         std::uint32_t b;
-      } ab;
-   } u;
-   const auto ta( (std::uint64_t)(& a ) );
-   const auto tb( (std::uint64_t)(& b ) );
-   u.ab.a = ta & 0xffff;
-   u.ab.b = tb & 0xffff;
-   return( u.all );
+   Allocate::allocate( a, b, data );
+   /** user fixed the size of this one or gave us the buffer, leave it alone **/
+   if( a.fixed_buffer_size != 0 ||
+       a.existing_buffer != nullptr ||
+       a.item_size == 0 )
+   {
+      return;
+   }
+   /** both ends may cap the edge, smaller one wins **/
+   auto max_bytes( a.max_bytes );
+   if( b.max_bytes != 0 && ( max_bytes == 0 || b.max_bytes < max_bytes ) )
+   {
+      max_bytes = b.max_bytes;
+   }
+   auto * const fifo( a.getFIFO() );
+   Allocate::setResizeSignal( fifo,
+                              policy.add_edge( fifo, a.item_size, max_bytes ) );
+   return;
 }
 
 
@@ -66,7 +68,6 @@ dynalloc::run()
 {
    auto alloc_func = [&]( PortInfo &a, PortInfo &b, void *data )
    {
-      /** same alloc for all, inherit from base alloc **/
       (this)->allocate( a, b, data );
    };
 
@@ -74,47 +75,12 @@ dynalloc::run()
    auto &container( (this)->source_kernels.acquire() );
    GraphTools::BFS( container, alloc_func );
    (this)->source_kernels.release();
+   (this)->allocate_shm();
    (this)->setReady();
-   std::map< std::size_t, int > size_map;
-
    /**
-    * make this a fixed quantity right now, if size > .75% at
-    * montor interval three times or more then increase size.
+    * producers post to the policy when they block, so there's
+    * no need to walk the graph, returns once exit_alloc is set.
     */
-
-   auto mon_func = [&]( PortInfo &a, PortInfo &b, void *data ) -> void
-   {
-      (void) data;
-
-      const auto hash_val( dynalloc::hash( a, b ) );
-      /** TODO, the values might wrap if no monitoring on **/
-      const auto realized_ratio( a.getFIFO()->get_frac_write_blocked() );
-      const auto ratio( 0.8 );
-      if( realized_ratio >= ratio )
-      {
-         const auto curr_count( size_map[ hash_val ]++ );
-         if( curr_count  > 2 )
-         {
-            /** get initializer function **/
-            auto * const buff_ptr( a.getFIFO() );
-            const auto cap( buff_ptr->capacity() );
-            buff_ptr->resize( cap * 2, ALLOC_ALIGN_WIDTH, exit_alloc );
-            size_map[ hash_val ] = 0;
-         }
-      }
-      return;
-   };
-   /** start monitor loop **/
-   while( ! exit_alloc )
-   {
-      /** monitor fifo's **/
-      std::chrono::microseconds dura( 3000 );
-      std::this_thread::sleep_for( dura );
-
-      auto &container( (this)->source_kernels.acquire() );
-      GraphTools::BFS( container, mon_func );
-      (this)->source_kernels.release();
-
-   }
+   policy.run( exit_alloc );
    return;
 }
@@ -17,6 +17,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <thread>
 #include "fifo.hpp"
 
 
@@ -36,6 +37,12 @@ FIFO::get_zero_write_stats( Blocked &copy )
    return;
 }
 
+std::uint64_t
+FIFO::get_items_written()
+{
+   return( 0 );
+}
+
 void
 FIFO::setPtrMap( ptr_map_t * const in )
 {
@@ -63,3 +70,55 @@ FIFO::setOutPeekSet( ptr_set_t * const peekset )
     UNUSED( peekset );
     return;
 }
+
+void
+FIFO::set_wait_strategy( const raft::wait::strategy strategy )
+{
+    UNUSED( strategy );
+    return;
+}
+
+void
+FIFO::idle_wait( const std::size_t spins )
+{
+    UNUSED( spins );
+    std::this_thread::yield();
+    return;
+}
+
+void
+FIFO::set_ready_bits( const ReadyBit &data,
+                      const ReadyBit &space,
+                      const ReadyBit &closed )
+{
+    UNUSED( data );
+    UNUSED( space );
+    UNUSED( closed );
+    return;
+}
+
+void
+FIFO::set_resize_signal( const ResizeSignal &signal )
+{
+    UNUSED( signal );
+    return;
+}
+
+void
+FIFO::set_memory_options( const raft::mem::options &mem )
+{
+    UNUSED( mem );
+    return;
+}
+
+void
+FIFO::set_fused()
+{
+    return;
+}
+
+void
+FIFO::reclaim()
+{
+    return;
+}
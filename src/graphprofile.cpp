@@ -0,0 +1,321 @@
+/**
+ * graphprofile.cpp -
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 23:58:36 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <typeinfo>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include "graphprofile.hpp"
+#include "kernel.hpp"
+#include "port_info.hpp"
+
+using namespace raft;
+
+namespace
+{
+
+/** bump if the file layout changes, older files are ignored **/
+constexpr int          profile_version( 1 );
+/** a new run counts for at least 1/history of the blended value **/
+constexpr std::uint64_t history( 4 );
+
+/** FNV-1a, only has to be stable from one run to the next **/
+std::uint64_t
+hash_string( const std::string &s )
+{
+   std::uint64_t h( 0xcbf29ce484222325ULL );
+   for( const auto c : s )
+   {
+      h ^= static_cast< unsigned char >( c );
+      h *= 0x100000001b3ULL;
+   }
+   return( h );
+}
+
+double
+blend( const double old_val,
+       const double new_val,
+       const std::uint64_t runs )
+{
+   if( new_val < 0 )
+   {
+      return( old_val );
+   }
+   if( old_val < 0 || runs == 0 )
+   {
+      return( new_val );
+   }
+   const double w( 1.0 / static_cast< double >( std::min( runs + 1, history ) ) );
+   return( old_val * ( 1.0 - w ) + new_val * w );
+}
+
+} /** end anonymous namespace **/
+
+graph_profile::graph_profile( kernelkeeper &all, const std::string &dir ) :
+   dir( dir )
+{
+   {
+      auto &c( all.acquire() );
+      for( auto * const k : c )
+      {
+         vertices.emplace_back( k );
+      }
+      all.release();
+   }
+   std::sort( vertices.begin(), vertices.end(),
+              []( const vertex &a, const vertex &b )
+              {
+                 return( a.k->get_id() < b.k->get_id() );
+              } );
+   for( std::size_t i( 0 ); i < vertices.size(); i++ )
+   {
+      vertex_index.insert( std::make_pair( vertices[ i ].k, i ) );
+   }
+   std::stringstream shape;
+   for( auto &v : vertices )
+   {
+      shape << typeid( *v.k ).name() << "\n";
+      for( auto &pair : v.k->output.portmap.map )
+      {
+         auto &info( pair.second );
+         const auto dst( vertex_index.find( info.other_kernel ) );
+         if( dst == vertex_index.end() )
+         {
+            continue;
+         }
+         edge_index.insert( std::make_pair( &info, edges.size() ) );
+         edges.emplace_back( &info );
+         shape << " " << info.my_name << " " << info.type.name() <<
+            " " << (*dst).second << " " << info.other_name << "\n";
+      }
+   }
+   graph_key = hash_string( shape.str() );
+   if( ! read() )
+   {
+      runs = 0;
+      for( auto &v : vertices )
+      {
+         v.load = -1.0;
+      }
+      for( auto &e : edges )
+      {
+         e.rate = -1.0;
+      }
+   }
+}
+
+graph_profile::~graph_profile()
+{
+   /** in case stop() was never reached **/
+   for( auto &v : vertices )
+   {
+      v.k->sample = nullptr;
+   }
+}
+
+std::string
+graph_profile::path() const
+{
+   std::stringstream ss;
+   ss << dir << "/" << std::hex << std::setw( 16 ) << std::setfill( '0' ) <<
+      graph_key << ".rprof";
+   return( ss.str() );
+}
+
+double
+graph_profile::kernel_load( const raft::kernel * const k ) const
+{
+   const auto found( vertex_index.find( k ) );
+   if( found == vertex_index.end() )
+   {
+      return( -1.0 );
+   }
+   return( vertices[ (*found).second ].load );
+}
+
+double
+graph_profile::edge_rate( const PortInfo &src ) const
+{
+   const auto found( edge_index.find( &src ) );
+   if( found == edge_index.end() )
+   {
+      return( -1.0 );
+   }
+   return( edges[ (*found).second ].rate );
+}
+
+double
+graph_profile::max_edge_rate() const noexcept
+{
+   double max( 0.0 );
+   for( const auto &e : edges )
+   {
+      max = std::max( max, e.rate );
+   }
+   return( max );
+}
+
+void
+graph_profile::start()
+{
+   for( auto &v : vertices )
+   {
+      v.sample    = run_sample();
+      v.k->sample = &v.sample;
+   }
+   started = std::chrono::steady_clock::now();
+}
+
+void
+graph_profile::stop()
+{
+   const auto wall( std::chrono::duration_cast< std::chrono::nanoseconds >(
+      std::chrono::steady_clock::now() - started ).count() );
+   for( auto &v : vertices )
+   {
+      v.k->sample = nullptr;
+   }
+   if( wall <= 0 )
+   {
+      return;
+   }
+   const auto wall_ns( static_cast< double >( wall ) );
+   for( auto &v : vertices )
+   {
+      const auto load( std::min( 1.0,
+         static_cast< double >( v.sample.busy_ns ) / wall_ns ) );
+      v.load = blend( v.load, load, runs );
+   }
+   for( auto &e : edges )
+   {
+      auto * const fifo( e.info->getFIFO() );
+      if( fifo == nullptr )
+      {
+         continue;
+      }
+      const auto bytes( static_cast< double >( fifo->get_items_written() ) *
+                        static_cast< double >( e.info->item_size ) );
+      e.rate = blend( e.rate, bytes / wall_ns * 1.0e9, runs );
+   }
+   runs++;
+   write();
+}
+
+bool
+graph_profile::read()
+{
+   std::ifstream in( path() );
+   if( ! in.is_open() )
+   {
+      return( false );
+   }
+   std::string   tag;
+   int           version( 0 );
+   std::uint64_t key( 0 );
+   std::size_t   n_vertices( 0 ), n_edges( 0 );
+   in >> tag >> version;
+   if( tag != "version" || version != profile_version )
+   {
+      return( false );
+   }
+   in >> tag >> std::hex >> key >> std::dec;
+   if( tag != "key" || key != graph_key )
+   {
+      return( false );
+   }
+   in >> tag >> runs;
+   if( tag != "runs" )
+   {
+      return( false );
+   }
+   in >> tag >> n_vertices >> n_edges;
+   if( ! in || tag != "size" ||
+       n_vertices != vertices.size() || n_edges != edges.size() )
+   {
+      return( false );
+   }
+   for( auto &v : vertices )
+   {
+      in >> tag >> v.load;
+      if( tag != "kernel" )
+      {
+         return( false );
+      }
+   }
+   for( auto &e : edges )
+   {
+      in >> tag >> e.rate;
+      if( tag != "edge" )
+      {
+         return( false );
+      }
+   }
+   return( static_cast< bool >( in ) );
+}
+
+void
+graph_profile::write() const
+{
+   if( mkdir( dir.c_str(), 0755 ) != 0 && errno != EEXIST )
+   {
+      std::cerr << "Couldn't create profile directory \"" << dir << "\": " <<
+         std::strerror( errno ) << "\n";
+      return;
+   }
+   /** other processes may be reading it, so swap the whole file in **/
+   const auto final_path( path() );
+   const auto temp_path( final_path + "." + std::to_string( getpid() ) );
+   {
+      std::ofstream out( temp_path, std::ios::trunc );
+      if( ! out.is_open() )
+      {
+         std::cerr << "Couldn't write profile \"" << temp_path << "\"\n";
+         return;
+      }
+      out << "version " << profile_version << "\n";
+      out << "key " << std::hex << graph_key << std::dec << "\n";
+      out << "runs " << runs << "\n";
+      out << "size " << vertices.size() << " " << edges.size() << "\n";
+      out << std::setprecision( 17 );
+      for( const auto &v : vertices )
+      {
+         out << "kernel " << v.load << "\n";
+      }
+      for( const auto &e : edges )
+      {
+         out << "edge " << e.rate << "\n";
+      }
+   }
+   if( std::rename( temp_path.c_str(), final_path.c_str() ) != 0 )
+   {
+      std::cerr << "Couldn't replace profile \"" << final_path << "\": " <<
+         std::strerror( errno ) << "\n";
+      std::remove( temp_path.c_str() );
+   }
+}
@@ -122,6 +122,11 @@ GraphTools::__BFS( std::queue< raft::kernel* > &queue,
                source.other_kernel->input.getPortInfoFor( source.other_name ) );
             func( source, dst, data );
          }
+         else if( source.mem == SHM )
+         {
+            /** other end is in another process, see link_shm **/
+            continue;
+         }
          else
          if( connected_error )
          {
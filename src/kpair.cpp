@@ -268,6 +268,21 @@ operator <= ( raft::kernel_wrapper &&w, kpair &b )
     return( *ptr );
 }
 
+/** a copy of a per input port of b, see map::inline_dup_join **/
+kpair&
+operator >= ( raft::kernel &a, raft::kernel &b )
+{
+    auto *ptr( new kpair( a, b, false, true ) );
+    return( *ptr );
+}
+
+kpair&
+operator >= ( raft::kernel_wrapper &&a, raft::kernel_wrapper &&b )
+{
+    auto *ptr( new kpair( a, b, false, true ) );
+    return( *ptr );
+}
+
 kpair&
 operator >= ( kpair &a, raft::kernel_wrapper &&w )
 {
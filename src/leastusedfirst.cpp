@@ -1,10 +1,10 @@
 /**
- * leastusedfirst.cpp - 
+ * leastusedfirst.cpp -
  * @author: Jonathan Beard
- * @version: Tue Oct 28 13:10:21 2014
- * 
- * Copyright 2014 Jonathan Beard
- * 
+ * @version: Mon Oct 19 02:06:44 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
  * You may obtain a copy of the License at:
@@ -18,3 +18,43 @@
  * limitations under the License.
  */
 #include "leastusedfirst.hpp"
+
+leastusedfirst::leastusedfirst() : splitmethod()
+{
+}
+
+leastusedfirst::~leastusedfirst()
+{
+}
+
+FIFO*
+leastusedfirst::select_fifo( Port &port_list, const functype type )
+{
+   auto &list( fifos( port_list ) );
+   const auto n( list.size() );
+   FIFO        *best( nullptr );
+   float        best_occ( 0 );
+   std::size_t  best_index( 0 );
+   for( std::size_t i( 0 ); i < n; i++ )
+   {
+      const auto index( ( next + i ) % n );
+      auto * const fifo( list[ index ] );
+      if( ! ready( *fifo, type ) )
+      {
+         continue;
+      }
+      const auto occ( occupancy( *fifo ) );
+      if( best == nullptr ||
+          ( type == sendtype ? occ < best_occ : occ > best_occ ) )
+      {
+         best       = fifo;
+         best_occ   = occ;
+         best_index = index;
+      }
+   }
+   if( best != nullptr )
+   {
+      next = best_index + 1;
+   }
+   return( best );
+}
@@ -19,6 +19,7 @@
  */
 #include <sstream>
 #include <map>
+#include <set>
 #include <sstream>
 #include <vector>
 #include <typeinfo>
@@ -35,12 +36,52 @@
 #include "graphtools.hpp"
 #include "kpair.hpp"
 #include "mapexception.hpp"
+#include "parallelk.hpp"
+
+constexpr std::size_t raft::map::fused_capacity;
 
 raft::map::map() : MapBase()
 {
 
 }
 
+void
+raft::map::setWaitStrategy( const raft::wait::strategy strategy )
+{
+   wait_strategy = ( strategy == raft::wait::use_default ?
+                     raft::wait::adaptive : strategy );
+}
+
+void
+raft::map::setMemoryCap( const std::size_t bytes )
+{
+   max_bytes = bytes;
+}
+
+void
+raft::map::setProfileDir( const std::string &dir )
+{
+   profile_dir = dir;
+}
+
+void
+raft::map::setRepinWindow( const std::chrono::milliseconds period )
+{
+   repin_window = period;
+}
+
+void
+raft::map::setMaxReplicas( const std::size_t n )
+{
+   max_replicas = n;
+}
+
+void
+raft::map::setFusion( const bool enable )
+{
+   fusion = enable;
+}
+
 void
 raft::map::checkEdges( kernelkeeper &source_k )
 {
@@ -75,104 +116,131 @@ raft::map::checkEdges( kernelkeeper &source_k )
 void
 raft::map::enableDuplication( kernelkeeper &source, kernelkeeper &all )
 {
-    auto &source_k( source.acquire() );
-    auto &all_k   ( all.acquire()    );
-    /** don't have to do this but it makes it far more apparent where it comes from **/
-    void * const kernel_ptr( reinterpret_cast< void* >( &all_k ) );
-    using kernel_ptr_t = std::remove_reference< decltype( all_k ) >::type;
-    /** need to grab impl of Lengauer and Tarjan dominators, use for SESE **/
-    /** in the interim, restrict to kernels that are simple to duplicate **/
-    /** NOTE: there's a better linear SESE algorithm jcb17May16 **/
-    GraphTools::BFS( source_k,
-                     []( PortInfo &a, PortInfo &b, void *data )
-                     {
-                        auto * const all_k( reinterpret_cast< kernel_ptr_t* >( data ) );
-                        if( a.out_of_order && b.out_of_order )
-                        {
-                           /** case of inline kernel **/
-                           if( b.my_kernel->input.count() == 1 &&
-                               b.my_kernel->output.count() == 1 &&
-                               a.my_kernel->dup_candidate  )
-                           {
-                              auto *kernel_a( a.my_kernel );
-                              assert( kernel_a->input.count() == 1 );
-                              auto &port_info_front( kernel_a->input.getPortInfo() );
-                              auto *front( port_info_front.other_kernel );
-                              auto &front_port_info( front->output.getPortInfo() );
-                              /**
-                               * front -> kernel_a goes to
-                               * front -> split -> kernel_a
-                               */
-                              auto *split(
-                                 static_cast< raft::kernel* >(
-                                    port_info_front.split_func() ) );
-                              all_k->insert( split );
-                              MapBase::insert( front,    front_port_info,
-                                               kernel_a, port_info_front,
-                                               split );
-
-                              assert( kernel_a->output.count() == 1 );
-
-                              /**
-                               * now we need the port info from the input
-                               * port on back
-                               **/
-
-                              /**
-                               * kernel_a -> back goes to
-                               * kernel_a -> join -> back
-                               */
-                              auto *join( static_cast< raft::kernel* >( a.join_func() ) );
-                              all_k->insert( join );
-                              MapBase::insert( a.my_kernel, a,
-                                               b.my_kernel, b,
-                                               join );
-                              /**
-                               * finally set the flag to the scheduler
-                               * so that the parallel map manager can
-                               * pick it up an use it.
-                               */
-                              a.my_kernel->dup_enabled = true;
-                           }
-                           /** parallalizable source, single output no inputs**/
-                           else if( a.my_kernel->input.count() == 0 &&
-                                    a.my_kernel->output.count() == 1 )
-                           {
-                              auto *join( static_cast< raft::kernel* >( a.join_func() ) );
-                              all_k->insert( join );
-                              MapBase::insert( a.my_kernel, a,
-                                               b.my_kernel, b,
-                                               join );
-                              a.my_kernel->dup_enabled = true;
-                           }
-                           /** parallelizable sink, single input, no outputs **/
-                           else if( b.my_kernel->input.count() == 1 &&
-                                    b.my_kernel->output.count() == 0 )
-                           {
-                              auto *split(
-                                 static_cast< raft::kernel* >( b.split_func() ) );
-                              all_k->insert( split );
-                              MapBase::insert( a.my_kernel, a,
-                                               b.my_kernel, b,
-                                               split );
-                              b.my_kernel->dup_enabled = true;
-                           }
-                           /**
-                            * flag as candidate if the connecting
-                            * kernel only has one input port.
-                            */
-                           else if( b.my_kernel->input.count() == 1 )
-                           {
-                              /** simply flag as a candidate **/
-                              b.my_kernel->dup_candidate = true;
-                           }
-
-                        }
-                     },
-                     kernel_ptr,
-                     false );
-   source.release();
-   all.release();
+    UNUSED( source );
+    auto &all_k( all.acquire() );
+    /**
+     * pick them all before changing anything, a kernel next to one
+     * that is duplicated then sees the split or join, e.g.,
+     * a -> join -> split -> b when a and b both are.
+     */
+    std::vector< raft::kernel* > dup_list;
+    for( auto * const k : all_k )
+    {
+        if( dynamic_cast< raft::parallel_k* >( k ) != nullptr ||
+            ! k->input.hasPorts() )
+        {
+            continue;
+        }
+        bool all_out_of_order( true );
+        for( auto * const port : { &k->input, &k->output } )
+        {
+            for( auto &pair : port->portmap.map )
+            {
+                const auto &info( pair.second );
+                all_out_of_order &= ( info.out_of_order &&
+                                      info.other_kernel != nullptr &&
+                                      info.split_func != nullptr &&
+                                      info.join_func  != nullptr );
+            }
+        }
+        if( all_out_of_order )
+        {
+            dup_list.emplace_back( k );
+        }
+    }
+    for( auto * const k : dup_list )
+    {
+        /** front -> k goes to front -> split -> k **/
+        for( auto &pair : k->input.portmap.map )
+        {
+            auto &info( pair.second );
+            auto * const front( info.other_kernel );
+            auto &front_info( front->output.getPortInfoFor( info.other_name ) );
+            auto * const split( static_cast< raft::kernel* >( info.split_func() ) );
+            split->internal_alloc = true;
+            all_k.insert( split );
+            MapBase::insert( front, front_info, k, info, split );
+        }
+        /** k -> back goes to k -> join -> back **/
+        for( auto &pair : k->output.portmap.map )
+        {
+            auto &info( pair.second );
+            auto * const back( info.other_kernel );
+            auto &back_info( back->input.getPortInfoFor( info.other_name ) );
+            auto * const join( static_cast< raft::kernel* >( info.join_func() ) );
+            join->internal_alloc = true;
+            all_k.insert( join );
+            MapBase::insert( k, info, back, back_info, join );
+        }
+        /** picked up by the parallelism monitor **/
+        k->dup_enabled = true;
+    }
+    all.release();
+}
+
+PortInfo*
+raft::map::fused_link( raft::kernel * const k )
+{
+    if( k->output.count() != 1 ||
+        dynamic_cast< raft::parallel_k* >( k ) != nullptr )
+    {
+        return( nullptr );
+    }
+    auto &info( k->output.portmap.map.begin()->second );
+    auto * const next( info.other_kernel );
+    if( next == nullptr || next == k ||
+        next->input.count() != 1 ||
+        dynamic_cast< raft::parallel_k* >( next ) != nullptr ||
+        info.out_of_order ||
+        info.mem == SHM ||
+        info.existing_buffer != nullptr ||
+        /** only the single producer/consumer ring grows in place **/
+        info.const_map.find( Type::HeapSPSC ) == info.const_map.end() )
+    {
+        return( nullptr );
+    }
+    return( &info );
+}
+
+void
+raft::map::fuseChains( kernelkeeper &all )
+{
+    auto &all_k( all.acquire() );
+    /** a kernel fed by a fusable link isn't the start of a chain **/
+    std::set< raft::kernel* > fed;
+    for( auto * const k : all_k )
+    {
+        auto * const info( fused_link( k ) );
+        if( info != nullptr )
+        {
+            fed.insert( info->other_kernel );
+        }
+    }
+    /** a loop of them has no start, and is left alone **/
+    for( auto * const head : all_k )
+    {
+        if( fed.count( head ) != 0 )
+        {
+            continue;
+        }
+        auto *k( head );
+        for( auto *info( fused_link( k ) ); info != nullptr; info = fused_link( k ) )
+        {
+            auto * const next( info->other_kernel );
+            auto &next_info( next->input.getPortInfoFor( info->other_name ) );
+            if( info->fixed_buffer_size == 0 )
+            {
+                info->fixed_buffer_size     = fused_capacity;
+                next_info.fixed_buffer_size = fused_capacity;
+            }
+            info->fused       = true;
+            next_info.fused   = true;
+            k->fused_next     = next;
+            next->fused_stage = true;
+            k = next;
+        }
+    }
+    all.release();
 }
 
 void
@@ -88,3 +88,61 @@ MapBase::insert( raft::kernel *a,  PortInfo &a_out,
    join( *i, i_out.my_name, i_out,
          *b, b_in.my_name, b_in );
 }
+
+void
+MapBase::link_shm( raft::kernel *a,
+                   const std::string a_port,
+                   const std::string edge,
+                   const std::size_t buffer )
+{
+   assert( a != nullptr );
+   join_shm( *a, a->output.getPortInfoFor( a_port ), edge, buffer );
+   if( ! a->input.hasPorts() )
+   {
+      source_kernels += a;
+   }
+   all_kernels += a;
+}
+
+void
+MapBase::link_shm( const std::string edge,
+                   raft::kernel *b,
+                   const std::string b_port,
+                   const std::size_t buffer )
+{
+   assert( b != nullptr );
+   join_shm( *b, b->input.getPortInfoFor( b_port ), edge, buffer );
+   /** nothing in this map feeds it, so the graph walks start here **/
+   source_kernels += b;
+   if( ! b->output.hasPorts() )
+   {
+      dst_kernels += b;
+   }
+   all_kernels += b;
+}
+
+void
+MapBase::join_shm( raft::kernel &k, PortInfo &info,
+                   const std::string &edge,
+                   const std::size_t buffer )
+{
+   if( info.const_map.find( Type::SharedMemory ) == info.const_map.end() )
+   {
+      std::stringstream ss;
+      ss << "Port " << common::printClassName( k ) << "[" << info.my_name <<
+         "] has type " << common::printClassNameFromStr( info.type.name() ) <<
+         " which can't be sent through shared memory, it must be " <<
+         "trivially copyable and fit in a cache line.\n";
+      throw PortTypeException( ss.str() );
+   }
+   if( info.other_kernel != nullptr || info.mem == SHM )
+   {
+      std::stringstream ss;
+      ss << "Port " << common::printClassName( k ) << "[" << info.my_name <<
+         "] is already linked.\n";
+      throw PortDoubleInitializeException( ss.str() );
+   }
+   info.mem               = SHM;
+   info.shm_name          = edge;
+   info.fixed_buffer_size = buffer;
+}
@@ -0,0 +1,289 @@
+/**
+ * pagealloc.cpp -
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 19:02:17 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cassert>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#ifdef __linux
+#include <dirent.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "pagealloc.hpp"
+
+#ifdef __linux
+namespace
+{
+
+/** from linux/mempolicy.h, not always installed **/
+constexpr int mpol_bind = 2;
+
+std::size_t
+small_page()
+{
+   static const std::size_t size( sysconf( _SC_PAGESIZE ) );
+   return( size );
+}
+
+std::size_t
+huge_page()
+{
+   static const std::size_t size( [](){
+      std::ifstream meminfo( "/proc/meminfo" );
+      std::string   key;
+      std::size_t   kb( 0 );
+      while( meminfo >> key )
+      {
+         if( key == "Hugepagesize:" && meminfo >> kb )
+         {
+            return( kb * 1024 );
+         }
+      }
+      /** most common size on the machines we run on **/
+      return( static_cast< std::size_t >( 1 ) << 21 );
+   }() );
+   return( size );
+}
+
+/**
+ * mapped_length - length rounded up to whole pages, huge is set
+ * if huge pages should be tried.  allocate and release both use
+ * this so release doesn't have to remember anything.
+ */
+std::size_t
+mapped_length( const std::size_t length,
+               const raft::mem::options &opts,
+               bool &huge )
+{
+   huge = ( opts.page == raft::mem::huge && length >= huge_page() );
+   const auto unit( huge ? huge_page() : small_page() );
+   return( ( length + unit - 1 ) / unit * unit );
+}
+
+void*
+map_anonymous( const std::size_t length, const int flags )
+{
+   return( mmap( nullptr,
+                 length,
+                 PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | flags,
+                 -1,
+                 0 ) );
+}
+
+/**
+ * map_transparent - maps length bytes aligned to a huge page so
+ * the kernel can back it with transparent huge pages.
+ */
+void*
+map_transparent( const std::size_t length )
+{
+   const auto unit( huge_page() );
+   auto * const raw( reinterpret_cast< char* >(
+      map_anonymous( length + unit, 0 ) ) );
+   if( raw == MAP_FAILED )
+   {
+      return( MAP_FAILED );
+   }
+   const auto addr( reinterpret_cast< std::uintptr_t >( raw ) );
+   const auto lead( ( unit - ( addr % unit ) ) % unit );
+   if( lead != 0 )
+   {
+      munmap( raw, lead );
+   }
+   munmap( raw + lead + length, unit - lead );
+   auto * const ptr( raw + lead );
+#ifdef MADV_HUGEPAGE
+   madvise( ptr, length, MADV_HUGEPAGE );
+#endif
+   return( ptr );
+}
+
+/**
+ * touch - fault every page in from a thread pinned to core so
+ * first touch puts them on core's node.  If the pin fails the
+ * pages end up wherever this thread ran, no worse than not
+ * placing them at all.
+ */
+void
+touch( void * const ptr,
+       const std::size_t length,
+       const core_id_t core )
+{
+   std::thread toucher( [&]()
+   {
+      cpu_set_t cpuset;
+      CPU_ZERO( &cpuset );
+      CPU_SET( core, &cpuset );
+      sched_setaffinity( 0 /* calling thread */, sizeof( cpuset ), &cpuset );
+      auto * const bytes( reinterpret_cast< volatile char* >( ptr ) );
+      for( std::size_t offset( 0 ); offset < length; offset += small_page() )
+      {
+         bytes[ offset ] = 0;
+      }
+   } );
+   toucher.join();
+}
+
+bool
+bind_node( void * const ptr,
+           const std::size_t length,
+           const int node )
+{
+   constexpr std::size_t bits( sizeof( unsigned long ) * 8 );
+   /** room for 1024 nodes **/
+   unsigned long nodemask[ 1024 / bits ] = { 0 };
+   if( node < 0 || static_cast< std::size_t >( node ) >= 1024 )
+   {
+      return( false );
+   }
+   nodemask[ node / bits ] |= 1UL << ( node % bits );
+   /** the kernel drops the last bit of maxnode, hence the + 1 **/
+   return( syscall( SYS_mbind,
+                    ptr,
+                    length,
+                    mpol_bind,
+                    nodemask,
+                    sizeof( nodemask ) * 8 + 1,
+                    0 ) == 0 );
+}
+
+void
+place( void * const ptr,
+       const std::size_t length,
+       const raft::mem::options &opts )
+{
+   if( opts.place == raft::mem::anywhere || opts.core < 0 )
+   {
+      return;
+   }
+   if( opts.place == raft::mem::bind &&
+       bind_node( ptr, length, page_alloc::node_of( opts.core ) ) )
+   {
+      return;
+   }
+   /** first_touch, or bind without NUMA support in the kernel **/
+   touch( ptr, length, opts.core );
+}
+
+} /** end anonymous namespace **/
+#endif /** end if linux **/
+
+void*
+page_alloc::allocate( const std::size_t length,
+                      const raft::mem::options &opts )
+{
+   assert( length != 0 );
+#ifdef __linux
+   bool huge( false );
+   const auto len( mapped_length( length, opts, huge ) );
+   void *ptr( MAP_FAILED );
+   if( huge )
+   {
+      ptr = map_anonymous( len, MAP_HUGETLB );
+      if( ptr == MAP_FAILED )
+      {
+         /** nothing reserved, try transparent huge pages **/
+         ptr = map_transparent( len );
+      }
+   }
+   if( ptr == MAP_FAILED )
+   {
+      ptr = map_anonymous( len, 0 );
+   }
+   if( ptr == MAP_FAILED )
+   {
+      perror( "Failed to map FIFO memory!" );
+      exit( EXIT_FAILURE );
+   }
+   place( ptr, len, opts );
+   return( ptr );
+#else
+   UNUSED( opts );
+   auto * const ptr( calloc( 1, length ) );
+   if( ptr == nullptr )
+   {
+      perror( "Failed to allocate FIFO memory!" );
+      exit( EXIT_FAILURE );
+   }
+   return( ptr );
+#endif
+}
+
+void
+page_alloc::release( void * const ptr,
+                     const std::size_t length,
+                     const raft::mem::options &opts )
+{
+   if( ptr == nullptr )
+   {
+      return;
+   }
+#ifdef __linux
+   bool huge( false );
+   munmap( ptr, mapped_length( length, opts, huge ) );
+#else
+   UNUSED( length );
+   UNUSED( opts );
+   free( ptr );
+#endif
+   return;
+}
+
+int
+page_alloc::node_of( const core_id_t core )
+{
+#ifdef __linux
+   if( core < 0 )
+   {
+      return( -1 );
+   }
+   /** each cpu dir has a nodeN link on NUMA systems **/
+   const std::string path( "/sys/devices/system/cpu/cpu" +
+                           std::to_string( core ) );
+   auto * const dir( opendir( path.c_str() ) );
+   if( dir == nullptr )
+   {
+      return( -1 );
+   }
+   int node( -1 );
+   while( auto * const entry = readdir( dir ) )
+   {
+      if( std::strncmp( entry->d_name, "node", 4 ) == 0 &&
+          std::isdigit( static_cast< unsigned char >( entry->d_name[ 4 ] ) ) )
+      {
+         node = std::atoi( entry->d_name + 4 );
+         break;
+      }
+   }
+   closedir( dir );
+   return( node );
+#else
+   UNUSED( core );
+   return( -1 );
+#endif
+}
@@ -1,6 +1,7 @@
 #include <cstddef>
 #include <mutex>
 #include "parallelk.hpp"
+#include "fifo.hpp"
 
 using namespace raft;
 
@@ -37,3 +38,9 @@ parallel_k::unlock_helper( Port &port )
 {
    port.portmap.mutex_map.unlock(); 
 }
+
+void
+parallel_k::idle_wait( FIFO &fifo, const std::size_t spins )
+{
+   fifo.idle_wait( spins );
+}
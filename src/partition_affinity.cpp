@@ -0,0 +1,197 @@
+/**
+ * partition_affinity.cpp -
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 00:21:09 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cassert>
+#include <map>
+#include <queue>
+#include <set>
+#include <vector>
+
+#include "partition_affinity.hpp"
+#include "graphprofile.hpp"
+#include "graphtools.hpp"
+#include "port_info.hpp"
+
+namespace
+{
+
+using neighbors_t = std::map< raft::kernel*, double >;
+
+struct link_data
+{
+   const raft::graph_profile               *profile;
+   std::map< raft::kernel*, neighbors_t >   adjacent;
+   std::set< raft::kernel* >                has_input;
+};
+
+bool
+by_id( raft::kernel * const a, raft::kernel * const b )
+{
+   return( a->get_id() < b->get_id() );
+}
+
+} /** end anonymous namespace **/
+
+void
+partition_affinity::partition( kernelkeeper &kernels )
+{
+   const cpu_topology topology;
+   place( kernels, topology );
+   return;
+}
+
+void
+partition_affinity::place( kernelkeeper &kernels,
+                           const cpu_topology &topology )
+{
+   const auto &cpus( topology.cpus() );
+   auto &c( kernels.acquire() );
+   if( c.empty() || cpus.empty() )
+   {
+      kernels.release();
+      return;
+   }
+   /** who talks to whom, and how much if it was measured **/
+   link_data links;
+   links.profile = ( profile != nullptr && profile->loaded() ? profile : nullptr );
+   GraphTools::BFS( c,
+                    (edge_func) []( PortInfo &a, PortInfo &b, void *data )
+                    {
+                       auto * const l( reinterpret_cast< link_data* >( data ) );
+                       double weight( 1.0 );
+                       if( l->profile != nullptr )
+                       {
+                          const auto rate( l->profile->edge_rate( a ) );
+                          const auto max( l->profile->max_edge_rate() );
+                          if( rate > 0 && max > 0 )
+                          {
+                             /** never zero, the link still exists **/
+                             weight += rate / max * 1000.0;
+                          }
+                       }
+                       l->adjacent[ a.my_kernel ][ b.my_kernel ] += weight;
+                       l->adjacent[ b.my_kernel ][ a.my_kernel ] += weight;
+                       l->has_input.insert( b.my_kernel );
+                    },
+                    &links,
+                    false );
+   /**
+    * breadth first from the sources, so a pipeline is placed in
+    * order, then whatever wasn't reached (cycles with no source)
+    */
+   std::vector< raft::kernel* > all( c.begin(), c.end() );
+   std::sort( all.begin(), all.end(), by_id );
+   std::vector< raft::kernel* > order;
+   std::set< raft::kernel* >    visited;
+   auto visit_from( [&]( raft::kernel * const start )
+   {
+      std::queue< raft::kernel* > q;
+      q.push( start );
+      visited.insert( start );
+      while( ! q.empty() )
+      {
+         auto * const k( q.front() );
+         q.pop();
+         order.emplace_back( k );
+         std::vector< raft::kernel* > next;
+         for( const auto &n : links.adjacent[ k ] )
+         {
+            if( c.count( n.first ) != 0 && visited.insert( n.first ).second )
+            {
+               next.emplace_back( n.first );
+            }
+         }
+         std::sort( next.begin(), next.end(), by_id );
+         for( auto * const n : next )
+         {
+            q.push( n );
+         }
+      }
+   } );
+   for( auto * const k : all )
+   {
+      if( links.has_input.count( k ) == 0 && visited.count( k ) == 0 )
+      {
+         visit_from( k );
+      }
+   }
+   for( auto * const k : all )
+   {
+      if( visited.count( k ) == 0 )
+      {
+         visit_from( k );
+      }
+   }
+   /** more kernels than cores means sharing, evenly **/
+   const auto per_cpu( ( order.size() + cpus.size() - 1 ) / cpus.size() );
+   std::vector< std::size_t > llc_free( topology.llc_count(), 0 );
+   for( const auto &cpu : cpus )
+   {
+      llc_free[ cpu.llc ] += per_cpu;
+   }
+   std::vector< std::size_t >                 cpu_used( cpus.size(), 0 );
+   std::map< raft::kernel*, std::size_t >     llc_of;
+   std::size_t                                last_llc( 0 );
+   for( auto * const k : order )
+   {
+      /** the LLC holding most of this kernel's traffic so far **/
+      std::vector< double > score( llc_free.size(), 0.0 );
+      for( const auto &n : links.adjacent[ k ] )
+      {
+         const auto placed( llc_of.find( n.first ) );
+         if( placed != llc_of.end() )
+         {
+            score[ (*placed).second ] += n.second;
+         }
+      }
+      std::size_t best( llc_free.size() );
+      for( std::size_t l( 0 ); l < llc_free.size(); l++ )
+      {
+         if( llc_free[ l ] == 0 )
+         {
+            continue;
+         }
+         if( best == llc_free.size() || score[ l ] > score[ best ] ||
+             ( score[ l ] == score[ best ] && l == last_llc ) )
+         {
+            best = l;
+         }
+      }
+      assert( best != llc_free.size() );
+      /** least used core in it, cores ordered physical first **/
+      std::size_t pick( cpus.size() );
+      for( std::size_t i( 0 ); i < cpus.size(); i++ )
+      {
+         if( cpus[ i ].llc == best && cpu_used[ i ] < per_cpu &&
+             ( pick == cpus.size() || cpu_used[ i ] < cpu_used[ pick ] ) )
+         {
+            pick = i;
+         }
+      }
+      assert( pick != cpus.size() );
+      cpu_used[ pick ]++;
+      llc_free[ best ]--;
+      llc_of[ k ] = best;
+      last_llc    = best;
+      (this)->setCore( *k, cpus[ pick ].id );
+   }
+   kernels.release();
+   return;
+}
@@ -5,11 +5,14 @@
  * type.
  */
 #ifdef USE_PARTITION
+#include <cmath>
 #include <cstdio>
 #include <scotch.h>
 #include "partition_scotch.hpp"
 #include "graph.tcc"
 #include "graphtools.hpp"
+#include "graphprofile.hpp"
+#include "defs.hpp"
 
 void
 partition_scotch::partition( kernelkeeper &keeper )
@@ -25,15 +28,15 @@ partition_scotch::partition( kernelkeeper &keeper )
    auto weight_func(
       []( PortInfo &a, PortInfo &b, void *weight_data ) -> weight_t
       {
-         //FIXME -> lets use a memoization of prev. runs to do 
-         //initial partition in the future
-         return( 1 );
+         UNUSED( b );
+         /** traffic measured on earlier runs, if on file **/
+         return( edge_weight( a, weight_data ) );
       }
    );
    run_scotch( c, 
                cores, 
                weight_func, 
-               nullptr );
+               loaded_profile() );
    keeper.release();
    return;
 }
@@ -100,17 +103,47 @@ partition_scotch::simple(  container_type &c,
    auto weight_func( 
       []( PortInfo &a, PortInfo &b, void *weight_data ) -> weight_t
       {
-         /** simple weight to start **/
-         return( 1 );
+         UNUSED( b );
+         /** simple weight to start, unless there is a profile **/
+         return( edge_weight( a, weight_data ) );
       }
    );
    run_scotch( c, 
                cores, 
                weight_func, 
-               nullptr );
+               loaded_profile() );
    return;
 }
    
+void*
+partition_scotch::loaded_profile() const noexcept
+{
+   if( profile == nullptr || ! profile->loaded() )
+   {
+      return( nullptr );
+   }
+   return( const_cast< raft::graph_profile* >( profile ) );
+}
+
+weight_t
+partition_scotch::edge_weight( PortInfo &src, void *weight_data )
+{
+   if( weight_data == nullptr )
+   {
+      return( 1 );
+   }
+   const auto * const prof(
+      reinterpret_cast< const raft::graph_profile* >( weight_data ) );
+   const auto rate( prof->edge_rate( src ) );
+   const auto max( prof->max_edge_rate() );
+   if( rate <= 0 || max <= 0 )
+   {
+      return( 1 );
+   }
+   /** relative to the busiest edge so it fits in a weight_t **/
+   return( 1 + static_cast< weight_t >( std::llround( rate / max * weight_scale ) ) );
+}
+
 bool 
 partition_scotch::simple_check( container_type &c,
                                 const core_id_t cores )
@@ -140,7 +173,24 @@ partition_scotch::run_scotch( container_type &c,
    get_graph_info( c, 
                    raft_graph, 
                    weight_func, 
-                   nullptr );
+                   weight );
+   if( weight != nullptr )
+   {
+      /** busy kernels weigh more, so they're spread across cores **/
+      const auto * const prof(
+         reinterpret_cast< const raft::graph_profile* >( weight ) );
+      edge_id_t index( 0 );
+      for( raft::kernel const *k : c )
+      {
+         const auto load( prof->kernel_load( k ) );
+         if( load >= 0 )
+         {
+            raft_graph.setVertexWeight( index, 
+               1 + static_cast< weight_t >( std::llround( load * weight_scale ) ) );
+         }
+         index++;
+      }
+   }
    SCOTCH_Graph graph;
    if( SCOTCH_graphInit( &graph ) != 0 )
    {
@@ -156,7 +206,7 @@ partition_scotch::run_scotch( container_type &c,
          table->num_vertices      /** vertex nmbr (zero indexed)   **/,
          table->vtable            /** vertex tab **/,
          &table->vtable[ 1 ]      /** vendtab **/,
-         nullptr           /** velotab **/,
+         table->vweight    /** velotab **/,
          nullptr           /** vlbltab **/,
          table->num_edges                 /** edge number **/,
          table->etable             /** edge tab **/,
@@ -94,11 +94,21 @@ pool_schedule::start()
     auto &container( kernel_set.acquire() );
     for( auto * const k : container )
     {  
+        /** runs as part of its chain's first stage **/
+        if( Schedule::fusedStage( k ) )
+        {
+            continue;
+        }
         auto *td( new thread_data( k ) );
         thread_data_mutex.lock();
         thread_data_pool.emplace_back( td );
         thread_data_mutex.unlock();
-        if( ! k->output.hasPorts() /** has no outputs, only 0 > inputs **/ )
+        auto *last( k );
+        while( last->fused_next != nullptr )
+        {
+            last = last->fused_next;
+        }
+        if( ! last->output.hasPorts() /** has no outputs, only 0 > inputs **/ )
         {
             std::lock_guard< std::mutex > tail_lock( tail_mutex );
             /** destination kernel **/
@@ -72,6 +72,28 @@ Port::operator[]( const std::string &&port_name )
    return( *((*ret_val).second.getFIFO())  );
 }
 
+void
+Port::setWaitStrategy( const std::string &&port_name,
+                       const raft::wait::strategy strategy )
+{
+   getPortInfoFor( port_name ).wait_strategy = strategy;
+}
+
+void
+Port::setMemoryCap( const std::string &&port_name,
+                    const std::size_t bytes )
+{
+   getPortInfoFor( port_name ).max_bytes = bytes;
+}
+
+void
+Port::setMemoryOptions( const std::string &&port_name,
+                        const raft::mem::pages page,
+                        const raft::mem::placement place )
+{
+   getPortInfoFor( port_name ).mem_options = raft::mem::options( page, place );
+}
+
 bool
 Port::hasPorts()
 {
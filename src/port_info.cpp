@@ -30,12 +30,18 @@ PortInfo::PortInfo( const PortInfo &other ) : type( other.type )
    other_kernel   = other.other_kernel;
    other_name     = other.other_name;
    out_of_order   = other.out_of_order;
+   mem            = other.mem;
    existing_buffer= other.existing_buffer;
    nitems         = other.nitems;
    start_index    = other.start_index;
    split_func      = other.split_func;
    join_func       = other.join_func;
    fixed_buffer_size = other.fixed_buffer_size;
+   wait_strategy     = other.wait_strategy;
+   item_size         = other.item_size;
+   max_bytes         = other.max_bytes;
+   mem_options       = other.mem_options;
+   shm_name          = other.shm_name;
 }
 
 
@@ -45,22 +51,6 @@ PortInfo::~PortInfo()
 }
 
 
-FIFO* 
-PortInfo::getFIFO()
-{
-   struct{
-      FIFO *a;
-      FIFO *b;
-   }copy = { fifo_a, fifo_b };
-   /** for most architectures that don't need this, it'll be optimized out after the first iteration **/
-   while( copy.a != copy.b )
-   {
-      copy.a = fifo_a;
-      copy.b = fifo_b;
-   }
-   return( copy.a );
-}
-
 void 
 PortInfo::setFIFO( FIFO * const in )
 {
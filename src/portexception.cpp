@@ -69,3 +69,8 @@ PortAlreadyExists::PortAlreadyExists(
    const std::string message ) : PortException( message )
 {
 }
+
+FusedStageBlockedException::FusedStageBlockedException(
+   const std::string message ) : PortException( message )
+{
+}
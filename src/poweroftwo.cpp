@@ -0,0 +1,68 @@
+/**
+ * poweroftwo.cpp -
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 02:06:44 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdint>
+#include "poweroftwo.hpp"
+
+poweroftwo::poweroftwo() : splitmethod(),
+                           /** splits made together shouldn't pick alike **/
+                           state( reinterpret_cast< std::uintptr_t >( this ) | 1 )
+{
+}
+
+poweroftwo::~poweroftwo()
+{
+}
+
+FIFO*
+poweroftwo::select_fifo( Port &port_list, const functype type )
+{
+   auto &list( fifos( port_list ) );
+   const auto n( list.size() );
+   if( n == 0 )
+   {
+      return( nullptr );
+   }
+   const auto a( random() % n );
+   /** a different port from a whenever there are two **/
+   const auto b( n == 1 ? a : ( a + 1 + random() % ( n - 1 ) ) % n );
+   const bool a_ready( ready( *list[ a ], type ) );
+   const bool b_ready( ready( *list[ b ], type ) );
+   if( a_ready && b_ready )
+   {
+      const auto occ_a( occupancy( *list[ a ] ) );
+      const auto occ_b( occupancy( *list[ b ] ) );
+      return( ( type == sendtype ? occ_b < occ_a : occ_b > occ_a ) ?
+              list[ b ] : list[ a ] );
+   }
+   if( a_ready || b_ready )
+   {
+      return( a_ready ? list[ a ] : list[ b ] );
+   }
+   for( std::size_t i( 0 ); i < n; i++ )
+   {
+      const auto index( ( next + i ) % n );
+      if( ready( *list[ index ], type ) )
+      {
+         next = index + 1;
+         return( list[ index ] );
+      }
+   }
+   return( nullptr );
+}
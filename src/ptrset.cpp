@@ -0,0 +1,93 @@
+/**
+ * ptrset.cpp -
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 22:31:05 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cassert>
+
+#include "ptrset.hpp"
+
+namespace
+{
+/** table size to start with, power of two **/
+constexpr std::size_t initial_slots( 16 );
+}
+
+ptr_set::ptr_set() : table( initial_slots, 0 ),
+                     mask( initial_slots - 1 )
+{
+}
+
+void
+ptr_set::insert( const std::uintptr_t ptr )
+{
+   assert( ptr != 0 );
+   auto i( slot( ptr ) );
+   for( ; table[ i ] != 0; i = ( i + 1 ) & mask )
+   {
+      if( table[ i ] == ptr )
+      {
+         return;
+      }
+   }
+   table[ i ] = ptr;
+   members.emplace_back( ptr );
+   if( members.size() > table.size() / 2 )
+   {
+      grow();
+   }
+}
+
+void
+ptr_set::clear() noexcept
+{
+   if( members.size() < table.size() / 8 )
+   {
+      /** usually one or two, zero just those **/
+      for( const auto ptr : members )
+      {
+         auto i( slot( ptr ) );
+         while( table[ i ] != ptr )
+         {
+            i = ( i + 1 ) & mask;
+         }
+         table[ i ] = 0;
+      }
+   }
+   else
+   {
+      std::fill( table.begin(), table.end(), 0 );
+   }
+   members.clear();
+}
+
+void
+ptr_set::grow()
+{
+   table.assign( table.size() << 1, 0 );
+   mask = table.size() - 1;
+   for( const auto ptr : members )
+   {
+      auto i( slot( ptr ) );
+      while( table[ i ] != 0 )
+      {
+         i = ( i + 1 ) & mask;
+      }
+      table[ i ] = ptr;
+   }
+}
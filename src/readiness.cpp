@@ -0,0 +1,233 @@
+/**
+ * readiness.cpp -
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 15:31:08 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cassert>
+
+#include "fifo.hpp"
+#include "readiness.hpp"
+
+Readiness::Readiness( const Readiness &other )
+{
+   (void) other;
+}
+
+Readiness::~Readiness()
+{
+   auto *b( first.next.load( std::memory_order_relaxed ) );
+   while( b != nullptr )
+   {
+      auto * const next( b->next.load( std::memory_order_relaxed ) );
+      delete( b );
+      b = next;
+   }
+}
+
+Readiness::block*
+Readiness::get_block( const std::size_t index )
+{
+   auto *b( &first );
+   for( auto n( index / word_bits ); n > 0; n-- )
+   {
+      auto *next( b->next.load( std::memory_order_acquire ) );
+      if( next == nullptr )
+      {
+         next = new block();
+         b->next.store( next, std::memory_order_release );
+      }
+      b = next;
+   }
+   return( b );
+}
+
+void
+Readiness::add_input( FIFO * const fifo,
+                      ReadyBit &data,
+                      ReadyBit &closed )
+{
+   assert( fifo != nullptr );
+   std::lock_guard< std::mutex > guard( add_mutex );
+   const auto index( n_in.load( std::memory_order_relaxed ) );
+   auto * const b( get_block( index ) );
+   const word_t mask( word_t( 1 ) << ( index % word_bits ) );
+   b->in[ index % word_bits ] = fifo;
+   data   = ReadyBit( &b->data,   mask );
+   closed = ReadyBit( &b->closed, mask );
+   /** an existing buffer can start out full **/
+   if( fifo->size() > 0 )
+   {
+      data.set();
+   }
+   n_in.store( index + 1, std::memory_order_release );
+}
+
+ReadyBit
+Readiness::add_output( FIFO * const fifo )
+{
+   assert( fifo != nullptr );
+   std::lock_guard< std::mutex > guard( add_mutex );
+   const auto index( n_out.load( std::memory_order_relaxed ) );
+   auto * const b( get_block( index ) );
+   const word_t mask( word_t( 1 ) << ( index % word_bits ) );
+   b->out[ index % word_bits ] = fifo;
+   ReadyBit space( &b->space, mask );
+   space.set();
+   n_out.store( index + 1, std::memory_order_release );
+   return( space );
+}
+
+bool
+Readiness::has_input() const noexcept
+{
+   for( auto *b( &first ); b != nullptr;
+         b = b->next.load( std::memory_order_acquire ) )
+   {
+      if( b->data.load( std::memory_order_acquire ) != 0 )
+      {
+         return( true );
+      }
+   }
+   return( false );
+}
+
+bool
+Readiness::has_output_space() const noexcept
+{
+   const auto count( n_out.load( std::memory_order_acquire ) );
+   std::size_t i( 0 );
+   for( auto *b( &first ); b != nullptr;
+         b = b->next.load( std::memory_order_acquire ), i++ )
+   {
+      const auto mask( valid( i, count ) );
+      if( ( b->space.load( std::memory_order_acquire ) & mask ) != mask )
+      {
+         return( false );
+      }
+   }
+   return( true );
+}
+
+bool
+Readiness::inputs_closed() const noexcept
+{
+   const auto count( n_in.load( std::memory_order_acquire ) );
+   std::size_t i( 0 );
+   for( auto *b( &first ); b != nullptr;
+         b = b->next.load( std::memory_order_acquire ), i++ )
+   {
+      const auto mask( valid( i, count ) );
+      if( ( b->closed.load( std::memory_order_acquire ) & mask ) != mask )
+      {
+         return( false );
+      }
+   }
+   return( true );
+}
+
+void
+Readiness::refresh_input()
+{
+   for( auto *b( &first ); b != nullptr;
+         b = b->next.load( std::memory_order_acquire ) )
+   {
+      auto bits( b->data.load( std::memory_order_acquire ) );
+      while( bits != 0 )
+      {
+         const auto index( __builtin_ctzll( bits ) );
+         const word_t mask( word_t( 1 ) << index );
+         bits &= ~mask;
+         auto * const fifo( b->in[ index ] );
+         if( fifo->size() > 0 )
+         {
+            continue;
+         }
+         /** clear then re-check, a push may have raced with us **/
+         ReadyBit bit( &b->data, mask );
+         bit.clear();
+         if( fifo->size() > 0 )
+         {
+            bit.set();
+         }
+      }
+   }
+}
+
+bool
+Readiness::poll_input()
+{
+   const auto count( n_in.load( std::memory_order_acquire ) );
+   bool any( false );
+   std::size_t i( 0 );
+   for( auto *b( &first ); b != nullptr;
+         b = b->next.load( std::memory_order_acquire ), i++ )
+   {
+      auto bits( valid( i, count ) );
+      while( bits != 0 )
+      {
+         const auto index( __builtin_ctzll( bits ) );
+         const word_t mask( word_t( 1 ) << index );
+         bits &= ~mask;
+         ReadyBit bit( &b->data, mask );
+         if( b->in[ index ]->size() > 0 )
+         {
+            bit.set();
+            any = true;
+         }
+         else
+         {
+            bit.clear();
+            if( b->in[ index ]->size() > 0 )
+            {
+               bit.set();
+               any = true;
+            }
+         }
+      }
+   }
+   return( any );
+}
+
+bool
+Readiness::poll_output_space()
+{
+   const auto count( n_out.load( std::memory_order_acquire ) );
+   bool all( true );
+   std::size_t i( 0 );
+   for( auto *b( &first ); b != nullptr;
+         b = b->next.load( std::memory_order_acquire ), i++ )
+   {
+      auto bits( valid( i, count ) );
+      while( bits != 0 )
+      {
+         const auto index( __builtin_ctzll( bits ) );
+         const word_t mask( word_t( 1 ) << index );
+         bits &= ~mask;
+         ReadyBit bit( &b->space, mask );
+         bit.clear();
+         if( b->out[ index ]->space_avail() > 0 )
+         {
+            bit.set();
+         }
+         else
+         {
+            all = false;
+         }
+      }
+   }
+   return( all );
+}
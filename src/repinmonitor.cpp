@@ -0,0 +1,266 @@
+/**
+ * repinmonitor.cpp -
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 01:12:40 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cassert>
+#include <fstream>
+#include <map>
+#include <string>
+
+#include "repinmonitor.hpp"
+#include "kernel.hpp"
+#include "fifo.hpp"
+
+constexpr double      repin_monitor::wait_threshold;
+constexpr double      repin_monitor::blocked_limit;
+constexpr double      repin_monitor::min_gain;
+constexpr std::size_t repin_monitor::confirm;
+constexpr std::size_t repin_monitor::cooldown;
+
+namespace
+{
+
+/**
+ * read_schedstat - time the thread has run and has waited to run,
+ * in ns, false if the kernel doesn't keep them.
+ */
+bool
+read_schedstat( const std::int64_t tid,
+                std::uint64_t &cpu_ns,
+                std::uint64_t &wait_ns )
+{
+   std::ifstream in( "/proc/self/task/" + std::to_string( tid ) + "/schedstat" );
+   if( ! in.is_open() )
+   {
+      return( false );
+   }
+   in >> cpu_ns >> wait_ns;
+   return( static_cast< bool >( in ) );
+}
+
+} /** end anonymous namespace **/
+
+repin_monitor::repin_monitor( const cpu_topology &topology,
+                              const std::chrono::milliseconds period ) :
+   topology( topology ),
+   period( period ),
+   window_start( clock::now() )
+{
+}
+
+void
+repin_monitor::add( raft::kernel * const k, slot * const s )
+{
+   assert( s != nullptr );
+   entries.emplace_back( k, s );
+}
+
+void
+repin_monitor::tick()
+{
+   if( disabled || entries.empty() )
+   {
+      return;
+   }
+   for( auto &e : entries )
+   {
+      if( e.k != nullptr )
+      {
+         e.samples++;
+         e.blocked += ( fifo_blocked( e.k ) ? 1 : 0 );
+      }
+   }
+   const auto now( clock::now() );
+   if( now - window_start < period )
+   {
+      return;
+   }
+   const auto wall( static_cast< double >(
+      std::chrono::duration_cast< std::chrono::nanoseconds >(
+         now - window_start ).count() ) );
+   window_start = now;
+   std::vector< usage > use( entries.size() );
+   bool started( false ), readable( false );
+   for( std::size_t i( 0 ); i < entries.size(); i++ )
+   {
+      auto &e( entries[ i ] );
+      const auto tid( e.s->tid.load( std::memory_order_acquire ) );
+      std::uint64_t cpu_ns( 0 ), wait_ns( 0 );
+      /** not started yet, or already done, counts for nothing **/
+      if( tid == 0 || ! read_schedstat( tid, cpu_ns, wait_ns ) )
+      {
+         started |= ( tid != 0 );
+         e.primed = false;
+      }
+      else
+      {
+         started  = true;
+         readable = true;
+         if( e.primed )
+         {
+            use[ i ].cpu     = static_cast< double >( cpu_ns - e.cpu_ns ) / wall;
+            use[ i ].wait    = static_cast< double >( wait_ns - e.wait_ns ) / wall;
+            use[ i ].blocked = ( e.samples == 0 ? 0.0 :
+               static_cast< double >( e.blocked ) / static_cast< double >( e.samples ) );
+         }
+         e.cpu_ns  = cpu_ns;
+         e.wait_ns = wait_ns;
+         e.primed  = true;
+      }
+      e.samples = 0;
+      e.blocked = 0;
+   }
+   if( started && ! readable )
+   {
+      disabled = true;
+      return;
+   }
+   window( use );
+}
+
+std::int64_t
+repin_monitor::window( const std::vector< usage > &use )
+{
+   assert( use.size() == entries.size() );
+   const auto &cpus( topology.cpus() );
+   std::map< core_id_t, double >      load;
+   std::map< core_id_t, std::size_t > llc;
+   for( const auto &c : cpus )
+   {
+      load[ c.id ] = 0.0;
+      llc[ c.id ]  = c.llc;
+   }
+   for( std::size_t i( 0 ); i < entries.size(); i++ )
+   {
+      const auto core( entries[ i ].s->core.load( std::memory_order_relaxed ) );
+      if( load.count( core ) != 0 )
+      {
+         load[ core ] += use[ i ].cpu + use[ i ].wait;
+      }
+   }
+   std::int64_t best( -1 );
+   core_id_t    best_target( -1 );
+   double       best_gain( 0.0 );
+   for( std::size_t i( 0 ); i < entries.size(); i++ )
+   {
+      auto &e( entries[ i ] );
+      const auto core( e.s->core.load( std::memory_order_relaxed ) );
+      if( e.frozen > 0 )
+      {
+         e.frozen--;
+         e.strikes = 0;
+         continue;
+      }
+      if( load.count( core ) == 0 ||
+          use[ i ].wait < wait_threshold ||
+          use[ i ].blocked > blocked_limit )
+      {
+         e.strikes = 0;
+         continue;
+      }
+      /** least loaded core anywhere, and within this LLC **/
+      core_id_t any( -1 ), near( -1 );
+      for( const auto &c : cpus )
+      {
+         if( c.id == core )
+         {
+            continue;
+         }
+         if( any == -1 || load[ c.id ] < load[ any ] )
+         {
+            any = c.id;
+         }
+         if( c.llc == llc[ core ] &&
+             ( near == -1 || load[ c.id ] < load[ near ] ) )
+         {
+            near = c.id;
+         }
+      }
+      if( any == -1 )
+      {
+         e.strikes = 0;
+         continue;
+      }
+      /** staying in the cache is worth a little load **/
+      const auto target( near != -1 && load[ near ] <= load[ any ] + 0.1 ?
+                         near : any );
+      const auto demand( use[ i ].cpu + use[ i ].wait );
+      const auto gain( load[ core ] - ( load[ target ] + demand ) );
+      if( gain < min_gain )
+      {
+         e.strikes = 0;
+         continue;
+      }
+      if( ++e.strikes >= confirm && gain > best_gain )
+      {
+         best        = static_cast< std::int64_t >( i );
+         best_target = target;
+         best_gain   = gain;
+      }
+   }
+   if( best != -1 )
+   {
+      auto &e( entries[ best ] );
+      e.s->core.store( best_target, std::memory_order_release );
+      e.frozen  = cooldown;
+      /** the loads just changed, everyone else has to make the case again **/
+      for( auto &other : entries )
+      {
+         other.strikes = 0;
+      }
+   }
+   return( best );
+}
+
+bool
+repin_monitor::fifo_blocked( raft::kernel * const k )
+{
+   /** splits and joins gain ports while running **/
+   k->lock();
+   const bool blocked( fifo_blocked_locked( k ) );
+   k->unlock();
+   return( blocked );
+}
+
+bool
+repin_monitor::fifo_blocked_locked( raft::kernel * const k )
+{
+   bool has_input( false );
+   bool starved( true );
+   for( auto &port : k->input )
+   {
+      has_input = true;
+      if( port.size() != 0 )
+      {
+         starved = false;
+         break;
+      }
+   }
+   if( has_input && starved )
+   {
+      return( true );
+   }
+   for( auto &port : k->output )
+   {
+      if( port.size() >= port.capacity() )
+      {
+         return( true );
+      }
+   }
+   return( false );
+}
@@ -0,0 +1,209 @@
+/**
+ * resizepolicy.cpp -
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 16:40:12 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cassert>
+
+#include "allocate.hpp"
+#include "fifo.hpp"
+#include "blocked.hpp"
+#include "resizepolicy.hpp"
+#include "resizesignal.hpp"
+
+constexpr std::chrono::microseconds ResizePolicy::tick;
+constexpr std::size_t               ResizePolicy::shrink_window;
+
+void
+ResizeSignal::forward() noexcept
+{
+   policy->post( edge_id );
+}
+
+ResizePolicy::ResizePolicy( const std::size_t map_max_bytes,
+                            const std::size_t min_items ) :
+   map_max_bytes( map_max_bytes ),
+   min_items( min_items )
+{
+}
+
+ResizeSignal
+ResizePolicy::add_edge( FIFO * const fifo,
+                        const std::size_t item_size,
+                        const std::size_t max_bytes )
+{
+   assert( fifo != nullptr );
+   assert( item_size != 0 );
+   std::lock_guard< std::mutex > guard( edge_mutex );
+   const auto edge_id( edges.size() );
+   edges.emplace_back( new edge( fifo, item_size, max_bytes ) );
+   bytes += fifo->capacity() * item_size;
+   return( ResizeSignal( this, &edges.back()->pending, edge_id ) );
+}
+
+void
+ResizePolicy::post( const std::size_t edge_id )
+{
+   {
+      std::lock_guard< std::mutex > guard( post_mutex );
+      posted.emplace_back( edge_id );
+   }
+   post_cv.notify_one();
+}
+
+std::size_t
+ResizePolicy::total_bytes()
+{
+   return( bytes.load( std::memory_order_relaxed ) );
+}
+
+void
+ResizePolicy::run( volatile bool &exit_alloc )
+{
+   using clock = std::chrono::steady_clock;
+   std::vector< std::size_t > ids;
+   std::vector< edge* >       snapshot;
+   auto next_tick( clock::now() + tick );
+   while( ! exit_alloc )
+   {
+      {
+         std::unique_lock< std::mutex > lock( post_mutex );
+         post_cv.wait_until( lock, next_tick,
+                             [&](){ return( ! posted.empty() ); } );
+         ids.swap( posted );
+      }
+      for( const auto id : ids )
+      {
+         edge *e( nullptr );
+         {
+            std::lock_guard< std::mutex > guard( edge_mutex );
+            e = edges[ id ].get();
+         }
+         /**
+          * a bigger buffer only helps if the consumer can catch
+          * up, if it hasn't been starved since we last grew this
+          * edge then it is simply the slower side.
+          */
+         if( e->starved && grow( *e, exit_alloc ) )
+         {
+            e->starved     = false;
+            e->quiet_ticks = 0;
+         }
+         e->pending.store( false, std::memory_order_release );
+      }
+      ids.clear();
+      if( clock::now() < next_tick )
+      {
+         continue;
+      }
+      next_tick += tick;
+      {
+         std::lock_guard< std::mutex > guard( edge_mutex );
+         snapshot.clear();
+         for( auto &e : edges )
+         {
+            snapshot.emplace_back( e.get() );
+         }
+      }
+      for( auto * const e : snapshot )
+      {
+         sample( *e, exit_alloc );
+      }
+   }
+   return;
+}
+
+bool
+ResizePolicy::grow( edge &e, volatile bool &exit_alloc )
+{
+   const auto cap( e.fifo->capacity() );
+   auto items( cap * 2 );
+   if( e.max_bytes != 0 )
+   {
+      items = std::min( items, e.max_bytes / e.item_size );
+   }
+   if( map_max_bytes != 0 )
+   {
+      const auto used( bytes.load( std::memory_order_relaxed ) );
+      const auto room( used < map_max_bytes ?
+                          ( map_max_bytes - used ) / e.item_size : 0 );
+      items = std::min( items, cap + room );
+   }
+   if( items <= cap )
+   {
+      return( false );
+   }
+   resize( e, items, exit_alloc );
+   return( e.fifo->capacity() > cap );
+}
+
+void
+ResizePolicy::sample( edge &e, volatile bool &exit_alloc )
+{
+   /** free stores left behind by earlier resizes once drained **/
+   e.fifo->reclaim();
+   Blocked read, write;
+   e.fifo->get_zero_read_stats( read );
+   /** also restarts the stats window the adaptive wait strategy uses **/
+   e.fifo->get_zero_write_stats( write );
+   const auto size( e.fifo->size() );
+   /** consumer waited on empty, or may be idle outside of pop **/
+   if( read.bec.blocked != 0 || size == 0 )
+   {
+      e.starved = true;
+   }
+   e.high_water = std::max( e.high_water, size );
+   if( write.bec.blocked != 0 ||
+       e.pending.load( std::memory_order_acquire ) )
+   {
+      e.quiet_ticks = 0;
+      e.high_water  = 0;
+      return;
+   }
+   if( ++e.quiet_ticks < shrink_window )
+   {
+      return;
+   }
+   const auto cap( e.fifo->capacity() );
+   if( e.high_water * 4 <= cap && cap / 2 >= min_items )
+   {
+      resize( e, cap / 2, exit_alloc );
+   }
+   e.quiet_ticks = 0;
+   e.high_water  = 0;
+   return;
+}
+
+void
+ResizePolicy::resize( edge &e,
+                      const std::size_t items,
+                      volatile bool &exit_alloc )
+{
+   const auto before( e.fifo->capacity() );
+   e.fifo->resize( items, ALLOC_ALIGN_WIDTH, exit_alloc );
+   const auto after( e.fifo->capacity() );
+   if( after > before )
+   {
+      bytes += ( after - before ) * e.item_size;
+   }
+   else
+   {
+      bytes -= ( before - after ) * e.item_size;
+   }
+   return;
+}
@@ -11,22 +11,16 @@ roundrobin::~roundrobin()
 FIFO*  
 roundrobin::select_fifo( Port &port_list, const functype type )
 {
-   for( ;; )
+   auto &list( fifos( port_list ) );
+   const auto n( list.size() );
+   for( std::size_t i( 0 ); i < n; i++ )
    {
-      for( auto &port : port_list )
+      const auto index( ( next + i ) % n );
+      if( ready( *list[ index ], type ) )
       {
-         /** 
-          * TODO, big assumption here is that 
-          * eventually a port will have space 
-          */
-         if( type == sendtype && port.space_avail() > 0 )
-         {
-            return( &( port ) );
-         }
-         if( type == gettype && port.size() > 0 )
-         {
-            return( &( port ) );
-         }
+         next = index + 1;
+         return( list[ index ] );
       }
    }
+   return( nullptr );
 }
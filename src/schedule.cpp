@@ -1,15 +1,20 @@
 #include <iostream>
+#include <thread>
+#include <chrono>
+#include <cstdint>
 
 #include "kernel.hpp"
 #include "map.hpp"
 #include "schedule.hpp"
+#include "graphprofile.hpp"
 #include "optdef.hpp"
 #include "defs.hpp"
 
 
 Schedule::Schedule( raft::map &map ) : kernel_set( map.all_kernels ),
                                  source_kernels( map.source_kernels ),
-                                 dst_kernels( map.dst_kernels )
+                                 dst_kernels( map.dst_kernels ),
+                                 repin_window( map.repin_window )
 {
    //TODO, see if we want to keep this
    handlers.addHandler( raft::quit, Schedule::quitHandler );
@@ -47,10 +52,13 @@ Schedule::invalidateOutputPorts( raft::kernel *kernel )
 {
 
    auto &output_ports( kernel->output );
+   /** a split can gain ports while running **/
+   kernel->lock();
    for( auto &port : output_ports )
    {
       port.invalidate();
    }
+   kernel->unlock();
    return;
 }
 
@@ -125,35 +133,72 @@ Schedule::kernelHasInputData( raft::kernel *kernel )
       /** only output ports, keep calling till exits **/
       return( true );
    }
-   for( auto &port : port_list )
+   return( kernel->readiness.has_input() );
+}
+
+
+bool
+Schedule::kernelPollInputData( raft::kernel *kernel )
+{
+   auto &port_list( kernel->input );
+   if( ! port_list.hasPorts() )
    {
-      const auto size( port.size() );
-      if( size > 0 )
-      {
-         return( true );
-      }
+      return( true );
    }
-   return( false );
+   return( kernel->readiness.poll_input() );
+}
+
+
+bool
+Schedule::kernelHasOutputSpace( raft::kernel *kernel )
+{
+   return( kernel->readiness.has_output_space() );
 }
 
 
+bool
+Schedule::kernelPollOutputSpace( raft::kernel *kernel )
+{
+   return( kernel->readiness.poll_output_space() );
+}
+
 
 bool
 Schedule::kernelHasNoInputPorts( raft::kernel *kernel )
 {
-   auto &port_list( kernel->input );
    /** assume data check is already complete **/
-   for( auto &port : port_list )
+   return( kernel->readiness.inputs_closed() );
+}
+
+
+bool
+Schedule::kernelIdleWait( raft::kernel * const kernel,
+                          const std::size_t spins )
+{
+   if( kernelHasInputData( kernel ) )
    {
-      if( ! port.is_invalid() )
-      {
-         return( false );
-      }
+      return( false );
    }
-   return( true );
+   /**
+    * with several input ports data may show up on any of them,
+    * rotate which one we wait on, a park on the wrong port is
+    * bounded by the park timeout.
+    */
+   auto &port_list( kernel->input );
+   /** a join can gain ports while running, park outside the lock **/
+   kernel->lock();
+   auto it( port_list.begin() );
+   for( auto n( spins % port_list.count() ); n > 0; n-- )
+   {
+      ++it;
+   }
+   auto &fifo( *it );
+   kernel->unlock();
+   fifo.idle_wait( spins );
+   /** picks up any readiness bit set without a fence **/
+   return( ! kernelPollInputData( kernel ) );
 }
 
-
 bool
 Schedule::kernelRun( raft::kernel * const kernel,
                      volatile bool       &finished,
@@ -162,9 +207,34 @@ Schedule::kernelRun( raft::kernel * const kernel,
 {
    UNUSED( gotostate );
    UNUSED( kernel_state );
+   if( kernel->fused_next != nullptr )
+   {
+      fusedRun( kernel, finished );
+   }
+   else
+   {
+      stageRun( kernel, finished );
+   }
+   return( true );
+}
+
+bool
+Schedule::fusedStage( raft::kernel * const kernel )
+{
+   return( kernel->fused_stage );
+}
+
+void
+Schedule::stageRun( raft::kernel * const kernel,
+                    volatile bool       &finished )
+{
    if( kernelHasInputData( kernel ) )
    {
-      const auto sig_status( kernel->run() );
+      const auto sig_status( kernel->sample == nullptr ?
+                                kernel->run() :
+                                timedRun( kernel ) );
+      /** clear the bits of any input the kernel emptied **/
+      kernel->readiness.refresh_input();
       if( sig_status == raft::stop )
       {
          invalidateOutputPorts( kernel );
@@ -173,14 +243,71 @@ Schedule::kernelRun( raft::kernel * const kernel,
    }
    /**
     * must recheck data items again after port valid check, there could
-    * have been a push between these two conditional statements.
+    * have been a push between these two conditional statements.  Only
+    * happens once all inputs are closed so check every port exactly.
     */
-   if(  kernelHasNoInputPorts( kernel ) && ! kernelHasInputData( kernel ) )
+   if(  kernelHasNoInputPorts( kernel ) && ! kernelPollInputData( kernel ) )
    {
       invalidateOutputPorts( kernel );
       finished = true;
    }
-   return( true );
+   return;
+}
+
+void
+Schedule::fusedRun( raft::kernel * const head,
+                    volatile bool       &finished )
+{
+   if( ! head->fused_done )
+   {
+      stageRun( head, head->fused_done );
+   }
+   fusedDrain( head->fused_next );
+   bool done( true );
+   for( auto *k( head ); k != nullptr; k = k->fused_next )
+   {
+      done &= k->fused_done;
+   }
+   finished = done;
+   return;
+}
+
+void
+Schedule::fusedDrain( raft::kernel * const kernel )
+{
+   if( kernel == nullptr )
+   {
+      return;
+   }
+   /**
+    * only the stage before writes to this one's input, and it
+    * isn't running, so once the bit is clear the input is empty.
+    * Without data it only needs a run if the input is closed.
+    */
+   while( ! kernel->fused_done )
+   {
+      if( ! kernelHasInputData( kernel ) &&
+          ! kernelHasNoInputPorts( kernel ) )
+      {
+         break;
+      }
+      stageRun( kernel, kernel->fused_done );
+      fusedDrain( kernel->fused_next );
+   }
+   return;
+}
+
+raft::kstatus
+Schedule::timedRun( raft::kernel * const kernel )
+{
+   using clock = std::chrono::steady_clock;
+   const auto start( clock::now() );
+   const auto sig_status( kernel->run() );
+   const auto elapsed( clock::now() - start );
+   kernel->sample->busy_ns += static_cast< std::uint64_t >(
+      std::chrono::duration_cast< std::chrono::nanoseconds >( elapsed ).count() );
+   kernel->sample->runs++;
+   return( sig_status );
 }
 
 void
@@ -198,15 +325,19 @@ Schedule::setPtrSets( raft::kernel * const kernel,
      * within the view of the kernel they'll be
      * accessed sequentially so no contention
      */
-    for( auto &port : kernel->input )
+    /** the stages of a fused chain all run on this thread **/
+    for( auto *k( kernel ); k != nullptr; k = k->fused_next )
     {
-        port.setPtrMap( in );
-        port.setInPeekSet( peekset );
-    }
-    for( auto &port : kernel->output )
-    {
-        port.setPtrSet( out );
-        port.setOutPeekSet( peekset );
+        for( auto &port : k->input )
+        {
+            port.setPtrMap( in );
+            port.setInPeekSet( peekset );
+        }
+        for( auto &port : k->output )
+        {
+            port.setPtrSet( out );
+            port.setOutPeekSet( peekset );
+        }
     }
     return;
 }
@@ -216,28 +347,14 @@ Schedule::fifo_gc( ptr_map_t * const in,
                    ptr_set_t * const out,
                    ptr_set_t * const peekset )
 {
-    auto in_begin( in->begin() ), in_end( in->end() );
-    auto out_beg( out->begin() ), out_end( out->end() );
-    while( out_beg != out_end )
+    /** forwarded items belong to the next FIFO now **/
+    for( const auto &recycled : *in )
     {
-        if( (*out_beg) != (*in_begin).first )
-        {
-            void * const ptr = reinterpret_cast< void* >( (*in_begin).first );
-            (*in_begin).second( ptr );
-            ++in_begin;
-        }
-        else
+        if( ! out->contains( recycled.first ) )
         {
-            ++out_beg;
-            ++in_begin;
+            recycled.second( reinterpret_cast< void* >( recycled.first ) );
         }
     }
-    while( in_begin != in_end )
-    {
-            void * const ptr = reinterpret_cast< void* >( (*in_begin).first );
-            (*in_begin).second( ptr );
-            ++in_begin;
-    }
     in->clear();
     out->clear();
     peekset->clear();
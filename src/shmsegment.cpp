@@ -0,0 +1,306 @@
+/**
+ * shmsegment.cpp -
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 21:40:12 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "portexception.hpp"
+#include "shmsegment.hpp"
+
+static_assert( ATOMIC_LONG_LOCK_FREE == 2 && ATOMIC_BOOL_LOCK_FREE == 2 &&
+               ATOMIC_INT_LOCK_FREE == 2,
+               "shared memory FIFOs need address free atomics" );
+
+/**
+ * header - first thing in the segment, magic is stored last by
+ * the creator so a non-zero magic means the rest is valid.
+ */
+struct shm_segment::header
+{
+   std::atomic< std::uint64_t >  magic;
+   std::uint64_t                 length;
+   std::uint64_t                 item_size;
+   std::uint64_t                 type_hash;
+   std::uint64_t                 max_cap;
+   std::uint64_t                 store_offset;
+   std::uint64_t                 signal_offset;
+   /** attached process for each Direction, 0 if none yet **/
+   std::atomic< std::int32_t >   pid[ 2 ];
+   char                          pad[ L1D_CACHE_LINE_SIZE ];
+   SPSCIndices                   indices;
+};
+
+namespace
+{
+
+constexpr std::uint64_t shm_magic = 0x52414654534d0001 /** RAFTSM, v1 **/;
+
+/** time allowed for a creator to finish making the segment **/
+constexpr std::chrono::seconds create_timeout( 2 );
+
+std::size_t
+round_to( const std::size_t n, const std::size_t unit )
+{
+   return( ( n + unit - 1 ) / unit * unit );
+}
+
+bool
+process_alive( const std::int32_t pid )
+{
+   return( pid == 0 || kill( pid, 0 ) == 0 || errno != ESRCH );
+}
+
+[[noreturn]] void
+fail( const char * const what )
+{
+   perror( what );
+   exit( EXIT_FAILURE );
+}
+
+} /** end anonymous namespace **/
+
+shm_segment::shm_segment( const std::string &name,
+                          const Direction dir,
+                          const std::size_t item_size,
+                          const std::size_t type_hash,
+                          const std::size_t max_cap,
+                          const std::size_t align ) : path( "/raft." + name ),
+                                                      dir( dir )
+{
+   if( name.empty() || name.find( '/' ) != std::string::npos ||
+       path.length() > 255 )
+   {
+      throw PortException( "invalid shared memory edge name \"" + name + "\"" );
+   }
+   /** each failure means the segment went away, start over **/
+   while( ! ( ( create( item_size, type_hash, max_cap, align ) ||
+                open( item_size, type_hash ) ) && claim() ) );
+}
+
+shm_segment::~shm_segment()
+{
+   unmap();
+}
+
+std::size_t
+shm_segment::capacity() const noexcept
+{
+   return( head->max_cap );
+}
+
+void*
+shm_segment::store() const noexcept
+{
+   return( reinterpret_cast< char* >( head ) + head->store_offset );
+}
+
+Buffer::SignalMap*
+shm_segment::signals() const noexcept
+{
+   return( reinterpret_cast< Buffer::SignalMap* >(
+      reinterpret_cast< char* >( head ) + head->signal_offset ) );
+}
+
+SPSCIndices*
+shm_segment::indices() const noexcept
+{
+   return( &head->indices );
+}
+
+bool
+shm_segment::peer_alive() const noexcept
+{
+   const auto other( dir == Direction::Producer ? Direction::Consumer :
+                                                  Direction::Producer );
+   return( process_alive( head->pid[ other ].load( std::memory_order_acquire ) ) );
+}
+
+bool
+shm_segment::create( const std::size_t item_size,
+                     const std::size_t type_hash,
+                     const std::size_t max_cap,
+                     const std::size_t align )
+{
+   const auto fd( shm_open( path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600 ) );
+   if( fd < 0 )
+   {
+      if( errno == EEXIST )
+      {
+         return( false );
+      }
+      fail( "Failed to create shared memory FIFO" );
+   }
+   const std::size_t line( L1D_CACHE_LINE_SIZE );
+   const auto store_offset(
+      round_to( sizeof( header ), align > line ? align : line ) );
+   const auto signal_offset(
+      round_to( store_offset + max_cap * item_size, line ) );
+   length = signal_offset + Buffer::SignalMap::bytes( max_cap );
+   if( ftruncate( fd, length ) != 0 )
+   {
+      fail( "Failed to size shared memory FIFO" );
+   }
+   auto * const mem( mmap( nullptr,
+                           length,
+                           PROT_READ | PROT_WRITE,
+                           MAP_SHARED,
+                           fd,
+                           0 ) );
+   close( fd );
+   if( mem == MAP_FAILED )
+   {
+      fail( "Failed to map shared memory FIFO" );
+   }
+   /** fresh segments are zeroed, only the non-zero parts to fill in **/
+   head = new ( mem ) header();
+   head->length        = length;
+   head->item_size     = item_size;
+   head->type_hash     = type_hash;
+   head->max_cap       = max_cap;
+   head->store_offset  = store_offset;
+   head->signal_offset = signal_offset;
+   Buffer::SignalMap::make( signals(), max_cap );
+   head->magic.store( shm_magic, std::memory_order_release );
+   return( true );
+}
+
+bool
+shm_segment::open( const std::size_t item_size,
+                   const std::size_t type_hash )
+{
+   const auto fd( shm_open( path.c_str(), O_RDWR, 0 ) );
+   if( fd < 0 )
+   {
+      if( errno == ENOENT )
+      {
+         /** unlinked since create saw it, try again **/
+         return( false );
+      }
+      fail( "Failed to open shared memory FIFO" );
+   }
+   /** the creator may still be sizing it, then filling in the header **/
+   const auto deadline( std::chrono::steady_clock::now() + create_timeout );
+   const std::size_t header_length( sizeof( header ) );
+   void *mem( MAP_FAILED );
+   for( ;; )
+   {
+      struct stat st;
+      if( mem == MAP_FAILED && fstat( fd, &st ) == 0 &&
+          static_cast< std::size_t >( st.st_size ) >= header_length )
+      {
+         mem = mmap( nullptr, header_length, PROT_READ | PROT_WRITE,
+                     MAP_SHARED, fd, 0 );
+      }
+      if( mem != MAP_FAILED &&
+          reinterpret_cast< header* >( mem )->magic.load(
+             std::memory_order_acquire ) == shm_magic )
+      {
+         break;
+      }
+      if( std::chrono::steady_clock::now() > deadline )
+      {
+         /** creator died part way through **/
+         if( mem != MAP_FAILED )
+         {
+            munmap( mem, header_length );
+         }
+         close( fd );
+         shm_unlink( path.c_str() );
+         return( false );
+      }
+      std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+   }
+   length = reinterpret_cast< header* >( mem )->length;
+   munmap( mem, header_length );
+   mem = mmap( nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+   close( fd );
+   if( mem == MAP_FAILED )
+   {
+      fail( "Failed to map shared memory FIFO" );
+   }
+   head = reinterpret_cast< header* >( mem );
+   if( head->item_size != item_size || head->type_hash != type_hash )
+   {
+      unmap();
+      throw PortTypeMismatchException(
+         "shared memory edge \"" + path + "\" carries a different type" );
+   }
+   return( true );
+}
+
+bool
+shm_segment::claim()
+{
+   const auto other( dir == Direction::Producer ? Direction::Consumer :
+                                                  Direction::Producer );
+   std::int32_t expected( 0 );
+   bool stale( false );
+   if( ! head->pid[ dir ].compare_exchange_strong( expected, getpid() ) )
+   {
+      if( process_alive( expected ) )
+      {
+         unmap();
+         throw PortDoubleInitializeException(
+            "shared memory edge \"" + path + "\" is already attached at this end" );
+      }
+      stale = true;
+   }
+   /**
+    * a producer that finds a dead consumer would fill the buffer
+    * and block forever, a consumer that finds a dead producer is
+    * fine, it reads whatever was left and sees the end of stream.
+    */
+   if( dir == Direction::Producer &&
+       ! process_alive( head->pid[ other ].load( std::memory_order_acquire ) ) )
+   {
+      stale = true;
+   }
+   if( stale )
+   {
+      unmap();
+      shm_unlink( path.c_str() );
+      return( false );
+   }
+   /** second one in removes the name, mappings keep it alive **/
+   if( head->pid[ other ].load( std::memory_order_acquire ) != 0 )
+   {
+      shm_unlink( path.c_str() );
+   }
+   return( true );
+}
+
+void
+shm_segment::unmap() noexcept
+{
+   if( head != nullptr )
+   {
+      munmap( head, length );
+      head = nullptr;
+   }
+}
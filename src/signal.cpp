@@ -17,41 +17,27 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <new>
 #include "signal.hpp"
 
 using namespace Buffer;
 
-Signal::Signal()
+std::size_t
+SignalMap::bytes( const std::size_t max_cap ) noexcept
 {
-
-}
-
-Signal::Signal( const Signal &other )
-{
-   (this)->sig = other.sig;
-}
-
-Signal& 
-Signal::operator = ( raft::signal signal )
-{
-   (this)->sig = signal;
-   return( (*this) );
-}
-
-Signal& 
-Signal::operator = ( raft::signal &signal )
-{
-   (this)->sig = signal;
-   return( (*this) );
-}
-
-Signal::operator raft::signal ()
-{
-   return( (this)->sig );
+   return( sizeof( SignalMap ) +
+           ( ( max_cap + 63 ) >> 6 ) * sizeof( word_t ) +
+           max_cap * sizeof( raft::signal ) );
 }
 
-std::size_t 
-Signal::getindex() noexcept
+SignalMap*
+SignalMap::make( void * const mem, const std::size_t max_cap ) noexcept
 {
-   return( index );
+   auto * const map( new ( mem ) SignalMap( max_cap ) );
+   auto * const words( reinterpret_cast< word_t* >( map + 1 ) );
+   for( std::size_t i( 0 ); i < ( ( max_cap + 63 ) >> 6 ); i++ )
+   {
+      new ( &words[ i ] ) word_t( 0 );
+   }
+   return( map );
 }
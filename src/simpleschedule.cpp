@@ -23,12 +23,17 @@
 #include <map>
 #include <cmath>
 #include <chrono>
+#ifdef __linux
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 #include "kernel.hpp"
 #include "map.hpp"
 #include "simpleschedule.hpp"
 #include "rafttypes.hpp"
 #include "affinity.hpp"
+#include "cputopology.hpp"
 #ifdef USE_PARTITION
 #include "partition_scotch.hpp"
 #endif
@@ -48,6 +53,14 @@ simple_schedule::simple_schedule( raft::map &map ) : Schedule( map )
 {
 }
 
+simple_schedule::thread_data::thread_data( raft::kernel * const k,
+                                           bool *fin ) : k( k ),
+                                                         finished( fin )
+{
+   /** set before the thread starts, it pins itself from this **/
+   pin.core.store( k->getCoreAssignment() );
+}
+
 
 simple_schedule::~simple_schedule()
 {
@@ -70,11 +83,31 @@ simple_schedule::start()
    auto &container( kernel_set.acquire() );
    for( auto * const k : container )
    {  
+      /** runs on the thread of its chain's first stage **/
+      if( Schedule::fusedStage( k ) )
+      {
+         continue;
+      }
       auto * const th_info( new thread_info_t( k ) );
-      th_info->data.loc = k->getCoreAssignment();
       thread_map.emplace_back( th_info );
    }
    kernel_set.release();
+   /** only pinned kernels can be moved **/
+   if( repin_window.count() > 0 )
+   {
+      for( auto *t_info : thread_map )
+      {
+         if( t_info->data.pin.core.load() == -1 )
+         {
+            continue;
+         }
+         if( ! monitor )
+         {
+            monitor.reset( new repin_monitor( cpu_topology(), repin_window ) );
+         }
+         monitor->add( t_info->data.k, &t_info->data.pin );
+      }
+   }
    
    bool keep_going( true );
    while( keep_going )
@@ -108,6 +141,10 @@ simple_schedule::start()
       }
       //if we're here we have a lock and need to unlock
       thread_map_mutex.unlock();
+      if( monitor )
+      {
+         monitor->tick();
+      }
       /**
        * NOTE: added to keep from having to unlock these so frequently
        * might need to make the interval adjustable dep. on app
@@ -154,21 +191,37 @@ simple_schedule::simple_run( void * data )
                         &in, 
                         &out,
                         &peekset );
-   if( thread_d->loc != -1 )
-   {
-      /** call does nothing if not available **/
-      affinity::set( thread_d->loc );
-   }
-   else
-   {
 #ifdef USE_PARTITION
-       assert( false );
+   assert( thread_d->pin.core.load() != -1 );
 #endif
-   }
+#ifdef __linux
+   thread_d->pin.tid.store( syscall( SYS_gettid ), std::memory_order_release );
+#endif
+   core_id_t pinned( -1 );
+   std::size_t idle( 0 );
    while( ! *(thread_d->finished) )
    {
+      /** first time through, or the monitor moved us **/
+      const auto core( thread_d->pin.core.load( std::memory_order_relaxed ) );
+      if( R_UNLIKELY( core != pinned ) )
+      {
+         /** call does nothing if not available **/
+         affinity::set( core );
+         pinned = core;
+      }
       Schedule::kernelRun( thread_d->k, *(thread_d->finished) );
       //takes care of peekset clearing too
       Schedule::fifo_gc( &in, &out, &peekset );
+      /** starved, back off per the input FIFO's wait strategy **/
+      if( ! *(thread_d->finished) &&
+          Schedule::kernelIdleWait( thread_d->k, idle ) )
+      {
+         idle++;
+      }
+      else
+      {
+         idle = 0;
+      }
    }
+   thread_d->pin.tid.store( 0, std::memory_order_release );
 }
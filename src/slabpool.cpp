@@ -0,0 +1,221 @@
+/**
+ * slabpool.cpp -
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 22:31:05 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include "slabpool.hpp"
+
+using namespace Buffer;
+
+/**
+ * slot - sits right in front of every object, next is only used
+ * while the slot is free.
+ */
+struct slab_pool::slot
+{
+   slab_pool   *owner;
+   slot        *next;
+};
+
+namespace
+{
+
+/** slots in the first slab, each one after doubles **/
+constexpr std::size_t first_slab_slots( 8 );
+/** ...until a slab would be bigger than this **/
+constexpr std::size_t max_slab_bytes( 1 << 21 );
+
+std::size_t
+round_to( const std::size_t n, const std::size_t unit )
+{
+   return( ( n + unit - 1 ) / unit * unit );
+}
+
+std::size_t
+slot_align( const std::size_t object_align )
+{
+   const std::size_t line( L1D_CACHE_LINE_SIZE );
+   return( object_align > line ? object_align : line );
+}
+
+} /** end anonymous namespace **/
+
+slab_pool::slab_pool( const std::size_t object_size,
+                      const std::size_t object_align ) :
+   align( slot_align( object_align ) ),
+   header_bytes( round_to( sizeof( slot ), object_align ) ),
+   stride( round_to( header_bytes + object_size, align ) ),
+   next_slab( first_slab_slots )
+{
+}
+
+slab_pool::~slab_pool()
+{
+   for( const auto &s : slabs )
+   {
+      if( opts.custom() )
+      {
+         page_alloc::release( s.mem, s.length, opts );
+      }
+      else
+      {
+         free( s.mem );
+      }
+   }
+}
+
+slab_pool*
+slab_pool::make( const std::size_t object_size,
+                 const std::size_t object_align )
+{
+   return( new slab_pool( object_size, object_align ) );
+}
+
+void
+slab_pool::detach()
+{
+   /** whatever is on the local list goes with the pool **/
+   drop( 1 + local_count );
+}
+
+void
+slab_pool::set_options( const raft::mem::options &opts )
+{
+   /** slabs are freed the way they were made, so only before the first **/
+   if( slabs.empty() )
+   {
+      (this)->opts = opts;
+   }
+}
+
+void*
+slab_pool::allocate()
+{
+   if( local == nullptr )
+   {
+      refill();
+   }
+   auto * const s( local );
+   local = s->next;
+   local_count--;
+   return( s + 1 );
+}
+
+void
+slab_pool::release( void * const obj ) noexcept
+{
+   auto * const s( slot_of( obj ) );
+   auto * const pool( s->owner );
+   auto *head( pool->returned.load( std::memory_order_relaxed ) );
+   do
+   {
+      s->next = head;
+   }while( ! pool->returned.compare_exchange_weak( head,
+                                                   s,
+                                                   std::memory_order_release,
+                                                   std::memory_order_relaxed ) );
+   pool->drop( 1 );
+}
+
+slab_pool*
+slab_pool::owner( const void * const obj ) noexcept
+{
+   return( slot_of( obj )->owner );
+}
+
+slab_pool::slot*
+slab_pool::slot_of( const void * const obj ) noexcept
+{
+   assert( obj != nullptr );
+   /** the header ends where the object starts, whatever the pool **/
+   return( reinterpret_cast< slot* >(
+      const_cast< char* >( reinterpret_cast< const char* >( obj ) ) ) - 1 );
+}
+
+void
+slab_pool::refill()
+{
+   /** taken whole, so no ABA with the threads pushing onto it **/
+   auto * const taken( returned.exchange( nullptr, std::memory_order_acquire ) );
+   if( taken != nullptr )
+   {
+      /** the headers are needed again as soon as they're handed out **/
+      std::size_t n( 0 );
+      for( auto *s( taken ); s != nullptr; s = s->next )
+      {
+         n++;
+      }
+      local       = taken;
+      local_count = n;
+      refs.fetch_add( n, std::memory_order_relaxed );
+      return;
+   }
+   auto n( next_slab );
+   if( n * stride > max_slab_bytes )
+   {
+      n = max_slab_bytes / stride;
+      n = ( n == 0 ? 1 : n );
+   }
+   else
+   {
+      next_slab <<= 1;
+   }
+   const auto length( n * stride );
+   void *mem( nullptr );
+   if( opts.custom() )
+   {
+      mem = page_alloc::allocate( length, opts );
+   }
+   else
+   {
+      const auto ret_val( posix_memalign( &mem, align, length ) );
+      if( ret_val != 0 )
+      {
+         std::cerr << "posix_memalign returned error code (" << ret_val << ")";
+         std::cerr << " with message: \n" << strerror( ret_val ) << "\n";
+         exit( EXIT_FAILURE );
+      }
+   }
+   slabs.emplace_back( slab{ mem, length } );
+   /** thread the new slots, first one out first **/
+   for( std::size_t i( n ); i-- > 0; )
+   {
+      auto * const s( reinterpret_cast< slot* >(
+         reinterpret_cast< char* >( mem ) + i * stride + header_bytes ) - 1 );
+      s->owner = this;
+      s->next  = local;
+      local    = s;
+   }
+   local_count = n;
+   carved     += n;
+   refs.fetch_add( n, std::memory_order_relaxed );
+}
+
+void
+slab_pool::drop( const std::size_t n ) noexcept
+{
+   if( refs.fetch_sub( n, std::memory_order_acq_rel ) == n )
+   {
+      delete( this );
+   }
+}
@@ -0,0 +1,58 @@
+/**
+ * splitmethod.cpp -
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 02:06:44 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include "splitmethod.hpp"
+
+std::vector< FIFO* >&
+splitmethod::fifos( Port &port_list )
+{
+   /** ports are only ever added, so the count says if it's stale **/
+   if( fifo_cache.size() != port_list.count() )
+   {
+      /**
+       * the port map is in string order ("10" before "2"), put
+       * the ports in id order so index i is port i, methods that
+       * hash onto an index (keyhash) rely on that.
+       */
+      std::vector< std::pair< std::string, FIFO* > > named;
+      for( auto it( port_list.begin() ); it != port_list.end(); ++it )
+      {
+         named.emplace_back( it.name(), &(*it) );
+      }
+      std::sort( named.begin(), named.end(),
+                 []( const std::pair< std::string, FIFO* > &a,
+                     const std::pair< std::string, FIFO* > &b )
+      {
+         /** ids have no leading zeros, shorter is smaller **/
+         return( a.first.size() != b.first.size() ?
+                 a.first.size() < b.first.size() :
+                 a.first < b.first );
+      } );
+      fifo_cache.clear();
+      for( const auto &port : named )
+      {
+         fifo_cache.emplace_back( port.second );
+      }
+   }
+   return( fifo_cache );
+}
@@ -58,11 +58,15 @@ stdalloc::run()
                            a.start_index,
                            a.existing_buffer );
       }
+      else if( a.fixed_buffer_size != 0 )
+      {
+         fifo = Allocate::fixed_fifo( a )( a.fixed_buffer_size,
+                                           16 /** align **/,
+                                           nullptr /* data struct **/ );
+      }
       else
       {
-         /** check for pre-existing alloc size for test purposes **/
-         fifo = test_func( a.fixed_buffer_size != 0 ?
-                              a.fixed_buffer_size : 4 /** size **/,
+         fifo = test_func( 4 /** size **/,
                            16 /** align **/,
                            nullptr /* data struct **/);
       }
@@ -72,6 +76,7 @@ stdalloc::run()
    auto &container( (this)->source_kernels.acquire() );
    GraphTools::BFS( container, alloc_func );
    (this)->source_kernels.release();
+   (this)->allocate_shm();
    (this)->setReady();
    return;
 }
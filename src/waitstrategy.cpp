@@ -0,0 +1,120 @@
+/**
+ * waitstrategy.cpp -
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 13:05:44 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <climits>
+#include <chrono>
+#include <thread>
+#ifdef __linux
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ctime>
+#endif
+
+#include "waitstrategy.hpp"
+
+/**
+ * PARK_TIMEOUT_NS - upper bound on a single park, a wakeup
+ * can be missed with the adaptive strategy (and while the
+ * buffer is being resized) so never sleep much longer than
+ * the allocator's monitor interval.
+ */
+#define PARK_TIMEOUT_NS 1000000
+
+static thread_local WaitStrategy::block_hook_t block_hook = nullptr;
+static thread_local void                      *block_data = nullptr;
+
+void
+WaitStrategy::set_block_hook( block_hook_t hook, void * const data ) noexcept
+{
+   block_hook = hook;
+   block_data = data;
+}
+
+void
+WaitStrategy::notify_blocked() noexcept
+{
+   if( block_hook != nullptr )
+   {
+      block_hook( block_data );
+   }
+}
+
+void
+WaitStrategy::set_ready_bits( const ReadyBit &data,
+                              const ReadyBit &space,
+                              const ReadyBit &closed ) noexcept
+{
+   consumer.ready = data;
+   producer.ready = space;
+   (this)->closed = closed;
+}
+
+void
+WaitStrategy::set( const raft::wait::strategy s ) noexcept
+{
+   mode = ( s == raft::wait::use_default ? raft::wait::adaptive : s );
+}
+
+raft::wait::strategy
+WaitStrategy::get() const noexcept
+{
+   return( mode );
+}
+
+void
+WaitStrategy::futex_wait( std::atomic< std::uint32_t > &word,
+                          const std::uint32_t expected ) noexcept
+{
+#ifdef __linux
+   static_assert( sizeof( std::atomic< std::uint32_t > ) == sizeof( int ),
+                  "futex word must be the size of an int" );
+   struct timespec timeout = { 0, PARK_TIMEOUT_NS };
+   /** EAGAIN, EINTR and ETIMEDOUT are all fine, caller re-checks **/
+   syscall( SYS_futex,
+            reinterpret_cast< int* >( &word ),
+            FUTEX_WAIT_PRIVATE,
+            static_cast< int >( expected ),
+            &timeout,
+            nullptr,
+            0 );
+#else
+   if( word.load( std::memory_order_acquire ) == expected )
+   {
+      std::this_thread::sleep_for(
+         std::chrono::nanoseconds( PARK_TIMEOUT_NS / 10 ) );
+   }
+#endif
+}
+
+void
+WaitStrategy::futex_wake( std::atomic< std::uint32_t > &word ) noexcept
+{
+#ifdef __linux
+   syscall( SYS_futex,
+            reinterpret_cast< int* >( &word ),
+            FUTEX_WAKE_PRIVATE,
+            INT_MAX,
+            nullptr,
+            nullptr,
+            0 );
+#else
+   (void) word;
+#endif
+}
@@ -0,0 +1,352 @@
+/**
+ * workstealschedule.cpp -
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 14:10:27 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+
+#include "kernel.hpp"
+#include "map.hpp"
+#include "workstealschedule.hpp"
+#include "waitstrategy.hpp"
+#include "defs.hpp"
+
+constexpr std::size_t work_steal_schedule::max_spares;
+
+work_steal_schedule::work_steal_schedule( raft::map &map,
+                                          const std::size_t n_workers ) :
+   Schedule( map ),
+   n_workers( n_workers != 0 ? n_workers :
+              ( std::thread::hardware_concurrency() != 0 ?
+                std::thread::hardware_concurrency() : 1 ) )
+{
+}
+
+work_steal_schedule::~work_steal_schedule()
+{
+   /** workers are joined by start(), tasks/workers freed by unique_ptr **/
+}
+
+void
+work_steal_schedule::start()
+{
+   {
+      std::lock_guard< std::mutex > guard( spawn_mutex );
+      auto &container( kernel_set.acquire() );
+      for( auto * const k : container )
+      {
+         /** runs as part of its chain's first stage **/
+         if( Schedule::fusedStage( k ) )
+         {
+            continue;
+         }
+         tasks.emplace_back( new task( k ) );
+      }
+      kernel_set.release();
+      const auto n_slots( n_workers + max_spares );
+      for( std::size_t i( 0 ); i < n_slots; i++ )
+      {
+         workers.emplace_back( new worker( this, i ) );
+      }
+      remaining = tasks.size();
+      for( std::size_t i( 0 ); i < tasks.size(); i++ )
+      {
+         auto * const t( tasks[ i ].get() );
+         Schedule::setPtrSets( t->k, &t->in, &t->out, &t->peekset );
+         /** keep the partitioner's grouping if there is one **/
+         const auto core( t->k->getCoreAssignment() );
+         const auto index( core >= 0 ? static_cast< std::size_t >( core ) % n_workers
+                                     : i % n_workers );
+         workers[ index ]->q.emplace_back( t );
+      }
+      for( std::size_t i( 0 ); i < n_workers; i++ )
+      {
+         start_worker();
+      }
+   }
+   {
+      /** once stopped nothing starts or restarts a worker **/
+      std::unique_lock< std::mutex > lock( spawn_mutex );
+      all_done.wait( lock, [&](){ return( n_running == 0 ); } );
+      stopped = true;
+   }
+   for( std::size_t i( 0 ); i < n_started.load( std::memory_order_acquire ); i++ )
+   {
+      workers[ i ]->th.join();
+   }
+   return;
+}
+
+void
+work_steal_schedule::handleSchedule( raft::kernel * const kernel )
+{
+   std::lock_guard< std::mutex > guard( spawn_mutex );
+   if( workers.size() == 0 || stopped )
+   {
+      /** not started yet, start() picks it up from kernel_set **/
+      return;
+   }
+   auto * const t( new task( kernel ) );
+   Schedule::setPtrSets( kernel, &t->in, &t->out, &t->peekset );
+   {
+      std::lock_guard< std::mutex > task_guard( task_mutex );
+      tasks.emplace_back( t );
+   }
+   remaining++;
+   if( n_running == 0 )
+   {
+      /**
+       * every worker saw nothing left and has left worker_run, or
+       * is about to, start() can't be joining them till stopped
+       */
+      auto &w( *workers[ 0 ] );
+      w.th.join();
+      {
+         std::lock_guard< std::mutex > q_guard( w.lock );
+         w.q.emplace_back( t );
+      }
+      n_running++;
+      w.th = std::thread( worker_run, &w );
+      return;
+   }
+   auto &w( *workers[ next_queue++ % n_started.load() ] );
+   std::lock_guard< std::mutex > q_guard( w.lock );
+   w.q.emplace_back( t );
+}
+
+void
+work_steal_schedule::start_worker()
+{
+   const auto index( n_started.load( std::memory_order_relaxed ) );
+   if( index == workers.size() )
+   {
+      return;
+   }
+   auto &w( *workers[ index ] );
+   n_running++;
+   w.th = std::thread( worker_run, &w );
+   n_started.store( index + 1, std::memory_order_release );
+}
+
+bool
+work_steal_schedule::spares_used() const
+{
+   return( n_started.load( std::memory_order_acquire ) == workers.size() );
+}
+
+bool
+work_steal_schedule::keep_running()
+{
+   if( remaining.load( std::memory_order_acquire ) > 0 )
+   {
+      return( true );
+   }
+   std::lock_guard< std::mutex > guard( spawn_mutex );
+   if( remaining.load( std::memory_order_acquire ) > 0 )
+   {
+      return( true );
+   }
+   if( --n_running == 0 )
+   {
+      all_done.notify_all();
+   }
+   return( false );
+}
+
+void
+work_steal_schedule::worker_blocked( void * const data )
+{
+   auto * const w( reinterpret_cast< worker* >( data ) );
+   if( w->blocked )
+   {
+      /** already counted for this kernel firing **/
+      return;
+   }
+   w->blocked = true;
+   auto * const sched( w->sched );
+   const auto blocked( ++sched->n_blocked );
+   std::deque< task* > handoff;
+   {
+      std::lock_guard< std::mutex > guard( w->lock );
+      handoff.swap( w->q );
+   }
+   std::lock_guard< std::mutex > guard( sched->spawn_mutex );
+   auto n( sched->n_started.load() );
+   /**
+    * hand our deque to the spare if we start one, otherwise to
+    * the next worker, either way nothing waits on us to unblock.
+    */
+   auto *target( sched->workers[ ( w->index + 1 ) % n ].get() );
+   if( n - blocked < sched->n_workers && n < sched->workers.size() )
+   {
+      target = sched->workers[ n ].get();
+      {
+         std::lock_guard< std::mutex > q_guard( target->lock );
+         target->q.insert( target->q.end(), handoff.begin(), handoff.end() );
+      }
+      sched->start_worker();
+      return;
+   }
+   std::lock_guard< std::mutex > q_guard( target->lock );
+   target->q.insert( target->q.end(), handoff.begin(), handoff.end() );
+}
+
+work_steal_schedule::task*
+work_steal_schedule::next_task( worker * const w )
+{
+   {
+      std::lock_guard< std::mutex > guard( w->lock );
+      if( ! w->q.empty() )
+      {
+         auto * const t( w->q.front() );
+         w->q.pop_front();
+         return( t );
+      }
+   }
+   if( steal( w ) )
+   {
+      std::lock_guard< std::mutex > guard( w->lock );
+      if( ! w->q.empty() )
+      {
+         auto * const t( w->q.front() );
+         w->q.pop_front();
+         return( t );
+      }
+   }
+   return( nullptr );
+}
+
+bool
+work_steal_schedule::steal( worker * const w )
+{
+   std::vector< task* > stolen;
+   const auto n( n_started.load( std::memory_order_acquire ) );
+   for( std::size_t i( 1 ); i < n && stolen.empty(); i++ )
+   {
+      auto &victim( *workers[ ( w->index + i ) % n ] );
+      std::unique_lock< std::mutex > lock( victim.lock, std::try_to_lock );
+      if( ! lock.owns_lock() )
+      {
+         continue;
+      }
+      /** owner takes from the front, steal half from the back **/
+      for( auto count( ( victim.q.size() + 1 ) / 2 ); count > 0; count-- )
+      {
+         stolen.emplace_back( victim.q.back() );
+         victim.q.pop_back();
+      }
+   }
+   if( stolen.empty() )
+   {
+      return( false );
+   }
+   /** never hold two deque locks at once **/
+   std::lock_guard< std::mutex > guard( w->lock );
+   w->q.insert( w->q.end(), stolen.begin(), stolen.end() );
+   return( true );
+}
+
+void
+work_steal_schedule::worker_run( worker * const w )
+{
+   auto * const sched( w->sched );
+   WaitStrategy::set_block_hook( work_steal_schedule::worker_blocked, w );
+   /** tasks looked at without running one, and full idle passes **/
+   std::size_t misses( 0 );
+   std::size_t idle( 0 );
+   while( sched->keep_running() )
+   {
+      auto * const t( sched->next_task( w ) );
+      bool ran( false );
+      if( t != nullptr )
+      {
+         /**
+          * only fire kernels that can make progress without
+          * blocking the worker, kernels without data still go
+          * through kernelRun so that closed inputs finish them.
+          * The readiness bits can be missed, once we've gone a
+          * full pass without progress check the ports themselves.
+          * A space bit only clears once a push finds the FIFO
+          * full, so with every spare in use check them too, a
+          * kernel that blocks now has nobody to cover for it.
+          */
+         const bool exact( idle > 0 || sched->spares_used() );
+         const bool has_data( exact ?
+                                 Schedule::kernelPollInputData( t->k ) :
+                                 Schedule::kernelHasInputData( t->k ) );
+         const bool has_space( exact ?
+                                 Schedule::kernelPollOutputSpace( t->k ) :
+                                 Schedule::kernelHasOutputSpace( t->k ) );
+         if( ! has_data || has_space )
+         {
+            Schedule::kernelRun( t->k, t->finished );
+            Schedule::fifo_gc( &t->in, &t->out, &t->peekset );
+            ran = has_data;
+         }
+         if( w->blocked )
+         {
+            w->blocked = false;
+            sched->n_blocked--;
+         }
+         if( t->finished )
+         {
+            sched->remaining--;
+         }
+         else
+         {
+            std::lock_guard< std::mutex > guard( w->lock );
+            w->q.emplace_back( t );
+         }
+      }
+      if( ran )
+      {
+         misses = 0;
+         idle   = 0;
+         continue;
+      }
+      /** back off once per pass over our deque with no progress **/
+      std::size_t q_size( 0 );
+      {
+         std::lock_guard< std::mutex > guard( w->lock );
+         q_size = w->q.size();
+      }
+      if( ++misses <= q_size )
+      {
+         continue;
+      }
+      misses = 0;
+      /** nothing ready here, take half of someone else's deque **/
+      if( sched->steal( w ) )
+      {
+         continue;
+      }
+      if( idle < 64 )
+      {
+         WaitStrategy::relax();
+      }
+      else if( idle < 1024 )
+      {
+         std::this_thread::yield();
+      }
+      else
+      {
+         std::this_thread::sleep_for( std::chrono::microseconds( 100 ) );
+      }
+      idle++;
+   }
+   WaitStrategy::set_block_hook( nullptr, nullptr );
+}
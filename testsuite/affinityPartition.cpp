@@ -0,0 +1,257 @@
+/**
+ * affinityPartition.cpp - builds a made up sysfs tree with two last
+ * level caches of four cores each (two SMT threads per core) and
+ * checks the topology read from it, then places two pipelines on it.
+ * Each pipeline has to land within one LLC, the two in different
+ * ones, and only the allowed cores may be used even when there are
+ * more kernels than cores.  Last, the real machine: every kernel has
+ * to end up on a core the process is allowed to run on.
+ *
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 00:21:09 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <raft>
+
+class stage : public raft::kernel
+{
+public:
+    stage( const bool in, const bool out ) : raft::kernel()
+    {
+        if( in )
+        {
+            input.addPort< std::int64_t >( "0" );
+        }
+        if( out )
+        {
+            output.addPort< std::int64_t >( "0" );
+        }
+    }
+
+    virtual raft::kstatus run()
+    {
+        return( raft::stop );
+    }
+};
+
+using pipeline_t = std::vector< std::unique_ptr< stage > >;
+
+static void
+build( pipeline_t &p, const std::size_t length, raft::map &M )
+{
+    for( std::size_t i( 0 ); i < length; i++ )
+    {
+        p.emplace_back( new stage( i != 0, i + 1 != length ) );
+    }
+    for( std::size_t i( 0 ); i + 1 < length; i++ )
+    {
+        M += *p[ i ] >> *p[ i + 1 ];
+    }
+}
+
+static void
+write_file( const std::string &path, const std::string &contents )
+{
+    std::ofstream out( path );
+    out << contents << "\n";
+}
+
+/** cpu i is thread i % 2 of core i / 2, cpus 0-3 and 4-7 share an L3 **/
+static std::string
+make_sysfs()
+{
+    char dir_template[] = "/tmp/raftsysfsXXXXXX";
+    if( mkdtemp( dir_template ) == nullptr )
+    {
+        return( "" );
+    }
+    const std::string root( dir_template );
+    for( int i( 0 ); i < 8; i++ )
+    {
+        const auto cpu( root + "/cpu" + std::to_string( i ) );
+        mkdir( cpu.c_str(), 0755 );
+        mkdir( ( cpu + "/node" + std::to_string( i / 4 ) ).c_str(), 0755 );
+        mkdir( ( cpu + "/topology" ).c_str(), 0755 );
+        write_file( cpu + "/topology/physical_package_id", "0" );
+        write_file( cpu + "/topology/core_id", std::to_string( i / 2 ) );
+        mkdir( ( cpu + "/cache" ).c_str(), 0755 );
+        const std::string l3( i < 4 ? "0-3" : "4-7" );
+        const struct { const char *level, *type; std::string shared; } caches[] = {
+            { "1", "Data",        std::to_string( i / 2 * 2 ) + "-" +
+                                  std::to_string( i / 2 * 2 + 1 ) },
+            { "1", "Instruction", "0-7" },
+            { "3", "Unified",     l3 } };
+        int index( 0 );
+        for( const auto &c : caches )
+        {
+            const auto dir( cpu + "/cache/index" + std::to_string( index++ ) );
+            mkdir( dir.c_str(), 0755 );
+            write_file( dir + "/level", c.level );
+            write_file( dir + "/type", c.type );
+            write_file( dir + "/shared_cpu_list", c.shared );
+        }
+    }
+    return( root );
+}
+
+static void
+remove_sysfs( const std::string &root )
+{
+    const std::string cmd( "rm -rf " + root );
+    if( system( cmd.c_str() ) != 0 )
+    {
+        std::cerr << "couldn't remove " << root << "\n";
+    }
+}
+
+static bool
+check_topology( const std::string &root )
+{
+    const cpu_topology t( root, { 0, 1, 2, 3, 4, 5, 6, 7 } );
+    const auto &cpus( t.cpus() );
+    if( cpus.size() != 8 || t.llc_count() != 2 )
+    {
+        std::cerr << "expected 8 cpus in 2 LLCs, got " << cpus.size() <<
+            " in " << t.llc_count() << "\n";
+        return( false );
+    }
+    /** one thread per core first, then the siblings **/
+    const core_id_t expected[] = { 0, 2, 1, 3, 4, 6, 5, 7 };
+    for( std::size_t i( 0 ); i < 8; i++ )
+    {
+        if( cpus[ i ].id != expected[ i ] ||
+            cpus[ i ].llc != ( expected[ i ] < 4 ? 0 : 1 ) ||
+            cpus[ i ].node != ( expected[ i ] < 4 ? 0 : 1 ) )
+        {
+            std::cerr << "cpu " << i << " in the wrong order or place\n";
+            return( false );
+        }
+    }
+    return( true );
+}
+
+static bool
+check_pipelines( const std::string &root )
+{
+    raft::map M;
+    pipeline_t a, b;
+    build( a, 4, M );
+    build( b, 4, M );
+    kernelkeeper keeper;
+    for( auto &k : a ) keeper += k.get();
+    for( auto &k : b ) keeper += k.get();
+    partition_affinity pt;
+    pt.place( keeper, cpu_topology( root, { 0, 1, 2, 3, 4, 5, 6, 7 } ) );
+    std::set< core_id_t > used;
+    std::set< bool >      a_llc, b_llc;
+    for( auto &k : a )
+    {
+        used.insert( k->getCoreAssignment() );
+        a_llc.insert( k->getCoreAssignment() < 4 );
+    }
+    for( auto &k : b )
+    {
+        used.insert( k->getCoreAssignment() );
+        b_llc.insert( k->getCoreAssignment() < 4 );
+    }
+    if( used.size() != 8 || a_llc.size() != 1 || b_llc.size() != 1 ||
+        *a_llc.begin() == *b_llc.begin() )
+    {
+        std::cerr << "pipelines weren't kept within an LLC each\n";
+        return( false );
+    }
+    return( true );
+}
+
+static bool
+check_allowed( const std::string &root )
+{
+    raft::map M;
+    pipeline_t a;
+    build( a, 12, M );
+    kernelkeeper keeper;
+    for( auto &k : a ) keeper += k.get();
+    const std::set< core_id_t > allowed = { 1, 2, 5, 7 };
+    partition_affinity pt;
+    pt.place( keeper, cpu_topology( root, { 1, 2, 5, 7 } ) );
+    std::map< core_id_t, int > count;
+    for( auto &k : a )
+    {
+        count[ k->getCoreAssignment() ]++;
+    }
+    for( const auto &c : count )
+    {
+        if( allowed.count( c.first ) == 0 || c.second > 3 )
+        {
+            std::cerr << "core " << c.first << " given " << c.second <<
+                " kernels\n";
+            return( false );
+        }
+    }
+    return( true );
+}
+
+static bool
+check_machine()
+{
+    raft::map M;
+    pipeline_t a;
+    build( a, 5, M );
+    kernelkeeper keeper;
+    for( auto &k : a ) keeper += k.get();
+    partition_affinity pt;
+    pt.partition( keeper );
+    const auto allowed( cpu_topology::allowed_cpus() );
+    for( auto &k : a )
+    {
+        if( std::find( allowed.begin(), allowed.end(),
+                       k->getCoreAssignment() ) == allowed.end() )
+        {
+            std::cerr << "kernel put on core " << k->getCoreAssignment() <<
+                " outside the affinity mask\n";
+            return( false );
+        }
+    }
+    return( true );
+}
+
+int
+main()
+{
+    const auto root( make_sysfs() );
+    if( root.empty() )
+    {
+        std::cerr << "couldn't make the sysfs tree\n";
+        return( EXIT_FAILURE );
+    }
+    const bool ok( check_topology( root ) &&
+                   check_pipelines( root ) &&
+                   check_allowed( root ) &&
+                   check_machine() );
+    remove_sysfs( root );
+    return( ok ? EXIT_SUCCESS : EXIT_FAILURE );
+}
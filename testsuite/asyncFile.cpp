@@ -0,0 +1,103 @@
+/**
+ * asyncFile.cpp - copies the test text with an async_reader and an
+ * async_writer, once on whatever backend is on offer and once on the
+ * thread pool, and checks the copy byte for byte.  Then searches
+ * the text through an async_reader with overlapping chunks, every
+ * match has to turn up.
+ *
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 04:14:52 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <raft>
+#include <raftio>
+#include <raftalgorithm>
+
+/** pwd is root for cmake's test script **/
+static const std::string path( "./testsuite/alice.txt" );
+static const std::string copy( "./asyncFile.out" );
+
+using chunk_t = raft::filechunk< 4096 >;
+
+static std::string
+slurp( const std::string &name )
+{
+    std::ifstream in( name );
+    return( std::string( ( std::istreambuf_iterator< char >( in ) ),
+                           std::istreambuf_iterator< char >() ) );
+}
+
+static bool
+copies( const raft::aio::backend b, const std::string &file )
+{
+    {
+        raft::async_reader< chunk_t > read( path, 0, 4, b );
+        raft::async_writer< chunk_t > write( copy, 4, b );
+        if( b == raft::aio::pool &&
+            ( read.backend() != raft::aio::pool || write.backend() != raft::aio::pool ) )
+        {
+            std::cerr << "asked for the thread pool and didn't get it\n";
+            return( false );
+        }
+        raft::map m;
+        m += read >> write;
+        m.exe();
+    }
+    const auto text( slurp( copy ) );
+    std::remove( copy.c_str() );
+    if( text != file )
+    {
+        std::cerr << "copy has " << text.size() << " bytes, file has " <<
+            file.size() << "\n";
+        return( false );
+    }
+    return( true );
+}
+
+int
+main()
+{
+    const auto file( slurp( path ) );
+    if( ! copies( raft::aio::use_default, file ) ||
+        ! copies( raft::aio::pool, file ) )
+    {
+        return( EXIT_FAILURE );
+    }
+
+    const std::string term( "Alice" );
+    std::vector< raft::match_t > matches;
+    raft::async_reader< raft::filechunk< 512 > > read( path,
+                                                       static_cast< long >( term.length() ) );
+    raft::search< raft::filechunk< 512 >, raft::stdlib > find( term );
+    auto we( raft::write_each< raft::match_t >(
+            std::back_inserter( matches ) ) );
+    raft::map m;
+    m += read >> find >> we;
+    m.exe();
+    if( matches.size() != 174 /** count from grep **/ )
+    {
+        std::cerr << "found " << matches.size() << " matches, expected 174\n";
+        return( EXIT_FAILURE );
+    }
+    return( EXIT_SUCCESS );
+}
@@ -0,0 +1,175 @@
+/**
+ * autoParallel.cpp - a slow kernel between a bursty source and a
+ * sink, linked out of order both ways.  The burst backs up the
+ * slow kernel's input so the run-time has to add copies of it,
+ * the quiet spell after has to retire them again, and through it
+ * all every item has to reach the sink exactly once.
+ *
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 01:38:27 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <raft>
+
+using type_t = std::int64_t;
+
+static constexpr type_t burst_items = 40000;
+static constexpr type_t tail_items  = 1000;
+
+class burst : public raft::kernel
+{
+public:
+    burst() : raft::kernel()
+    {
+        output.addPort< type_t >( "0" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        if( next == burst_items && ! rested )
+        {
+            /** long enough to retire whatever was added **/
+            std::this_thread::sleep_for( std::chrono::milliseconds( 3000 ) );
+            rested = true;
+        }
+        output[ "0" ].push( next++ );
+        return( next == burst_items + tail_items ? raft::stop : raft::proceed );
+    }
+
+private:
+    type_t next   = 0;
+    bool   rested = false;
+};
+
+class slow : public raft::kernel
+{
+public:
+    slow() : raft::kernel()
+    {
+        input.addPort< type_t >( "0" );
+        output.addPort< type_t >( "0" );
+    }
+
+    slow( const slow &other ) : slow()
+    {
+        UNUSED( other );
+    }
+
+    virtual raft::kstatus run()
+    {
+        type_t item;
+        input[ "0" ].pop( item );
+        const auto end( std::chrono::steady_clock::now() +
+                        std::chrono::microseconds( 20 ) );
+        while( std::chrono::steady_clock::now() < end );
+        output[ "0" ].push( item );
+        return( raft::proceed );
+    }
+
+    CLONE();
+};
+
+class sum : public raft::kernel
+{
+public:
+    sum( type_t &total, type_t &count ) : raft::kernel(),
+                                          total( total ),
+                                          count( count )
+    {
+        input.addPort< type_t >( "0" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        type_t item;
+        input[ "0" ].pop( item );
+        total += item;
+        count++;
+        return( raft::proceed );
+    }
+
+private:
+    type_t &total;
+    type_t &count;
+};
+
+/** counts what the monitor did **/
+class counting_parallel : public basic_parallel
+{
+public:
+    counting_parallel( raft::map &map,
+                       Allocate &alloc,
+                       Schedule &sched,
+                       volatile bool &exit_para ) :
+        basic_parallel( map, alloc, sched, exit_para )
+    {
+    }
+
+    static std::atomic< int > added;
+    static std::atomic< int > retired;
+
+protected:
+    virtual bool replicate( group &g )
+    {
+        const bool ok( basic_parallel::replicate( g ) );
+        added += ( ok ? 1 : 0 );
+        return( ok );
+    }
+
+    virtual bool retire( group &g )
+    {
+        const bool ok( basic_parallel::retire( g ) );
+        retired += ( ok ? 1 : 0 );
+        return( ok );
+    }
+};
+
+std::atomic< int > counting_parallel::added( 0 );
+std::atomic< int > counting_parallel::retired( 0 );
+
+int
+main()
+{
+    type_t total( 0 ), count( 0 );
+    burst b;
+    slow  s;
+    sum   t( total, count );
+    raft::map m;
+    m += b >> raft::order::out >> s >> raft::order::out >> t;
+    m.setMaxReplicas( 3 );
+    m.exe< partition_dummy, simple_schedule, dynalloc, counting_parallel >();
+
+    const type_t n( burst_items + tail_items );
+    if( count != n || total != n * ( n - 1 ) / 2 )
+    {
+        std::cerr << "got " << count << " items summing to " << total <<
+            ", expected " << n << " summing to " << n * ( n - 1 ) / 2 << "\n";
+        return( EXIT_FAILURE );
+    }
+    if( counting_parallel::added == 0 || counting_parallel::retired == 0 )
+    {
+        std::cerr << "added " << counting_parallel::added << " copies, retired " <<
+            counting_parallel::retired << "\n";
+        return( EXIT_FAILURE );
+    }
+    return( EXIT_SUCCESS );
+}
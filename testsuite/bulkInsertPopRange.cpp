@@ -0,0 +1,146 @@
+/**
+ * bulkInsertPopRange.cpp - push ranges with insert and read
+ * them back with pop_range and peek_range/recycle so that the
+ * bulk copies wrap around the end of both the resizeable heap
+ * and the fixed size single producer/consumer heap.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 11:40:52 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <utility>
+#include <vector>
+#include <raft>
+
+using type_t = std::int64_t;
+
+/** multiple of both the insert and pop sizes **/
+static const type_t total( 100 * 37 * 4 );
+
+class producer : public raft::kernel
+{
+public:
+    producer() : raft::kernel()
+    {
+        output.addPort< type_t >( "a", "b" );
+    }
+
+    virtual ~producer() = default;
+
+    virtual raft::kstatus run()
+    {
+        std::vector< type_t > batch;
+        for( type_t i( 0 ); i < 100; i++ )
+        {
+            batch.emplace_back( counter++ );
+        }
+        output[ "a" ].insert( batch.begin(), batch.end() );
+        output[ "b" ].insert( batch.begin(), batch.end() );
+        if( counter == total )
+        {
+            return( raft::stop );
+        }
+        return( raft::proceed );
+    }
+
+private:
+    type_t counter = 0;
+};
+
+static void check( const type_t val, const type_t expected )
+{
+    if( val != expected )
+    {
+        std::cerr << "received " << val << ", expected "
+                  << expected << ", exiting!!\n";
+        exit( EXIT_FAILURE );
+    }
+}
+
+class poprange : public raft::kernel
+{
+public:
+    poprange() : raft::kernel()
+    {
+        input.addPort< type_t >( "in" );
+    }
+
+    virtual ~poprange() = default;
+
+    virtual raft::kstatus run()
+    {
+        std::vector< std::pair< type_t, raft::signal > > items( 37 );
+        input[ "in" ].pop_range< type_t >( items, 37 );
+        for( const auto &pair : items )
+        {
+            check( pair.first, count++ );
+        }
+        return( raft::proceed );
+    }
+
+    type_t count = 0;
+};
+
+class peekrecycle : public raft::kernel
+{
+public:
+    peekrecycle() : raft::kernel()
+    {
+        input.addPort< type_t >( "in" );
+    }
+
+    virtual ~peekrecycle() = default;
+
+    virtual raft::kstatus run()
+    {
+        {
+            auto range( input[ "in" ].peek_range< type_t >( 4 ) );
+            for( std::size_t i( 0 ); i < range.size(); i++ )
+            {
+                check( range[ i ].ele, count + i );
+            }
+        }
+        input[ "in" ].recycle( 4 );
+        count += 4;
+        return( raft::proceed );
+    }
+
+    type_t count = 0;
+};
+
+int
+main()
+{
+    producer    p;
+    poprange    a;
+    peekrecycle b;
+
+    raft::map M;
+    M.link( &p, "a", &a );
+    M.link( &p, "b", &b, 10 );
+    M.exe();
+    if( a.count != total || b.count != total )
+    {
+        std::cerr << "received " << a.count << " and " << b.count
+                  << " items, expected " << total << "\n";
+        return( EXIT_FAILURE );
+    }
+    return( EXIT_SUCCESS );
+}
@@ -0,0 +1,202 @@
+/**
+ * extPool.cpp - 4 KB records, too big to go inline, through
+ * producer >> forwarder >> consumer.  The producer mixes push and
+ * allocate/send, the forwarder pushes what it peeked so the record
+ * moves on without a copy, the consumer mixes pop and peek/recycle.
+ * Every record has to arrive intact and in order, every one made
+ * has to be destroyed, and the slots have to be reused rather than
+ * a new one per record.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 22:31:05 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <set>
+#include <raft>
+
+static std::atomic< std::int64_t > live( 0 );
+
+struct record
+{
+    record( const std::int64_t seq = -1 ) : seq( seq )
+    {
+        for( auto &val : payload )
+        {
+            val = seq;
+        }
+        live++;
+    }
+
+    record( const record &other ) : seq( other.seq )
+    {
+        for( std::size_t i( 0 ); i < n_vals; i++ )
+        {
+            payload[ i ] = other.payload[ i ];
+        }
+        live++;
+    }
+
+    record& operator = ( const record &other ) = default;
+
+    ~record()
+    {
+        live--;
+    }
+
+    bool intact( const std::int64_t expected ) const
+    {
+        for( const auto val : payload )
+        {
+            if( val != expected )
+            {
+                return( false );
+            }
+        }
+        return( seq == expected );
+    }
+
+    static const std::size_t n_vals = 4096 / sizeof( std::int64_t ) - 1;
+
+    std::int64_t seq;
+    std::int64_t payload[ n_vals ];
+};
+
+static const std::int64_t n_items( 100000 );
+
+class producer : public raft::kernel
+{
+public:
+    producer() : raft::kernel()
+    {
+        output.addPort< record >( "0" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        auto &port( output[ "0" ] );
+        if( counter % 2 == 0 )
+        {
+            port.push( record( counter ) );
+        }
+        else
+        {
+            port.allocate< record >( counter );
+            port.send();
+        }
+        if( ++counter == n_items )
+        {
+            return( raft::stop );
+        }
+        return( raft::proceed );
+    }
+
+private:
+    std::int64_t counter = 0;
+};
+
+class forwarder : public raft::kernel
+{
+public:
+    forwarder() : raft::kernel()
+    {
+        input.addPort< record >( "0" );
+        output.addPort< record >( "0" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        auto &rec( input[ "0" ].peek< record >() );
+        output[ "0" ].push( rec );
+        input[ "0" ].recycle();
+        return( raft::proceed );
+    }
+};
+
+class consumer : public raft::kernel
+{
+public:
+    consumer() : raft::kernel()
+    {
+        input.addPort< record >( "0" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        auto &port( input[ "0" ] );
+        bool ok( false );
+        if( count % 2 == 0 )
+        {
+            record rec;
+            port.pop( rec );
+            ok = rec.intact( count );
+        }
+        else
+        {
+            auto &rec( port.peek< record >() );
+            ok = rec.intact( count );
+            seen.insert( reinterpret_cast< std::uintptr_t >( &rec ) );
+            port.recycle();
+        }
+        if( ! ok )
+        {
+            std::cerr << "record " << count << " damaged, exiting!!\n";
+            exit( EXIT_FAILURE );
+        }
+        count++;
+        return( raft::proceed );
+    }
+
+    std::int64_t               count = 0;
+    /** slots handed to peek, should be few **/
+    std::set< std::uintptr_t > seen;
+};
+
+int
+main()
+{
+    {
+        producer  p;
+        forwarder f;
+        consumer  c;
+        raft::map M;
+        M += p >> f >> c;
+        M.exe();
+        if( c.count != n_items )
+        {
+            std::cerr << "consumer got " << c.count << " of " << n_items << "\n";
+            return( EXIT_FAILURE );
+        }
+        /**
+         * half the records were peeked, the slots in use at once
+         * are bounded by what the FIFOs hold, which may have grown
+         */
+        if( c.seen.size() > n_items / 8 )
+        {
+            std::cerr << c.seen.size() << " distinct slots, not being reused\n";
+            return( EXIT_FAILURE );
+        }
+    }
+    if( live != 0 )
+    {
+        std::cerr << live << " records never destroyed\n";
+        return( EXIT_FAILURE );
+    }
+    return( EXIT_SUCCESS );
+}
@@ -0,0 +1,127 @@
+/**
+ * fileWriter.cpp - writes a stream of numbers through a filewriter
+ * and reads them back.  Then has four pread_reader copies, each
+ * with a run of the test text, feed an ordered filewriter through
+ * a buffer smaller than three chunks, the file written has to be
+ * the test text again.
+ *
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 04:43:36 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <raft>
+#include <raftio>
+
+/** pwd is root for cmake's test script **/
+static const std::string path( "./testsuite/alice.txt" );
+static const std::string out( "./fileWriter.out" );
+
+using type_t  = std::int64_t;
+using chunk_t = raft::filechunk< 4096 >;
+
+static constexpr type_t      count = 100000;
+static constexpr std::size_t ports = 4;
+
+class numbers : public raft::kernel
+{
+public:
+    numbers() : raft::kernel()
+    {
+        output.addPort< type_t >( "0" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        output[ "0" ].push( next++ );
+        return( next == count ? raft::stop : raft::proceed );
+    }
+
+private:
+    type_t next = 0;
+};
+
+static std::string
+slurp( const std::string &name )
+{
+    std::ifstream in( name, std::ios::binary );
+    return( std::string( ( std::istreambuf_iterator< char >( in ) ),
+                           std::istreambuf_iterator< char >() ) );
+}
+
+static bool
+items()
+{
+    {
+        numbers src;
+        raft::filewriter< type_t > write( out );
+        raft::map m;
+        m += src >> write;
+        m.exe();
+    }
+    const auto text( slurp( out ) );
+    std::remove( out.c_str() );
+    if( text.size() != count * sizeof( type_t ) )
+    {
+        std::cerr << "wrote " << text.size() << " bytes, expected " <<
+            count * sizeof( type_t ) << "\n";
+        return( false );
+    }
+    const auto * const n( reinterpret_cast< const type_t* >( text.data() ) );
+    for( type_t i( 0 ); i < count; i++ )
+    {
+        if( n[ i ] != i )
+        {
+            std::cerr << "item " << i << " is " << n[ i ] << "\n";
+            return( false );
+        }
+    }
+    return( true );
+}
+
+static bool
+ordered_chunks( const std::string &file )
+{
+    {
+        raft::pread_reader< chunk_t > read( path );
+        raft::filewriter< chunk_t > write( out, ports, true, 10000 );
+        raft::map m;
+        m += read >= write;
+        m.exe();
+    }
+    const auto text( slurp( out ) );
+    std::remove( out.c_str() );
+    if( text != file )
+    {
+        std::cerr << "wrote " << text.size() << " bytes, file has " <<
+            file.size() << ( text.size() == file.size() ? ", out of order" : "" ) << "\n";
+        return( false );
+    }
+    return( true );
+}
+
+int
+main()
+{
+    const auto file( slurp( path ) );
+    return( items() && ordered_chunks( file ) ? EXIT_SUCCESS : EXIT_FAILURE );
+}
@@ -0,0 +1,226 @@
+/**
+ * fusedChain.cpp - a source, a chain of single port stages and a
+ * sink with fusion turned on.  The whole chain has to run on one
+ * thread, two items per run out of the source have to get through
+ * the small fused FIFOs, and the sum at the end has to be right.
+ * Then a source and a stage in the middle that each push several
+ * times fused_capacity items per run, the fused FIFOs have to grow
+ * rather than hang.
+ *
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 02:58:02 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <thread>
+#include <raft>
+
+using type_t = std::int64_t;
+
+static constexpr type_t      count  = 100000;
+static constexpr std::size_t stages = 15;
+
+/** every kernel that ran, by the thread it ran on **/
+static std::set< std::thread::id > threads;
+static std::mutex                  threads_mutex;
+
+static void
+seen()
+{
+    std::lock_guard< std::mutex > guard( threads_mutex );
+    threads.insert( std::this_thread::get_id() );
+}
+
+class pairs : public raft::kernel
+{
+public:
+    pairs() : raft::kernel()
+    {
+        output.addPort< type_t >( "0" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        seen();
+        output[ "0" ].push( next++ );
+        output[ "0" ].push( next++ );
+        return( next == count ? raft::stop : raft::proceed );
+    }
+
+private:
+    type_t next = 0;
+};
+
+class add_one : public raft::kernel
+{
+public:
+    add_one() : raft::kernel()
+    {
+        input.addPort< type_t >( "0" );
+        output.addPort< type_t >( "0" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        seen();
+        type_t item;
+        input[ "0" ].pop( item );
+        output[ "0" ].push( item + 1 );
+        return( raft::proceed );
+    }
+};
+
+/** far more per run than a fused FIFO starts out with **/
+static constexpr type_t burst       = raft::map::fused_capacity * 4;
+static constexpr type_t bursts_sent = 16;
+
+class bursts : public raft::kernel
+{
+public:
+    bursts() : raft::kernel()
+    {
+        output.addPort< type_t >( "0" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        for( type_t i( 0 ); i < burst; i++ )
+        {
+            output[ "0" ].push( next++ );
+        }
+        return( next == burst * bursts_sent ? raft::stop : raft::proceed );
+    }
+
+private:
+    type_t next = 0;
+};
+
+/** each item burst times **/
+class repeat : public raft::kernel
+{
+public:
+    repeat() : raft::kernel()
+    {
+        input.addPort< type_t >( "0" );
+        output.addPort< type_t >( "0" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        type_t item;
+        input[ "0" ].pop( item );
+        for( type_t i( 0 ); i < burst; i++ )
+        {
+            output[ "0" ].push( item );
+        }
+        return( raft::proceed );
+    }
+};
+
+class sum : public raft::kernel
+{
+public:
+    sum( type_t &total, type_t &items ) : raft::kernel(),
+                                          total( total ),
+                                          items( items )
+    {
+        input.addPort< type_t >( "0" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        seen();
+        type_t item;
+        input[ "0" ].pop( item );
+        total += item;
+        items++;
+        return( raft::proceed );
+    }
+
+private:
+    type_t &total;
+    type_t &items;
+};
+
+static bool
+chain_of_stages()
+{
+    type_t total( 0 ), items( 0 );
+    pairs src;
+    std::array< std::unique_ptr< add_one >, stages > chain;
+    sum t( total, items );
+    raft::map m;
+    raft::kernel *prev( &src );
+    for( auto &stage : chain )
+    {
+        stage.reset( new add_one() );
+        m += *prev >> *stage;
+        prev = stage.get();
+    }
+    m += *prev >> t;
+    m.setFusion( true );
+    m.exe();
+
+    const type_t expected( count * ( count - 1 ) / 2 +
+                           count * static_cast< type_t >( stages ) );
+    if( items != count || total != expected )
+    {
+        std::cerr << "got " << items << " items summing to " << total <<
+            ", expected " << count << " summing to " << expected << "\n";
+        return( false );
+    }
+    if( threads.size() != 1 )
+    {
+        std::cerr << "chain ran on " << threads.size() << " threads\n";
+        return( false );
+    }
+    return( true );
+}
+
+static bool
+big_runs()
+{
+    type_t total( 0 ), items( 0 );
+    bursts src;
+    add_one one;
+    repeat r;
+    sum t( total, items );
+    raft::map m;
+    m += src >> one >> r >> t;
+    m.setFusion( true );
+    m.exe();
+
+    const type_t sent( burst * bursts_sent );
+    const type_t expected( burst * ( sent * ( sent - 1 ) / 2 + sent ) );
+    if( items != sent * burst || total != expected )
+    {
+        std::cerr << "big runs: got " << items << " items summing to " << total <<
+            ", expected " << sent * burst << " summing to " << expected << "\n";
+        return( false );
+    }
+    return( true );
+}
+
+int
+main()
+{
+    return( chain_of_stages() && big_runs() ? EXIT_SUCCESS : EXIT_FAILURE );
+}
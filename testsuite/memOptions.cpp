@@ -0,0 +1,154 @@
+/**
+ * memOptions.cpp - stores allocated with huge pages and NUMA
+ * placement must behave just like heap ones.  Checks page_alloc
+ * directly for every combination, then runs an edge that asks for
+ * both and will likely be resized on the way.  Whether the pages
+ * really are huge or bound depends on the machine, so that isn't
+ * checked.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 19:02:17 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <raft>
+
+using type_t = std::int64_t;
+
+static const type_t n_items( 1 << 20 );
+
+class producer : public raft::kernel
+{
+public:
+    producer() : raft::kernel()
+    {
+        output.addPort< type_t >( "0" );
+        output.setMemoryOptions( "0", raft::mem::huge, raft::mem::bind );
+    }
+
+    virtual ~producer() = default;
+
+    virtual raft::kstatus run()
+    {
+        output[ "0" ].push( counter );
+        if( ++counter == n_items )
+        {
+            return( raft::stop );
+        }
+        return( raft::proceed );
+    }
+
+private:
+    type_t counter = 0;
+};
+
+class consumer : public raft::kernel
+{
+public:
+    consumer() : raft::kernel()
+    {
+        input.addPort< type_t >( "0" );
+    }
+
+    virtual ~consumer() = default;
+
+    virtual raft::kstatus run()
+    {
+        type_t val( 0 );
+        input[ "0" ].pop( val );
+        if( val != count )
+        {
+            std::cerr << "received " << val << ", expected " << count
+                      << ", exiting!!\n";
+            exit( EXIT_FAILURE );
+        }
+        count++;
+        return( raft::proceed );
+    }
+
+    type_t count = 0;
+};
+
+static bool
+check_alloc( const raft::mem::options &opts, const std::size_t length )
+{
+    auto * const bytes( reinterpret_cast< unsigned char* >(
+        page_alloc::allocate( length, opts ) ) );
+    if( reinterpret_cast< std::uintptr_t >( bytes ) % 4096 != 0 )
+    {
+        std::cerr << "memory isn't page aligned\n";
+        return( false );
+    }
+    for( std::size_t i( 0 ); i < length; i++ )
+    {
+        if( bytes[ i ] != 0 )
+        {
+            std::cerr << "memory isn't zeroed at " << i << "\n";
+            return( false );
+        }
+        bytes[ i ] = static_cast< unsigned char >( i );
+    }
+    for( std::size_t i( 0 ); i < length; i++ )
+    {
+        if( bytes[ i ] != static_cast< unsigned char >( i ) )
+        {
+            std::cerr << "memory didn't hold its value at " << i << "\n";
+            return( false );
+        }
+    }
+    page_alloc::release( bytes, length, opts );
+    return( true );
+}
+
+int
+main()
+{
+    const raft::mem::pages     pages[]  = { raft::mem::normal,
+                                            raft::mem::huge };
+    const raft::mem::placement places[] = { raft::mem::anywhere,
+                                            raft::mem::first_touch,
+                                            raft::mem::bind };
+    for( const auto page : pages )
+    {
+        for( const auto place : places )
+        {
+            raft::mem::options opts( page, place );
+            opts.core = 0;
+            /** one smaller than a page, one spanning several huge ones **/
+            if( ! check_alloc( opts, 100 ) ||
+                ! check_alloc( opts, ( 1 << 22 ) + 100 ) )
+            {
+                return( EXIT_FAILURE );
+            }
+        }
+    }
+
+    producer p;
+    consumer c;
+    raft::map M;
+    M.link( &p, &c );
+    M.exe();
+    if( c.count != n_items )
+    {
+        std::cerr << "received " << c.count << " items, expected "
+                  << n_items << "\n";
+        return( EXIT_FAILURE );
+    }
+    return( EXIT_SUCCESS );
+}
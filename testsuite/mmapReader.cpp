@@ -0,0 +1,116 @@
+/**
+ * mmapReader.cpp - maps the test text and searches it through
+ * overlapping views, every match found by reading the whole file
+ * has to be found once.  Then puts the file back together from the
+ * views of a second reader and checks it byte for byte.
+ *
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 03:22:47 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <raft>
+#include <raftio>
+#include <raftalgorithm>
+
+/** pwd is root for cmake's test script **/
+static const std::string path( "./testsuite/alice.txt" );
+
+class rebuild : public raft::kernel
+{
+public:
+    rebuild( std::string &text, const std::size_t overlap ) : raft::kernel(),
+                                                              text( text ),
+                                                              overlap( overlap )
+    {
+        input.addPort< raft::fileview >( "0" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        auto &view( input[ "0" ].peek< raft::fileview >() );
+        /** views come in order on one port, skip what was shared **/
+        const std::size_t skip( view.index == 0 ? 0 : overlap );
+        if( view.start_position + skip != text.size() )
+        {
+            bad = true;
+        }
+        text.append( view.buffer + skip, view.length - skip );
+        input[ "0" ].recycle();
+        return( raft::proceed );
+    }
+
+    bool bad = false;
+
+private:
+    std::string       &text;
+    const std::size_t  overlap;
+};
+
+int
+main()
+{
+    std::ifstream in( path );
+    const std::string file( ( std::istreambuf_iterator< char >( in ) ),
+                              std::istreambuf_iterator< char >() );
+    const std::string term( "Alice" );
+    std::vector< raft::match_t > expected;
+    for( auto pos( file.find( term ) ); pos != std::string::npos;
+         pos = file.find( term, pos + 1 ) )
+    {
+        expected.emplace_back( pos, pos + term.length() );
+    }
+
+    {
+        std::vector< raft::match_t > matches;
+        raft::mmap_reader read( path, 512, term.length() - 1 );
+        raft::search< raft::fileview, raft::stdlib > find( term );
+        auto we( raft::write_each< raft::match_t >(
+                std::back_inserter( matches ) ) );
+        raft::map m;
+        m += read >> find >> we;
+        m.exe();
+        if( matches != expected )
+        {
+            std::cerr << "found " << matches.size() << " matches, expected " <<
+                expected.size() << "\n";
+            return( EXIT_FAILURE );
+        }
+    }
+
+    {
+        std::string text;
+        const std::size_t overlap( 100 );
+        raft::mmap_reader read( path, 4096, overlap );
+        rebuild r( text, overlap );
+        raft::map m;
+        m += read >> r;
+        m.exe();
+        if( r.bad || text != file )
+        {
+            std::cerr << "views put back together give " << text.size() <<
+                " bytes, file has " << file.size() << "\n";
+            return( EXIT_FAILURE );
+        }
+    }
+    return( EXIT_SUCCESS );
+}
@@ -0,0 +1,171 @@
+/**
+ * portHandle.cpp - kernels that look their ports up once, in the
+ * constructor, and only use the handles in run().  Checks every
+ * item gets through with its signal, and that asking for a handle
+ * with the wrong type or name throws.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 23:02:47 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <raft>
+
+using type_t = std::int64_t;
+
+static const type_t n_items( 100000 );
+
+static raft::signal
+expected_signal( const type_t i )
+{
+    return( i % 11 == 0 ?
+            static_cast< raft::signal >( raft::MAX_SYSTEM_SIGNAL + 1 ) :
+            raft::none );
+}
+
+class producer : public raft::kernel
+{
+public:
+    producer() : raft::kernel()
+    {
+        output.addPort< type_t >( "number" );
+        out = output.handle< type_t >( "number" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        if( counter % 2 == 0 )
+        {
+            out.push( counter, expected_signal( counter ) );
+        }
+        else
+        {
+            out.allocate() = counter;
+            out.send( expected_signal( counter ) );
+        }
+        if( ++counter == n_items )
+        {
+            return( raft::stop );
+        }
+        return( raft::proceed );
+    }
+
+private:
+    type_t                      counter = 0;
+    raft::port_handle< type_t > out;
+};
+
+class consumer : public raft::kernel
+{
+public:
+    consumer() : raft::kernel()
+    {
+        input.addPort< type_t >( "number" );
+        in = input.handle< type_t >( "number" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        type_t       val( -1 );
+        raft::signal sig( raft::none );
+        if( count % 2 == 0 )
+        {
+            in.pop( val, &sig );
+        }
+        else
+        {
+            val = in.peek( &sig );
+            in.recycle();
+        }
+        if( val != count || sig != expected_signal( count ) )
+        {
+            std::cerr << "received " << val << " with signal " << sig <<
+                ", expected " << count << ", exiting!!\n";
+            exit( EXIT_FAILURE );
+        }
+        count++;
+        return( raft::proceed );
+    }
+
+    type_t                      count = 0;
+
+private:
+    raft::port_handle< type_t > in;
+};
+
+class wrong : public raft::kernel
+{
+public:
+    wrong() : raft::kernel()
+    {
+        input.addPort< type_t >( "number" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        return( raft::stop );
+    }
+
+    bool wrong_type()
+    {
+        try
+        {
+            input.handle< double >( "number" );
+        }
+        catch( PortTypeMismatchException & )
+        {
+            return( true );
+        }
+        return( false );
+    }
+
+    bool wrong_name()
+    {
+        try
+        {
+            input.handle< type_t >( "numbers" );
+        }
+        catch( PortNotFoundException & )
+        {
+            return( true );
+        }
+        return( false );
+    }
+};
+
+int
+main()
+{
+    wrong w;
+    if( ! w.wrong_type() || ! w.wrong_name() )
+    {
+        std::cerr << "bad handle request didn't throw\n";
+        return( EXIT_FAILURE );
+    }
+    producer p;
+    consumer c;
+    raft::map M;
+    M += p >> c;
+    M.exe();
+    if( c.count != n_items )
+    {
+        std::cerr << "consumer got " << c.count << " of " << n_items << "\n";
+        return( EXIT_FAILURE );
+    }
+    return( EXIT_SUCCESS );
+}
@@ -0,0 +1,112 @@
+/**
+ * preadReader.cpp - four copies of a pread_reader, one per join
+ * port, read the test text between them.  Every chunk of the file
+ * has to come through exactly once, hold the bytes at its offset,
+ * and overlap the chunk before it by chunk_offset - 1 bytes.
+ *
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 03:47:19 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <raft>
+#include <raftio>
+
+/** pwd is root for cmake's test script **/
+static const std::string path( "./testsuite/alice.txt" );
+
+static constexpr std::size_t ports        = 4;
+static constexpr long        chunk_offset = 101;
+
+using chunk_t = raft::filechunk< 4096 >;
+
+class collect : public raft::kernel
+{
+public:
+    collect( std::map< std::uint64_t, std::string > &chunks,
+             std::size_t &bad ) : raft::kernel(),
+                                  chunks( chunks ),
+                                  bad( bad )
+    {
+        input.addPort< chunk_t >( "0" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        auto &chunk( input[ "0" ].peek< chunk_t >() );
+        const std::string text( chunk.buffer, chunk.length );
+        if( ! chunks.emplace( chunk.index, text ).second )
+        {
+            /** same chunk twice **/
+            bad++;
+        }
+        starts[ chunk.index ] = chunk.start_position;
+        input[ "0" ].recycle();
+        return( raft::proceed );
+    }
+
+    std::map< std::uint64_t, std::size_t > starts;
+
+private:
+    std::map< std::uint64_t, std::string > &chunks;
+    std::size_t                            &bad;
+};
+
+int
+main()
+{
+    std::ifstream in( path );
+    const std::string file( ( std::istreambuf_iterator< char >( in ) ),
+                              std::istreambuf_iterator< char >() );
+
+    std::map< std::uint64_t, std::string > chunks;
+    std::size_t bad( 0 );
+    raft::pread_reader< chunk_t > read( path, chunk_offset );
+    raft::join< chunk_t > jo( ports );
+    collect c( chunks, bad );
+    raft::map m;
+    m += read >= jo >> c;
+    m.exe();
+
+    /** put the file back together, dropping what each chunk shares **/
+    const std::size_t overlap( chunk_offset - 1 );
+    std::string text;
+    std::uint64_t expect( 0 );
+    for( const auto &chunk : chunks )
+    {
+        const std::size_t skip( chunk.first == 0 ? 0 : overlap );
+        if( chunk.first != expect++ ||
+            c.starts[ chunk.first ] + skip != text.size() ||
+            file.compare( c.starts[ chunk.first ], chunk.second.size(), chunk.second ) != 0 )
+        {
+            bad++;
+        }
+        text.append( chunk.second, skip, std::string::npos );
+    }
+    if( bad != 0 || text != file )
+    {
+        std::cerr << bad << " bad chunks, chunks put back together give " <<
+            text.size() << " bytes, file has " << file.size() << "\n";
+        return( EXIT_FAILURE );
+    }
+    return( EXIT_SUCCESS );
+}
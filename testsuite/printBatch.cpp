@@ -0,0 +1,220 @@
+/**
+ * printBatch.cpp - four sources of numbers, each into a print
+ * kernel of its own, all printing one per line to the same stream.
+ * Every line has to be a whole number and every number has to be
+ * there once.  Then prints doubles, negative and unsigned integers
+ * and strings, plus doubles with the stream set to fixed, with a
+ * locale of its own, with a width and fill set, and with a German
+ * C locale if the system has one, and checks the text is what
+ * operator << gives for each.
+ *
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 05:08:21 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <array>
+#include <clocale>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <locale>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <raft>
+#include <raftio>
+
+using type_t = std::int64_t;
+
+static constexpr std::size_t sources = 4;
+static constexpr type_t      count   = 50000;
+
+class numbers : public raft::kernel
+{
+public:
+    numbers( const type_t first ) : raft::kernel(), next( first ), last( first + count )
+    {
+        output.addPort< type_t >( "0" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        output[ "0" ].push( next++ );
+        return( next == last ? raft::stop : raft::proceed );
+    }
+
+private:
+    type_t       next;
+    const type_t last;
+};
+
+template < class T > class items : public raft::kernel
+{
+public:
+    items( const std::vector< T > &list ) : raft::kernel(), list( list )
+    {
+        output.addPort< T >( "0" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        output[ "0" ].push( list[ next++ ] );
+        return( next == list.size() ? raft::stop : raft::proceed );
+    }
+
+private:
+    const std::vector< T > &list;
+    std::size_t             next = 0;
+};
+
+static bool
+shared_stream()
+{
+    std::ostringstream os;
+    std::array< std::unique_ptr< numbers >, sources > src;
+    std::array< std::unique_ptr< raft::print< type_t, '\n' > >, sources > p;
+    raft::map m;
+    for( std::size_t i( 0 ); i < sources; i++ )
+    {
+        src[ i ].reset( new numbers( static_cast< type_t >( i ) * count ) );
+        p[ i ].reset( new raft::print< type_t, '\n' >( os ) );
+        m += *src[ i ] >> *p[ i ];
+    }
+    m.exe();
+
+    std::vector< bool > seen( sources * count, false );
+    std::istringstream lines( os.str() );
+    std::string line;
+    std::size_t n( 0 );
+    while( std::getline( lines, line ) )
+    {
+        const auto value( std::stoll( line ) );
+        if( std::to_string( value ) != line || value < 0 ||
+            value >= static_cast< type_t >( sources * count ) || seen[ value ] )
+        {
+            std::cerr << "bad line \"" << line << "\"\n";
+            return( false );
+        }
+        seen[ value ] = true;
+        n++;
+    }
+    if( n != sources * count )
+    {
+        std::cerr << "printed " << n << " lines, expected " << sources * count << "\n";
+        return( false );
+    }
+    return( true );
+}
+
+/** dots between thousands and a decimal comma **/
+class german : public std::numpunct< char >
+{
+protected:
+    virtual char do_decimal_point() const
+    {
+        return( ',' );
+    }
+
+    virtual char do_thousands_sep() const
+    {
+        return( '.' );
+    }
+
+    virtual std::string do_grouping() const
+    {
+        return( "\3" );
+    }
+};
+
+static void
+as_is( std::ostream &stream )
+{
+    UNUSED( stream );
+}
+
+static void
+fixed( std::ostream &stream )
+{
+    stream << std::fixed << std::setprecision( 3 );
+}
+
+static void
+grouped( std::ostream &stream )
+{
+    stream.imbue( std::locale( std::locale::classic(), new german() ) );
+}
+
+static void
+padded( std::ostream &stream )
+{
+    stream << std::setw( 12 ) << std::setfill( '*' );
+}
+
+template < class T, class Setup > static bool
+same_as_stream( const std::vector< T > &list, Setup setup )
+{
+    std::ostringstream os, expect;
+    setup( os );
+    setup( expect );
+    for( const auto &item : list )
+    {
+        expect << item << ' ';
+    }
+    {
+        items< T > src( list );
+        raft::print< T, ' ' > p( os );
+        raft::map m;
+        m += src >> p;
+        m.exe();
+    }
+    if( os.str() != expect.str() )
+    {
+        std::cerr << "printed \"" << os.str() << "\", expected \"" << expect.str() << "\"\n";
+        return( false );
+    }
+    return( true );
+}
+
+int
+main()
+{
+    const std::vector< double > doubles{ 0.0, -1.5, 3.14159265358979, 1e-300, 6.02e23, 100000.0, 1234567.0 };
+    const std::vector< std::int32_t > ints{ 0, -1, 42, std::numeric_limits< std::int32_t >::min(),
+                                            std::numeric_limits< std::int32_t >::max() };
+    const std::vector< std::uint64_t > unsigneds{ 0, 7, std::numeric_limits< std::uint64_t >::max() };
+    const std::vector< std::string > strings{ "alice", "", "rabbit hole" };
+    bool ok( shared_stream() &&
+             same_as_stream( doubles, as_is ) &&
+             same_as_stream( doubles, fixed ) &&
+             same_as_stream( ints, as_is ) &&
+             same_as_stream( unsigneds, as_is ) &&
+             same_as_stream( strings, as_is ) &&
+             same_as_stream( doubles, grouped ) &&
+             same_as_stream( ints, grouped ) &&
+             same_as_stream( doubles, padded ) &&
+             same_as_stream( ints, padded ) &&
+             same_as_stream( strings, padded ) );
+    /** the streams keep the classic locale, only snprintf would change **/
+    if( ok && std::setlocale( LC_NUMERIC, "de_DE.UTF-8" ) != nullptr )
+    {
+        ok = same_as_stream( doubles, as_is );
+        std::setlocale( LC_NUMERIC, "C" );
+    }
+    return( ok ? EXIT_SUCCESS : EXIT_FAILURE );
+}
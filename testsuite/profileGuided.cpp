@@ -0,0 +1,193 @@
+/**
+ * profileGuided.cpp - runs the same graph twice with profiling on,
+ * using a partitioner that only looks at what it is handed.  The
+ * first run has nothing on file, the second has to get back the
+ * load of each kernel and the traffic over the edges.  A graph of
+ * a different shape mustn't pick up the first graph's profile.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 23:58:36 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include <raft>
+
+using type_t = std::int64_t;
+
+static const type_t n_items( 20000 );
+
+class producer : public raft::kernel
+{
+public:
+    producer() : raft::kernel()
+    {
+        output.addPort< type_t >( "0" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        output[ "0" ].push( counter );
+        if( ++counter == n_items )
+        {
+            return( raft::stop );
+        }
+        return( raft::proceed );
+    }
+
+private:
+    type_t counter = 0;
+};
+
+class worker : public raft::kernel
+{
+public:
+    worker() : raft::kernel()
+    {
+        input.addPort< type_t >( "0" );
+        output.addPort< type_t >( "0" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        type_t val( 0 );
+        input[ "0" ].pop( val );
+        /** something to measure **/
+        volatile type_t sum( 0 );
+        for( type_t i( 0 ); i < 200; i++ )
+        {
+            sum = sum + ( val ^ i );
+        }
+        output[ "0" ].push( val );
+        return( raft::proceed );
+    }
+};
+
+class consumer : public raft::kernel
+{
+public:
+    consumer() : raft::kernel()
+    {
+        input.addPort< type_t >( "0" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        type_t val( 0 );
+        input[ "0" ].pop( val );
+        count++;
+        return( raft::proceed );
+    }
+
+    type_t count = 0;
+};
+
+/** what the partitioner was handed on the last exe() **/
+static struct
+{
+    bool        given  = false;
+    bool        loaded = false;
+    double      load   = -1.0;
+    double      rate   = -1.0;
+    std::string path;
+} seen;
+
+static raft::kernel *watched( nullptr );
+
+class check_partition : public interface_partition
+{
+public:
+    virtual void partition( kernelkeeper &keeper )
+    {
+        (void) keeper;
+        seen.given  = ( profile != nullptr );
+        seen.loaded = ( seen.given && profile->loaded() );
+        if( seen.given )
+        {
+            seen.path = profile->path();
+            seen.load = profile->kernel_load( watched );
+            seen.rate = profile->max_edge_rate();
+        }
+    }
+};
+
+static bool
+run_graph( const std::string &dir, const bool longer )
+{
+    producer p;
+    worker   w;
+    worker   extra;
+    consumer c;
+    watched = &w;
+    raft::map M;
+    if( longer )
+    {
+        M += p >> w >> extra >> c;
+    }
+    else
+    {
+        M += p >> w >> c;
+    }
+    M.setProfileDir( dir );
+    M.exe< check_partition >();
+    return( c.count == n_items );
+}
+
+int
+main()
+{
+    char dir_template[] = "/tmp/raftprofileXXXXXX";
+    if( mkdtemp( dir_template ) == nullptr )
+    {
+        std::cerr << "couldn't make a directory for the profile\n";
+        return( EXIT_FAILURE );
+    }
+    const std::string dir( dir_template );
+    auto ret_val( EXIT_SUCCESS );
+    if( ! run_graph( dir, false ) || ! seen.given || seen.loaded )
+    {
+        std::cerr << "first run shouldn't have found a profile\n";
+        ret_val = EXIT_FAILURE;
+    }
+    const auto first_path( seen.path );
+    if( ret_val == EXIT_SUCCESS &&
+        ( ! run_graph( dir, false ) || ! seen.loaded ) )
+    {
+        std::cerr << "second run didn't find the profile\n";
+        ret_val = EXIT_FAILURE;
+    }
+    if( ret_val == EXIT_SUCCESS &&
+        ( seen.load <= 0.0 || seen.load > 1.0 || seen.rate <= 0.0 ) )
+    {
+        std::cerr << "profile has load " << seen.load << " and rate " <<
+            seen.rate << "\n";
+        ret_val = EXIT_FAILURE;
+    }
+    if( ret_val == EXIT_SUCCESS &&
+        ( ! run_graph( dir, true ) || seen.loaded ) )
+    {
+        std::cerr << "different graph picked up the profile\n";
+        ret_val = EXIT_FAILURE;
+    }
+    std::remove( first_path.c_str() );
+    std::remove( seen.path.c_str() );
+    rmdir( dir.c_str() );
+    return( ret_val );
+}
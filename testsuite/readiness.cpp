@@ -0,0 +1,140 @@
+/**
+ * readiness.cpp - wide fan-in, more input ports than fit in one
+ * readiness word, most of them empty at any given time.  The
+ * consumer must only be fired when one of its ports has data
+ * and must still see every item and finish once all the
+ * producers close their ports.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 15:58:40 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <raft>
+
+using type_t = std::int64_t;
+
+static const std::size_t n_ports( 96 );
+static const type_t      max_count( 100 );
+
+class producer : public raft::kernel
+{
+public:
+    producer( const std::size_t id ) : raft::kernel(),
+                                       id( id )
+    {
+        output.addPort< type_t >( "0" );
+    }
+
+    virtual ~producer() = default;
+
+    virtual raft::kstatus run()
+    {
+        /** stagger so that only a few ports have data at once **/
+        if( counter % 16 == static_cast< type_t >( id % 16 ) )
+        {
+            std::this_thread::sleep_for( std::chrono::microseconds( 200 ) );
+        }
+        output[ "0" ].push( counter );
+        if( ++counter == max_count )
+        {
+            return( raft::stop );
+        }
+        return( raft::proceed );
+    }
+
+private:
+    const std::size_t id;
+    type_t            counter = 0;
+};
+
+class consumer : public raft::kernel
+{
+public:
+    consumer() : raft::kernel()
+    {
+        for( std::size_t i( 0 ); i < n_ports; i++ )
+        {
+            input.addPort< type_t >( std::to_string( i ) );
+        }
+    }
+
+    virtual ~consumer() = default;
+
+    virtual raft::kstatus run()
+    {
+        bool found( false );
+        for( auto &port : input )
+        {
+            while( port.size() > 0 )
+            {
+                type_t val( 0 );
+                port.pop( val );
+                sum += val;
+                count++;
+                found = true;
+            }
+        }
+        if( ! found )
+        {
+            empty_firings++;
+        }
+        return( raft::proceed );
+    }
+
+    type_t sum           = 0;
+    type_t count         = 0;
+    type_t empty_firings = 0;
+};
+
+int
+main()
+{
+    consumer c;
+    std::vector< std::unique_ptr< producer > > producers;
+    raft::map M;
+    for( std::size_t i( 0 ); i < n_ports; i++ )
+    {
+        producers.emplace_back( new producer( i ) );
+        M.link( producers.back().get(), &c, std::to_string( i ) );
+    }
+    M.exe();
+
+    const type_t n( n_ports );
+    const type_t expected( n * ( max_count * ( max_count - 1 ) ) / 2 );
+    if( c.count != n * max_count || c.sum != expected )
+    {
+        std::cerr << "received " << c.count << " items summing to "
+                  << c.sum << ", expected " << n * max_count
+                  << " summing to " << expected << "\n";
+        return( EXIT_FAILURE );
+    }
+    if( c.empty_firings != 0 )
+    {
+        std::cerr << "consumer fired " << c.empty_firings
+                  << " times with no input data\n";
+        return( EXIT_FAILURE );
+    }
+    return( EXIT_SUCCESS );
+}
@@ -0,0 +1,278 @@
+/**
+ * reorderJoin.cpp - puts streams back in order with a reorder
+ * join.  Once behind a four way split whose workers take a random
+ * time per item, so items reach the join out of order across its
+ * ports.  Once straight from a source that sends each block of
+ * sixteen backwards over four ports, so items are out of order
+ * within a port too, with one number missing from the end.
+ * Everything has to come out in order exactly once.  Last from a
+ * source that leaves a gap and only closes its ports well after
+ * sending, whatever is held behind the gap has to come out too.
+ *
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 02:31:15 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <raft>
+
+using type_t = std::int64_t;
+
+static constexpr std::size_t ports   = 4;
+static constexpr type_t      count   = 20000;
+static constexpr type_t      block   = 16;
+/** left out of the second stream, the last one it would send **/
+static constexpr type_t      missing = count - block;
+
+/** the item is its own sequence number **/
+struct self
+{
+    std::uint64_t operator()( const type_t &item ) const
+    {
+        return( static_cast< std::uint64_t >( item ) );
+    }
+};
+
+class ascending : public raft::kernel
+{
+public:
+    ascending() : raft::kernel()
+    {
+        output.addPort< type_t >( "0" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        output[ "0" ].push( next++ );
+        return( next == count ? raft::stop : raft::proceed );
+    }
+
+private:
+    type_t next = 0;
+};
+
+/** each block of sixteen backwards, dealt over the ports **/
+class backwards : public raft::kernel
+{
+public:
+    backwards() : raft::kernel()
+    {
+        for( std::size_t i( 0 ); i < ports; i++ )
+        {
+            output.addPort< type_t >( std::to_string( i ) );
+        }
+    }
+
+    virtual raft::kstatus run()
+    {
+        for( type_t i( block - 1 ); i >= 0; i-- )
+        {
+            const auto item( base + i );
+            if( item != missing )
+            {
+                output[ std::to_string( port ) ].push( item );
+                port = ( port + 1 ) % ports;
+            }
+        }
+        base += block;
+        return( base == count ? raft::stop : raft::proceed );
+    }
+
+private:
+    type_t      base = 0;
+    std::size_t port = 0;
+};
+
+/** 0 on one port, 2 and 3 on another, then closes late **/
+class gap_then_wait : public raft::kernel
+{
+public:
+    gap_then_wait() : raft::kernel()
+    {
+        output.addPort< type_t >( "0", "1" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        output[ "0" ].push< type_t >( 0 );
+        output[ "1" ].push< type_t >( 2 );
+        output[ "1" ].push< type_t >( 3 );
+        std::this_thread::sleep_for( std::chrono::milliseconds( 200 ) );
+        return( raft::stop );
+    }
+};
+
+class gather : public raft::kernel
+{
+public:
+    gather( std::vector< type_t > &got ) : raft::kernel(), got( got )
+    {
+        input.addPort< type_t >( "0" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        type_t item;
+        input[ "0" ].pop( item );
+        got.push_back( item );
+        return( raft::proceed );
+    }
+
+private:
+    std::vector< type_t > &got;
+};
+
+class jitter : public raft::kernel
+{
+public:
+    jitter( const unsigned seed ) : raft::kernel(), gen( seed )
+    {
+        input.addPort< type_t >( "0" );
+        output.addPort< type_t >( "0" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        type_t item;
+        input[ "0" ].pop( item );
+        const auto end( std::chrono::steady_clock::now() +
+                        std::chrono::microseconds( delay( gen ) ) );
+        while( std::chrono::steady_clock::now() < end );
+        output[ "0" ].push( item );
+        return( raft::proceed );
+    }
+
+private:
+    std::mt19937                         gen;
+    std::uniform_int_distribution< int > delay{ 0, 20 };
+};
+
+class in_order : public raft::kernel
+{
+public:
+    in_order( type_t &items, type_t &wrong ) : raft::kernel(),
+                                               items( items ),
+                                               wrong( wrong )
+    {
+        input.addPort< type_t >( "0" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        type_t item;
+        input[ "0" ].pop( item );
+        if( expect == missing )
+        {
+            /** only the second stream skips it **/
+            expect += ( item == missing + 1 ? 1 : 0 );
+        }
+        wrong += ( item != expect ? 1 : 0 );
+        expect = item + 1;
+        items++;
+        return( raft::proceed );
+    }
+
+private:
+    type_t &items;
+    type_t &wrong;
+    type_t expect = 0;
+};
+
+static bool
+report( const char * const name, const type_t items, const type_t wrong, const type_t n )
+{
+    if( items != n || wrong != 0 )
+    {
+        std::cerr << name << ": got " << items << " of " << n << " items, " <<
+            wrong << " out of order\n";
+        return( false );
+    }
+    return( true );
+}
+
+static bool
+shuffled_workers()
+{
+    type_t items( 0 ), wrong( 0 );
+    ascending src;
+    raft::split< type_t > s( ports );
+    std::array< std::unique_ptr< jitter >, ports > workers;
+    raft::reorder_join< type_t, self > rj( ports );
+    in_order check( items, wrong );
+    raft::map m;
+    m += src >> s;
+    for( std::size_t i( 0 ); i < ports; i++ )
+    {
+        workers[ i ].reset( new jitter( static_cast< unsigned >( i + 1 ) ) );
+        m += s[ std::to_string( i ) ] >> *workers[ i ] >> rj[ std::to_string( i ) ];
+    }
+    m += rj >> check;
+    m.exe();
+    return( report( "shuffled workers", items, wrong, count ) );
+}
+
+static bool
+backwards_blocks()
+{
+    type_t items( 0 ), wrong( 0 );
+    backwards src;
+    raft::reorder_join< type_t, self > rj( ports );
+    in_order check( items, wrong );
+    raft::map m;
+    for( std::size_t i( 0 ); i < ports; i++ )
+    {
+        m += src[ std::to_string( i ) ] >> rj[ std::to_string( i ) ];
+    }
+    m += rj >> check;
+    m.exe();
+    return( report( "backwards blocks", items, wrong, count - 1 ) );
+}
+
+static bool
+late_close()
+{
+    std::vector< type_t > got;
+    gap_then_wait src;
+    raft::reorder_join< type_t, self > rj( 2 );
+    gather g( got );
+    raft::map m;
+    m += src[ "0" ] >> rj[ "0" ];
+    m += src[ "1" ] >> rj[ "1" ];
+    m += rj >> g;
+    m.exe();
+    if( got != std::vector< type_t >{ 0, 2, 3 } )
+    {
+        std::cerr << "late close: got " << got.size() << " of 3 items\n";
+        return( false );
+    }
+    return( true );
+}
+
+int
+main()
+{
+    const bool ok( shuffled_workers() && backwards_blocks() && late_close() );
+    return( ok ? EXIT_SUCCESS : EXIT_FAILURE );
+}
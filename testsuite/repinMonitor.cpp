@@ -0,0 +1,166 @@
+/**
+ * repinMonitor.cpp - feeds the re-pinning monitor made up windows
+ * on four cores.  Three kernels fighting over core zero must not
+ * move until the case has held for a few windows, then only one
+ * moves, to an idle core, and it stays there while the next one
+ * has to make its own case.  Kernels that each have a core, and
+ * kernels held up by their FIFOs, must never move.
+ *
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 01:12:40 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <raft>
+#include "repinmonitor.hpp"
+
+class idle : public raft::kernel
+{
+public:
+    idle() : raft::kernel()
+    {
+    }
+
+    virtual raft::kstatus run()
+    {
+        return( raft::stop );
+    }
+};
+
+/** no sysfs here, so four cores, each on its own **/
+static const cpu_topology four( "/nonexistent", { 0, 1, 2, 3 } );
+
+struct setup
+{
+    setup( const std::vector< core_id_t > &cores ) :
+        monitor( four, std::chrono::milliseconds( 1000 ) ),
+        slots( cores.size() )
+    {
+        for( std::size_t i( 0 ); i < cores.size(); i++ )
+        {
+            kernels.emplace_back( new idle() );
+            slots[ i ].core.store( cores[ i ] );
+            monitor.add( kernels[ i ].get(), &slots[ i ] );
+        }
+    }
+
+    repin_monitor                        monitor;
+    std::vector< repin_monitor::slot >   slots;
+    std::vector< std::unique_ptr< idle > > kernels;
+};
+
+static bool
+check_contended()
+{
+    setup s( { 0, 0, 0, 1 } );
+    std::vector< repin_monitor::usage > use( 4 );
+    for( std::size_t i( 0 ); i < 3; i++ )
+    {
+        use[ i ].cpu  = 0.33;
+        use[ i ].wait = 0.66;
+    }
+    use[ 3 ].cpu = 0.5;
+    for( std::size_t w( 0 ); w + 1 < repin_monitor::confirm; w++ )
+    {
+        if( s.monitor.window( use ) != -1 )
+        {
+            std::cerr << "moved before the case was confirmed\n";
+            return( false );
+        }
+    }
+    const auto first( s.monitor.window( use ) );
+    if( first < 0 || first > 2 )
+    {
+        std::cerr << "expected one of the kernels on core 0 to move\n";
+        return( false );
+    }
+    const auto to( s.slots[ first ].core.load() );
+    if( to != 2 && to != 3 )
+    {
+        std::cerr << "moved to busy core " << to << "\n";
+        return( false );
+    }
+    /** core 0 now has two, that has to be confirmed all over again **/
+    for( std::size_t w( 0 ); w + 1 < repin_monitor::confirm; w++ )
+    {
+        if( s.monitor.window( use ) != -1 )
+        {
+            std::cerr << "second move came too soon\n";
+            return( false );
+        }
+    }
+    const auto second( s.monitor.window( use ) );
+    if( second < 0 || second > 2 || second == first )
+    {
+        std::cerr << "expected a second kernel off core 0\n";
+        return( false );
+    }
+    const auto to2( s.slots[ second ].core.load() );
+    if( to2 == 0 || to2 == 1 || to2 == to )
+    {
+        std::cerr << "second move went to busy core " << to2 << "\n";
+        return( false );
+    }
+    /** the first one is still cooling down, it must not bounce **/
+    for( std::size_t w( 0 ); w < repin_monitor::cooldown; w++ )
+    {
+        s.monitor.window( use );
+    }
+    if( s.slots[ first ].core.load() != to )
+    {
+        std::cerr << "moved kernel didn't stay put\n";
+        return( false );
+    }
+    return( true );
+}
+
+static bool
+check_stays( const std::vector< core_id_t > &cores,
+             const repin_monitor::usage &u,
+             const char *what )
+{
+    setup s( cores );
+    std::vector< repin_monitor::usage > use( cores.size(), u );
+    for( std::size_t w( 0 ); w < 3 * repin_monitor::confirm; w++ )
+    {
+        if( s.monitor.window( use ) != -1 )
+        {
+            std::cerr << what << " kernel was moved\n";
+            return( false );
+        }
+    }
+    return( true );
+}
+
+int
+main()
+{
+    repin_monitor::usage balanced;
+    balanced.cpu  = 0.9;
+    repin_monitor::usage blocked;
+    blocked.cpu     = 0.2;
+    blocked.wait    = 0.66;
+    blocked.blocked = 0.8;
+    const bool ok( check_contended() &&
+                   check_stays( { 0, 1, 2, 3 }, balanced, "balanced" ) &&
+                   check_stays( { 0, 0, 0 }, blocked, "FIFO blocked" ) );
+    return( ok ? EXIT_SUCCESS : EXIT_FAILURE );
+}
@@ -0,0 +1,134 @@
+/**
+ * resizeHandoff.cpp - resizes a heap FIFO over and over, both
+ * growing and shrinking, while a producer and a consumer are
+ * running flat out and a third thread keeps asking for the
+ * size.  Neither end should ever see anything out of order,
+ * including peek_range calls that straddle a resize.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 18:05:31 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <raft>
+
+using type_t = std::int64_t;
+
+static const type_t      n_items( 200000 );
+static const std::size_t range( 5 );
+
+int
+main()
+{
+    RingBuffer< type_t > fifo( 16 );
+    std::atomic< bool >  done( false );
+    volatile bool        exit_alloc( false );
+
+    std::thread producer( [&]()
+    {
+        for( type_t i( 0 ); i < n_items; i++ )
+        {
+            fifo.push( i );
+        }
+    } );
+
+    std::size_t n_resizes( 0 );
+    std::thread allocator( [&]()
+    {
+        const std::size_t sizes[] = { 8, 64, 16, 256, 32, 8, 128 };
+        while( ! done.load( std::memory_order_relaxed ) )
+        {
+            for( const auto size : sizes )
+            {
+                fifo.resize( size, 16, exit_alloc );
+                fifo.reclaim();
+                n_resizes++;
+                std::this_thread::sleep_for( std::chrono::microseconds( 50 ) );
+            }
+        }
+    } );
+
+    std::thread monitor( [&]()
+    {
+        while( ! done.load( std::memory_order_relaxed ) )
+        {
+            /**
+             * from a third thread size() is only a snapshot, it can
+             * count a store the consumer is emptying as full and a
+             * slow consumer can leave several stores queued, so all
+             * it can be held to is staying sane while stores are
+             * swapped and freed under it.
+             */
+            if( fifo.size() > static_cast< std::size_t >( n_items ) ||
+                fifo.space_avail() > 256 )
+            {
+                std::cerr << "size out of range\n";
+                exit( EXIT_FAILURE );
+            }
+        }
+    } );
+
+    type_t expected( 0 );
+    while( expected < n_items )
+    {
+        if( expected % 7 == 0 && n_items - expected >= static_cast< type_t >( range ) )
+        {
+            auto items( fifo.peek_range< type_t >( range ) );
+            for( std::size_t i( 0 ); i < range; i++ )
+            {
+                if( items[ i ].ele != expected + static_cast< type_t >( i ) )
+                {
+                    std::cerr << "peeked " << items[ i ].ele << ", expected "
+                              << expected + i << ", exiting!!\n";
+                    exit( EXIT_FAILURE );
+                }
+            }
+            fifo.recycle( range );
+            expected += range;
+            continue;
+        }
+        type_t val( 0 );
+        fifo.pop( val );
+        if( val != expected )
+        {
+            std::cerr << "received " << val << ", expected " << expected
+                      << ", exiting!!\n";
+            exit( EXIT_FAILURE );
+        }
+        expected++;
+    }
+    done = true;
+    producer.join();
+    allocator.join();
+    monitor.join();
+    if( fifo.size() != 0 )
+    {
+        std::cerr << "fifo not empty at the end\n";
+        return( EXIT_FAILURE );
+    }
+    if( n_resizes == 0 )
+    {
+        std::cerr << "fifo was never resized\n";
+        return( EXIT_FAILURE );
+    }
+    return( EXIT_SUCCESS );
+}
@@ -0,0 +1,143 @@
+/**
+ * resizePolicy.cpp - bursty producer then a trickle.  The bursts
+ * block the producer while the consumer drains in between, so the
+ * edge should grow, but never past the cap set on the port.  The
+ * trickle leaves the edge mostly empty, so it should shrink again.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 17:12:55 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <raft>
+
+using type_t = std::int64_t;
+
+static const std::size_t n_bursts( 30 );
+static const std::size_t burst( 2048 );
+static const std::size_t n_trickle( 500 );
+static const std::size_t cap_items( 1024 );
+
+class producer : public raft::kernel
+{
+public:
+    producer() : raft::kernel()
+    {
+        output.addPort< type_t >( "0" );
+        output.setMemoryCap( "0", cap_items * sizeof( type_t ) );
+    }
+
+    virtual ~producer() = default;
+
+    virtual raft::kstatus run()
+    {
+        auto &port( output[ "0" ] );
+        if( round < n_bursts )
+        {
+            for( std::size_t i( 0 ); i < burst; i++ )
+            {
+                port.push( counter++ );
+            }
+            max_cap = std::max( max_cap, port.capacity() );
+            std::this_thread::sleep_for( std::chrono::milliseconds( 20 ) );
+        }
+        else
+        {
+            port.push( counter++ );
+            std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+        }
+        if( ++round == n_bursts + n_trickle )
+        {
+            final_cap = port.capacity();
+            return( raft::stop );
+        }
+        return( raft::proceed );
+    }
+
+    std::size_t max_cap   = 0;
+    std::size_t final_cap = 0;
+
+private:
+    type_t      counter = 0;
+    std::size_t round   = 0;
+};
+
+class consumer : public raft::kernel
+{
+public:
+    consumer() : raft::kernel()
+    {
+        input.addPort< type_t >( "0" );
+    }
+
+    virtual ~consumer() = default;
+
+    virtual raft::kstatus run()
+    {
+        type_t val( 0 );
+        input[ "0" ].pop( val );
+        if( val != count )
+        {
+            std::cerr << "received " << val << ", expected " << count
+                      << ", exiting!!\n";
+            exit( EXIT_FAILURE );
+        }
+        /** hiccup now and then so the producer blocks **/
+        if( ++count % 512 == 0 )
+        {
+            std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+        }
+        return( raft::proceed );
+    }
+
+    type_t count = 0;
+};
+
+int
+main()
+{
+    producer p;
+    consumer c;
+    raft::map M;
+    M.link( &p, &c );
+    M.exe();
+
+    const type_t expected( n_bursts * burst + n_trickle );
+    if( c.count != expected )
+    {
+        std::cerr << "received " << c.count << " items, expected "
+                  << expected << "\n";
+        return( EXIT_FAILURE );
+    }
+    if( p.max_cap <= INITIAL_ALLOC_SIZE || p.max_cap > cap_items )
+    {
+        std::cerr << "edge grew to " << p.max_cap << " items, expected more than "
+                  << INITIAL_ALLOC_SIZE << " and at most " << cap_items << "\n";
+        return( EXIT_FAILURE );
+    }
+    if( p.final_cap >= p.max_cap )
+    {
+        std::cerr << "edge never shrank from " << p.max_cap << " items\n";
+        return( EXIT_FAILURE );
+    }
+    return( EXIT_SUCCESS );
+}
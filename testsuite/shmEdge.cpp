@@ -0,0 +1,215 @@
+/**
+ * shmEdge.cpp - links a producer in a child process to a consumer in
+ * this one through a shared memory edge.  The producer mixes push
+ * with allocate/send and the consumer pop with peek/recycle, every
+ * item has to arrive in order with its signal.  Then a producer that
+ * dies part way through, the consumer has to get everything sent
+ * before it died and finish.  Also checks that a type that can't
+ * cross processes is refused and that no segment is left behind.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 21:40:12 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <raft>
+
+struct item_t
+{
+    std::int64_t seq;
+    double       val;
+};
+
+static const std::int64_t n_items( 100000 );
+/** the crashing producer dies after this many **/
+static const std::int64_t n_crash( 1000 );
+
+static raft::signal
+expected_signal( const std::int64_t i )
+{
+    return( i % 17 == 0 ?
+            static_cast< raft::signal >( raft::MAX_SYSTEM_SIGNAL + 1 ) :
+            raft::none );
+}
+
+class producer : public raft::kernel
+{
+public:
+    producer( const std::int64_t die_at ) : raft::kernel(),
+                                            die_at( die_at )
+    {
+        output.addPort< item_t >( "0" );
+    }
+
+    virtual ~producer() = default;
+
+    virtual raft::kstatus run()
+    {
+        if( counter == die_at )
+        {
+            /** no clean up, no invalidate, just gone **/
+            _exit( EXIT_SUCCESS );
+        }
+        auto &port( output[ "0" ] );
+        if( counter % 2 == 0 )
+        {
+            port.push( item_t{ counter, counter * .5 },
+                       expected_signal( counter ) );
+        }
+        else
+        {
+            /** written straight into the segment **/
+            auto &ref( port.allocate< item_t >() );
+            ref.seq = counter;
+            ref.val = counter * .5;
+            port.send( expected_signal( counter ) );
+        }
+        if( ++counter == n_items )
+        {
+            return( raft::stop );
+        }
+        return( raft::proceed );
+    }
+
+private:
+    std::int64_t       counter = 0;
+    const std::int64_t die_at;
+};
+
+class consumer : public raft::kernel
+{
+public:
+    consumer() : raft::kernel()
+    {
+        input.addPort< item_t >( "0" );
+    }
+
+    virtual ~consumer() = default;
+
+    virtual raft::kstatus run()
+    {
+        auto &port( input[ "0" ] );
+        item_t       val;
+        raft::signal sig( raft::none );
+        if( count % 2 == 0 )
+        {
+            port.pop( val, &sig );
+        }
+        else
+        {
+            val = port.peek< item_t >( &sig );
+            port.recycle();
+        }
+        if( val.seq != count || val.val != count * .5 ||
+            sig != expected_signal( count ) )
+        {
+            std::cerr << "received " << val.seq << " with signal " << sig <<
+                ", expected " << count << ", exiting!!\n";
+            exit( EXIT_FAILURE );
+        }
+        count++;
+        return( raft::proceed );
+    }
+
+    std::int64_t count = 0;
+};
+
+class strings : public raft::kernel
+{
+public:
+    strings() : raft::kernel()
+    {
+        output.addPort< std::string >( "0" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        return( raft::stop );
+    }
+};
+
+/**
+ * run_pair - producer in a child, consumer here, returns the
+ * number of items the consumer got.  The child is reaped on the
+ * side so that the consumer can tell once it has died.
+ */
+static std::int64_t
+run_pair( const std::string &edge, const std::int64_t die_at )
+{
+    const auto pid( fork() );
+    if( pid == 0 )
+    {
+        producer p( die_at );
+        raft::map M;
+        M.link_shm( &p, "0", edge, 256 );
+        M.exe();
+        _exit( EXIT_SUCCESS );
+    }
+    std::thread reaper( [pid](){ waitpid( pid, nullptr, 0 ); } );
+    consumer c;
+    raft::map M;
+    M.link_shm( edge, &c, "0" );
+    M.exe();
+    reaper.join();
+    return( c.count );
+}
+
+int
+main()
+{
+    const std::string edge( "shmEdge." + std::to_string( getpid() ) );
+
+    try
+    {
+        strings s;
+        raft::map M;
+        M.link_shm( &s, "0", edge );
+        std::cerr << "std::string accepted by a shared memory edge\n";
+        return( EXIT_FAILURE );
+    }
+    catch( PortTypeException & )
+    {
+        /** expected **/
+    }
+
+    if( run_pair( edge, -1 ) != n_items )
+    {
+        std::cerr << "consumer didn't get every item\n";
+        return( EXIT_FAILURE );
+    }
+    if( run_pair( edge, n_crash ) != n_crash )
+    {
+        std::cerr << "consumer didn't get every item sent before the crash\n";
+        return( EXIT_FAILURE );
+    }
+    /** both ends attached, so the name should be gone **/
+    const auto fd( shm_open( ( "/raft." + edge ).c_str(), O_RDONLY, 0 ) );
+    if( fd >= 0 || errno != ENOENT )
+    {
+        std::cerr << "shared memory segment left behind\n";
+        return( EXIT_FAILURE );
+    }
+    return( EXIT_SUCCESS );
+}
@@ -0,0 +1,149 @@
+/**
+ * signalMap.cpp - pushes a stream where every 13th item carries a
+ * user signal through a small heap FIFO, so slots are reused many
+ * times, and reads it back with every kind of consumer call.  Each
+ * item must come out with exactly the signal it went in with, a
+ * slot that once held a signal must read raft::none once reused.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 20:11:36 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <raft>
+
+using type_t = std::int64_t;
+
+static const type_t n_items( 100000 );
+
+static raft::signal
+expected_signal( const type_t i )
+{
+    return( i % 13 == 0 ?
+            static_cast< raft::signal >( raft::MAX_SYSTEM_SIGNAL + 1 + i % 5 ) :
+            raft::none );
+}
+
+static void
+check( const type_t val, const raft::signal sig, const type_t expected )
+{
+    if( val != expected )
+    {
+        std::cerr << "received " << val << ", expected " << expected
+                  << ", exiting!!\n";
+        exit( EXIT_FAILURE );
+    }
+    if( sig != expected_signal( expected ) )
+    {
+        std::cerr << "item " << val << " has signal " << sig
+                  << ", expected " << expected_signal( expected )
+                  << ", exiting!!\n";
+        exit( EXIT_FAILURE );
+    }
+}
+
+int
+main()
+{
+    RingBuffer< type_t > buffer( 16 );
+    /** the FIFO interface, the ring buffer hides some of it **/
+    FIFO &fifo( buffer );
+
+    /** single pushes and ranges, the range's signal goes on its last item **/
+    std::thread producer( [&]()
+    {
+        type_t i( 0 );
+        while( i < n_items )
+        {
+            if( i % 3 == 0 || i + 13 > n_items )
+            {
+                fifo.push( i, expected_signal( i ) );
+                i++;
+                continue;
+            }
+            /** run up to and including the next signalled item **/
+            std::vector< type_t > range;
+            do
+            {
+                range.emplace_back( i );
+            }while( expected_signal( i++ ) == raft::none );
+            fifo.insert( range.begin(), range.end(), expected_signal( i - 1 ) );
+        }
+    } );
+
+    type_t expected( 0 );
+    std::size_t round( 0 );
+    while( expected < n_items )
+    {
+        switch( round++ % 4 )
+        {
+            case( 0 ):
+            {
+                type_t      val( 0 );
+                raft::signal sig( raft::none );
+                fifo.pop( val, &sig );
+                check( val, sig, expected++ );
+            }
+            break;
+            case( 1 ):
+            {
+                const auto n( std::min< type_t >( 7, n_items - expected ) );
+                std::vector< std::pair< type_t, raft::signal > > items( n );
+                fifo.pop_range< type_t >( items, n );
+                for( const auto &pair : items )
+                {
+                    check( pair.first, pair.second, expected++ );
+                }
+            }
+            break;
+            case( 2 ):
+            {
+                raft::signal sig( raft::none );
+                const auto val( fifo.peek< type_t >( &sig ) );
+                check( val, sig, expected++ );
+                fifo.recycle( 1 );
+            }
+            break;
+            case( 3 ):
+            {
+                const auto n( std::min< type_t >( 5, n_items - expected ) );
+                {
+                    auto items( fifo.peek_range< type_t >( n ) );
+                    for( type_t i( 0 ); i < n; i++ )
+                    {
+                        check( items[ i ].ele, items[ i ].sig, expected + i );
+                    }
+                }
+                /** thrown away, signals and all **/
+                fifo.recycle( n );
+                expected += n;
+            }
+            break;
+        }
+    }
+    producer.join();
+    if( fifo.size() != 0 )
+    {
+        std::cerr << "fifo not empty at the end\n";
+        return( EXIT_FAILURE );
+    }
+    return( EXIT_SUCCESS );
+}
@@ -0,0 +1,332 @@
+/**
+ * splitMethods.cpp - sends a counted stream through a four way
+ * split with each split method, with and without batches.  Every
+ * item has to come out exactly once, the balancing methods have
+ * to give every port a fair share, and key hashing has to send
+ * every item to the port its key names.  Then checks that adding
+ * a port to key hashing only moves keys to the new port, for the
+ * hash itself and for a key hashing split grown port by port past
+ * ten ports the way the run-time adds them while running.
+ *
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 02:06:44 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <raft>
+#include "generate.tcc"
+
+using type_t = std::int64_t;
+
+static constexpr std::size_t ports = 4;
+static constexpr type_t      count = 40000;
+
+class tally : public raft::kernel
+{
+public:
+    tally( const std::size_t port ) : raft::kernel(), port( port )
+    {
+        input.addPort< type_t >( "0" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        type_t item;
+        input[ "0" ].pop( item );
+        total += item;
+        items++;
+        /** std::hash of an integer is the integer here **/
+        misplaced += ( keyhash< type_t >::jump( static_cast< std::uint64_t >( item ), ports ) !=
+                       port ? 1 : 0 );
+        return( raft::proceed );
+    }
+
+    const std::size_t port;
+    type_t            total     = 0;
+    type_t            items     = 0;
+    type_t            misplaced = 0;
+};
+
+template < class method >
+static bool
+check( const char * const name,
+       const std::size_t batch,
+       const bool keyed )
+{
+    raft::test::generate< type_t > gen( count );
+    raft::split< type_t, method >  s( ports, batch );
+    std::array< std::unique_ptr< tally >, ports > sinks;
+    raft::map m;
+    m += gen >> s;
+    for( std::size_t i( 0 ); i < ports; i++ )
+    {
+        sinks[ i ].reset( new tally( i ) );
+        m += s[ std::to_string( i ) ] >> *sinks[ i ];
+    }
+    m.exe();
+    type_t total( 0 ), items( 0 );
+    for( const auto &t : sinks )
+    {
+        total += t->total;
+        items += t->items;
+        if( keyed && t->misplaced != 0 )
+        {
+            std::cerr << name << ": " << t->misplaced <<
+                " items on the wrong port for their key\n";
+            return( false );
+        }
+        if( ! keyed && t->items < count / static_cast< type_t >( ports * 20 ) )
+        {
+            std::cerr << name << " (batch " << batch << "): port " <<
+                t->port << " only got " << t->items << " items\n";
+            return( false );
+        }
+    }
+    if( items != count || total != count * ( count - 1 ) / 2 )
+    {
+        std::cerr << name << " (batch " << batch << "): got " << items <<
+            " items summing to " << total << "\n";
+        return( false );
+    }
+    return( true );
+}
+
+static constexpr std::size_t grown_ports = 16;
+static constexpr type_t      step_items  = 2000;
+static constexpr type_t      n_keys      = 500;
+
+/** by_key - items are sequence numbers, n_keys keys round and round **/
+struct by_key
+{
+    std::size_t operator()( const type_t &item ) const
+    {
+        return( static_cast< std::size_t >( item % n_keys ) );
+    }
+};
+
+/** copies of keyed_copy made so far, counting the original **/
+static std::atomic< std::size_t > copies( 0 );
+
+/** source for grown(), item n * step_items waits for n + 1 copies **/
+class steps : public raft::kernel
+{
+public:
+    steps() : raft::kernel()
+    {
+        output.addPort< type_t >( "0" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        const auto step( static_cast< std::size_t >( next / step_items ) + 1 );
+        if( next % step_items == 0 && step <= grown_ports )
+        {
+            while( copies.load() < step )
+            {
+                std::this_thread::yield();
+            }
+        }
+        output[ "0" ].push( next++ );
+        return( next == step_items * static_cast< type_t >( grown_ports ) ?
+                raft::stop : raft::proceed );
+    }
+
+private:
+    type_t next = 0;
+};
+
+/**
+ * keyed_copy - logs what it gets, copies are made in port order
+ * so the id is also the split port the copy hangs off.
+ */
+class keyed_copy : public raft::kernel
+{
+public:
+    keyed_copy() : raft::kernel(), id( copies++ )
+    {
+        input.addPort< type_t >( "0" );
+        output.addPort< type_t >( "0" );
+    }
+
+    keyed_copy( const keyed_copy &other ) : keyed_copy()
+    {
+        UNUSED( other );
+    }
+
+    virtual raft::kstatus run()
+    {
+        type_t item;
+        input[ "0" ].pop( item );
+        seen[ id ].emplace_back( item );
+        output[ "0" ].push( item );
+        return( raft::proceed );
+    }
+
+    CLONE();
+
+    static std::array< std::vector< type_t >, grown_ports > seen;
+
+private:
+    const std::size_t id;
+};
+
+std::array< std::vector< type_t >, grown_ports > keyed_copy::seen;
+
+/** growing_parallel - adds copies one after another, no sampling **/
+class growing_parallel : public basic_parallel
+{
+public:
+    growing_parallel( raft::map &map,
+                      Allocate &alloc,
+                      Schedule &sched,
+                      volatile bool &exit_para ) :
+        basic_parallel( map, alloc, sched, exit_para )
+    {
+    }
+
+    static raft::kernel *original;
+
+    virtual void start()
+    {
+        if( ! add_group( original ) )
+        {
+            return;
+        }
+        auto &g( groups.back() );
+        while( ! exit_para && g.replicas.size() < grown_ports && replicate( g ) )
+        {
+            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+        }
+    }
+};
+
+raft::kernel* growing_parallel::original( nullptr );
+
+/**
+ * grown - a keyed split grown from one port to grown_ports while
+ * running.  Each key has to go from port to higher port, never
+ * back, in order of the items.
+ */
+static bool
+grown()
+{
+    steps src;
+    raft::split< type_t, keyhash< type_t, by_key > > s( 1 );
+    keyed_copy copy;
+    raft::join< type_t > j( 1 );
+    tally sink( 0 );
+    growing_parallel::original = &copy;
+    raft::map m;
+    m += src >> s;
+    m += s[ "0" ] >> copy;
+    m += copy >> j[ "0" ];
+    m += j >> sink;
+    m.setMaxReplicas( grown_ports );
+    m.exe< partition_dummy, simple_schedule, dynalloc, growing_parallel >();
+
+    const type_t n( step_items * static_cast< type_t >( grown_ports ) );
+    if( sink.items != n )
+    {
+        std::cerr << "keyhash split: got " << sink.items << " of " << n << " items\n";
+        return( false );
+    }
+    /** per key, the port it was last on and the last item there **/
+    std::vector< std::size_t > port( n_keys, 0 );
+    std::vector< type_t >      last( n_keys, -1 );
+    std::vector< std::pair< type_t, std::size_t > > all;
+    for( std::size_t i( 0 ); i < grown_ports; i++ )
+    {
+        for( const auto item : keyed_copy::seen[ i ] )
+        {
+            all.emplace_back( item, i );
+        }
+    }
+    std::sort( all.begin(), all.end() );
+    for( const auto &item : all )
+    {
+        const auto k( item.first % n_keys );
+        if( item.second < port[ k ] )
+        {
+            std::cerr << "keyhash split: key " << k << " went back from port " <<
+                port[ k ] << " to " << item.second << " after item " << last[ k ] << "\n";
+            return( false );
+        }
+        port[ k ] = item.second;
+        last[ k ] = item.first;
+    }
+    return( true );
+}
+
+/** stable - going from n to n + 1 ports only moves keys to port n **/
+static bool
+stable()
+{
+    for( std::size_t n( 1 ); n < 16; n++ )
+    {
+        std::size_t moved( 0 );
+        for( std::uint64_t k( 0 ); k < static_cast< std::uint64_t >( count ); k++ )
+        {
+            const auto before( keyhash< type_t >::jump( k, n ) );
+            const auto after( keyhash< type_t >::jump( k, n + 1 ) );
+            if( before != after )
+            {
+                if( after != n )
+                {
+                    std::cerr << "keyhash: key " << k << " moved from port " <<
+                        before << " to " << after << " going to " << n + 1 << " ports\n";
+                    return( false );
+                }
+                moved++;
+            }
+        }
+        /** about one in n + 1 should move **/
+        if( moved * ( n + 1 ) * 2 < static_cast< std::size_t >( count ) ||
+            moved * ( n + 1 ) > static_cast< std::size_t >( count ) * 2 )
+        {
+            std::cerr << "keyhash: " << moved << " of " << count <<
+                " keys moved going to " << n + 1 << " ports\n";
+            return( false );
+        }
+    }
+    return( true );
+}
+
+int
+main()
+{
+    const bool ok( check< roundrobin >( "roundrobin", 1, false ) &&
+                   check< roundrobin >( "roundrobin", 64, false ) &&
+                   check< leastusedfirst >( "leastusedfirst", 1, false ) &&
+                   check< leastusedfirst >( "leastusedfirst", 64, false ) &&
+                   check< poweroftwo >( "poweroftwo", 1, false ) &&
+                   check< poweroftwo >( "poweroftwo", 64, false ) &&
+                   check< keyhash< type_t > >( "keyhash", 1, true ) &&
+                   check< keyhash< type_t > >( "keyhash", 64, true ) &&
+                   stable() &&
+                   grown() );
+    return( ok ? EXIT_SUCCESS : EXIT_FAILURE );
+}
@@ -0,0 +1,120 @@
+/**
+ * spscFixedLink.cpp - edges linked with a fixed buffer size
+ * get the single producer/consumer heap, check that it is
+ * sized to the next power of two and delivers in order.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 10:02:13 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <raft>
+
+struct obj_t
+{
+   obj_t() = default;
+
+   obj_t( const std::int64_t v ) : a( v ), b( v + 1 ){}
+
+   std::int64_t a = 0;
+   std::int64_t b = 0;
+};
+
+static const std::int64_t max_count( 10000 );
+
+class start : public raft::kernel
+{
+public:
+    start() : raft::kernel()
+    {
+        output.addPort< std::int64_t >( "x" );
+        output.addPort< obj_t >( "y" );
+    }
+
+    virtual ~start() = default;
+
+    virtual raft::kstatus run()
+    {
+        output[ "x" ].push( counter );
+        auto &mem( output[ "y" ].allocate< obj_t >( counter ) );
+        (void) mem;
+        output[ "y" ].send();
+        if( ++counter == max_count )
+        {
+            return( raft::stop );
+        }
+        return( raft::proceed );
+    }
+
+private:
+    std::int64_t counter = 0;
+};
+
+class last : public raft::kernel
+{
+public:
+    last() : raft::kernel()
+    {
+        input.addPort< std::int64_t >( "x" );
+        input.addPort< obj_t >( "y" );
+    }
+
+    virtual ~last() = default;
+
+    virtual raft::kstatus run()
+    {
+        if( input[ "x" ].capacity() != 8 || input[ "y" ].capacity() != 8 )
+        {
+            std::cerr << "fixed size edge not sized as expected, exiting!!\n";
+            exit( EXIT_FAILURE );
+        }
+        std::int64_t val( 0 );
+        input[ "x" ].pop( val );
+        obj_t obj;
+        input[ "y" ].pop( obj );
+        if( val != counter || obj.a != counter || obj.b != counter + 1 )
+        {
+            std::cerr << "failed to receive correct item, exiting!!\n";
+            exit( EXIT_FAILURE );
+        }
+        counter++;
+        return( raft::proceed );
+    }
+
+    std::int64_t counter = 0;
+};
+
+int
+main()
+{
+    start s;
+    last  l;
+
+    raft::map M;
+    M.link( &s, "x", &l, "x", 5 );
+    M.link( &s, "y", &l, "y", 5 );
+    M.exe();
+    if( l.counter != max_count )
+    {
+        std::cerr << "received " << l.counter << " items, expected "
+                  << max_count << "\n";
+        return( EXIT_FAILURE );
+    }
+    return( EXIT_SUCCESS );
+}
@@ -0,0 +1,101 @@
+/**
+ * spscSignal.cpp - sends signals with no item through the single
+ * producer/consumer ring, with strings in between.  Popping the
+ * signal-only slot has to give an empty string and the eof, and
+ * nothing in between may go wrong with the strings around it.
+ * Then inserts from iterators the ring doesn't take, which has
+ * to throw without putting anything in.
+ *
+ * @author: Jonathan Beard
+ * @version: Mon Oct 19 06:02:47 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <raft>
+
+using ring_t = RingBuffer< std::string, Type::HeapSPSC, false >;
+
+/** inline_signal_send is for the run-time only **/
+class ring : public ring_t
+{
+public:
+    ring() : ring_t( 8 )
+    {
+    }
+
+    void signal_only( const raft::signal sig )
+    {
+        (this)->inline_signal_send( sig );
+    }
+};
+
+int
+main()
+{
+    ring r;
+    FIFO &fifo( r );
+    /** long enough not to fit in the string itself **/
+    const std::string text( 100, 'a' );
+    for( int round( 0 ); round < 100; round++ )
+    {
+        fifo.push< std::string >( text );
+        r.signal_only( raft::eof );
+        std::string item;
+        raft::signal sig( raft::none );
+        fifo.pop< std::string >( item, &sig );
+        if( item != text || sig != raft::none )
+        {
+            std::cerr << "round " << round << ", wrong string before the signal\n";
+            return( EXIT_FAILURE );
+        }
+        fifo.pop< std::string >( item, &sig );
+        if( ! item.empty() || sig != raft::eof )
+        {
+            std::cerr << "round " << round << ", signal-only slot wasn't empty\n";
+            return( EXIT_FAILURE );
+        }
+    }
+    bool finished( false );
+    r.get_write_finished( finished );
+    if( ! finished )
+    {
+        std::cerr << "eof sent, but the write isn't finished\n";
+        return( EXIT_FAILURE );
+    }
+    /** only list and vector iterators are taken, anything else throws **/
+    ring other;
+    FIFO &other_fifo( other );
+    std::deque< std::string > items( 3, text );
+    try
+    {
+        other_fifo.insert( items.begin(), items.end(), raft::eof );
+        std::cerr << "insert from a deque didn't throw\n";
+        return( EXIT_FAILURE );
+    }
+    catch( PortTypeException &ex )
+    {
+        UNUSED( ex );
+    }
+    if( other_fifo.size() != 0 )
+    {
+        std::cerr << "insert from a deque left items behind\n";
+        return( EXIT_FAILURE );
+    }
+    return( EXIT_SUCCESS );
+}
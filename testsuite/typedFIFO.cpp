@@ -0,0 +1,174 @@
+/**
+ * typedFIFO.cpp - kernels that push, pop and peek through typed
+ * views of their ports.  One edge is the default heap, one is a
+ * fixed size link so it gets the single producer/consumer ring,
+ * and one carries records too big to go inline.  The views for
+ * the first two have to reach the ring directly, the producer asks
+ * for the wrong kind of ring on the first edge and the record view
+ * has no direct path, those have to fall back to the FIFO.  Every
+ * item has to arrive in order with its signal either way.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 23:40:18 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <raft>
+
+using type_t = std::int64_t;
+
+struct record
+{
+    record( const type_t seq = -1 ) : seq( seq ){}
+
+    type_t seq;
+    char   payload[ 256 ];
+};
+
+static const type_t n_items( 100000 );
+
+static raft::signal
+expected_signal( const type_t i )
+{
+    return( i % 7 == 0 ?
+            static_cast< raft::signal >( raft::MAX_SYSTEM_SIGNAL + 1 ) :
+            raft::none );
+}
+
+static void
+fail( const char * const what )
+{
+    std::cerr << what << ", exiting!!\n";
+    exit( EXIT_FAILURE );
+}
+
+class producer : public raft::kernel
+{
+public:
+    producer() : raft::kernel()
+    {
+        output.addPort< type_t >( "heap", "spsc" );
+        output.addPort< record >( "ext" );
+        /** the heap edge isn't an SPSC ring, has to fall back **/
+        heap = output.typed< type_t, Type::HeapSPSC >( "heap" );
+        spsc = output.typed< type_t, Type::HeapSPSC >( "spsc" );
+        ext  = output.typed< record >( "ext" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        if( counter == 0 &&
+            ( heap.is_direct() || ! spsc.is_direct() || ext.is_direct() ) )
+        {
+            fail( "producer views took the wrong path" );
+        }
+        const auto sig( expected_signal( counter ) );
+        heap.push( counter, sig );
+        spsc.push( counter, sig );
+        ext.push( record( counter ), sig );
+        if( ++counter == n_items )
+        {
+            return( raft::stop );
+        }
+        return( raft::proceed );
+    }
+
+private:
+    type_t                                 counter = 0;
+    TypedFIFO< type_t, Type::HeapSPSC >    heap;
+    TypedFIFO< type_t, Type::HeapSPSC >    spsc;
+    TypedFIFO< record >                    ext;
+};
+
+class consumer : public raft::kernel
+{
+public:
+    consumer() : raft::kernel()
+    {
+        input.addPort< type_t >( "heap", "spsc" );
+        input.addPort< record >( "ext" );
+        heap = input.typed< type_t >( "heap" );
+        spsc = input.typed< type_t, Type::HeapSPSC >( "spsc" );
+        ext  = input.typed< record >( "ext" );
+    }
+
+    virtual raft::kstatus run()
+    {
+        if( count == 0 &&
+            ( ! heap.is_direct() || ! spsc.is_direct() || ext.is_direct() ) )
+        {
+            fail( "consumer views took the wrong path" );
+        }
+        const auto expected( expected_signal( count ) );
+        raft::signal sig( raft::none );
+        type_t val( -1 );
+        if( count % 2 == 0 )
+        {
+            heap.pop( val, &sig );
+        }
+        else
+        {
+            val = heap.peek( &sig );
+            heap.recycle();
+        }
+        if( val != count || sig != expected )
+        {
+            fail( "wrong item on the heap edge" );
+        }
+        sig = raft::none;
+        spsc.pop( val, &sig );
+        if( val != count || sig != expected )
+        {
+            fail( "wrong item on the spsc edge" );
+        }
+        sig = raft::none;
+        auto &rec( ext.peek( &sig ) );
+        if( rec.seq != count || sig != expected )
+        {
+            fail( "wrong record on the ext edge" );
+        }
+        ext.recycle();
+        count++;
+        return( raft::proceed );
+    }
+
+    type_t                                 count = 0;
+
+private:
+    TypedFIFO< type_t >                    heap;
+    TypedFIFO< type_t, Type::HeapSPSC >    spsc;
+    TypedFIFO< record >                    ext;
+};
+
+int
+main()
+{
+    producer p;
+    consumer c;
+    raft::map M;
+    M.link( &p, "heap", &c, "heap" );
+    M.link( &p, "spsc", &c, "spsc", 64 );
+    M.link( &p, "ext", &c, "ext" );
+    M.exe();
+    if( c.count != n_items )
+    {
+        std::cerr << "consumer got " << c.count << " of " << n_items << "\n";
+        return( EXIT_FAILURE );
+    }
+    return( EXIT_SUCCESS );
+}
@@ -0,0 +1,126 @@
+/**
+ * waitStrategy.cpp - slow producer feeding a consumer through
+ * edges that park (set on the map) and yield (set on the port),
+ * checks that everything arrives in order and that the parked
+ * consumer isn't spinning while it waits.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 13:42:10 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <thread>
+#include <raft>
+
+static const std::int64_t max_count( 50 );
+
+class producer : public raft::kernel
+{
+public:
+    producer() : raft::kernel()
+    {
+        output.addPort< std::int64_t >( "a", "b" );
+        output.setWaitStrategy( "b", raft::wait::yield );
+    }
+
+    virtual ~producer() = default;
+
+    virtual raft::kstatus run()
+    {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 4 ) );
+        output[ "a" ].push( counter );
+        output[ "b" ].push( counter );
+        if( ++counter == max_count )
+        {
+            return( raft::stop );
+        }
+        return( raft::proceed );
+    }
+
+private:
+    std::int64_t counter = 0;
+};
+
+class consumer : public raft::kernel
+{
+public:
+    consumer() : raft::kernel()
+    {
+        input.addPort< std::int64_t >( "a", "b" );
+    }
+
+    virtual ~consumer() = default;
+
+    virtual raft::kstatus run()
+    {
+        std::int64_t a( 0 ), b( 0 );
+        input[ "a" ].pop( a );
+        input[ "b" ].pop( b );
+        if( a != counter || b != counter )
+        {
+            std::cerr << "received " << a << " and " << b << ", expected "
+                      << counter << ", exiting!!\n";
+            exit( EXIT_FAILURE );
+        }
+        counter++;
+        return( raft::proceed );
+    }
+
+    std::int64_t counter = 0;
+};
+
+int
+main()
+{
+    producer p;
+    consumer c;
+
+    raft::map M;
+    M.setWaitStrategy( raft::wait::park );
+    M.link( &p, "a", &c, "a" );
+    M.link( &p, "b", &c, "b" );
+
+    const auto cpu_start( std::clock() );
+    const auto wall_start( std::chrono::steady_clock::now() );
+    M.exe();
+    const double cpu( static_cast< double >( std::clock() - cpu_start ) /
+                      CLOCKS_PER_SEC );
+    const std::chrono::duration< double > wall(
+        std::chrono::steady_clock::now() - wall_start );
+
+    if( c.counter != max_count )
+    {
+        std::cerr << "received " << c.counter << " items, expected "
+                  << max_count << "\n";
+        return( EXIT_FAILURE );
+    }
+    /**
+     * the consumer waits on "a" nearly the whole run, a spinning
+     * consumer alone would use a full core for the wall time.
+     */
+    if( cpu > wall.count() * 0.75 )
+    {
+        std::cerr << "used " << cpu << "s of cpu in " << wall.count()
+                  << "s, consumer doesn't appear to be parked\n";
+        return( EXIT_FAILURE );
+    }
+    return( EXIT_SUCCESS );
+}
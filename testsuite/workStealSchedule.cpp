@@ -0,0 +1,141 @@
+/**
+ * workStealSchedule.cpp - long chain of kernels run on two
+ * work stealing workers.  The sink pops two items per firing so
+ * it blocks inside run() whenever only one is queued, which has
+ * to be covered by a spare worker rather than stalling the map.
+ *
+ * @author: Jonathan Beard
+ * @version: Sun Oct 18 14:52:31 2026
+ *
+ * Copyright 2026 Jonathan Beard
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <raft>
+
+using type_t = std::int64_t;
+
+static const type_t      max_count( 10000 );
+static const std::size_t n_stages( 50 );
+
+class start : public raft::kernel
+{
+public:
+    start() : raft::kernel()
+    {
+        output.addPort< type_t >( "0" );
+    }
+
+    virtual ~start() = default;
+
+    virtual raft::kstatus run()
+    {
+        output[ "0" ].push( counter );
+        if( ++counter == max_count )
+        {
+            return( raft::stop );
+        }
+        return( raft::proceed );
+    }
+
+private:
+    type_t counter = 0;
+};
+
+class addone : public raft::kernel
+{
+public:
+    addone() : raft::kernel()
+    {
+        input.addPort< type_t >( "0" );
+        output.addPort< type_t >( "0" );
+    }
+
+    virtual ~addone() = default;
+
+    virtual raft::kstatus run()
+    {
+        type_t val( 0 );
+        input[ "0" ].pop( val );
+        output[ "0" ].push( val + 1 );
+        return( raft::proceed );
+    }
+};
+
+class pairsum : public raft::kernel
+{
+public:
+    pairsum() : raft::kernel()
+    {
+        input.addPort< type_t >( "0" );
+    }
+
+    virtual ~pairsum() = default;
+
+    virtual raft::kstatus run()
+    {
+        type_t a( 0 ), b( 0 );
+        input[ "0" ].pop( a );
+        input[ "0" ].pop( b );
+        if( a + 1 != b )
+        {
+            std::cerr << "received " << a << " then " << b << ", exiting!!\n";
+            exit( EXIT_FAILURE );
+        }
+        sum += a + b;
+        count += 2;
+        return( raft::proceed );
+    }
+
+    type_t sum   = 0;
+    type_t count = 0;
+};
+
+int
+main()
+{
+    start   s;
+    pairsum p;
+    std::vector< std::unique_ptr< addone > > stages;
+    for( std::size_t i( 0 ); i < n_stages; i++ )
+    {
+        stages.emplace_back( new addone() );
+    }
+
+    raft::map M;
+    M.link( &s, stages.front().get() );
+    for( std::size_t i( 1 ); i < n_stages; i++ )
+    {
+        M.link( stages[ i - 1 ].get(), stages[ i ].get() );
+    }
+    M.link( stages.back().get(), &p );
+    M.exe< partition_dummy, work_steal_schedule_n< 2 > >();
+
+    const type_t offset( n_stages );
+    const type_t expected( ( max_count * ( max_count - 1 ) ) / 2 +
+                           max_count * offset );
+    if( p.count != max_count || p.sum != expected )
+    {
+        std::cerr << "received " << p.count << " items summing to "
+                  << p.sum << ", expected " << max_count << " summing to "
+                  << expected << "\n";
+        return( EXIT_FAILURE );
+    }
+    return( EXIT_SUCCESS );
+}